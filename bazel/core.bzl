@@ -338,6 +338,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/renderer_impl.cpp",
     "src/mbgl/renderer/renderer_impl.hpp",
     "src/mbgl/renderer/renderer_state.cpp",
+    "src/mbgl/renderer/shared_atlas.cpp",
+    "src/mbgl/renderer/shared_atlas.hpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.cpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.hpp",
     "src/mbgl/renderer/sources/render_geojson_source.cpp",
@@ -384,6 +386,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/collection.hpp",
     "src/mbgl/style/conversion/color_ramp_property_value.cpp",
     "src/mbgl/style/conversion/constant.cpp",
+    "src/mbgl/style/conversion/conversion_cache.cpp",
+    "src/mbgl/style/conversion/conversion_cache.hpp",
     "src/mbgl/style/conversion/coordinate.cpp",
     "src/mbgl/style/conversion/custom_geometry_source_options.cpp",
     "src/mbgl/style/conversion/filter.cpp",
@@ -444,6 +448,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/expression/value.cpp",
     "src/mbgl/style/expression/within.cpp",
     "src/mbgl/style/filter.cpp",
+    "src/mbgl/style/filter_program.cpp",
+    "src/mbgl/style/filter_program.hpp",
     "src/mbgl/style/sprite.cpp",
     "src/mbgl/style/image.cpp",
     "src/mbgl/style/image_impl.cpp",
@@ -487,6 +493,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/properties.hpp",
     "src/mbgl/style/property_expression.cpp",
     "src/mbgl/style/rapidjson_conversion.hpp",
+    "src/mbgl/style/snapshot.cpp",
+    "src/mbgl/style/snapshot_conversion.hpp",
     "src/mbgl/style/source.cpp",
     "src/mbgl/style/source_impl.cpp",
     "src/mbgl/style/source_impl.hpp",
@@ -540,6 +548,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/quads.hpp",
     "src/mbgl/text/shaping.cpp",
     "src/mbgl/text/shaping.hpp",
+    "src/mbgl/text/shaping_cache.cpp",
+    "src/mbgl/text/shaping_cache.hpp",
     "src/mbgl/text/tagged_string.cpp",
     "src/mbgl/text/tagged_string.hpp",
     "src/mbgl/tile/custom_geometry_tile.cpp",
@@ -553,6 +563,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/tile/geometry_tile_data.hpp",
     "src/mbgl/tile/geometry_tile_worker.cpp",
     "src/mbgl/tile/geometry_tile_worker.hpp",
+    "src/mbgl/tile/layout_cache.cpp",
+    "src/mbgl/tile/layout_cache.hpp",
     "src/mbgl/tile/raster_dem_tile.cpp",
     "src/mbgl/tile/raster_dem_tile.hpp",
     "src/mbgl/tile/raster_dem_tile_worker.cpp",
@@ -706,6 +718,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/platform/settings.hpp",
     "include/mbgl/platform/thread.hpp",
     "include/mbgl/platform/time.hpp",
+    "include/mbgl/renderer/layout_cache_stats.hpp",
     "include/mbgl/renderer/query.hpp",
     "include/mbgl/renderer/renderer.hpp",
     "include/mbgl/renderer/renderer_frontend.hpp",
@@ -790,6 +803,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/style/property_expression.hpp",
     "include/mbgl/style/property_value.hpp",
     "include/mbgl/style/rotation.hpp",
+    "include/mbgl/style/snapshot.hpp",
     "include/mbgl/style/source.hpp",
     "include/mbgl/style/sources/custom_geometry_source.hpp",
     "include/mbgl/style/sources/geojson_source.hpp",
@@ -872,6 +886,8 @@ MLN_CORE_HEADERS = [
 MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/attribute.cpp",
     "src/mbgl/gl/attribute.hpp",
+    "src/mbgl/gl/buffer_arena.cpp",
+    "src/mbgl/gl/buffer_arena.hpp",
     "src/mbgl/gl/command_encoder.cpp",
     "src/mbgl/gl/command_encoder.hpp",
     "src/mbgl/gl/context.cpp",
@@ -888,11 +904,14 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/framebuffer.hpp",
     "src/mbgl/gl/index_buffer_resource.cpp",
     "src/mbgl/gl/index_buffer_resource.hpp",
+    "src/mbgl/gl/multi_draw_extension.hpp",
     "src/mbgl/gl/object.cpp",
     "src/mbgl/gl/object.hpp",
     "src/mbgl/gl/offscreen_texture.cpp",
     "src/mbgl/gl/offscreen_texture.hpp",
     "src/mbgl/gl/program.hpp",
+    "src/mbgl/gl/program_binary_cache.cpp",
+    "src/mbgl/gl/program_binary_cache.hpp",
     "src/mbgl/gl/render_pass.cpp",
     "src/mbgl/gl/render_pass.hpp",
     "src/mbgl/gl/renderbuffer_resource.cpp",
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/annotation/annotation.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_observer.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/color.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr Size size{1000, 1000};
+const LatLng center{40.726989, -73.992857}; // Manhattan
+
+class AnnotationBenchmark {
+public:
+    AnnotationBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        map.getStyle().loadJSON(R"({"version": 8, "sources": {}, "layers": []})");
+        map.jumpTo(CameraOptions().withCenter(center).withZoom(11.0));
+    }
+
+    util::RunLoop loop;
+    HeadlessFrontend frontend{size, 1};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(size),
+            ResourceOptions().withCachePath("benchmark/fixtures/api/cache.db").withAssetPath(".").withApiKey("foobar")};
+};
+
+// A route of a few dozen points, spread over a region about the size of the viewport
+LineAnnotation makeRoute(std::size_t i, double offset = 0) {
+    LineString<double> route;
+    double lon = center.longitude() + 0.3 * std::sin(i * 1.7) + offset;
+    double lat = center.latitude() + 0.3 * std::cos(i * 2.3);
+    for (std::size_t j = 0; j < 32; ++j) {
+        route.emplace_back(lon, lat);
+        lon += 0.004 * std::cos(i + j * 0.3);
+        lat += 0.004 * std::sin(i + j * 0.5);
+    }
+    LineAnnotation annotation{std::move(route)};
+    annotation.color = Color::red();
+    return annotation;
+}
+
+FillAnnotation makeArea(std::size_t i) {
+    const double lon = center.longitude() + 0.3 * std::cos(i * 1.3);
+    const double lat = center.latitude() + 0.3 * std::sin(i * 3.1);
+    FillAnnotation annotation{
+        Polygon<double>{{{lon, lat}, {lon + 0.01, lat}, {lon + 0.01, lat + 0.01}, {lon, lat + 0.01}, {lon, lat}}}};
+    annotation.color = Color::blue();
+    return annotation;
+}
+
+std::vector<AnnotationID> addAnnotations(Map& map, std::size_t count) {
+    std::vector<AnnotationID> ids;
+    ids.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ids.push_back(i % 2 ? map.addAnnotation(makeArea(i)) : map.addAnnotation(makeRoute(i)));
+    }
+    return ids;
+}
+
+} // end namespace
+
+// Adds thousands of line and fill annotations, and renders the tiles of the annotation source
+static void API_addShapeAnnotations(::benchmark::State& state) {
+    AnnotationBenchmark bench;
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        const auto ids = addAnnotations(bench.map, count);
+        bench.frontend.render(bench.map);
+
+        state.PauseTiming();
+        for (const auto id : ids) {
+            bench.map.removeAnnotation(id);
+        }
+        bench.frontend.render(bench.map);
+        state.ResumeTiming();
+    }
+}
+
+// Moves one route among thousands of annotations, which only needs the tiles it overlaps to be updated
+static void API_updateShapeAnnotation(::benchmark::State& state) {
+    AnnotationBenchmark bench;
+    const auto ids = addAnnotations(bench.map, static_cast<std::size_t>(state.range(0)));
+    bench.frontend.render(bench.map);
+
+    std::size_t iteration = 0;
+    for (auto _ : state) {
+        bench.map.updateAnnotation(ids[0], makeRoute(0, (iteration++ % 2) * 0.01));
+        bench.frontend.render(bench.map);
+    }
+}
+
+BENCHMARK(API_addShapeAnnotations)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond)->Iterations(5);
+BENCHMARK(API_updateShapeAnnotation)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond)->Iterations(20);
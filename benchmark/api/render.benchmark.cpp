@@ -1,9 +1,13 @@
 #include <benchmark/benchmark.h>
 
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gfx/renderer_backend.hpp>
+#include <mbgl/gfx/rendering_stats.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_observer.hpp>
 #include <mbgl/map/map_options.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/resource_options.hpp>
@@ -11,10 +15,20 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/style/transition_options.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/util/color.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/rapidjson.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <array>
+#include <cmath>
+#include <ctime>
 #include <sstream>
 #include <optional>
 
@@ -23,6 +37,7 @@ using namespace mbgl;
 namespace {
 
 static std::string cachePath{"benchmark/fixtures/api/cache.db"};
+static std::string shaderCachePath{"benchmark/fixtures/shader_cache"};
 constexpr double pixelRatio{1.0};
 constexpr Size size{1000, 1000};
 
@@ -49,6 +64,39 @@ void prepare_map2(Map& map, std::optional<std::string> json = std::nullopt) {
     map.getStyle().addImage(std::make_unique<style::Image>("test-icon", std::move(image), 1.0f));
 }
 
+void invertColors(JSValue& value, JSDocument::AllocatorType& allocator) {
+    if (value.IsString()) {
+        if (const auto color = Color::parse(value.GetString())) {
+            const Color inverted{color->a - color->r, color->a - color->g, color->a - color->b, color->a};
+            value.SetString(inverted.stringify().c_str(), allocator);
+        }
+    } else if (value.IsArray()) {
+        for (auto& item : value.GetArray()) {
+            invertColors(item, allocator);
+        }
+    } else if (value.IsObject()) {
+        for (auto& member : value.GetObject()) {
+            invertColors(member.value, allocator);
+        }
+    }
+}
+
+// The fixture style with the colors of its paint properties inverted, as a night theme of it
+std::string nightStyle() {
+    JSDocument document;
+    document.Parse<0>(util::read_file("benchmark/fixtures/api/style.json").c_str());
+    for (auto& layer : document["layers"].GetArray()) {
+        if (layer.HasMember("paint")) {
+            invertColors(layer["paint"], document.GetAllocator());
+        }
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    document.Accept(writer);
+    return buffer.GetString();
+}
+
 } // end namespace
 
 static void API_renderStill_reuse_map(::benchmark::State& state) {
@@ -60,9 +108,13 @@ static void API_renderStill_reuse_map(::benchmark::State& state) {
             ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
     prepare(map);
 
+    gfx::RenderingStats stats;
     for (auto _ : state) {
-        frontend.render(map);
+        stats = frontend.render(map).stats;
     }
+    // A multi-draw call counts once in draw_calls, and once per range in draw_ranges
+    state.counters["draw_calls"] = stats.numDrawCalls;
+    state.counters["draw_ranges"] = stats.numDrawRanges;
 }
 
 static void API_renderStill_reuse_map_formatted_labels(::benchmark::State& state) {
@@ -123,6 +175,119 @@ static void API_renderStill_recreate_map_2(::benchmark::State& state) {
     }
 }
 
+// Time to first complete frame with the shared worker pool sized by `state.range(0)`
+static void API_renderStill_recreate_map_pool_size(::benchmark::State& state) {
+    RenderBenchmark bench;
+    auto& settings = platform::Settings::getInstance();
+    settings.set(platform::EXPERIMENTAL_THREAD_POOL_SIZE, static_cast<uint64_t>(state.range(0)));
+
+    for (auto _ : state) {
+        HeadlessFrontend frontend{size, pixelRatio};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map);
+        frontend.render(map);
+    }
+
+    settings.set(platform::EXPERIMENTAL_THREAD_POOL_SIZE, mapbox::base::Value{});
+}
+
+// Lays out the labels of a block of adjacent street tiles, with the shaping cache disabled or enabled by
+// `state.range(0)`. The cache is kept across iterations, as it would be across tile reloads and zoom levels.
+static void API_renderStill_recreate_map_shaping_cache(::benchmark::State& state) {
+    RenderBenchmark bench;
+    auto& cache = ShapingCache::getInstance();
+    cache.clear();
+    cache.setMaxEntries(state.range(0) ? ShapingCache::defaultMaxEntries : 0);
+
+    for (auto _ : state) {
+        HeadlessFrontend frontend{size, pixelRatio};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map);
+        frontend.render(map);
+    }
+
+    const auto stats = cache.getStats();
+    const auto lookups = stats.hits + stats.misses;
+    state.counters["hit_rate"] = lookups ? static_cast<double>(stats.hits) / lookups : 0.0;
+    state.counters["entries"] = static_cast<double>(stats.entries);
+
+    cache.setMaxEntries(ShapingCache::defaultMaxEntries);
+    cache.clear();
+}
+
+// Time to the first frame of a new map, with the on-disk shader cache disabled or enabled by `state.range(0)`.
+// When enabled, each iteration loads the shaders, and the Vulkan pipelines, saved by the previous ones. For stable
+// numbers with Vulkan, run on a software driver such as lavapipe, by setting `VK_ICD_FILENAMES` to its ICD file.
+// The counters are the pipelines created by the first frame, and by a frame at another location drawn afterwards,
+// which stalls on every pipeline it creates.
+static void API_renderStill_first_frame_shader_cache(::benchmark::State& state) {
+    RenderBenchmark bench;
+    auto& settings = platform::Settings::getInstance();
+    if (state.range(0)) {
+        settings.set(platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH, shaderCachePath);
+    }
+
+    gfx::RenderingStats firstFrame;
+    gfx::RenderingStats secondFrame;
+    for (auto _ : state) {
+        HeadlessFrontend frontend{size, pixelRatio};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map);
+        firstFrame = frontend.render(map).stats;
+
+        state.PauseTiming();
+        map.jumpTo(CameraOptions().withCenter(LatLng{41.379800, 2.176810})); // Barcelona
+        secondFrame = frontend.render(map).stats;
+        state.ResumeTiming();
+    }
+
+    state.counters["pipelines_first_frame"] = firstFrame.numCreatedPipelines;
+    state.counters["pipelines_second_frame"] = secondFrame.numCreatedPipelines - firstFrame.numCreatedPipelines;
+    state.counters["shader_cache_hits"] = firstFrame.numProgramBinaryHits;
+    state.counters["shader_cache_misses"] = firstFrame.numProgramBinaryMisses;
+
+    settings.set(platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH, mapbox::base::Value{});
+}
+
+// Switches between the day and night themes of a style, which differ only in their paint properties, and renders
+// a frame after each switch. The new style replaces the current one when `state.range(0)` is 0, and is applied as
+// a diff otherwise. The time is the stall before the first complete frame of a theme. The counter is the CPU time
+// of the whole process for a switch, most of it spent on the workers when the tiles are parsed and laid out again.
+static void API_renderStill_theme_swap(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    const std::array<std::string, 2> themes{util::read_file("benchmark/fixtures/api/style.json"), nightStyle()};
+    const auto mode = state.range(0) ? style::Style::LoadMode::Diff : style::Style::LoadMode::Replace;
+    prepare(map, themes[0]);
+    frontend.render(map);
+
+    std::size_t theme = 0;
+    std::clock_t cpu = 0;
+    for (auto _ : state) {
+        theme = 1 - theme;
+        const std::clock_t start = std::clock();
+        map.getStyle().loadJSON(themes[theme], mode);
+        frontend.render(map);
+        cpu += std::clock() - start;
+    }
+
+    state.counters["process_cpu_ms"] = benchmark::Counter(1000.0 * cpu / CLOCKS_PER_SEC,
+                                                          benchmark::Counter::kAvgIterations);
+}
+
 static void API_renderStill_multiple_sources(::benchmark::State& state) {
     using namespace mbgl::style;
     RenderBenchmark bench;
@@ -154,9 +319,76 @@ static void API_renderStill_multiple_sources(::benchmark::State& state) {
     }
 }
 
+// Renders the frames of a camera animation over the labels of the fixture: a pan when
+// `state.range(0)` is 0, a rotation otherwise. Placement transitions are disabled, so that
+// symbols are placed in every frame. The `placement_ms` counter is the part of the time per
+// frame spent placing symbols.
+static void API_renderContinuous_camera_animation(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Continuous).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    prepare(map);
+    map.getStyle().setTransitionOptions(style::TransitionOptions{std::nullopt, std::nullopt, false});
+    while (!map.isFullyLoaded()) {
+        frontend.renderOnce(map);
+    }
+
+    const auto& stats = frontend.getBackend()->getContext().renderingStats();
+    const double placementTime = stats.placementTime;
+    const bool rotate = state.range(0) != 0;
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        ++frame;
+        if (rotate) {
+            map.jumpTo(CameraOptions().withBearing(5.0 * std::sin(frame * 0.05)));
+        } else {
+            // Back and forth, to stay over the tiles in the cache
+            map.moveBy({(frame / 100) % 2 ? -2.0 : 2.0, 0.0});
+        }
+        frontend.renderFrame();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["placement_ms"] = benchmark::Counter(1000.0 * (stats.placementTime - placementTime),
+                                                        benchmark::Counter::kAvgIterations);
+}
+
 BENCHMARK(API_renderStill_reuse_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map_2)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderStill_recreate_map_pool_size)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(0) // hardware concurrency
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(50);
+BENCHMARK(API_renderStill_recreate_map_shaping_cache)
+    ->ArgName("cache")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(50);
+BENCHMARK(API_renderStill_first_frame_shader_cache)
+    ->ArgName("cache")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(20);
+BENCHMARK(API_renderStill_theme_swap)
+    ->ArgName("diff")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(50);
 BENCHMARK(API_renderStill_multiple_sources)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderContinuous_camera_animation)
+    ->ArgName("rotate")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(400);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/dem_data.hpp>
+#include <mbgl/util/image.hpp>
+
+#include <cmath>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr uint32_t tileSize = 512;
+
+// A smooth synthetic terrain in the Mapbox Terrain-RGB encoding, so that the PNG
+// compresses about as well as real elevation tiles.
+PremultipliedImage makeTerrain(uint32_t offset) {
+    PremultipliedImage image({tileSize, tileSize});
+    uint8_t* pixel = image.data.get();
+    for (uint32_t y = 0; y < tileSize; y++) {
+        for (uint32_t x = 0; x < tileSize; x++) {
+            const double elevation = 1000.0 + 800.0 * std::sin((x + offset) / 40.0) * std::cos(y / 55.0);
+            const auto value = static_cast<uint32_t>((elevation + 10000.0) * 10.0);
+            *pixel++ = static_cast<uint8_t>(value >> 16);
+            *pixel++ = static_cast<uint8_t>(value >> 8);
+            *pixel++ = static_cast<uint8_t>(value);
+            *pixel++ = 255;
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+// The work done by RasterDEMTileWorker for each tile: PNG decode and border setup.
+static void DEMData_Decode(benchmark::State& state) {
+    const std::string png = encodePNG(makeTerrain(0));
+
+    for (auto _ : state) {
+        DEMData dem(decodeImage(png), Tileset::DEMEncoding::Mapbox);
+        benchmark::DoNotOptimize(dem.getImage()->data.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * tileSize * tileSize * 4));
+}
+
+static void DEMData_Construct(benchmark::State& state) {
+    const PremultipliedImage image = makeTerrain(0);
+
+    for (auto _ : state) {
+        DEMData dem(image, Tileset::DEMEncoding::Mapbox);
+        benchmark::DoNotOptimize(dem.getImage()->data.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * image.bytes()));
+}
+
+// Backfills all eight neighbors, as happens once the surrounding tiles are loaded.
+static void DEMData_BackfillBorder(benchmark::State& state) {
+    DEMData dem(makeTerrain(0), Tileset::DEMEncoding::Mapbox);
+    const DEMData neighbor(makeTerrain(tileSize), Tileset::DEMEncoding::Mapbox);
+
+    for (auto _ : state) {
+        for (int8_t dy = -1; dy <= 1; dy++) {
+            for (int8_t dx = -1; dx <= 1; dx++) {
+                if (dx != 0 || dy != 0) {
+                    dem.backfillBorder(neighbor, dx, dy);
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(DEMData_Decode)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DEMData_Construct)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DEMData_BackfillBorder)->Unit(benchmark::kMicrosecond);
@@ -6,6 +6,12 @@
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <iterator>
+#include <utility>
+#include <vector>
 
 using namespace mbgl;
 
@@ -30,5 +36,83 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+namespace {
+
+// All layer filters of an OpenMapTiles style
+std::vector<style::Filter> openMapTilesFilters() {
+    JSDocument document;
+    document.Parse<0>(util::read_file("test/fixtures/resources/style_vector.json").c_str());
+
+    std::vector<style::Filter> filters;
+    for (const auto& layer : document["layers"].GetArray()) {
+        if (layer.HasMember("filter")) {
+            style::conversion::Error error;
+            if (auto filter = style::conversion::convert<style::Filter>(
+                    style::conversion::Convertible(&layer["filter"]), error)) {
+                filters.push_back(std::move(*filter));
+            }
+        }
+    }
+    return filters;
+}
+
+// Features with the kind of properties found in OpenMapTiles layers
+std::vector<StubGeometryTileFeature> openMapTilesFeatures() {
+    const std::pair<FeatureType, PropertyMap> samples[] = {
+        {FeatureType::LineString, {{"class", std::string("motorway")}, {"ramp", int64_t(1)}}},
+        {FeatureType::LineString, {{"class", std::string("primary")}, {"brunnel", std::string("bridge")}}},
+        {FeatureType::LineString, {{"class", std::string("minor")}, {"layer", int64_t(1)}}},
+        {FeatureType::LineString, {{"class", std::string("service")}, {"brunnel", std::string("tunnel")}}},
+        {FeatureType::LineString, {{"class", std::string("river")}, {"intermittent", int64_t(0)}}},
+        {FeatureType::Polygon, {{"class", std::string("residential")}}},
+        {FeatureType::Polygon, {{"class", std::string("wood")}, {"subclass", std::string("forest")}}},
+        {FeatureType::Point, {{"class", std::string("city")}, {"rank", int64_t(4)}}},
+        {FeatureType::LineString, {{"admin_level", int64_t(2)}, {"disputed", int64_t(0)}}},
+    };
+
+    std::vector<StubGeometryTileFeature> features;
+    features.reserve(std::size(samples));
+    for (const auto& [type, properties] : samples) {
+        features.emplace_back(FeatureIdentifier{}, type, GeometryCollection{}, properties);
+    }
+    return features;
+}
+
+} // namespace
+
+// Evaluating every filter of the style on each feature, by walking the expression tree
+static void Parse_EvaluateFilter_OpenMapTiles_Expression(benchmark::State& state) {
+    const auto filters = openMapTilesFilters();
+    const auto features = openMapTilesFeatures();
+
+    for (auto _ : state) {
+        for (const auto& feature : features) {
+            const style::expression::EvaluationContext context(14.0f, &feature);
+            for (const auto& filter : filters) {
+                benchmark::DoNotOptimize((**filter.expression).evaluate(context));
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * features.size() * filters.size()));
+}
+
+// The same, through the compiled form of each filter
+static void Parse_EvaluateFilter_OpenMapTiles_Compiled(benchmark::State& state) {
+    const auto filters = openMapTilesFilters();
+    const auto features = openMapTilesFeatures();
+
+    for (auto _ : state) {
+        for (const auto& feature : features) {
+            const style::expression::EvaluationContext context(14.0f, &feature);
+            for (const auto& filter : filters) {
+                benchmark::DoNotOptimize(filter(context));
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * features.size() * filters.size()));
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateFilter_OpenMapTiles_Expression);
+BENCHMARK(Parse_EvaluateFilter_OpenMapTiles_Compiled);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr uint32_t tileSize = 512;
+
+// A raster tile with varying alpha, so that every pixel needs to be converted
+UnassociatedImage makeTile() {
+    UnassociatedImage image({tileSize, tileSize});
+    uint8_t* pixel = image.data.get();
+    for (uint32_t y = 0; y < tileSize; y++) {
+        for (uint32_t x = 0; x < tileSize; x++) {
+            *pixel++ = static_cast<uint8_t>(x);
+            *pixel++ = static_cast<uint8_t>(y);
+            *pixel++ = static_cast<uint8_t>(x ^ y);
+            *pixel++ = static_cast<uint8_t>(x + y);
+        }
+    }
+    return image;
+}
+
+// The work done by RasterTileWorker for each tile
+void decodeTile(benchmark::State& state, const std::string& path) {
+    const std::string data = util::read_file(path);
+    std::size_t bytes = 0;
+
+    for (auto _ : state) {
+        PremultipliedImage image = decodeImage(data);
+        benchmark::DoNotOptimize(image.data.get());
+        bytes += image.bytes();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+} // namespace
+
+static void Image_DecodePNG(benchmark::State& state) {
+    decodeTile(state, "test/fixtures/image/tile.png");
+}
+
+static void Image_DecodeJPEG(benchmark::State& state) {
+    decodeTile(state, "test/fixtures/image/tile.jpeg");
+}
+
+#if !defined(__QT__) // WebP support is not enabled in Qt by default
+static void Image_DecodeWebP(benchmark::State& state) {
+    decodeTile(state, "test/fixtures/image/tile.webp");
+}
+#endif // !defined(__QT__)
+
+static void Image_Premultiply(benchmark::State& state) {
+    const UnassociatedImage tile = makeTile();
+
+    for (auto _ : state) {
+        PremultipliedImage image = util::premultiply(tile.clone());
+        benchmark::DoNotOptimize(image.data.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * tile.bytes()));
+}
+
+static void Image_Unpremultiply(benchmark::State& state) {
+    const PremultipliedImage tile = util::premultiply(makeTile());
+
+    for (auto _ : state) {
+        UnassociatedImage image = util::unpremultiply(tile.clone());
+        benchmark::DoNotOptimize(image.data.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * tile.bytes()));
+}
+
+BENCHMARK(Image_DecodePNG)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Image_DecodeJPEG)->Unit(benchmark::kMicrosecond);
+#if !defined(__QT__)
+BENCHMARK(Image_DecodeWebP)->Unit(benchmark::kMicrosecond);
+#endif
+BENCHMARK(Image_Premultiply)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Image_Unpremultiply)->Unit(benchmark::kMicrosecond);
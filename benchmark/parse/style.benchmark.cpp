@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/parser.hpp>
+#include <mbgl/style/snapshot.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cassert>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+void parseStyle(benchmark::State& state, const std::string& data, const bool isSnapshot) {
+    for (auto _ : state) {
+        style::Parser parser;
+        [[maybe_unused]] const auto error = isSnapshot ? parser.parseSnapshot(data) : parser.parse(data);
+        assert(!error);
+        benchmark::DoNotOptimize(parser.layers.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+} // namespace
+
+static void Parse_Style_JSON(benchmark::State& state) {
+    parseStyle(state, util::read_file("benchmark/fixtures/api/style.json"), false);
+}
+
+// The same style, loaded from a snapshot
+static void Parse_Style_Snapshot(benchmark::State& state) {
+    parseStyle(state, style::snapshot::encode(util::read_file("benchmark/fixtures/api/style.json")), true);
+}
+
+static void Parse_Style_EncodeSnapshot(benchmark::State& state) {
+    const auto json = util::read_file("benchmark/fixtures/api/style.json");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(style::snapshot::encode(json));
+    }
+}
+
+BENCHMARK(Parse_Style_JSON);
+BENCHMARK(Parse_Style_Snapshot);
+BENCHMARK(Parse_Style_EncodeSnapshot);
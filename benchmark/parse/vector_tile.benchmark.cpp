@@ -28,3 +28,78 @@ static void Parse_VectorTile(benchmark::State& state) {
 }
 
 BENCHMARK(Parse_VectorTile);
+
+static void Parse_VectorTile_Visit(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+
+    while (state.KeepRunning()) {
+        std::size_t length = 0;
+        VectorTileData tile(data);
+        for (const auto& name : tile.layerNames()) {
+            if (auto layer = tile.getLayer(name)) {
+                layer->visitFeatures([&](std::size_t, const GeometryTileFeature& feature) {
+                    length += feature.getGeometries().size();
+                    length += feature.getProperties().size();
+                    return true;
+                });
+            }
+        }
+        (void)length;
+    }
+}
+
+BENCHMARK(Parse_VectorTile_Visit);
+
+// Filter-style access: a couple of property lookups per feature, with geometry only decoded for matches
+static void Parse_VectorTile_GetValue(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const std::string classKey = "class";
+    const std::string typeKey = "type";
+
+    while (state.KeepRunning()) {
+        std::size_t length = 0;
+        VectorTileData tile(data);
+        for (const auto& name : tile.layerNames()) {
+            if (auto layer = tile.getLayer(name)) {
+                const std::size_t count = layer->featureCount();
+                for (std::size_t i = 0; i < count; i++) {
+                    if (auto feature = layer->getFeature(i)) {
+                        if (feature->getValue(classKey) || feature->getValue(typeKey)) {
+                            length += feature->getGeometries().size();
+                        }
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+BENCHMARK(Parse_VectorTile_GetValue);
+
+static void Parse_VectorTile_GetValue_Visit(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const std::string classKey = "class";
+    const std::string typeKey = "type";
+
+    while (state.KeepRunning()) {
+        std::size_t length = 0;
+        VectorTileData tile(data);
+        for (const auto& name : tile.layerNames()) {
+            if (auto layer = tile.getLayer(name)) {
+                layer->visitFeatures([&](std::size_t, const GeometryTileFeature& feature) {
+                    if (feature.getValue(classKey) || feature.getValue(typeKey)) {
+                        length += feature.getGeometries().size();
+                    }
+                    return true;
+                });
+            }
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+BENCHMARK(Parse_VectorTile_GetValue_Visit);
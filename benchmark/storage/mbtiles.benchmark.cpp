@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Enough 50 kB tiles to be well beyond the SQLite page cache: 4^6 tiles at z6, about 200 MB
+constexpr int8_t tileZoom = 6;
+constexpr int32_t tilesPerSide = 1 << tileZoom;
+constexpr std::size_t tileSize = 50 * 1024;
+
+using Clock = std::chrono::steady_clock;
+
+// A throwaway .mbtiles file, generated once per process
+class LargeMBTiles {
+public:
+    LargeMBTiles()
+        : path((std::filesystem::temp_directory_path() / "mbgl-benchmark-large.mbtiles").string()) {
+        util::deleteFile(path);
+
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate);
+        db.exec("CREATE TABLE metadata (name TEXT, value TEXT)");
+        db.exec("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)");
+        db.exec("CREATE UNIQUE INDEX tile_index ON tiles (zoom_level, tile_column, tile_row)");
+        db.exec(
+            "INSERT INTO metadata VALUES ('format', 'pbf'), ('minzoom', '" + util::toString(tileZoom) +
+            "'), ('maxzoom', '" + util::toString(tileZoom) + "')");
+
+        // Data from a small alphabet, so that it compresses roughly like real vector tiles
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> alphabet('a', 'p');
+        std::string data(tileSize, 0);
+
+        mapbox::sqlite::Transaction transaction(db);
+        mapbox::sqlite::Statement insert(db, "INSERT INTO tiles VALUES (?1, ?2, ?3, ?4)");
+        for (int32_t x = 0; x < tilesPerSide; ++x) {
+            for (int32_t y = 0; y < tilesPerSide; ++y) {
+                std::generate(data.begin(), data.end(), [&] { return static_cast<char>(alphabet(random)); });
+                // Half of the tiles are stored gzipped, as produced by most tile generators
+                const std::string blob = (x + y) % 2 ? util::compress(data, util::GZIP) : data;
+
+                mapbox::sqlite::Query query(insert);
+                query.bind(1, static_cast<int64_t>(tileZoom));
+                query.bind(2, static_cast<int64_t>(x));
+                query.bind(3, static_cast<int64_t>(y));
+                query.bindBlob(4, blob.data(), blob.size(), false);
+                query.run();
+            }
+        }
+        transaction.commit();
+    }
+
+    ~LargeMBTiles() { util::deleteFile(path); }
+
+    Resource tile(int32_t x, int32_t y) const {
+        return Resource::tile(
+            "mbtiles://" + path + "?file={z}/{x}/{y}.pbf", 1.0, x, y, tileZoom, Tileset::Scheme::XYZ);
+    }
+
+    static const LargeMBTiles& get() {
+        static const LargeMBTiles instance;
+        return instance;
+    }
+
+    const std::string path;
+};
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    const auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+} // namespace
+
+// Fetches random tiles one at a time, measuring the round trip of each request.
+static void MBTiles_TileLatency(benchmark::State& state) {
+    const auto& mbtiles = LargeMBTiles::get();
+
+    util::RunLoop loop;
+    MBTilesFileSource fileSource(ResourceOptions::Default(), ClientOptions());
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int32_t> coordinate(0, tilesPerSide - 1);
+
+    std::vector<double> latencies;
+    int64_t bytes = 0;
+
+    for (auto _ : state) {
+        const auto resource = mbtiles.tile(coordinate(random), coordinate(random));
+        const auto start = Clock::now();
+        auto request = fileSource.request(resource, [&](const Response& response) {
+            bytes += static_cast<int64_t>(response.data ? response.data->size() : 0);
+            loop.stop();
+        });
+        loop.run();
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+    state.counters["p50_us"] = percentile(latencies, 0.50);
+    state.counters["p99_us"] = percentile(latencies, 0.99);
+}
+
+// Keeps a window of requests outstanding, as a map does when a viewport of tiles is loaded.
+static void MBTiles_TileThroughput(benchmark::State& state) {
+    const auto& mbtiles = LargeMBTiles::get();
+    const auto window = static_cast<std::size_t>(state.range(0));
+
+    util::RunLoop loop;
+    MBTilesFileSource fileSource(ResourceOptions::Default(), ClientOptions());
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int32_t> coordinate(0, tilesPerSide - 1);
+
+    int64_t bytes = 0;
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<AsyncRequest>> requests;
+        requests.reserve(window);
+        std::size_t pending = window;
+        for (std::size_t i = 0; i < window; ++i) {
+            requests.push_back(
+                fileSource.request(mbtiles.tile(coordinate(random), coordinate(random)), [&](const Response& response) {
+                    bytes += static_cast<int64_t>(response.data ? response.data->size() : 0);
+                    if (--pending == 0) {
+                        loop.stop();
+                    }
+                }));
+        }
+        loop.run();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * window));
+    state.SetBytesProcessed(bytes);
+}
+
+BENCHMARK(MBTiles_TileLatency)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(MBTiles_TileThroughput)->ArgName("window")->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -6,8 +6,12 @@
 #include <mbgl/storage/sqlite3.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/io.hpp>
 
+#include <filesystem>
+#include <list>
 #include <random>
+#include <tuple>
 
 class OfflineDatabase : public benchmark::Fixture {
 public:
@@ -200,3 +204,54 @@ BENCHMARK_F(OfflineDatabase, ResizeDatabase)(benchmark::State& state) {
         }
     }
 }
+
+// A fly-over worth of small tiles written to a full, file backed ambient cache, either one
+// transaction per tile or in batches of `batch` tiles as done by DatabaseFileSource.
+static void OfflineDatabase_AmbientInsertStorm(benchmark::State& state) {
+    using namespace mbgl;
+
+    const auto batchSize = static_cast<std::size_t>(state.range(0));
+    const std::string path = (std::filesystem::temp_directory_path() / "mbgl-benchmark-ambient.db").string();
+    constexpr unsigned tilesPerIteration = 1024;
+
+    util::deleteFile(path);
+    Log::setObserver(std::make_unique<Log::NullObserver>());
+    {
+        mbgl::OfflineDatabase db{path, TileServerOptions::DefaultConfiguration()};
+        db.setMaximumAmbientCacheSize(5 * 1024 * 1024);
+
+        Response response;
+        response.data = std::make_shared<std::string>(8 * 1024, 'x');
+        response.expires = util::now() + std::chrono::hours(1);
+
+        unsigned next = 0;
+        for (auto _ : state) {
+            std::list<std::tuple<Resource, Response>> batch;
+            for (unsigned i = 0; i < tilesPerIteration; ++i, ++next) {
+                Resource tile = Resource::tile(
+                    "mapbox://storm" + util::toString(next), 1, 0, 0, 0, Tileset::Scheme::XYZ);
+                if (batchSize == 1) {
+                    db.put(tile, response);
+                    continue;
+                }
+                batch.emplace_back(std::move(tile), response);
+                if (batch.size() == batchSize) {
+                    db.putAmbientResources(batch);
+                    batch.clear();
+                }
+            }
+            db.putAmbientResources(batch);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tilesPerIteration));
+    }
+    Log::removeObserver();
+    util::deleteFile(path);
+}
+
+BENCHMARK(OfflineDatabase_AmbientInsertStorm)
+    ->ArgName("batch")
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_observer.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <random>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// A fleet of vehicles, of which a small share moves with every update
+constexpr std::size_t featureCount = 40000;
+constexpr std::size_t movedCount = featureCount / 100;
+
+GeoJSONFeature vehicle(uint64_t id, std::mt19937& random) {
+    std::uniform_real_distribution<double> lng(-10.0, 10.0);
+    std::uniform_real_distribution<double> lat(40.0, 55.0);
+    GeoJSONFeature feature{mapbox::geometry::point<double>(lng(random), lat(random))};
+    feature.id = id;
+    feature.properties["speed"] = uint64_t(id % 120);
+    return feature;
+}
+
+Immutable<GeoJSONOptions> updatable() {
+    auto options = makeMutable<GeoJSONOptions>();
+    options->updatable = true;
+    return options;
+}
+
+GeoJSONData::Features fleet(std::mt19937& random) {
+    GeoJSONData::Features features;
+    features.reserve(featureCount);
+    for (uint64_t id = 0; id < featureCount; ++id) {
+        features.push_back(vehicle(id, random));
+    }
+    return features;
+}
+
+} // namespace
+
+// Sets the whole collection again after moving 1% of the features.
+static void GeoJSONSource_FullReplace(benchmark::State& state) {
+    std::mt19937 random(42);
+    auto features = fleet(random);
+    GeoJSONSource source("vehicles");
+    source.setGeoJSON(GeoJSON{features});
+
+    std::uniform_int_distribution<uint64_t> pick(0, featureCount - 1);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < movedCount; ++i) {
+            const auto id = pick(random);
+            features[id] = vehicle(id, random);
+        }
+        source.setGeoJSON(GeoJSON{features});
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * movedCount));
+}
+
+// Moves the same share of features through an update by feature ID.
+static void GeoJSONSource_FeatureDelta(benchmark::State& state) {
+    std::mt19937 random(42);
+    GeoJSONSource source("vehicles", updatable());
+    source.setGeoJSON(GeoJSON{fleet(random)});
+
+    std::uniform_int_distribution<uint64_t> pick(0, featureCount - 1);
+    std::size_t regions = 0;
+    for (auto _ : state) {
+        const auto previous = source.impl().getData().lock();
+        GeoJSONSourceDiff diff;
+        diff.add.reserve(movedCount);
+        for (std::size_t i = 0; i < movedCount; ++i) {
+            diff.add.push_back(vehicle(pick(random), random));
+        }
+        source.updateGeoJSON(diff);
+        regions = source.impl().getChangedRegions(*previous)->size();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * movedCount));
+    state.counters["changed_regions"] = static_cast<double>(regions);
+}
+
+// Renders the fleet over a map after each move of 1% of the features, which sets the whole collection again when
+// `state.range(0)` is 0, and goes through an update by feature ID otherwise. Each frame waits for the reloaded tiles,
+// so the time includes the tiles parsed again on the workers, which the update by ID limits to the touched ones.
+static void GeoJSONSource_Render(benchmark::State& state) {
+    util::RunLoop loop;
+    const Size size{1000, 1000};
+    HeadlessFrontend frontend{size, 1.0f};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(1.0f),
+            ResourceOptions().withCachePath(":memory:")};
+    map.getStyle().loadJSON(R"({"version": 8, "sources": {}, "layers": []})");
+    map.jumpTo(CameraOptions().withCenter(LatLng{47.5, 0.0}).withZoom(6.0));
+
+    std::mt19937 random(42);
+    auto features = fleet(random);
+    auto source = std::make_unique<GeoJSONSource>("vehicles", updatable());
+    source->setGeoJSON(GeoJSON{features});
+    auto* vehicles = source.get();
+    map.getStyle().addSource(std::move(source));
+    map.getStyle().addLayer(std::make_unique<CircleLayer>("vehicles", "vehicles"));
+    frontend.render(map);
+
+    const bool delta = state.range(0) != 0;
+    std::uniform_int_distribution<uint64_t> pick(0, featureCount - 1);
+    for (auto _ : state) {
+        GeoJSONSourceDiff diff;
+        for (std::size_t i = 0; i < movedCount; ++i) {
+            const auto id = pick(random);
+            features[id] = vehicle(id, random);
+            diff.add.push_back(features[id]);
+        }
+        if (delta) {
+            vehicles->updateGeoJSON(diff);
+        } else {
+            vehicles->setGeoJSON(GeoJSON{features});
+        }
+        frontend.render(map);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * movedCount));
+}
+
+BENCHMARK(GeoJSONSource_FullReplace)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSONSource_FeatureDelta)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSONSource_Render)->ArgName("delta")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/grid_index.hpp>
+
+#include <functional>
+#include <optional>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// A viewport with the collision index padding, and its cell size
+constexpr float gridSize = 1200;
+constexpr uint32_t cellSize = 25;
+
+using Grid = GridIndex<uint32_t>;
+
+} // namespace
+
+// What placement does with every label: a hit test, and an insert when there is room.
+// Three quarters of the labels are line labels, made of circles.
+static void GridIndex_PlaceLabels(benchmark::State& state) {
+    const auto labels = static_cast<uint32_t>(state.range(0));
+    const std::optional<std::function<bool(const uint32_t&)>> predicate{[](const uint32_t& i) { return i % 8 != 0; }};
+    std::size_t placed = 0;
+
+    for (auto _ : state) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(0, gridSize);
+        std::uniform_real_distribution<float> extent(5, 60);
+
+        Grid grid(gridSize, gridSize, cellSize);
+        placed = 0;
+        for (uint32_t i = 0; i < labels; ++i) {
+            const float x = position(random);
+            const float y = position(random);
+            if (i % 4) {
+                const Grid::BCircle circle{{x, y}, extent(random) / 4};
+                if (!grid.hitTest(circle, predicate)) {
+                    grid.insert(uint32_t(i), circle);
+                    ++placed;
+                }
+            } else {
+                const Grid::BBox box{{x, y}, {x + extent(random) * 2, y + extent(random) / 2}};
+                if (!grid.hitTest(box, predicate)) {
+                    grid.insert(uint32_t(i), box);
+                    ++placed;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(grid);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * labels));
+    state.counters["placed"] = static_cast<double>(placed);
+}
+
+// Feature queries over a densely filled grid, as done by queryRenderedFeatures()
+static void GridIndex_Query(benchmark::State& state) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0, gridSize);
+    std::uniform_real_distribution<float> extent(5, 60);
+
+    Grid grid(gridSize, gridSize, cellSize);
+    for (uint32_t i = 0; i < 20000; ++i) {
+        const float x = position(random);
+        const float y = position(random);
+        grid.insert(uint32_t(i), Grid::BBox{{x, y}, {x + extent(random), y + extent(random)}});
+    }
+
+    std::size_t results = 0;
+    for (auto _ : state) {
+        const float x = position(random);
+        const float y = position(random);
+        results += grid.query({{x, y}, {x + 50, y + 50}}).size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    benchmark::DoNotOptimize(results);
+}
+
+BENCHMARK(GridIndex_PlaceLabels)->ArgName("labels")->Arg(2000)->Arg(20000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(GridIndex_Query)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <mbgl/util/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t tasksPerProducer = 20000;
+constexpr std::size_t tagsPerProducer = 8;
+
+using Clock = std::chrono::steady_clock;
+
+// A few hundred nanoseconds of work, roughly the size of a small tile parse step
+void spin(std::size_t seed) {
+    std::size_t value = seed;
+    for (int i = 0; i < 64; ++i) {
+        value = value * 2862933555777941757ULL + 3037000493ULL;
+    }
+    benchmark::DoNotOptimize(value);
+}
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    const auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+} // namespace
+
+// Several producer threads flood the pool with short tasks spread over a handful of tags each,
+// then wait for their tags to drain. Reports task throughput and queueing latency percentiles.
+static void ThreadPool_TaggedFlood(benchmark::State& state) {
+    const auto mode = static_cast<SchedulingMode>(state.range(0));
+    const auto producerCount = static_cast<std::size_t>(state.range(1));
+    const auto workerCount = std::max(2u, std::thread::hardware_concurrency());
+
+    ThreadedScheduler pool(workerCount, mode);
+    Scheduler& scheduler = pool;
+
+    std::vector<double> latencies(producerCount * tasksPerProducer);
+    std::vector<double> allLatencies;
+
+    for (auto _ : state) {
+        std::vector<std::thread> producers;
+        producers.reserve(producerCount);
+        for (std::size_t p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&, p] {
+                std::vector<util::SimpleIdentity> tags(tagsPerProducer);
+                for (std::size_t i = 0; i < tasksPerProducer; ++i) {
+                    const auto slot = p * tasksPerProducer + i;
+                    scheduler.schedule(tags[i % tagsPerProducer], [&latencies, slot, queued = Clock::now()] {
+                        latencies[slot] = std::chrono::duration<double, std::micro>(Clock::now() - queued).count();
+                        spin(slot);
+                    });
+                }
+                for (const auto& tag : tags) {
+                    scheduler.waitForEmpty(tag);
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        allLatencies.insert(allLatencies.end(), latencies.begin(), latencies.end());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * producerCount * tasksPerProducer));
+    state.counters["p50_us"] = percentile(allLatencies, 0.50);
+    state.counters["p99_us"] = percentile(allLatencies, 0.99);
+    state.counters["p999_us"] = percentile(allLatencies, 0.999);
+}
+
+// One producer floods the pool with short tasks of one tag, every 16th of them at high priority and every 64th at
+// low priority. Reports the queueing latency of each lane: high priority tasks skip the backlog, and low priority
+// ones still get a share of the turns.
+static void ThreadPool_PriorityLanes(benchmark::State& state) {
+    const auto mode = static_cast<SchedulingMode>(state.range(0));
+    ThreadedScheduler pool(std::max(2u, std::thread::hardware_concurrency()), mode);
+    Scheduler& scheduler = pool;
+    const util::SimpleIdentity tag;
+
+    const auto priorityOf = [](std::size_t i) {
+        if (i % 64 == 0) return TaskPriority::Low;
+        if (i % 16 == 0) return TaskPriority::High;
+        return TaskPriority::Normal;
+    };
+
+    std::vector<double> latencies(tasksPerProducer);
+    std::array<std::vector<double>, 3> laneLatencies;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < tasksPerProducer; ++i) {
+            scheduler.scheduleWithPriority(tag, priorityOf(i), [&latencies, i, queued = Clock::now()] {
+                latencies[i] = std::chrono::duration<double, std::micro>(Clock::now() - queued).count();
+                spin(i);
+            });
+        }
+        scheduler.waitForEmpty(tag);
+        for (std::size_t i = 0; i < tasksPerProducer; ++i) {
+            laneLatencies[static_cast<std::size_t>(priorityOf(i))].push_back(latencies[i]);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasksPerProducer));
+    state.counters["high_p99_us"] = percentile(laneLatencies[0], 0.99);
+    state.counters["normal_p99_us"] = percentile(laneLatencies[1], 0.99);
+    state.counters["low_p99_us"] = percentile(laneLatencies[2], 0.99);
+}
+
+BENCHMARK(ThreadPool_TaggedFlood)
+    ->ArgNames({"mode", "producers"})
+    ->ArgsProduct({{static_cast<int64_t>(SchedulingMode::SharedQueue),
+                    static_cast<int64_t>(SchedulingMode::WorkStealing)},
+                   {1, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(ThreadPool_PriorityLanes)
+    ->ArgName("mode")
+    ->Arg(static_cast<int64_t>(SchedulingMode::SharedQueue))
+    ->Arg(static_cast<int64_t>(SchedulingMode::WorkStealing))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -77,6 +77,9 @@ public:
 
     ActorRef<std::decay_t<Object>> self() { return parent.self(); }
 
+    /// Set the scheduling priority of messages sent to this actor
+    void setPriority(TaskPriority priority) { parent.mailbox->setPriority(priority); }
+
 private:
     const std::shared_ptr<Scheduler> retainer;
     AspiringActor<Object> parent;
@@ -37,6 +37,9 @@ public:
 
     bool isOpen() const;
 
+    /// Set the priority used when scheduling this mailbox's pending messages
+    void setPriority(TaskPriority priority_) { priority = priority_; }
+
     void push(std::unique_ptr<Message>);
     void receive();
 
@@ -55,6 +58,7 @@ private:
     std::mutex pushingMutex;
 
     std::atomic<State> state{State::Idle};
+    std::atomic<TaskPriority> priority{TaskPriority::Normal};
     bool closed{false};
 
     std::mutex queueMutex;
@@ -4,6 +4,7 @@
 
 #include <mapbox/std/weak.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -12,6 +13,17 @@ namespace mbgl {
 
 class Mailbox;
 
+/// Relative urgency of a scheduled task. Schedulers that support it mostly start pending tasks of a higher
+/// priority before any task of a lower one, but keep a small share of their turns for the lower ones so that these
+/// aren't starved under sustained load. Other schedulers treat all tasks the same.
+enum class TaskPriority : uint8_t {
+    /// Work needed for what's currently on screen
+    High,
+    Normal,
+    /// Work that can wait, like releasing resources
+    Low,
+};
+
 /**
     A `Scheduler` is responsible for coordinating the processing of messages by
     one or more actors via their mailboxes. It's an abstract interface. Currently,
@@ -42,6 +54,16 @@ public:
     virtual void schedule(std::function<void()>&&) = 0;
     virtual void schedule(const util::SimpleIdentity, std::function<void()>&&) = 0;
 
+    /// Enqueues a function for execution with the given priority.
+    /// An empty tag assigns the task to the scheduler itself, as with the untagged `schedule`.
+    virtual void scheduleWithPriority(const util::SimpleIdentity tag, TaskPriority, std::function<void()>&& fn) {
+        if (tag.isEmpty()) {
+            schedule(std::move(fn));
+        } else {
+            schedule(tag, std::move(fn));
+        }
+    }
+
     /// Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
     /// Enqueues a function for execution on the render thread owned by the given tag.
@@ -137,6 +159,9 @@ public:
     const std::shared_ptr<Scheduler>& get() const noexcept { return scheduler; }
 
     void schedule(std::function<void()>&& fn) { scheduler->schedule(tag, std::move(fn)); }
+    void schedule(TaskPriority priority, std::function<void()>&& fn) {
+        scheduler->scheduleWithPriority(tag, priority, std::move(fn));
+    }
     void runOnRenderThread(std::function<void()>&& fn) { scheduler->runOnRenderThread(tag, std::move(fn)); }
     void runRenderJobs(bool closeQueue = false) { scheduler->runRenderJobs(tag, closeQueue); }
     void waitForEmpty() const noexcept { scheduler->waitForEmpty(tag); }
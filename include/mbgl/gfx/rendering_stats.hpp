@@ -16,6 +16,9 @@ struct RenderingStats {
     int numDrawCalls = 0;
     /// Total number of draw calls executed during all the frames
     int totalDrawCalls = 0;
+    /// Number of index ranges drawn during the most recent frame. A multi-draw call is a single draw call, but
+    /// counts each of its ranges here, as they would have been drawn one by one without it.
+    int numDrawRanges = 0;
 
     /// Total number of textures created
     int numCreatedTextures = 0;
@@ -59,6 +62,28 @@ struct RenderingStats {
     int memVertexBuffers = 0;
     int memUniformBuffers = 0;
 
+    /// Number of buffers shared by the vertex or index data of several drawables
+    int numArenaBuffers = 0;
+    /// Bytes of shared buffers in use, including ranges waiting for the GPU to finish with them
+    int memArenaUsed = 0;
+    /// Free bytes of shared buffers outside of the largest free range of each buffer
+    int memArenaFragmented = 0;
+
+    /// Bytes of the glyph and icon atlas textures, shared by all the tiles or belonging to a single tile
+    int memAtlases = 0;
+    /// Bytes uploaded to glyph and icon atlases, shared or belonging to a single tile
+    std::size_t atlasUploadBytes = 0;
+
+    /// Number of shader programs loaded from the on-disk shader cache instead of being compiled
+    int numProgramBinaryHits = 0;
+    /// Number of shader programs compiled because the on-disk shader cache had nothing usable for them
+    int numProgramBinaryMisses = 0;
+    /// Number of pipelines created, by backends that build a pipeline for each combination of shader and state
+    int numCreatedPipelines = 0;
+
+    /// Total time spent placing symbols during all the frames, in seconds
+    double placementTime = 0.0;
+
     int stencilClears = 0;
     int stencilUpdates = 0;
 
@@ -26,6 +26,7 @@ using UniqueVertexBufferResource = std::unique_ptr<VertexBufferResource>;
 
 namespace gl {
 
+class Context;
 class Texture2D;
 class VertexArray;
 
@@ -68,6 +69,10 @@ private:
 
     void uploadTextures() const;
 
+    void uploadSegments(gl::Context&);
+    void buildMultiDraw(gl::Context&);
+    void resetMultiDraw();
+
     void bindUniformBuffers() const;
     void unbindUniformBuffers() const;
 
@@ -15,6 +15,18 @@ DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_FILE, thread_priority_file
 DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_NETWORK, thread_priority_network);
 DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_DATABASE, thread_priority_database);
 
+// The value for EXPERIMENTAL_THREAD_POOL_SIZE must be an unsigned integer, the number of
+// threads in the shared background pool. Zero sizes the pool to the hardware concurrency.
+// Takes effect the next time the pool is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_POOL_SIZE, thread_pool_size);
+// The value for EXPERIMENTAL_THREAD_POOL_WORK_STEALING must be a boolean, see `SchedulingMode`.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_POOL_WORK_STEALING, thread_pool_work_stealing);
+
+// The value for EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH must be a string, an existing directory in which
+// the OpenGL and Vulkan renderers store compiled shader programs and pipelines, to load them on the next
+// start instead of compiling them again. Takes effect for contexts created afterwards.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH, program_binary_cache_path);
+
 /// Settings class provides non-persistent, in-process key-value storage.
 class Settings final {
 public:
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mbgl {
+
+/// Counters of the layout cache, see `Renderer::setLayoutCacheSize`
+struct LayoutCacheStats {
+    /// Number of tiles which took their layout from the cache instead of being parsed
+    std::size_t hits = 0;
+    /// Number of tiles which looked up the cache and had to be parsed
+    std::size_t misses = 0;
+    /// Number of layouts dropped to stay within the size limit
+    std::size_t evictions = 0;
+    /// Number of layouts currently held
+    std::size_t entries = 0;
+    /// Approximate size of the layouts currently held, in bytes
+    std::size_t bytes = 0;
+    /// The size limit, in bytes
+    std::size_t maxBytes = 0;
+};
+
+} // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/renderer/layout_cache_stats.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
 
@@ -110,6 +111,18 @@ public:
     // Memory
     void setTileCacheEnabled(bool);
     bool getTileCacheEnabled() const;
+
+    /**
+     * @brief Sets the size in bytes of the layout cache, which keeps the
+     * buckets and feature index of vector tiles dropped from the tile cache.
+     * Tiles created again for the same data, layers and images reuse them
+     * instead of parsing and laying out the data once more.
+     *
+     * The layout cache is disabled by default, and setting the size to zero
+     * disables it again.
+     */
+    void setLayoutCacheSize(std::size_t bytes);
+    LayoutCacheStats getLayoutCacheStats() const;
     void reduceMemoryUse();
     void clearData();
 
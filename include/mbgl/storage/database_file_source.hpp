@@ -72,6 +72,10 @@ public:
      * This call is asynchronous: the data may not be immediately available
      * for in-progress requests, although subsequent requests should have
      * access to the cached data.
+     *
+     * Writes are queued and committed to the database in batches, bounded by
+     * count, size and a short delay. Requests are served from the queue until
+     * the batch is written.
      */
     virtual void put(const Resource&, const Response&);
 
@@ -111,6 +111,12 @@ constexpr const char* API_BASE_URL_KEY = "api-base-url";
 /// type: unsigned
 constexpr const char* MAX_CONCURRENT_REQUESTS_KEY = "max-concurrent-requests";
 
+/// Property name to set / get maximum number of concurrent requests of offline downloads.
+/// When non-zero, offline downloads have a budget of their own instead of sharing the one
+/// of `max-concurrent-requests`, so they neither starve nor are starved by map requests.
+/// type: unsigned
+constexpr const char* MAX_CONCURRENT_OFFLINE_REQUESTS_KEY = "max-concurrent-offline-requests";
+
 // Properties that may be supported by database file sources:
 
 /// Property to set database mode. When set, database opens in read-only mode;
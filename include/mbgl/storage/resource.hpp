@@ -5,6 +5,8 @@
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <optional>
 
@@ -68,6 +70,12 @@ public:
     void setPriority(Priority p) { priority = p; }
     void setUsage(Usage u) { usage = u; }
 
+    /// Orders requests of the same priority which wait for a connection, lower values first.
+    /// All copies of a resource made after the first call share the value, so a request can be
+    /// reordered in place while it is pending. Tiles use their distance to the viewport center.
+    void setLoadOrder(float order);
+    float getLoadOrder() const;
+
     bool hasLoadingMethod(LoadingMethod method) const;
 
     static Resource style(const std::string& url);
@@ -101,10 +109,25 @@ public:
     std::shared_ptr<const std::string> priorData;
     Duration minimumUpdateInterval{Duration::zero()};
     StoragePolicy storagePolicy{StoragePolicy::Permanent};
+
+private:
+    std::shared_ptr<std::atomic<float>> loadOrder;
 };
 
 inline bool Resource::hasLoadingMethod(Resource::LoadingMethod method) const {
     return (loadingMethod & method);
 }
 
+inline void Resource::setLoadOrder(float order) {
+    if (loadOrder) {
+        loadOrder->store(order, std::memory_order_relaxed);
+    } else {
+        loadOrder = std::make_shared<std::atomic<float>>(order);
+    }
+}
+
+inline float Resource::getLoadOrder() const {
+    return loadOrder ? loadOrder->load(std::memory_order_relaxed) : 0.0f;
+}
+
 } // namespace mbgl
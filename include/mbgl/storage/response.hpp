@@ -16,6 +16,20 @@ public:
 
 public:
     class Error;
+
+    // Time spent in each phase of a network request. Phases that didn't happen,
+    // e.g. the TLS handshake on a reused connection, are zero.
+    struct Timing {
+        Duration dns{0};
+        Duration connect{0};
+        Duration tls{0};
+        // From sending the request to the first byte of the response
+        Duration firstByte{0};
+        // From the first to the last byte of the response
+        Duration transfer{0};
+        Duration total{0};
+    };
+
     // When this object is empty, the response was successful.
     std::unique_ptr<const Error> error;
 
@@ -37,6 +51,9 @@ public:
     std::optional<Timestamp> expires;
     std::optional<std::string> etag;
 
+    // Only set by file sources that can measure it.
+    std::optional<Timing> timing;
+
     bool isFresh() const { return expires ? *expires > util::now() : !error; }
 
     // Indicates whether we are allowed to use this response according to HTTP
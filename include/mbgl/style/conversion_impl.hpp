@@ -17,6 +17,7 @@
 #include <chrono>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <optional>
 
 namespace mbgl {
@@ -97,6 +98,12 @@ namespace style {
    Numbers should be converted to unsigned integer, signed integer, or floating
    point, in descending preference.
 
+   Optionally, it may provide:
+
+      * `identity(v)` -- returns a pointer identifying `v` when the same value
+   can be reached, and converted, more than once, as with the shared values of a
+   style snapshot; or `nullptr`. Without it, values have no identity.
+
    In addition, the type T must be move-constructable. And finally,
    `Convertible::Storage`, a typedef for `std::aligned_storage_t`, must be large
    enough to satisfy the memory requirements for any of the possible underlying
@@ -209,6 +216,11 @@ public:
         return v.vtable->toGeoJSON(v.storage, error);
     }
 
+    friend inline const void* identity(const Convertible& v) {
+        assert(v.vtable);
+        return v.vtable->identity(v.storage);
+    }
+
 private:
 #if __ANDROID__
     // Android:     JSValue* or mbgl::android::Value
@@ -245,8 +257,26 @@ private:
 
         // https://github.com/mapbox/mapbox-gl-native/issues/5623
         std::optional<GeoJSON> (*toGeoJSON)(const Storage&, Error&);
+
+        const void* (*identity)(const Storage&);
     };
 
+    template <typename T, typename = void>
+    struct HasIdentity : std::false_type {};
+
+    template <typename T>
+    struct HasIdentity<T, std::void_t<decltype(ConversionTraits<T>::identity(std::declval<const T&>()))>>
+        : std::true_type {};
+
+    template <typename T>
+    static const void* vtableIdentity([[maybe_unused]] const Storage& s) {
+        if constexpr (HasIdentity<T>::value) {
+            return ConversionTraits<T>::identity(reinterpret_cast<const T&>(s));
+        } else {
+            return nullptr;
+        }
+    }
+
     // Extracted this function from the table below to work around a GCC bug
     // with differing visibility settings for capturing lambdas:
     // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=80947
@@ -287,7 +317,8 @@ private:
             [](const Storage& s) { return Traits::toValue(reinterpret_cast<const T&>(s)); },
             [](const Storage& s, Error& err) {
                 return Traits::toGeoJSON(reinterpret_cast<const T&>(s), err);
-            }};
+            },
+            vtableIdentity<T>};
         return &vtable;
     }
 
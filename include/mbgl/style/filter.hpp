@@ -5,32 +5,48 @@
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/style/expression/expression.hpp>
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <tuple>
 #include <optional>
 
 namespace mbgl {
+
+class GeometryTileLayer;
+
 namespace style {
 
+class FilterProgram;
+
+/// Property keys of a compiled filter resolved against the key table of one source layer, see `Filter::bind`
+using FilterKeyBinding = std::vector<std::optional<std::uint32_t>>;
+
 class Filter {
 public:
     std::optional<std::shared_ptr<const expression::Expression>> expression;
 
 private:
     std::optional<mbgl::Value> legacyFilter;
+    // Pre-compiled form of `expression`, used to evaluate it on features when available
+    std::shared_ptr<const FilterProgram> program;
 
 public:
     Filter() = default;
 
-    Filter(expression::ParseResult _expression, std::optional<mbgl::Value> _filter = std::nullopt)
-        : expression(std::move(*_expression)),
-          legacyFilter(std::move(_filter)) {
-        assert(!expression || *expression != nullptr);
-    }
+    Filter(expression::ParseResult _expression, std::optional<mbgl::Value> _filter = std::nullopt);
 
     bool operator()(const expression::EvaluationContext& context) const;
 
+    /// Evaluate the filter for a feature visited on the layer `binding` was made for, looking up
+    /// properties by the layer's key indices.
+    bool operator()(const expression::EvaluationContext& context, const FilterKeyBinding& binding) const;
+
+    /// Resolve the property keys of the filter against the key table of `layer`. Returns nothing if the
+    /// filter isn't compiled or the layer has no key table, in which case the binding isn't needed.
+    std::optional<FilterKeyBinding> bind(const GeometryTileLayer& layer) const;
+
     operator bool() const { return expression || legacyFilter; }
 
     friend bool operator==(const Filter& lhs, const Filter& rhs) {
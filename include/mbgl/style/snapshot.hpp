@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace mbgl {
+namespace style {
+namespace snapshot {
+
+/// A style snapshot is a binary form of a style document that is loaded without parsing JSON.
+///
+/// Strings are stored once, identical values (e.g. a `match` expression shared by several layers) are stored
+/// once, and values are read in place. Snapshots are loaded with `Style::loadSnapshot`, style URLs and offline
+/// downloads only accept JSON. Snapshots are made by the same version of the library that loads them, they are
+/// rejected otherwise, as are those expanding to a document far larger or deeper than real styles.
+
+/// Whether the data is a snapshot rather than style JSON
+bool isSnapshot(const std::string& data);
+
+/// Throws `std::runtime_error` if the JSON can't be parsed
+std::string encode(const std::string& json);
+
+/// Returns the style JSON of a snapshot. Throws `std::runtime_error` if the snapshot is invalid.
+std::string decode(const std::string& snapshot);
+
+} // namespace snapshot
+} // namespace style
+} // namespace mbgl
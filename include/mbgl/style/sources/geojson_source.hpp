@@ -4,11 +4,13 @@
 #include <mbgl/style/source.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -34,8 +36,23 @@ struct GeoJSONOptions {
     using ClusterProperties = std::map<std::string, ClusterExpression>;
     ClusterProperties clusterProperties;
 
+    // Keep the features of data set as a feature collection, so that they can be updated by ID with
+    // `GeoJSONSource::updateGeoJSON`. They are kept in memory besides the tiled index.
+    bool updatable = false;
+
     static Immutable<GeoJSONOptions> defaultOptions();
 };
+
+// Changes to the features of a GeoJSON source, matched by feature ID. They are
+// applied in order: removeAll, remove, then add.
+struct GeoJSONSourceDiff {
+    bool removeAll = false;
+    std::vector<FeatureIdentifier> remove;
+    // Features to add. A feature with the ID of an existing feature replaces it,
+    // keeping its position in the collection.
+    std::vector<GeoJSONFeature> add;
+};
+
 class GeoJSONData {
 public:
     using TileFeatures = mapbox::feature::feature_collection<int16_t>;
@@ -60,8 +77,16 @@ public:
 
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
+    // Moves the features into the source rather than copying them when it keeps them
+    void setGeoJSON(GeoJSON&&);
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
 
+    // Adds, replaces and removes features by ID, and reloads only the tiles
+    // that the changed features touch. Requires an updatable source, see
+    // `GeoJSONOptions`, with data set as a feature collection in which every
+    // feature has an ID; throws otherwise.
+    void updateGeoJSON(const GeoJSONSourceDiff&);
+
     std::optional<std::string> getURL() const;
     const GeoJSONOptions& getOptions() const;
 
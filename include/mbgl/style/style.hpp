@@ -7,6 +7,7 @@
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -26,8 +27,23 @@ public:
     Style(std::shared_ptr<FileSource>, float pixelRatio, const TaggedScheduler& threadPool_);
     ~Style();
 
-    void loadJSON(const std::string&);
-    void loadURL(const std::string&);
+    /// How a new style is applied to the current one
+    enum class LoadMode : uint8_t {
+        /// The current style is dropped, and the tiles of all the sources are reloaded
+        Replace,
+        /// Only what differs from the current style is replaced, e.g. for switching between the day and night
+        /// themes of a map. Layers with a new paint are updated in place, with a transition, and tiles are laid out
+        /// again only for the sources of layers with a new layout. Sources with an unchanged definition keep their
+        /// tiles, and images are kept if the style uses the same sprites. Sources changed through `getSource` are
+        /// reloaded.
+        Diff,
+    };
+
+    void loadJSON(const std::string&, LoadMode = LoadMode::Replace);
+    void loadURL(const std::string&, LoadMode = LoadMode::Replace);
+    /// Loads a snapshot made by `snapshot::encode`. Snapshots are only accepted from the application, not from
+    /// style URLs.
+    void loadSnapshot(const std::string&, LoadMode = LoadMode::Replace);
 
     std::string getJSON() const;
     std::string getURL() const;
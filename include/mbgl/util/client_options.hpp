@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -52,6 +54,79 @@ public:
      */
     const std::string& version() const;
 
+    /**
+     * @brief Sets whether HTTP requests may be multiplexed over a shared
+     * HTTP/2 connection when the server supports it. Enabled by default.
+     *
+     * Only honored by the curl-based HTTP file source, and only when libcurl is built with HTTP/2 support.
+     *
+     * @param enabled Whether HTTP/2 multiplexing is allowed.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withHTTP2Multiplexing(bool enabled);
+
+    /**
+     * @brief Gets whether HTTP/2 multiplexing is allowed.
+     *
+     * @return true if requests may share an HTTP/2 connection.
+     */
+    bool http2Multiplexing() const;
+
+    /**
+     * @brief Sets the maximum number of simultaneous connections to a single
+     * host. Requests over the limit wait for a free connection. Defaults to 0,
+     * which means no limit.
+     *
+     * Only honored by the curl-based HTTP file source.
+     *
+     * @param count Maximum number of connections per host, or 0 for no limit.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withMaxConnectionsPerHost(uint32_t count);
+
+    /**
+     * @brief Gets the maximum number of simultaneous connections per host.
+     *
+     * @return maximum connections per host, 0 meaning no limit
+     */
+    uint32_t maxConnectionsPerHost() const;
+
+    /**
+     * @brief Sets how long resolved host names are cached. Defaults to 60 seconds.
+     *
+     * Only honored by the curl-based HTTP file source.
+     *
+     * @param timeout Time to live of DNS cache entries.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withDNSCacheTimeout(std::chrono::seconds timeout);
+
+    /**
+     * @brief Gets how long resolved host names are cached.
+     *
+     * @return time to live of DNS cache entries
+     */
+    std::chrono::seconds dnsCacheTimeout() const;
+
+    /**
+     * @brief Sets the idle time after which TCP keep-alive probes are sent on
+     * open connections, so that idle connections stay usable for later requests.
+     * Defaults to 0, which disables keep-alive probes.
+     *
+     * Only honored by the curl-based HTTP file source.
+     *
+     * @param interval Keep-alive idle time and probe interval, or 0 to disable.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withKeepAliveInterval(std::chrono::seconds interval);
+
+    /**
+     * @brief Gets the TCP keep-alive interval.
+     *
+     * @return keep-alive interval, 0 meaning disabled
+     */
+    std::chrono::seconds keepAliveInterval() const;
+
 private:
     ClientOptions(const ClientOptions&);
 
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace mbgl {
 namespace util {
@@ -14,7 +15,7 @@ enum CompressionFormat {
 };
 
 std::string compress(const std::string& raw, int windowBits = CompressionFormat::ZLIB);
-std::string decompress(const std::string& raw, int windowBits = CompressionFormat::DETECT);
+std::string decompress(std::string_view raw, int windowBits = CompressionFormat::DETECT);
 
 std::uint32_t crc32(const void* raw, size_t size) noexcept;
 
@@ -46,6 +46,10 @@ constexpr uint8_t DEFAULT_PREFETCH_ZOOM_DELTA = 4;
 
 constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
 
+// Upper bound of the memory mapped region of read-only databases. SQLite clamps this to its
+// compile time SQLITE_MAX_MMAP_SIZE, and falls back to regular reads where mmap is unavailable.
+constexpr uint64_t DEFAULT_READ_ONLY_MMAP_SIZE = uint64_t(1) << 30;
+
 // Default ImageManager's cache size for images added via onStyleImageMissing API.
 // Average sprite size with 1.0 pixel ratio is ~2kB, 8kB for pixel ratio of 2.0.
 constexpr std::size_t DEFAULT_ON_DEMAND_IMAGES_CACHE_SIZE = 100 * 8192;
@@ -2,7 +2,9 @@
 
 #include <mbgl/util/ignore.hpp>
 
+#include <cstdint>
 #include <functional>
+#include <string_view>
 #include <type_traits>
 
 namespace mbgl {
@@ -33,6 +35,28 @@ constexpr T factor() noexcept {
     return 16777619;
 }
 
+/// 64-bit FNV-1a hash of a sequence of strings.
+/// Unlike `std::hash`, the result doesn't change between runs, so it can identify data stored on disk.
+class FNV1a {
+public:
+    void add(std::string_view data) noexcept {
+        for (const char c : data) {
+            value = (value ^ static_cast<unsigned char>(c)) * factor<std::uint64_t>();
+        }
+    }
+
+    /// Add a string followed by a separator, so that moving text from one string to the next changes the hash
+    void addTerminated(std::string_view data) noexcept {
+        add(data);
+        add(std::string_view("\0", 1));
+    }
+
+    std::uint64_t get() const noexcept { return value; }
+
+private:
+    std::uint64_t value = 14695981039346656037ull;
+};
+
 /// Generate a hash key from a collection of integer values which doesn't depend on their order.
 /// Adapted from https://stackoverflow.com/a/76993810/135138
 template <typename TIter, typename TKey = detail::TIterVal<TIter>, TKey factor = factor<TKey>()>
@@ -12,6 +12,7 @@
 #include <mbgl/vulkan/uniform_buffer.hpp>
 #include <mbgl/vulkan/renderer_backend.hpp>
 #include <mbgl/vulkan/pipeline.hpp>
+#include <mbgl/vulkan/pipeline_cache.hpp>
 #include <mbgl/vulkan/descriptor_set.hpp>
 
 #include <memory>
@@ -71,7 +72,8 @@ public:
 
     /// Called at the end of a frame.
     void performCleanup() override {}
-    void reduceMemoryUsage() override {}
+    /// Also called before the app goes to the background, where it may be stopped without notice
+    void reduceMemoryUsage() override;
 
     gfx::UniqueDrawableBuilder createDrawableBuilder(std::string name) override;
     gfx::UniformBufferPtr createUniformBuffer(const void* data, std::size_t size, bool persistent) override;
@@ -141,6 +143,7 @@ public:
     DescriptorPoolGrowable& getDescriptorPool(DescriptorSetType type);
     const vk::UniquePipelineLayout& getGeneralPipelineLayout();
     const vk::UniquePipelineLayout& getPushConstantPipelineLayout();
+    const PipelineCache& getPipelineCache() const { return *pipelineCache; }
 
     uint8_t getCurrentFrameResourceIndex() const { return frameResourceIndex; }
     void enqueueDeletion(std::function<void(Context&)>&& function);
@@ -193,6 +196,7 @@ private:
     vk::UniqueDescriptorSetLayout drawableImageDescriptorSetLayout;
     vk::UniquePipelineLayout generalPipelineLayout;
     vk::UniquePipelineLayout pushConstantPipelineLayout;
+    std::unique_ptr<PipelineCache> pipelineCache;
 
     uint8_t frameResourceIndex = 0;
     std::vector<FrameResources> frameResources;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mbgl/vulkan/renderer_backend.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mbgl {
+namespace vulkan {
+
+/// The pipeline cache used to create every pipeline, and the SPIR-V of the shaders compiled at runtime.
+///
+/// Both are saved in the directory set with `platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH`, if any, so
+/// that the next run neither compiles the shaders nor waits for the driver to build the pipelines it has
+/// already seen. Pipeline cache data is only loaded if it was made by the same device and driver.
+class PipelineCache : private util::noncopyable {
+public:
+    PipelineCache(const RendererBackend&);
+
+    /// Saves the pipeline cache
+    ~PipelineCache();
+
+    const vk::PipelineCache& get() const { return cache.get(); }
+
+    /// Whether a directory is set to save the cache across runs
+    bool isPersistent() const { return !directory.empty(); }
+
+    /// Write the pipelines created so far to disk
+    void save() const;
+
+    /// Identify the SPIR-V compiled from a shader stage
+    std::uint64_t makeShaderKey(std::string_view stage, std::string_view preamble, std::string_view source) const;
+
+    /// Returns an empty vector if there's no valid SPIR-V for the key
+    std::vector<uint32_t> loadShader(std::uint64_t key) const;
+    void storeShader(std::uint64_t key, const std::vector<uint32_t>& spirv) const;
+
+private:
+    std::string getPipelineCachePath() const;
+    std::string getShaderPath(std::uint64_t key) const;
+
+    const RendererBackend& backend;
+    std::string directory;
+    vk::UniquePipelineCache cache;
+};
+
+} // namespace vulkan
+} // namespace mbgl
@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -37,6 +38,15 @@ struct MapboxTileLimitExceededException : util::Exception {
         : util::Exception("Mapbox tile limit exceeded") {}
 };
 
+// Download progress of the tiles of one source of a region, for resuming an interrupted download
+struct OfflineTileCheckpoint {
+    // Number of tiles, in enumeration order, that are stored in the region or missing on the server
+    uint64_t position = 0;
+    // Count and stored size of those tiles that are stored in the region
+    uint64_t tileCount = 0;
+    uint64_t tileSize = 0;
+};
+
 class OfflineDatabase {
 public:
     OfflineDatabase(std::string path, const TileServerOptions& options);
@@ -50,6 +60,13 @@ public:
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
+    // Writes a batch of ambient cache resources in a single transaction,
+    // running the eviction check once for the whole batch instead of once
+    // per resource. If the batch can't be written as a whole, e.g. when it
+    // doesn't fit in the cache, the resources are written one by one.
+    // Return value is the number of inserted resources.
+    uint64_t putAmbientResources(const std::list<std::tuple<Resource, Response>>&);
+
     // Force Mapbox GL Native to revalidate tiles stored in the ambient
     // cache with the tile server before using them, making sure they
     // are the latest version. This is more efficient than cleaning the
@@ -80,7 +97,17 @@ public:
     std::optional<std::pair<Response, uint64_t>> getRegionResource(const Resource&);
     std::optional<int64_t> hasRegionResource(const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
-    void putRegionResources(int64_t regionID, const std::list<std::tuple<Resource, Response>>&, OfflineRegionStatus&);
+    // Writes a batch of region resources in a single transaction. Return value is the stored
+    // size of each resource, in order, or empty if the batch could not be written.
+    std::vector<uint64_t> putRegionResources(int64_t regionID,
+                                             const std::list<std::tuple<Resource, Response>>&,
+                                             OfflineRegionStatus&);
+
+    // Tile download checkpoints of a region, keyed by tile source. They are kept in a table of
+    // their own, created when the database is opened, and are removed along with the region.
+    std::optional<OfflineTileCheckpoint> getRegionTileCheckpoint(int64_t regionID, const std::string& source);
+    void putRegionTileCheckpoint(int64_t regionID, const std::string& source, const OfflineTileCheckpoint&);
+    void deleteRegionTileCheckpoints(int64_t regionID);
 
     expected<OfflineRegionDefinition, std::exception_ptr> getRegionDefinition(int64_t regionID);
     expected<OfflineRegionStatus, std::exception_ptr> getRegionCompletedStatus(int64_t regionID);
@@ -112,6 +139,7 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void createTileCheckpointTable();
     void cleanup();
     bool disabled();
     void vacuum();
@@ -132,6 +160,12 @@ private:
     std::optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     std::optional<int64_t> hasInternal(const Resource&);
     std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
+    // Number of inserted resources, nothing if the batch wasn't written
+    std::optional<uint64_t> putAmbientBatch(const std::list<std::tuple<Resource, Response>>&);
+
+    // Returns the compressed data of the response, if it is smaller than the raw data
+    static std::optional<std::string> compressData(const Response&);
+    bool putData(const Resource&, const Response&, const std::optional<std::string>& compressedData);
 
     // Return value is true iff the resource was previously unused by any other regions.
     bool markUsed(int64_t regionID, const Resource&);
@@ -8,6 +8,8 @@
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <optional>
+#include <vector>
 
 namespace mbgl {
 
@@ -37,17 +39,29 @@ public:
     OfflineRegionStatus getStatus() const;
 
 private:
+    class TileQueue;
+
+    // Identifies a tile within its queue, so that its completion advances the queue's checkpoint
+    struct TilePosition {
+        TileQueue* queue;
+        uint64_t index;
+    };
+
     void activateDownload();
     void continueDownload();
     void deactivateDownload();
     bool flushResourcesBuffer();
+    bool hasQueuedResources() const;
+    void saveTileCheckpoints();
 
     /*
      * Ensure that the resource is stored in the database, requesting it if necessary.
      * While the request is in progress, it is recorded in `requests`. If the download
      * is deactivated, all in progress requests are cancelled.
      */
-    void ensureResource(Resource&&, std::function<void(Response)> = {});
+    void ensureResource(Resource&&,
+                        std::function<void(Response)> = {},
+                        std::optional<TilePosition> = std::nullopt);
 
     void onMapboxTileCountLimitExceeded();
 
@@ -61,8 +75,11 @@ private:
     std::list<std::unique_ptr<AsyncRequest>> requests;
     std::set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
+    std::list<TileQueue> tileQueues;
     std::list<Resource> resourcesToBeMarkedAsUsed;
     std::list<std::tuple<Resource, Response>> buffer;
+    std::vector<std::optional<TilePosition>> bufferedTiles;
+    std::size_t bufferedBytes = 0;
 
     void queueResource(Resource&&);
     void queueTiles(style::SourceType, uint16_t tileSize, const Tileset&);
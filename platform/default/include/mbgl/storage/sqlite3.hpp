@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <chrono>
@@ -142,6 +143,8 @@ public:
     void bindBlob(int offset, const void*, std::size_t length, bool retain = true);
     void bindBlob(int offset, const std::vector<uint8_t>&, bool retain = true);
 
+    // `std::string_view` and `std::optional<std::string_view>` results reference the column
+    // data in place and are only valid until the next call to run() or reset().
     template <typename T>
     T get(int offset);
 
@@ -11,21 +11,42 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/timer.hpp>
 
+#include <list>
 #include <map>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
+
+namespace {
+
+// Ambient cache writes are held back and committed together once any of these is reached
+constexpr std::size_t maxPendingWriteCount = 256;
+constexpr std::size_t maxPendingWriteBytes = 4 * 1024 * 1024;
+constexpr Duration maxPendingWriteDelay = Milliseconds(500);
+
+} // namespace
+
 class DatabaseFileSourceThread {
 public:
     DatabaseFileSourceThread(std::shared_ptr<FileSource> onlineFileSource_, const std::string& cachePath)
         : db(std::make_unique<OfflineDatabase>(cachePath, onlineFileSource_->getResourceOptions().tileServerOptions())),
           onlineFileSource(std::move(onlineFileSource_)) {}
 
+    ~DatabaseFileSourceThread() { flushPendingWrites(); }
+
     void request(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
-        std::optional<Response> offlineResponse = (resource.storagePolicy != Resource::StoragePolicy::Volatile)
-                                                      ? db->get(resource)
-                                                      : std::nullopt;
+        std::optional<Response> offlineResponse;
+        if (resource.storagePolicy != Resource::StoragePolicy::Volatile) {
+            offlineResponse = getPendingWrite(resource);
+            if (!offlineResponse) {
+                offlineResponse = db->get(resource);
+            }
+        }
         if (!offlineResponse) {
             offlineResponse.emplace();
             offlineResponse->noContent = true;
@@ -39,36 +60,44 @@ public:
     }
 
     void setDatabasePath(const std::string& path, const std::function<void()>& callback) {
+        flushPendingWrites();
         db->changePath(path);
         if (callback) {
             callback();
         }
     }
 
+    // The callback runs once the batch containing the resource is committed
     void forward(const Resource& resource, const Response& response, const std::function<void()>& callback) {
-        db->put(resource, response);
-        if (callback) {
-            callback();
-        }
+        enqueueWrite(resource, response, callback);
     }
 
-    void resetDatabase(const std::function<void(std::exception_ptr)>& callback) { callback(db->resetDatabase()); }
+    void resetDatabase(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
+        callback(db->resetDatabase());
+    }
 
-    void packDatabase(const std::function<void(std::exception_ptr)>& callback) { callback(db->pack()); }
+    void packDatabase(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
+        callback(db->pack());
+    }
 
     void runPackDatabaseAutomatically(bool autopack) { db->runPackDatabaseAutomatically(autopack); }
 
-    void put(const Resource& resource, const Response& response) { db->put(resource, response); }
+    void put(const Resource& resource, const Response& response) { enqueueWrite(resource, response, {}); }
 
     void invalidateAmbientCache(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
         callback(db->invalidateAmbientCache());
     }
 
     void clearAmbientCache(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
         callback(db->clearAmbientCache());
     }
 
     void setMaximumAmbientCacheSize(uint64_t size, const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
         callback(db->setMaximumAmbientCacheSize(size));
     }
 
@@ -89,6 +118,7 @@ public:
 
     void mergeOfflineRegions(const std::string& sideDatabasePath,
                              const std::function<void(expected<OfflineRegions, std::exception_ptr>)>& callback) {
+        flushPendingWrites();
         callback(db->mergeDatabase(sideDatabasePath));
     }
 
@@ -123,6 +153,8 @@ public:
     }
 
     void setRegionDownloadState(int64_t regionID, OfflineRegionDownloadState state) {
+        // Downloads read the database directly, and should find resources already in the ambient cache
+        flushPendingWrites();
         if (auto download = getDownload(regionID)) {
             download.value()->setState(state);
         }
@@ -130,9 +162,65 @@ public:
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) { db->setOfflineMapboxTileCountLimit(limit); }
 
-    void reopenDatabaseReadOnly(bool readOnly) { db->reopenDatabaseReadOnly(readOnly); }
+    void reopenDatabaseReadOnly(bool readOnly) {
+        flushPendingWrites();
+        db->reopenDatabaseReadOnly(readOnly);
+    }
+
+    void flushPendingWrites() {
+        flushTimer.stop();
+        if (pendingWrites.empty() && pendingWriteCallbacks.empty()) {
+            return;
+        }
+
+        db->putAmbientResources(pendingWrites);
+
+        pendingWrites.clear();
+        pendingWriteIndex.clear();
+        pendingWriteBytes = 0;
+
+        for (const auto& callback : pendingWriteCallbacks) {
+            callback();
+        }
+        pendingWriteCallbacks.clear();
+    }
 
 private:
+    void enqueueWrite(const Resource& resource, const Response& response, const std::function<void()>& callback) {
+        const bool wasEmpty = pendingWrites.empty() && pendingWriteCallbacks.empty();
+
+        // Errors are never stored, so they don't need to wait for the batch
+        if (!response.error) {
+            pendingWrites.emplace_back(resource, response);
+            pendingWriteIndex[resource.url] = std::prev(pendingWrites.end());
+            pendingWriteBytes += response.data ? response.data->size() : 0;
+        }
+        if (callback) {
+            pendingWriteCallbacks.push_back(callback);
+        }
+
+        if (pendingWrites.size() >= maxPendingWriteCount || pendingWriteBytes >= maxPendingWriteBytes) {
+            flushPendingWrites();
+        } else if (wasEmpty) {
+            flushTimer.start(maxPendingWriteDelay, Duration::zero(), [this] { flushPendingWrites(); });
+        }
+    }
+
+    // Reads see writes that are still waiting for their batch
+    std::optional<Response> getPendingWrite(const Resource& resource) {
+        const auto it = pendingWriteIndex.find(resource.url);
+        if (it == pendingWriteIndex.end()) {
+            return std::nullopt;
+        }
+        const Response& response = std::get<1>(*it->second);
+        if (response.notModified) {
+            // Only refreshes the expiration of the stored resource, which needs to be read back
+            flushPendingWrites();
+            return std::nullopt;
+        }
+        return response;
+    }
+
     expected<OfflineDownload*, std::exception_ptr> getDownload(int64_t regionID) {
         if (!onlineFileSource) {
             return unexpected<std::exception_ptr>(
@@ -155,6 +243,14 @@ private:
     std::unique_ptr<OfflineDatabase> db;
     std::map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
     std::shared_ptr<FileSource> onlineFileSource;
+
+    using PendingWrites = std::list<std::tuple<Resource, Response>>;
+    PendingWrites pendingWrites;
+    // Most recent pending write of each URL
+    std::unordered_map<std::string, PendingWrites::const_iterator> pendingWriteIndex;
+    std::vector<std::function<void()>> pendingWriteCallbacks;
+    std::size_t pendingWriteBytes = 0;
+    util::Timer flushTimer;
 };
 
 class DatabaseFileSource::Impl {
@@ -333,6 +429,8 @@ void DatabaseFileSource::setProperty(const std::string& key, const mapbox::base:
 }
 
 void DatabaseFileSource::pause() {
+    // Don't keep writes in memory while the application may be suspended
+    impl->actor().invoke(&DatabaseFileSourceThread::flushPendingWrites);
     impl->pause();
 }
 
@@ -15,12 +15,14 @@
 #include <curl/curl.h>
 
 #include <dlfcn.h>
+#include <algorithm>
 #include <queue>
 #include <map>
 #include <cassert>
 #include <cstring>
 #include <cstdio>
 #include <optional>
+#include <utility>
 
 static void handleError(CURLMcode code) {
     if (code != CURLM_OK) {
@@ -36,6 +38,50 @@ static void handleError(CURLcode code) {
 
 namespace mbgl {
 
+namespace {
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // CURL_HTTP_VERSION_2TLS was added in 7.47.0
+// Without HTTP/2 support, libcurl refuses to set the HTTP version to HTTP/2, and requests stay on HTTP/1.1
+bool supportsHTTP2() {
+    static const bool supported = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
+    return supported;
+}
+#endif
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (61) << 8 | 0) // CURLINFO_*_TIME_T were added in 7.61.0
+// Time from the start of the transfer until the given phase completed
+Duration getElapsed(CURL *handle, CURLINFO info) {
+    curl_off_t microseconds = 0;
+    curl_easy_getinfo(handle, info, &microseconds);
+    return std::chrono::duration_cast<Duration>(std::chrono::microseconds(microseconds));
+}
+
+Response::Timing getTiming(CURL *handle) {
+    const Duration nameLookup = getElapsed(handle, CURLINFO_NAMELOOKUP_TIME_T);
+    const Duration connect = getElapsed(handle, CURLINFO_CONNECT_TIME_T);
+    const Duration appConnect = getElapsed(handle, CURLINFO_APPCONNECT_TIME_T);
+    const Duration preTransfer = getElapsed(handle, CURLINFO_PRETRANSFER_TIME_T);
+    const Duration startTransfer = getElapsed(handle, CURLINFO_STARTTRANSFER_TIME_T);
+    const Duration total = getElapsed(handle, CURLINFO_TOTAL_TIME_T);
+
+    // Phases that were skipped report zero, e.g. the TLS handshake of a plain HTTP request
+    const auto phase = [](Duration end, Duration begin) {
+        return std::max(end - begin, Duration::zero());
+    };
+
+    Response::Timing timing;
+    timing.dns = nameLookup;
+    timing.connect = phase(connect, nameLookup);
+    timing.tls = phase(appConnect, connect);
+    timing.firstByte = phase(startTransfer, preTransfer);
+    timing.transfer = phase(total, startTransfer);
+    timing.total = total;
+    return timing;
+}
+#endif
+
+} // namespace
+
 class HTTPFileSource::Impl {
 public:
     Impl(const ResourceOptions &resourceOptions_, const ClientOptions &clientOptions_);
@@ -49,6 +95,7 @@ public:
     CURL *getHandle();
     void returnHandle(CURL *handle);
     void checkMultiInfo();
+    void applyConnectionOptions(const ClientOptions &);
 
     // Used as the CURL timer function to periodically check for socket updates.
     util::Timer timeout;
@@ -71,6 +118,9 @@ public:
     ClientOptions getClientOptions();
 
 private:
+    // Connection options currently set on the multi handle
+    std::optional<std::pair<bool, uint32_t>> connectionOptions;
+
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
@@ -114,6 +164,12 @@ HTTPFileSource::Impl::Impl(const ResourceOptions &resourceOptions_, const Client
 
     share = curl_share_init();
 
+    // Share resolved host names and TLS sessions between all requests, so that new
+    // connections to a known host skip the lookup and resume the TLS session
+    // instead of doing a full handshake.
+    handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS));
+    handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION));
+
     multi = curl_multi_init();
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, handleSocket));
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this));
@@ -171,6 +227,22 @@ void HTTPFileSource::Impl::checkMultiInfo() {
     }
 }
 
+// Client options may change at any time, but the multi handle may only be
+// configured from this thread, so the options are applied with each request.
+void HTTPFileSource::Impl::applyConnectionOptions(const ClientOptions &options) {
+    const std::pair<bool, uint32_t> current{options.http2Multiplexing(), options.maxConnectionsPerHost()};
+    if (connectionOptions == current) {
+        return;
+    }
+    connectionOptions = current;
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // CURLPIPE_MULTIPLEX was added in 7.43.0
+    handleError(
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, current.first ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING));
+#endif
+    handleError(curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(current.second)));
+}
+
 void HTTPFileSource::Impl::perform(curl_socket_t s, util::RunLoop::Event events) {
     int flags = 0;
 
@@ -300,6 +372,25 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl *context_, Resource resource_, Fil
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapLibreNative/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
 
+    const ClientOptions clientOptions = context->getClientOptions();
+    context->applyConnectionOptions(clientOptions);
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // CURL_HTTP_VERSION_2TLS was added in 7.47.0
+    if (clientOptions.http2Multiplexing() && supportsHTTP2()) {
+        // Negotiate HTTP/2 for HTTPS requests, and wait for a connection that is
+        // being established to the same host rather than opening another one.
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+        handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+    }
+#endif
+    handleError(curl_easy_setopt(
+        handle, CURLOPT_DNS_CACHE_TIMEOUT, static_cast<long>(clientOptions.dnsCacheTimeout().count())));
+    if (const auto keepAlive = clientOptions.keepAliveInterval(); keepAlive > Seconds::zero()) {
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L));
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, static_cast<long>(keepAlive.count())));
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, static_cast<long>(keepAlive.count())));
+    }
+
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
 }
@@ -396,6 +487,10 @@ void HTTPRequest::handleResult(CURLcode code) {
 
     using Error = Response::Error;
 
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (61) << 8 | 0)
+    response->timing = getTiming(handle);
+#endif
+
     // Add human-readable error code
     if (code != CURLE_OK) {
         switch (code) {
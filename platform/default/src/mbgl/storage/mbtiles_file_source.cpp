@@ -14,6 +14,8 @@
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/compression.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/filesystem.hpp>
 
 #include <mbgl/storage/sqlite3.hpp>
@@ -72,7 +74,9 @@ public:
 
     std::string db_path(const std::string &path) { return path.substr(0, path.find('?')); }
 
-    bool is_compressed(const std::string &v) { return (((uint8_t)v[0]) == 0x1f) && (((uint8_t)v[1]) == 0x8b); }
+    bool is_compressed(std::string_view v) {
+        return v.size() >= 2 && (((uint8_t)v[0]) == 0x1f) && (((uint8_t)v[1]) == 0x8b);
+    }
 
     // Generate a tilejson resource from .mbtiles file
     void request_tilejson(const Resource &resource, ActorRef<FileSourceRequest> req) {
@@ -84,7 +88,7 @@ public:
         auto &allocator = doc.GetAllocator();
 
         std::map<std::string, std::string> values;
-        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+        auto &db = get_db(path).db;
 
         mapbox::sqlite::Statement meta(db, "SELECT * from metadata");
         for (mapbox::sqlite::Query q(meta); q.run();) {
@@ -186,33 +190,34 @@ public:
     void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
         std::string base_path = url_to_path(resource.url);
         std::string path = db_path(base_path);
-        auto &db = get_db(path);
-
-        int iy = resource.tileData->y;
-        int iz = resource.tileData->z;
-
-        auto x = std::to_string(resource.tileData->x);
-        auto y = std::to_string((int)(pow(2, iz) - 1) - iy);
-        auto z = std::to_string(iz);
+        auto &connection = get_db(path);
 
-        std::string sql = "SELECT tile_data FROM tiles where zoom_level = " + z + " AND tile_column = " + x +
-                          " AND tile_row = " + y;
-        mapbox::sqlite::Statement stmt(db, sql.c_str());
+        const int64_t iz = resource.tileData->z;
+        const int64_t iy = resource.tileData->y;
 
         Response response;
         response.noContent = true;
 
-        for (mapbox::sqlite::Query q(stmt); q.run();) {
-            std::optional<std::string> data = q.get<std::optional<std::string>>(0);
+        if (!connection.tileStatement) {
+            connection.tileStatement = std::make_unique<mapbox::sqlite::Statement>(
+                connection.db,
+                "SELECT tile_data FROM tiles WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3");
+        }
+
+        mapbox::sqlite::Query q(*connection.tileStatement);
+        q.bind(1, iz);
+        q.bind(2, static_cast<int64_t>(resource.tileData->x));
+        q.bind(3, (int64_t(1) << iz) - 1 - iy);
+
+        if (q.run()) {
+            // The blob is read in place from the mapped file, and copied once into the response
+            const auto data = q.get<std::optional<std::string_view>>(0);
             if (data) {
-                response.data = std::make_shared<std::string>(*data);
+                response.data = std::make_shared<std::string>(is_compressed(*data) ? util::decompress(*data)
+                                                                                   : std::string(*data));
                 response.noContent = false;
                 response.expires = Timestamp::max();
                 response.etag = resource.url;
-
-                if (is_compressed(*response.data)) {
-                    response.data = std::make_shared<std::string>(util::decompress(*response.data));
-                }
             }
         }
         req.invoke(&FileSourceRequest::setResponse, response);
@@ -239,7 +244,20 @@ public:
     }
 
 private:
-    std::map<std::string, mapbox::sqlite::Database> db_cache;
+    // A connection that stays open for the lifetime of the file source, with the tile
+    // statement prepared on first use and reused for every following request.
+    struct Connection {
+        explicit Connection(const std::string &path)
+            : db(mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)) {
+            db.exec("PRAGMA mmap_size = " + util::toString(util::DEFAULT_READ_ONLY_MMAP_SIZE));
+        }
+
+        mapbox::sqlite::Database db;
+        std::unique_ptr<mapbox::sqlite::Statement> tileStatement;
+    };
+
+    // All requests run on the file source thread, so one connection per path is enough
+    std::map<std::string, Connection> db_cache;
 
     void close_db(const std::string &path) {
         auto ptr = db_cache.find(path);
@@ -251,15 +269,13 @@ private:
     void close_all() { db_cache.clear(); }
 
     // Multiple databases open simultaneoulsy, to effectively support multiple .mbtiles maps
-    mapbox::sqlite::Database &get_db(const std::string &path) {
+    Connection &get_db(const std::string &path) {
         auto ptr = db_cache.find(path);
         if (ptr != db_cache.end()) {
             return ptr->second;
         };
 
-        auto ptr2 = db_cache.insert(std::pair<std::string, mapbox::sqlite::Database>(
-            path, mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)));
-        return ptr2.first->second;
+        return db_cache.try_emplace(path, path).first->second;
     }
 
     mutable std::mutex resourceOptionsMutex;
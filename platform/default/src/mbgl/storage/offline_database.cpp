@@ -2,6 +2,7 @@
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/sqlite3.hpp>
 #include <mbgl/util/compression.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/chrono.hpp>
@@ -37,6 +38,7 @@ void OfflineDatabase::initialize() {
 
         db->setBusyTimeout(Milliseconds::max());
         db->exec("PRAGMA foreign_keys = ON");
+        db->exec("PRAGMA mmap_size = " + util::toString(util::DEFAULT_READ_ONLY_MMAP_SIZE));
 
         return;
     }
@@ -53,7 +55,7 @@ void OfflineDatabase::initialize() {
             // Newly created database, or old cache-only database; remove old table if it exists.
             removeOldCacheTable();
             createSchema();
-            return;
+            break;
         case 2:
             migrateToVersion3();
             // fall through
@@ -68,12 +70,15 @@ void OfflineDatabase::initialize() {
             // fall through
         case 6:
             // Happy path; we're done
-            return;
+            break;
         default:
             // Downgrade: delete the database and try to reinitialize.
             removeExisting();
             initialize();
+            return;
     }
+
+    createTileCheckpointTable();
 }
 
 void OfflineDatabase::changePath(const std::string& path_) {
@@ -294,6 +299,75 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
     return {false, 0};
 }
 
+uint64_t OfflineDatabase::putAmbientResources(const std::list<std::tuple<Resource, Response>>& resources) {
+    if (auto inserted = putAmbientBatch(resources)) {
+        return *inserted;
+    }
+
+    // Write what fits one resource at a time rather than dropping the whole batch
+    uint64_t inserted = 0;
+    for (const auto& [resource, response] : resources) {
+        if (!response.error && put(resource, response).first) {
+            inserted++;
+        }
+    }
+    return inserted;
+}
+
+std::optional<uint64_t> OfflineDatabase::putAmbientBatch(
+    const std::list<std::tuple<Resource, Response>>& resources) try {
+    if (readOnly || resources.empty()) return 0;
+
+    if (!db) {
+        initialize();
+    }
+
+    if (disabled()) {
+        return 0;
+    }
+
+    checkFlags();
+
+    // Compress everything up front, so that room for the whole batch is made at once
+    std::vector<std::optional<std::string>> compressed;
+    compressed.reserve(resources.size());
+    uint64_t size = 0;
+    for (const auto& elem : resources) {
+        const auto& response = std::get<1>(elem);
+        if (response.error) {
+            compressed.emplace_back();
+            continue;
+        }
+        compressed.push_back(compressData(response));
+        size += compressed.back() ? compressed.back()->size() : response.data ? response.data->size() : 0;
+    }
+
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    DatabaseSizeChangeStats stats(this);
+    if (!evict(size, stats)) {
+        Log::Info(Event::Database, "Unable to make space for the batch of entries, writing them one by one");
+        return std::nullopt;
+    }
+
+    uint64_t inserted = 0;
+    auto compressedData = compressed.begin();
+    for (const auto& elem : resources) {
+        const auto& response = std::get<1>(elem);
+        if (!response.error && putData(std::get<0>(elem), response, *compressedData)) {
+            inserted++;
+        }
+        ++compressedData;
+    }
+
+    updateAmbientCacheSize(stats);
+    transaction.commit();
+    return inserted;
+} catch (...) {
+    handleError("write resources");
+    return std::nullopt;
+}
+
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
                                                        const Response& response,
                                                        bool evict_) {
@@ -303,15 +377,8 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         return {false, 0};
     }
 
-    std::string compressedData;
-    bool compressed = false;
-    uint64_t size = 0;
-
-    if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
-    }
+    const std::optional<std::string> compressedData = compressData(response);
+    const uint64_t size = compressedData ? compressedData->size() : response.data ? response.data->size() : 0;
 
     std::optional<DatabaseSizeChangeStats> stats;
     if (evict_) {
@@ -322,24 +389,7 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         }
     }
 
-    bool inserted;
-
-    if (resource.kind == Resource::Kind::Tile) {
-        assert(resource.tileData);
-        inserted = putTile(*resource.tileData,
-                           response,
-                           compressed      ? compressedData
-                           : response.data ? *response.data
-                                           : "",
-                           compressed);
-    } else {
-        inserted = putResource(resource,
-                               response,
-                               compressed      ? compressedData
-                               : response.data ? *response.data
-                                               : "",
-                               compressed);
-    }
+    const bool inserted = putData(resource, response, compressedData);
 
     if (stats) {
         updateAmbientCacheSize(*stats);
@@ -348,6 +398,30 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     return {inserted, size};
 }
 
+std::optional<std::string> OfflineDatabase::compressData(const Response& response) {
+    if (!response.data) {
+        return std::nullopt;
+    }
+    std::string compressedData = util::compress(*response.data);
+    if (compressedData.size() < response.data->size()) {
+        return compressedData;
+    }
+    return std::nullopt;
+}
+
+bool OfflineDatabase::putData(const Resource& resource,
+                              const Response& response,
+                              const std::optional<std::string>& compressedData) {
+    const std::string& data = compressedData ? *compressedData : response.data ? *response.data : "";
+
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        return putTile(*resource.tileData, response, data, bool(compressedData));
+    } else {
+        return putResource(resource, response, data, bool(compressedData));
+    }
+}
+
 std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
     // Update accessed timestamp used for LRU eviction.
     if (!readOnly) {
@@ -389,7 +463,8 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const
     response.mustRevalidate = query.get<bool>(2);
     response.modified = query.get<std::optional<Timestamp>>(3);
 
-    auto data = query.get<std::optional<std::string>>(4);
+    // Read the blob in place, so that it is copied at most once into the response
+    const auto data = query.get<std::optional<std::string_view>>(4);
     if (!data) {
         response.noContent = true;
     } else if (query.get<bool>(5)) {
@@ -563,7 +638,8 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
     response.mustRevalidate = query.get<bool>(2);
     response.modified = query.get<std::optional<Timestamp>>(3);
 
-    std::optional<std::string> data = query.get<std::optional<std::string>>(4);
+    // Read the blob in place, so that it is copied at most once into the response
+    const auto data = query.get<std::optional<std::string_view>>(4);
     if (!data) {
         response.noContent = true;
     } else if (query.get<bool>(5)) {
@@ -1026,9 +1102,9 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return 0;
 }
 
-void OfflineDatabase::putRegionResources(int64_t regionID,
-                                         const std::list<std::tuple<Resource, Response>>& resources,
-                                         OfflineRegionStatus& status) try {
+std::vector<uint64_t> OfflineDatabase::putRegionResources(int64_t regionID,
+                                                          const std::list<std::tuple<Resource, Response>>& resources,
+                                                          OfflineRegionStatus& status) try {
     checkFlags();
 
     if (!db) {
@@ -1044,12 +1120,16 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     uint64_t completedTileCount = 0;
     uint64_t completedTileSize = 0;
 
+    std::vector<uint64_t> sizes;
+    sizes.reserve(resources.size());
+
     for (const auto& elem : resources) {
         const auto& resource = std::get<0>(elem);
         const auto& response = std::get<1>(elem);
 
         try {
             uint64_t resourceSize = putRegionResourceInternal(regionID, resource, response);
+            sizes.push_back(resourceSize);
             completedResourceCount++;
             completedResourceSize += resourceSize;
             if (resource.kind == Resource::Kind::Tile) {
@@ -1070,8 +1150,91 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     status.completedResourceSize += completedResourceSize;
     status.completedTileCount += completedTileCount;
     status.completedTileSize += completedTileSize;
+    return sizes;
 } catch (...) {
     handleError("write region resources");
+    return {};
+}
+
+void OfflineDatabase::createTileCheckpointTable() {
+    assert(db);
+    checkFlags();
+
+    // Not part of the versioned schema, but created whenever a writable database is opened: a
+    // database without checkpoints is complete, and there is no migration to run for it, nor
+    // anything to carry over when merging a side database.
+    // clang-format off
+    db->exec(
+        "CREATE TABLE IF NOT EXISTS region_tile_checkpoints ("
+        "  region_id  INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,"
+        "  source     TEXT NOT NULL,"
+        "  position   INTEGER NOT NULL,"
+        "  tile_count INTEGER NOT NULL,"
+        "  tile_size  INTEGER NOT NULL,"
+        "  UNIQUE (region_id, source)"
+        ")");
+    // clang-format on
+}
+
+std::optional<OfflineTileCheckpoint> OfflineDatabase::getRegionTileCheckpoint(int64_t regionID,
+                                                                              const std::string& source) try {
+    if (!db) {
+        initialize();
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "SELECT position, tile_count, tile_size "
+        "FROM region_tile_checkpoints "
+        "WHERE region_id = ?1 "
+        "AND source = ?2") };
+    // clang-format on
+    query.bind(1, regionID);
+    query.bind(2, source);
+    if (!query.run()) {
+        return std::nullopt;
+    }
+
+    return OfflineTileCheckpoint{static_cast<uint64_t>(query.get<int64_t>(0)),
+                                 static_cast<uint64_t>(query.get<int64_t>(1)),
+                                 static_cast<uint64_t>(query.get<int64_t>(2))};
+} catch (...) {
+    handleError("read tile checkpoint");
+    return std::nullopt;
+}
+
+void OfflineDatabase::putRegionTileCheckpoint(int64_t regionID,
+                                              const std::string& source,
+                                              const OfflineTileCheckpoint& checkpoint) try {
+    if (!db) {
+        initialize();
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "INSERT OR REPLACE INTO region_tile_checkpoints (region_id, source, position, tile_count, tile_size) "
+        "VALUES (?1, ?2, ?3, ?4, ?5)") };
+    // clang-format on
+    query.bind(1, regionID);
+    query.bind(2, source);
+    query.bind(3, static_cast<int64_t>(checkpoint.position));
+    query.bind(4, static_cast<int64_t>(checkpoint.tileCount));
+    query.bind(5, static_cast<int64_t>(checkpoint.tileSize));
+    query.run();
+} catch (...) {
+    handleError("write tile checkpoint");
+}
+
+void OfflineDatabase::deleteRegionTileCheckpoints(int64_t regionID) try {
+    if (!db) {
+        initialize();
+    }
+
+    mapbox::sqlite::Query query{getStatement("DELETE FROM region_tile_checkpoints WHERE region_id = ?")};
+    query.bind(1, regionID);
+    query.run();
+} catch (...) {
+    handleError("delete tile checkpoints");
 }
 
 uint64_t OfflineDatabase::putRegionResourceInternal(int64_t regionID,
@@ -16,14 +16,20 @@
 #include <mbgl/util/i18n.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <algorithm>
+#include <map>
 #include <set>
 
 namespace {
 
-const size_t kResourcesBatchSize = 64;
+// Downloaded resources are written in batches of this many resources or bytes, whichever comes
+// first, so that a large region is stored in few transactions without holding much in memory.
+const size_t kResourcesBatchSize = 256;
+const size_t kResourcesBatchBytes = 4 * 1024 * 1024;
 const size_t kMarkBatchSize = 200;
 
 } // namespace
@@ -49,51 +55,173 @@ Range<uint8_t> coveringZoomRange(const RegionDefinition& definition,
     return {static_cast<uint8_t>(minZ), static_cast<uint8_t>(maxZ)};
 }
 
-template <class Geometry, class Fn>
-void tileCover(const Geometry& geometry, uint8_t z, Fn&& fn) {
-    util::TileCover cover(geometry, z);
-    while (cover.hasNext()) {
-        fn(cover.next()->canonical);
-    }
+Range<uint8_t> coveringZoomRange(const OfflineRegionDefinition& definition,
+                                 style::SourceType type,
+                                 uint16_t tileSize,
+                                 const Range<uint8_t>& zoomRange) {
+    return std::visit([&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); }, definition);
 }
 
-template <class Fn>
-void tileCover(const OfflineRegionDefinition& definition,
-               style::SourceType type,
-               uint16_t tileSize,
-               const Range<uint8_t>& zoomRange,
-               Fn&& fn) {
-    const Range<uint8_t> clampedZoomRange = std::visit(
-        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); }, definition);
+std::unique_ptr<util::TileCover> makeCover(const OfflineRegionDefinition& definition, uint8_t z) {
+    return std::visit(overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) {
+                                     return std::make_unique<util::TileCover>(reg.bounds, z);
+                                 },
+                                 [&](const OfflineGeometryRegionDefinition& reg) {
+                                     return std::make_unique<util::TileCover>(reg.geometry, z);
+                                 }},
+                      definition);
+}
+
+// Counts the tiles by enumerating the cover they are downloaded from. The closed-form count of
+// util::tileCount() for bounds can disagree with the cover when the edges of the bounds lie on
+// tile boundaries, and the required counts must match the tiles that are actually downloaded.
+uint64_t tileCount(const OfflineRegionDefinition& definition, uint8_t z) {
+    auto cover = makeCover(definition, z);
+    uint64_t result = 0;
+    while (cover->next()) {
+        result++;
+    }
+    return result;
+}
 
+uint64_t tileCount(const OfflineRegionDefinition& definition, const Range<uint8_t>& clampedZoomRange) {
+    uint64_t result{};
     for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
-        std::visit(overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) { tileCover(reg.bounds, z, fn); },
-                              [&](const OfflineGeometryRegionDefinition& reg) {
-                                  tileCover(reg.geometry, z, fn);
-                              }},
-                   definition);
+        result += tileCount(definition, z);
     }
+
+    return result;
 }
 
 uint64_t tileCount(const OfflineRegionDefinition& definition,
                    style::SourceType type,
                    uint16_t tileSize,
                    const Range<uint8_t>& zoomRange) {
-    const Range<uint8_t> clampedZoomRange = std::visit(
-        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); }, definition);
+    return tileCount(definition, coveringZoomRange(definition, type, tileSize, zoomRange));
+}
 
-    uint64_t result{};
-    for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
-        result += std::visit(
-            overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) { return util::tileCount(reg.bounds, z); },
-                       [&](const OfflineGeometryRegionDefinition& reg) {
-                           return util::tileCount(reg.geometry, z);
-                       }},
-            definition);
+// OfflineDownload::TileQueue
+
+// The tiles of a tiled source, enumerated one at a time as they are requested instead of all
+// up front, so that the tile list of a large region is never held in memory. Tiles are numbered
+// in enumeration order, which is stable for a given region and source, so that an interrupted
+// download resumes from its checkpoint.
+class OfflineDownload::TileQueue {
+public:
+    TileQueue(const OfflineRegionDefinition& definition_, const Tileset& tileset, const Range<uint8_t>& zoomRange_)
+        : key(util::toString(zoomRange_.min) + "-" + util::toString(zoomRange_.max) +
+              (tileset.scheme == Tileset::Scheme::TMS ? "/tms/" : "/xyz/") + tileset.tiles[0]),
+          definition(definition_),
+          urlTemplate(tileset.tiles[0]),
+          scheme(tileset.scheme),
+          zoomRange(zoomRange_),
+          zoom(zoomRange_.min) {
+        for (uint8_t z = zoomRange.min; z <= zoomRange.max; z++) {
+            levelCounts.push_back(tileCount(definition, z));
+            size += levelCounts.back();
+        }
     }
 
-    return result;
-}
+    uint64_t count() const { return size; }
+    bool empty() const { return position >= size; }
+
+    std::optional<std::pair<Resource, uint64_t>> next() {
+        while (zoom <= zoomRange.max) {
+            if (!cover) {
+                cover = makeCover(definition, zoom);
+            }
+            if (cover->hasNext()) {
+                const CanonicalTileID tile = cover->next()->canonical;
+                auto tileResource = Resource::tile(urlTemplate,
+                                                   std::visit([](auto& def) { return def.pixelRatio; }, definition),
+                                                   tile.x,
+                                                   tile.y,
+                                                   tile.z,
+                                                   scheme);
+                tileResource.setPriority(Resource::Priority::Low);
+                tileResource.setUsage(Resource::Usage::Offline);
+                return std::make_pair(std::move(tileResource), position++);
+            }
+            cover.reset();
+            zoom++;
+        }
+
+        assert(position == size);
+        return std::nullopt;
+    }
+
+    // Continues from a checkpoint, skipping the tiles that are already done
+    void resume(const OfflineTileCheckpoint& checkpoint_) {
+        assert(position == 0 && checkpoint_.position <= size);
+        checkpoint = savedCheckpoint = checkpoint_;
+
+        uint64_t remaining = checkpoint.position;
+        while (remaining > 0 && zoom <= zoomRange.max) {
+            if (!cover) {
+                // Whole zoom levels are skipped without enumerating them again
+                const uint64_t levelCount = levelCounts[zoom - zoomRange.min];
+                if (remaining >= levelCount) {
+                    remaining -= levelCount;
+                    position += levelCount;
+                    zoom++;
+                    continue;
+                }
+                cover = makeCover(definition, zoom);
+            }
+            if (!cover->hasNext()) {
+                cover.reset();
+                zoom++;
+                continue;
+            }
+            cover->next();
+            remaining--;
+            position++;
+        }
+    }
+
+    // Records the tile at the given index as done, with its stored size, or with none when the
+    // server does not have it, and moves the checkpoint past all tiles done so far in order.
+    void complete(uint64_t index, std::optional<uint64_t> storedSize) {
+        done.emplace(index, storedSize);
+        while (!done.empty() && done.begin()->first == checkpoint.position) {
+            if (const auto& stored = done.begin()->second) {
+                checkpoint.tileCount++;
+                checkpoint.tileSize += *stored;
+            }
+            checkpoint.position++;
+            done.erase(done.begin());
+        }
+    }
+
+    // Returns the checkpoint if it moved since it was last saved
+    std::optional<OfflineTileCheckpoint> takeCheckpoint() {
+        if (checkpoint.position == savedCheckpoint.position) {
+            return std::nullopt;
+        }
+        savedCheckpoint = checkpoint;
+        return checkpoint;
+    }
+
+    const std::string key;
+
+private:
+    const OfflineRegionDefinition& definition;
+    const std::string urlTemplate;
+    const Tileset::Scheme scheme;
+    const Range<uint8_t> zoomRange;
+    uint8_t zoom;
+    std::unique_ptr<util::TileCover> cover;
+
+    // The number of tiles of each zoom level of the range, and of all of them
+    std::vector<uint64_t> levelCounts;
+    uint64_t size = 0;
+    uint64_t position = 0;
+
+    OfflineTileCheckpoint checkpoint;
+    OfflineTileCheckpoint savedCheckpoint;
+    // Tiles past the checkpoint that are done, as they complete out of order
+    std::map<uint64_t, std::optional<uint64_t>> done;
+};
 
 // OfflineDownload
 
@@ -384,11 +512,14 @@ void OfflineDownload::activateDownload() {
    fruitless anyway.
 */
 void OfflineDownload::continueDownload() {
-    if (resourcesRemaining.empty()) {
+    if (!hasQueuedResources()) {
         // Flush pending buffers.
         if (!flushResourcesBuffer()) return;
         if (status.complete()) {
             markPendingUsedResources();
+            // Checkpoints are only needed to resume an interrupted download
+            offlineDatabase.deleteRegionTileCheckpoints(id);
+            tileQueues.clear();
             setState(OfflineRegionDownloadState::Inactive);
             return;
         }
@@ -396,30 +527,66 @@ void OfflineDownload::continueDownload() {
 
     if (resourcesToBeMarkedAsUsed.size() >= kMarkBatchSize) markPendingUsedResources();
 
+    // Use the budget of offline downloads, if the file source has one
     uint32_t maxConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
-    auto value = onlineFileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY);
-    if (uint64_t* maxRequests = value.getUint()) {
-        maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
+    auto offlineValue = onlineFileSource.getProperty(MAX_CONCURRENT_OFFLINE_REQUESTS_KEY);
+    uint64_t* maxOfflineRequests = offlineValue.getUint();
+    if (maxOfflineRequests && *maxOfflineRequests > 0) {
+        maxConcurrentRequests = static_cast<uint32_t>(*maxOfflineRequests);
+    } else {
+        auto value = onlineFileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY);
+        if (uint64_t* maxRequests = value.getUint()) {
+            maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
+        }
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < maxConcurrentRequests) {
-        ensureResource(std::move(resourcesRemaining.front()));
-        resourcesRemaining.pop_front();
+    // Other resources come first, then the tiles of each source in turn
+    auto tileQueue = tileQueues.begin();
+    while (requests.size() < maxConcurrentRequests) {
+        if (!resourcesRemaining.empty()) {
+            ensureResource(std::move(resourcesRemaining.front()));
+            resourcesRemaining.pop_front();
+            continue;
+        }
+
+        while (tileQueue != tileQueues.end() && tileQueue->empty()) {
+            ++tileQueue;
+        }
+        if (tileQueue == tileQueues.end()) {
+            break;
+        }
+        if (auto tile = tileQueue->next()) {
+            ensureResource(std::move(tile->first), {}, TilePosition{&*tileQueue, tile->second});
+        }
     }
 }
 
 void OfflineDownload::deactivateDownload() {
+    saveTileCheckpoints();
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
     requests.clear();
     buffer.clear();
+    bufferedTiles.clear();
+    bufferedBytes = 0;
+    tileQueues.clear();
 }
 
 bool OfflineDownload::flushResourcesBuffer() {
     if (buffer.empty()) return true;
     try {
-        offlineDatabase.putRegionResources(id, buffer, status);
+        const auto sizes = offlineDatabase.putRegionResources(id, buffer, status);
+        if (sizes.size() == bufferedTiles.size()) {
+            for (std::size_t i = 0; i < sizes.size(); ++i) {
+                if (const auto& tile = bufferedTiles[i]) {
+                    tile->queue->complete(tile->index, sizes[i]);
+                }
+            }
+        }
         buffer.clear();
+        bufferedTiles.clear();
+        bufferedBytes = 0;
+        saveTileCheckpoints();
         observer->statusChanged(status);
         return true;
     } catch (const MapboxTileLimitExceededException&) {
@@ -428,6 +595,21 @@ bool OfflineDownload::flushResourcesBuffer() {
     }
 }
 
+bool OfflineDownload::hasQueuedResources() const {
+    return !resourcesRemaining.empty() ||
+           std::any_of(tileQueues.begin(), tileQueues.end(), [](const TileQueue& queue) { return !queue.empty(); });
+}
+
+void OfflineDownload::saveTileCheckpoints() {
+    // Tiles that were found in the database are done only once the region is marked as using them
+    markPendingUsedResources();
+    for (auto& queue : tileQueues) {
+        if (auto checkpoint = queue.takeCheckpoint()) {
+            offlineDatabase.putRegionTileCheckpoint(id, queue.key, *checkpoint);
+        }
+    }
+}
+
 void OfflineDownload::queueResource(Resource&& resource) {
     resource.setPriority(Resource::Priority::Low);
     resource.setUsage(Resource::Usage::Offline);
@@ -439,30 +621,32 @@ void OfflineDownload::queueResource(Resource&& resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto& tile) {
-        status.requiredResourceCount++;
-        status.requiredTileCount++;
-
-        auto tileResource = Resource::tile(tileset.tiles[0],
-                                           std::visit([](auto& def) { return def.pixelRatio; }, definition),
-                                           tile.x,
-                                           tile.y,
-                                           tile.z,
-                                           tileset.scheme);
-
-        tileResource.setPriority(Resource::Priority::Low);
-        tileResource.setUsage(Resource::Usage::Offline);
-
-        resourcesRemaining.push_back(std::move(tileResource));
-    });
+    auto& queue = tileQueues.emplace_back(
+        definition, tileset, coveringZoomRange(definition, type, tileSize, tileset.zoomRange));
+    status.requiredResourceCount += queue.count();
+    status.requiredTileCount += queue.count();
+
+    const auto checkpoint = offlineDatabase.getRegionTileCheckpoint(id, queue.key);
+    if (checkpoint && checkpoint->position <= queue.count() && checkpoint->tileCount <= checkpoint->position) {
+        // Tiles before the checkpoint are stored in the region already, or missing on the server
+        queue.resume(*checkpoint);
+        status.completedResourceCount += checkpoint->tileCount;
+        status.completedResourceSize += checkpoint->tileSize;
+        status.completedTileCount += checkpoint->tileCount;
+        status.completedTileSize += checkpoint->tileSize;
+        status.requiredResourceCount -= checkpoint->position - checkpoint->tileCount;
+    }
 }
 
 void OfflineDownload::markPendingUsedResources() {
+    if (resourcesToBeMarkedAsUsed.empty()) return;
     offlineDatabase.markUsedResources(id, resourcesToBeMarkedAsUsed);
     resourcesToBeMarkedAsUsed.clear();
 }
 
-void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Response)> callback) {
+void OfflineDownload::ensureResource(Resource&& resource,
+                                     std::function<void(Response)> callback,
+                                     std::optional<TilePosition> tile) {
     assert(resource.priority == Resource::Priority::Low);
     assert(resource.usage == Resource::Usage::Offline);
 
@@ -495,6 +679,9 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
                 status.completedTileCount += 1;
                 status.completedTileSize += *offlineResponse;
             }
+            if (tile) {
+                tile->queue->complete(tile->index, static_cast<uint64_t>(*offlineResponse));
+            }
 
             observer->statusChanged(status);
             continueDownload();
@@ -515,6 +702,9 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
                     requests.erase(fileRequestsIt);
                     assert(status.requiredResourceCount > 0);
                     status.requiredResourceCount--;
+                    if (tile) {
+                        tile->queue->complete(tile->index, std::nullopt);
+                    }
                     continueDownload();
                 }
                 return;
@@ -528,12 +718,17 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
 
             // Queue up for batched insertion
             buffer.emplace_back(resource, onlineResponse);
+            bufferedTiles.push_back(tile);
+            bufferedBytes += onlineResponse.data ? onlineResponse.data->size() : 0;
 
             // Flush buffer periodically.
-            // Have to keep `resourcesRemaining.empty()` as the following
+            // Have to keep `hasQueuedResources()` as the following
             // condition would fail otherwise.
             // TODO: Simplify the tile count limit check code path!
-            if ((buffer.size() == kResourcesBatchSize || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+            if ((buffer.size() >= kResourcesBatchSize || bufferedBytes >= kResourcesBatchBytes ||
+                 !hasQueuedResources()) &&
+                !flushResourcesBuffer())
+                return;
 
             if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
                 onMapboxTileCountLimitExceeded();
@@ -25,9 +25,10 @@
 
 #include <algorithm>
 #include <cassert>
-#include <list>
 #include <map>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -116,7 +117,7 @@ public:
 
     void remove(OnlineFileRequest* req) {
         allRequests.erase(req);
-        if (activeRequests.erase(req)) {
+        if (deactivateRequest(req)) {
             activatePendingRequest();
         } else {
             pendingRequests.remove(req);
@@ -128,7 +129,7 @@ public:
         assert(activeRequests.find(req) == activeRequests.end());
         assert(!req->request);
 
-        if (activeRequests.size() >= getMaximumConcurrentRequests()) {
+        if (!hasCapacityFor(req)) {
             queueRequest(req);
         } else {
             activateRequest(req);
@@ -139,13 +140,16 @@ public:
 
     void activateRequest(OnlineFileRequest* req) {
         auto callback = [=, this](const Response& response) {
-            activeRequests.erase(req);
+            deactivateRequest(req);
             req->request.reset();
             req->completed(response);
             activatePendingRequest();
         };
 
         activeRequests.insert(req);
+        if (req->resource.usage == Resource::Usage::Offline) {
+            activeOfflineRequests++;
+        }
 
         if (online) {
             req->request = httpFileSource.request(req->resource, callback);
@@ -157,8 +161,31 @@ public:
         }
     }
 
+    // Returns whether the request was active
+    bool deactivateRequest(OnlineFileRequest* req) {
+        if (!activeRequests.erase(req)) {
+            return false;
+        }
+        if (req->resource.usage == Resource::Usage::Offline) {
+            assert(activeOfflineRequests > 0);
+            activeOfflineRequests--;
+        }
+        return true;
+    }
+
+    // Offline downloads draw on a budget of their own when one is set, and share the regular one otherwise
+    bool hasCapacityFor(const OnlineFileRequest* req) const {
+        if (maximumConcurrentOfflineRequests == 0) {
+            return activeRequests.size() < maximumConcurrentRequests;
+        }
+        if (req->resource.usage == Resource::Usage::Offline) {
+            return activeOfflineRequests < maximumConcurrentOfflineRequests;
+        }
+        return activeRequests.size() - activeOfflineRequests < maximumConcurrentRequests;
+    }
+
     void activatePendingRequest() {
-        auto req = pendingRequests.pop();
+        auto req = pendingRequests.pop([&](const OnlineFileRequest* pending) { return hasCapacityFor(pending); });
 
         if (req) {
             activateRequest(*req);
@@ -192,6 +219,10 @@ public:
         maximumConcurrentRequests = maximumConcurrentRequests_;
     }
 
+    void setMaximumConcurrentOfflineRequests(uint32_t maximumConcurrentOfflineRequests_) {
+        maximumConcurrentOfflineRequests = maximumConcurrentOfflineRequests_;
+    }
+
     void setAPIBaseURL(std::string t) {
         resourceOptions.withTileServerOptions(TileServerOptions().withBaseURL(std::move(t)));
     }
@@ -220,63 +251,61 @@ private:
         }
     }
 
-    // Using Pending Requests as an priority queue which processes
-    // file requests in a FIFO manner but prefers regular requests
-    // over offline requests with a low priority such that low priority
-    // requests do not throttle regular requests.
-    //
-    // The order of a queue is therefore:
+    // Pending requests are activated in order of their priority, then of their load order, and
+    // first in, first out among equals, so that low priority requests do not throttle regular ones
+    // and tiles near the center of the viewport are requested first.
     //
-    // hi0 -- hi1 -- hi2 -- hi3 -- lo0 -- lo1 --lo2
-    //                              ^
-    //                              firstLowPriorityRequest
-
+    // The load order of a resource can change while its request is pending, so the next request
+    // is looked up when a connection becomes available instead of being kept in a heap. The queue
+    // holds at most the tiles of a few viewports, which keeps the scan cheap next to the request.
+    // Only requests that fit in their concurrency budget are considered, as offline downloads
+    // may have a budget of their own.
     struct PendingRequests {
-        PendingRequests()
-            : firstLowPriorityRequest(queue.begin()) {}
+        struct Entry {
+            OnlineFileRequest* request;
+            uint64_t sequence;
+        };
 
-        std::list<OnlineFileRequest*> queue;
-        std::list<OnlineFileRequest*>::iterator firstLowPriorityRequest;
+        std::vector<Entry> queue;
+        uint64_t nextSequence = 0;
 
         void remove(const OnlineFileRequest* request) {
-            auto it = std::find(queue.begin(), queue.end(), request);
+            auto it = std::find_if(
+                queue.begin(), queue.end(), [&](const Entry& entry) { return entry.request == request; });
             if (it != queue.end()) {
-                if (it == firstLowPriorityRequest) {
-                    firstLowPriorityRequest++;
-                }
-                queue.erase(it);
+                // Order is restored from the sequence numbers, so the last entry can fill the gap
+                *it = queue.back();
+                queue.pop_back();
             }
         }
 
-        void insert(OnlineFileRequest* request) {
-            if (request->resource.priority == Resource::Priority::Regular) {
-                firstLowPriorityRequest = queue.insert(firstLowPriorityRequest, request);
-                firstLowPriorityRequest++;
-            } else {
-                if (firstLowPriorityRequest == queue.end()) {
-                    firstLowPriorityRequest = queue.insert(queue.end(), request);
-                } else {
-                    queue.insert(queue.end(), request);
+        void insert(OnlineFileRequest* request) { queue.push_back({request, nextSequence++}); }
+
+        template <typename Fn>
+        std::optional<OnlineFileRequest*> pop(Fn&& canActivate) {
+            auto key = [](const Entry& entry) {
+                const Resource& resource = entry.request->resource;
+                return std::make_tuple(resource.priority, resource.getLoadOrder(), entry.sequence);
+            };
+            auto next = queue.end();
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                if ((next == queue.end() || key(*it) < key(*next)) && canActivate(it->request)) {
+                    next = it;
                 }
             }
-        }
-
-        std::optional<OnlineFileRequest*> pop() {
-            if (queue.empty()) {
+            if (next == queue.end()) {
                 return {};
             }
 
-            if (queue.begin() == firstLowPriorityRequest) {
-                firstLowPriorityRequest++;
-            }
-
-            OnlineFileRequest* next = queue.front();
-            queue.pop_front();
-            return {next};
+            OnlineFileRequest* request = next->request;
+            *next = queue.back();
+            queue.pop_back();
+            return {request};
         }
 
         bool contains(OnlineFileRequest* request) const {
-            return (std::find(queue.begin(), queue.end(), request) != queue.end());
+            return std::any_of(
+                queue.begin(), queue.end(), [&](const Entry& entry) { return entry.request == request; });
         }
     };
 
@@ -301,9 +330,11 @@ private:
     PendingRequests pendingRequests;
 
     std::set<OnlineFileRequest*> activeRequests;
+    std::size_t activeOfflineRequests = 0;
 
     bool online = true;
     uint32_t maximumConcurrentRequests;
+    uint32_t maximumConcurrentOfflineRequests = 0;
     HTTPFileSource httpFileSource;
     util::AsyncTask reachability{std::bind(&OnlineFileSourceThread::networkIsReachableAgain, this)};
     std::map<AsyncRequest*, std::unique_ptr<OnlineFileRequest>> tasks;
@@ -383,6 +414,25 @@ public:
         return cachedMaximumConcurrentRequests;
     }
 
+    void setMaximumConcurrentOfflineRequests(const mapbox::base::Value& value) {
+        if (auto* maximumConcurrentOfflineRequests = value.getUint()) {
+            assert(*maximumConcurrentOfflineRequests < std::numeric_limits<uint32_t>::max());
+            const auto maxConcurrentRequests = static_cast<uint32_t>(*maximumConcurrentOfflineRequests);
+            thread->actor().invoke(&OnlineFileSourceThread::setMaximumConcurrentOfflineRequests, maxConcurrentRequests);
+            {
+                std::lock_guard<std::mutex> lock(maximumConcurrentRequestsMutex);
+                cachedMaximumConcurrentOfflineRequests = maxConcurrentRequests;
+            }
+        } else {
+            Log::Error(Event::General, "Invalid max-concurrent-offline-requests property value type.");
+        }
+    }
+
+    uint32_t getMaximumConcurrentOfflineRequests() const {
+        std::lock_guard<std::mutex> lock(maximumConcurrentRequestsMutex);
+        return cachedMaximumConcurrentOfflineRequests;
+    }
+
     void setApiKey(const mapbox::base::Value& value) {
         if (auto* apiKey = value.getString()) {
             thread->actor().invoke(&OnlineFileSourceThread::setApiKey, *apiKey);
@@ -426,6 +476,7 @@ private:
 
     mutable std::mutex maximumConcurrentRequestsMutex;
     uint32_t cachedMaximumConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
+    uint32_t cachedMaximumConcurrentOfflineRequests = 0;
     const std::unique_ptr<util::Thread<OnlineFileSourceThread>> thread;
 };
 
@@ -674,6 +725,8 @@ void OnlineFileSource::setProperty(const std::string& key, const mapbox::base::V
         impl->setAPIBaseURL(value);
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         impl->setMaximumConcurrentRequests(value);
+    } else if (key == MAX_CONCURRENT_OFFLINE_REQUESTS_KEY) {
+        impl->setMaximumConcurrentOfflineRequests(value);
     } else if (key == ONLINE_STATUS_KEY) {
         // For testing only
         if (auto* boolValue = value.getBool()) {
@@ -692,6 +745,8 @@ mapbox::base::Value OnlineFileSource::getProperty(const std::string& key) const
         return impl->getAPIBaseURL();
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         return impl->getMaximumConcurrentRequests();
+    } else if (key == MAX_CONCURRENT_OFFLINE_REQUESTS_KEY) {
+        return impl->getMaximumConcurrentOfflineRequests();
     }
     std::string message = "Resource provider does not support property " + key;
     Log::Error(Event::General, message.c_str());
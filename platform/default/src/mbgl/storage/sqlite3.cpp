@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <chrono>
 #include <optional>
+#include <string_view>
 
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/logging.hpp>
@@ -394,6 +395,14 @@ std::string Query::get(int offset) {
             size_t(sqlite3_column_bytes(stmt.impl->stmt, offset))};
 }
 
+template <>
+std::string_view Query::get(int offset) {
+    assert(stmt.impl);
+    // sqlite3_column_blob returns null for empty blobs
+    const auto* data = reinterpret_cast<const char*>(sqlite3_column_blob(stmt.impl->stmt, offset));
+    return data ? std::string_view{data, size_t(sqlite3_column_bytes(stmt.impl->stmt, offset))} : std::string_view{};
+}
+
 template <>
 std::vector<uint8_t> Query::get(int offset) {
     assert(stmt.impl);
@@ -439,6 +448,16 @@ std::optional<std::string> Query::get(int offset) {
     }
 }
 
+template <>
+std::optional<std::string_view> Query::get(int offset) {
+    assert(stmt.impl);
+    if (sqlite3_column_type(stmt.impl->stmt, offset) == SQLITE_NULL) {
+        return std::nullopt;
+    } else {
+        return get<std::string_view>(offset);
+    }
+}
+
 template <>
 std::optional<std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>> Query::get(int offset) {
     assert(stmt.impl);
@@ -14,6 +14,7 @@
 #include <chrono>
 #include <limits>
 #include <optional>
+#include <string_view>
 #include <variant>
 
 #include <mbgl/util/chrono.hpp>
@@ -406,6 +407,28 @@ std::optional<std::string> Query::get(int offset) {
     return {std::string(value.constData(), value.size())};
 }
 
+// Blob columns only. The view points into the QByteArray shared with the cached record of
+// the query, which stays alive until the query moves to the next row or is finished.
+template <>
+std::string_view Query::get(int offset) {
+    assert(stmt.impl && stmt.impl->query.isValid());
+    const QVariant value = stmt.impl->query.value(offset);
+    checkQueryError(stmt.impl->query);
+    if (value.userType() != QMetaType::QByteArray) {
+        assert(value.isNull());
+        return {};
+    }
+    const auto* data = static_cast<const QByteArray*>(value.constData());
+    return {data->constData(), static_cast<std::size_t>(data->size())};
+}
+
+template <>
+std::optional<std::string_view> Query::get(int offset) {
+    assert(stmt.impl && stmt.impl->query.isValid());
+    if (stmt.impl->query.isNull(offset)) return {};
+    return {get<std::string_view>(offset)};
+}
+
 template <>
 std::optional<mbgl::Timestamp> Query::get(int offset) {
     assert(stmt.impl && stmt.impl->query.isValid());
@@ -160,11 +160,8 @@ void Mailbox::scheduleToRecieve(const std::optional<util::SimpleIdentity>& tag)
                 locked->receive();
             }
         };
-        if (tag) {
-            weakScheduler->schedule(*tag, std::move(setToRecieve));
-        } else {
-            weakScheduler->schedule(std::move(setToRecieve));
-        }
+        weakScheduler->scheduleWithPriority(
+            tag ? *tag : util::SimpleIdentity::Empty, priority, std::move(setToRecieve));
     }
 }
 
@@ -1,8 +1,13 @@
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/util/thread_local.hpp>
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <thread>
+
 namespace mbgl {
 
 std::function<void()> Scheduler::bindOnce(std::function<void()> fn) {
@@ -17,6 +22,32 @@ std::function<void()> Scheduler::bindOnce(std::function<void()> fn) {
 namespace {
 
 thread_local Scheduler* localScheduler;
+
+std::size_t backgroundThreadCount() {
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_THREAD_POOL_SIZE);
+    std::optional<std::size_t> count;
+    if (const auto* uintValue = value.getUint()) {
+        count = static_cast<std::size_t>(*uintValue);
+    } else if (const auto* intValue = value.getInt(); intValue && *intValue >= 0) {
+        count = static_cast<std::size_t>(*intValue);
+    }
+
+    if (!count) {
+        return ThreadPool::defaultThreadCount;
+    }
+    if (*count == 0) {
+        // `hardware_concurrency` may also return zero when it can't tell
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    return *count;
+}
+
+SchedulingMode backgroundSchedulingMode() {
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_THREAD_POOL_WORK_STEALING);
+    const auto* workStealing = value.getBool();
+    return (workStealing && *workStealing) ? SchedulingMode::WorkStealing : SchedulingMode::SharedQueue;
+}
+
 } // namespace
 
 void Scheduler::SetCurrent(Scheduler* scheduler) {
@@ -40,7 +71,7 @@ std::shared_ptr<Scheduler> Scheduler::GetBackground() {
     std::shared_ptr<Scheduler> scheduler = weak.lock();
 
     if (!scheduler) {
-        weak = scheduler = std::make_shared<ThreadPool>();
+        weak = scheduler = std::make_shared<ThreadPool>(backgroundThreadCount(), backgroundSchedulingMode());
     }
 
     return scheduler;
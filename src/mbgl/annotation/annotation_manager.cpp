@@ -11,9 +11,15 @@
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_impl.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
 
 #include <boost/iterator/function_output_iterator.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 // Note: LayerManager::annotationsEnabled is defined
 // at compile time, so that linker (with LTO on) is able
 // to optimize out the unreachable code.
@@ -36,6 +42,41 @@ const std::string AnnotationManager::SourceID = "org.maplibre.annotations";
 const std::string AnnotationManager::PointLayerID = "org.maplibre.annotations.points";
 const std::string AnnotationManager::ShapeLayerID = "org.maplibre.annotations.shape.";
 
+namespace {
+
+LatLngBounds symbolBounds(const SymbolAnnotation& annotation) {
+    const Point<double>& p = annotation.geometry;
+    return LatLngBounds::singleton({p.y, p.x});
+}
+
+// The areas that the annotations shown in a tile can come from. geojson-vt includes the shapes within a buffer
+// around the tile, and wraps those near the antimeridian into the neighboring world copy, so the area is also
+// repeated one world to each side.
+std::array<LatLngBounds, 3> tileQueryBounds(const CanonicalTileID& tileID) {
+    const double buffer = static_cast<double>(ShapeAnnotationImpl::tileBuffer) / util::EXTENT;
+    const double scale = std::pow(2.0, tileID.z);
+    const auto unproject = [&](double x, double y) {
+        return Projection::unproject({x * util::tileSize_D, y * util::tileSize_D}, scale);
+    };
+
+    auto bounds = LatLngBounds::hull(unproject(tileID.x - buffer, tileID.y + 1 + buffer),
+                                     unproject(tileID.x + 1 + buffer, tileID.y - buffer));
+    // Latitudes beyond the limits of the projection end up in the first and last rows of tiles
+    if (tileID.y == 0) {
+        bounds.extend(LatLng(90, bounds.west()));
+    }
+    if (tileID.y + 1 == (1u << tileID.z)) {
+        bounds.extend(LatLng(-90, bounds.west()));
+    }
+
+    const auto shifted = [&](double offset) {
+        return LatLngBounds::hull({bounds.south(), bounds.west() + offset}, {bounds.north(), bounds.east() + offset});
+    };
+    return {bounds, shifted(-util::DEGREES_MAX), shifted(util::DEGREES_MAX)};
+}
+
+} // namespace
+
 AnnotationManager::AnnotationManager(Style& style_)
     : style(style_) {}
 
@@ -78,18 +119,23 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    dirtyBounds.push_back(symbolBounds(annotation));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation) {
     ShapeAnnotationImpl& impl =
         *shapeAnnotations.emplace(id, std::make_unique<LineAnnotationImpl>(id, annotation)).first->second;
     impl.updateStyle(*style.get().impl);
+    shapeTree.insert({impl.bounds, id});
+    dirtyBounds.push_back(impl.bounds);
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation) {
     ShapeAnnotationImpl& impl =
         *shapeAnnotations.emplace(id, std::make_unique<FillAnnotationImpl>(id, annotation)).first->second;
     impl.updateStyle(*style.get().impl);
+    shapeTree.insert({impl.bounds, id});
+    dirtyBounds.push_back(impl.bounds);
 }
 
 void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation) {
@@ -116,6 +162,8 @@ void AnnotationManager::update(const AnnotationID& id, const LineAnnotation& ann
         return;
     }
 
+    shapeTree.remove(std::make_pair(it->second->bounds, id));
+    dirtyBounds.push_back(it->second->bounds);
     shapeAnnotations.erase(it);
     add(id, annotation);
     dirty = true;
@@ -128,6 +176,8 @@ void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& ann
         return;
     }
 
+    shapeTree.remove(std::make_pair(it->second->bounds, id));
+    dirtyBounds.push_back(it->second->bounds);
     shapeAnnotations.erase(it);
     add(id, annotation);
     dirty = true;
@@ -136,11 +186,14 @@ void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& ann
 void AnnotationManager::remove(const AnnotationID& id) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
+        dirtyBounds.push_back(symbolBounds(symbolAnnotations.at(id)->annotation));
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
         auto it = shapeAnnotations.find(id);
         (void)*style.get().impl->removeLayer(it->second->layerID);
+        shapeTree.remove(std::make_pair(it->second->bounds, id));
+        dirtyBounds.push_back(it->second->bounds);
         shapeAnnotations.erase(it);
     } else {
         assert(false); // Should never happen
@@ -166,13 +219,32 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
         boost::geometry::index::intersects(tileBounds),
         boost::make_function_output_iterator([&](const auto& val) { val->updateLayer(tileID, *pointLayer); }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
+    std::vector<AnnotationID> shapeIDs;
+    for (const auto& bounds : tileQueryBounds(tileID)) {
+        shapeTree.query(
+            boost::geometry::index::intersects(bounds),
+            boost::make_function_output_iterator([&](const auto& val) { shapeIDs.push_back(val.second); }));
+    }
+    // Visit the shapes in order, once each, even if they showed up in more than one world copy
+    std::sort(shapeIDs.begin(), shapeIDs.end());
+    shapeIDs.erase(std::unique(shapeIDs.begin(), shapeIDs.end()), shapeIDs.end());
+
+    for (const auto& shapeID : shapeIDs) {
+        shapeAnnotations.at(shapeID)->updateTileData(tileID, *tileData);
     }
 
     return tileData;
 }
 
+bool AnnotationManager::isTileDirty(const CanonicalTileID& tileID) const {
+    const auto tileBounds = tileQueryBounds(tileID);
+    return std::any_of(dirtyBounds.begin(), dirtyBounds.end(), [&](const LatLngBounds& dirtyArea) {
+        return std::any_of(tileBounds.begin(), tileBounds.end(), [&](const LatLngBounds& bounds) {
+            return boost::geometry::intersects(bounds, dirtyArea);
+        });
+    });
+}
+
 void AnnotationManager::updateStyle() {
     // Create annotation source, point layer, and point bucket. We do everything
     // via Style::Impl because we don't want annotation mutations to trigger
@@ -215,9 +287,12 @@ void AnnotationManager::updateData() {
     std::lock_guard<std::mutex> lock(mutex);
     if (dirty) {
         for (auto& tile : tiles) {
-            tile->setData(getTileData(tile->id.canonical));
+            if (isTileDirty(tile->id.canonical)) {
+                tile->setData(getTileData(tile->id.canonical));
+            }
         }
         dirty = false;
+        dirtyBounds.clear();
     }
 }
 
@@ -66,17 +66,23 @@ private:
     void updateStyle();
 
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
+    bool isTileDirty(const CanonicalTileID&) const;
 
     std::reference_wrapper<style::Style> style;
 
     std::mutex mutex;
 
     bool dirty = false;
+    // The areas changed since the last update, only the tiles overlapping them are updated
+    std::vector<LatLngBounds> dirtyBounds;
 
     AnnotationID nextID = 0;
 
     using SymbolAnnotationTree = boost::geometry::index::rtree<std::shared_ptr<const SymbolAnnotationImpl>,
                                                                boost::geometry::index::rstar<16, 4>>;
+    // Shapes are indexed by their bounds, so that a tile only visits the shapes it may show
+    using ShapeAnnotationTree = boost::geometry::index::rtree<std::pair<LatLngBounds, AnnotationID>,
+                                                              boost::geometry::index::rstar<16, 4>>;
     // Unlike std::unordered_map, std::map is guaranteed to sort by
     // AnnotationID, ensuring that older annotations are below newer
     // annotations. <https://github.com/mapbox/mapbox-gl-native/issues/5691>
@@ -85,6 +91,7 @@ private:
     using ImageMap = std::unordered_map<std::string, style::Image>;
 
     SymbolAnnotationTree symbolTree;
+    ShapeAnnotationTree shapeTree;
     SymbolAnnotationMap symbolAnnotations;
     ShapeAnnotationMap shapeAnnotations;
     ImageMap images;
@@ -8,7 +8,7 @@ namespace mbgl {
 using namespace style;
 
 FillAnnotationImpl::FillAnnotationImpl(AnnotationID id_, FillAnnotation annotation_)
-    : ShapeAnnotationImpl(id_),
+    : ShapeAnnotationImpl(id_, annotation_.geometry),
       annotation(ShapeAnnotationGeometry::visit(annotation_.geometry, CloseShapeAnnotation{}),
                  annotation_.opacity,
                  annotation_.color,
@@ -8,7 +8,7 @@ namespace mbgl {
 using namespace style;
 
 LineAnnotationImpl::LineAnnotationImpl(AnnotationID id_, LineAnnotation annotation_)
-    : ShapeAnnotationImpl(id_),
+    : ShapeAnnotationImpl(id_, annotation_.geometry),
       annotation(ShapeAnnotationGeometry::visit(annotation_.geometry, CloseShapeAnnotation{}),
                  annotation_.opacity,
                  annotation_.width,
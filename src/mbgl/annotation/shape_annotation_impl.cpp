@@ -8,13 +8,31 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <mapbox/geometry/envelope.hpp>
+
 namespace mbgl {
 
 using namespace style;
 
-ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_)
+namespace {
+
+LatLngBounds shapeBounds(const ShapeAnnotationGeometry& geometry) {
+    const auto box = ShapeAnnotationGeometry::visit(geometry,
+                                                    [](const auto& geom) { return mapbox::geometry::envelope(geom); });
+    if (box.min.x > box.max.x) {
+        // An empty shape isn't in any tile, so any bounds will do
+        return LatLngBounds::singleton({});
+    }
+    return LatLngBounds::hull({util::clamp(box.min.y, -90.0, 90.0), box.min.x},
+                              {util::clamp(box.max.y, -90.0, 90.0), box.max.x});
+}
+
+} // namespace
+
+ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const ShapeAnnotationGeometry& geometry_)
     : id(id_),
-      layerID(AnnotationManager::ShapeLayerID + util::toString(id)) {}
+      layerID(AnnotationManager::ShapeLayerID + util::toString(id)),
+      bounds(shapeBounds(geometry_)) {}
 
 void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
     static const double baseTolerance = 4;
@@ -27,7 +45,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         // The annotation source is currently hard coded to maxzoom 16, so we're
         // topping out at z16 here as well.
         options.maxZoom = 16;
-        options.buffer = 255u;
+        options.buffer = tileBuffer;
         options.extent = util::EXTENT;
         options.tolerance = baseTolerance;
         shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
@@ -4,6 +4,7 @@
 #include <mapbox/geojsonvt.hpp>
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/style/style.hpp>
 
@@ -17,7 +18,7 @@ class CanonicalTileID;
 
 class ShapeAnnotationImpl {
 public:
-    ShapeAnnotationImpl(AnnotationID);
+    ShapeAnnotationImpl(AnnotationID, const ShapeAnnotationGeometry&);
     virtual ~ShapeAnnotationImpl() = default;
 
     virtual void updateStyle(style::Style::Impl &) const = 0;
@@ -25,8 +26,13 @@ public:
 
     void updateTileData(const CanonicalTileID &, AnnotationTileData &);
 
+    /// Buffer around each tile, in tile units, within which the shape is included in the tile
+    static constexpr uint16_t tileBuffer = 255;
+
     const AnnotationID id;
     const std::string layerID;
+    /// Bounds of the geometry, used to find the tiles that show the shape
+    const LatLngBounds bounds;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
 };
 
@@ -1,6 +1,9 @@
 #include <mbgl/geometry/dem_data.hpp>
 #include <mbgl/math/clamp.hpp>
 
+#include <cstring>
+#include <stdexcept>
+
 namespace mbgl {
 
 DEMData::DEMData(const PremultipliedImage& _image, Tileset::DEMEncoding _encoding)
@@ -8,18 +11,10 @@ DEMData::DEMData(const PremultipliedImage& _image, Tileset::DEMEncoding _encodin
       // extra two pixels per row for border backfilling on either edge
       stride(dim + 2),
       encoding(_encoding) {
-    image = std::make_shared<PremultipliedImage>(Size(static_cast<uint32_t>(stride), static_cast<uint32_t>(stride)));
     if (_image.size.height != _image.size.width) {
         throw std::runtime_error("raster-dem tiles must be square.");
     }
-
-    auto* dest = reinterpret_cast<uint32_t*>(image->data.get()) + stride + 1;
-    auto* source = reinterpret_cast<uint32_t*>(_image.data.get());
-    for (int32_t y = 0; y < dim; y++) {
-        memcpy(dest, source, dim * 4);
-        dest += stride;
-        source += dim;
-    }
+    image = std::make_shared<PremultipliedImage>(Size(static_cast<uint32_t>(stride), static_cast<uint32_t>(stride)));
 
     // in order to avoid flashing seams between tiles, here we are initially
     // populating a 1px border of pixels around the image with the data of the
@@ -27,20 +22,23 @@ DEMData::DEMData(const PremultipliedImage& _image, Tileset::DEMEncoding _encodin
     // tile's neighboring tiles are loaded and the accurate data can be
     // backfilled using DEMData#backfillBorder
 
+    // Each row is copied along with its left and right border pixels while it
+    // is still in cache, rather than filling the vertical borders in a second
+    // pass over the whole image.
     auto* data = reinterpret_cast<uint32_t*>(image->data.get());
-    for (int32_t x = 0; x < dim; x++) {
-        auto rowOffset = stride * (x + 1);
-        // left vertical border
-        data[rowOffset] = data[rowOffset + 1];
-
-        // right vertical border
-        data[rowOffset + dim + 1] = data[rowOffset + dim];
+    const auto* source = reinterpret_cast<const uint32_t*>(_image.data.get());
+    for (int32_t y = 0; y < dim; y++) {
+        uint32_t* row = data + (y + 1) * stride;
+        std::memcpy(row + 1, source, dim * sizeof(uint32_t));
+        row[0] = source[0];
+        row[dim + 1] = source[dim - 1];
+        source += dim;
     }
 
     // top horizontal border with corners
-    memcpy(data, data + stride, stride * 4);
+    std::memcpy(data, data + stride, stride * sizeof(uint32_t));
     // bottom horizontal border with corners
-    memcpy(data + (dim + 1) * stride, data + dim * stride, stride * 4);
+    std::memcpy(data + (dim + 1) * stride, data + dim * stride, stride * sizeof(uint32_t));
 }
 
 // This function takes the DEMData from a neighboring tile and backfills the
@@ -78,12 +76,13 @@ void DEMData::backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy
     int32_t oy = -dy * dim;
 
     auto* dest = reinterpret_cast<uint32_t*>(image->data.get());
-    auto* source = reinterpret_cast<uint32_t*>(o.image->data.get());
+    const auto* source = reinterpret_cast<const uint32_t*>(o.image->data.get());
 
+    // Rows of the range are contiguous in both images: the top and bottom edges
+    // are a single copy, the left and right edges one pixel per row.
+    const auto width = static_cast<size_t>(xMax - xMin);
     for (int32_t y = yMin; y < yMax; y++) {
-        for (int32_t x = xMin; x < xMax; x++) {
-            dest[idx(x, y)] = source[idx(x + ox, y + oy)];
-        }
+        std::memcpy(dest + idx(xMin, y), source + idx(xMin + ox, y + oy), width * sizeof(uint32_t));
     }
 }
 
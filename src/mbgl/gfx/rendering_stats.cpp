@@ -19,7 +19,10 @@ bool RenderingStats::isZero() const {
                                 memBuffers,
                                 memIndexBuffers,
                                 memVertexBuffers,
-                                memUniformBuffers};
+                                memUniformBuffers,
+                                numArenaBuffers,
+                                memArenaUsed,
+                                memArenaFragmented};
     return std::all_of(expectedZeros.begin(), expectedZeros.end(), [](auto x) { return x == 0; });
 }
 
@@ -27,6 +30,7 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     numFrames += r.numFrames;
     numDrawCalls += r.numDrawCalls;
     totalDrawCalls += r.totalDrawCalls;
+    numDrawRanges += r.numDrawRanges;
     numCreatedTextures += r.numCreatedTextures;
     numActiveTextures += r.numActiveTextures;
     numTextureBindings += r.numTextureBindings;
@@ -51,6 +55,15 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     memIndexBuffers += r.memIndexBuffers;
     memVertexBuffers += r.memVertexBuffers;
     memUniformBuffers += r.memUniformBuffers;
+    numArenaBuffers += r.numArenaBuffers;
+    memArenaUsed += r.memArenaUsed;
+    memArenaFragmented += r.memArenaFragmented;
+    memAtlases += r.memAtlases;
+    atlasUploadBytes += r.atlasUploadBytes;
+    numProgramBinaryHits += r.numProgramBinaryHits;
+    numProgramBinaryMisses += r.numProgramBinaryMisses;
+    numCreatedPipelines += r.numCreatedPipelines;
+    placementTime += r.placementTime;
     stencilClears += r.stencilClears;
     stencilUpdates += r.stencilUpdates;
     return *this;
@@ -69,6 +82,7 @@ std::string RenderingStats::toString(std::string_view sep) const {
     optionalStatLine(ss, numFrames, "numFrames", sep);
     optionalStatLine(ss, numDrawCalls, "numDrawCalls", sep);
     optionalStatLine(ss, totalDrawCalls, "totalDrawCalls", sep);
+    optionalStatLine(ss, numDrawRanges, "numDrawRanges", sep);
     optionalStatLine(ss, numCreatedTextures, "numCreatedTextures", sep);
     optionalStatLine(ss, numActiveTextures, "numActiveTextures", sep);
     optionalStatLine(ss, numTextureBindings, "numTextureBindings", sep);
@@ -93,6 +107,15 @@ std::string RenderingStats::toString(std::string_view sep) const {
     optionalStatLine(ss, memIndexBuffers, "memIndexBuffers", sep);
     optionalStatLine(ss, memVertexBuffers, "memVertexBuffers", sep);
     optionalStatLine(ss, memUniformBuffers, "memUniformBuffers", sep);
+    optionalStatLine(ss, numArenaBuffers, "numArenaBuffers", sep);
+    optionalStatLine(ss, memArenaUsed, "memArenaUsed", sep);
+    optionalStatLine(ss, memArenaFragmented, "memArenaFragmented", sep);
+    optionalStatLine(ss, memAtlases, "memAtlases", sep);
+    optionalStatLine(ss, atlasUploadBytes, "atlasUploadBytes", sep);
+    optionalStatLine(ss, numProgramBinaryHits, "numProgramBinaryHits", sep);
+    optionalStatLine(ss, numProgramBinaryMisses, "numProgramBinaryMisses", sep);
+    optionalStatLine(ss, numCreatedPipelines, "numCreatedPipelines", sep);
+    optionalStatLine(ss, placementTime, "placementTime", sep);
     optionalStatLine(ss, stencilClears, "stencilClears", sep);
     optionalStatLine(ss, stencilUpdates, "stencilUpdates", sep);
     return ss.str();
@@ -62,7 +62,7 @@ public:
     template <class Vertex>
     void updateVertexBuffer(VertexBuffer<Vertex>& buffer, const VertexVector<Vertex>& v) {
         assert(v.elements() == buffer.elements);
-        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes());
+        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes(), /*offset=*/0);
     }
 
     template <class DrawMode>
@@ -96,7 +96,11 @@ protected:
                                                                              std::size_t size,
                                                                              BufferUsageType,
                                                                              bool persistent = false) = 0;
-    virtual void updateVertexBufferResource(VertexBufferResource&, const void* data, std::size_t size) = 0;
+    // Writes `size` bytes from `data` into the buffer, starting `offset` bytes in
+    virtual void updateVertexBufferResource(VertexBufferResource&,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) = 0;
 
 public:
     virtual std::unique_ptr<IndexBufferResource> createIndexBufferResource(const void* data,
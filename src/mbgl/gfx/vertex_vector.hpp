@@ -3,7 +3,10 @@
 #include <mbgl/util/ignore.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -23,7 +26,9 @@ public:
           buffer(std::move(other.buffer)),
 #endif // MLN_DRAWABLE_RENDERER
           dirty(other.dirty),
-          released(other.released) {
+          released(other.released),
+          modifiedBegin(other.modifiedBegin),
+          modifiedEnd(other.modifiedEnd) {
     }
     virtual ~VertexVectorBase() = default;
 
@@ -43,9 +48,35 @@ public:
         if (dirty) {
             lastModified = util::MonotonicTimer::now();
             dirty = false;
+            modifiedBegin = 0;
+            modifiedEnd = std::numeric_limits<std::size_t>::max();
         }
     }
 
+    /// Record that the elements in [begin, end) were overwritten in place.  Until the next upload, only the union of
+    /// such ranges needs to be sent to the GPU, unless the vector was also changed as a whole.
+    void updateModified(std::size_t begin, std::size_t end) {
+        if (dirty) {
+            updateModified();
+            return;
+        }
+        modifiedBegin = std::min(modifiedBegin, begin);
+        modifiedEnd = std::max(modifiedEnd, end);
+        lastModified = util::MonotonicTimer::now();
+    }
+
+    /// The range of elements changed since the last upload, clamped to the current size
+    std::pair<std::size_t, std::size_t> getModifiedRange() const {
+        const auto end = std::min(modifiedEnd, getRawCount());
+        return {std::min(modifiedBegin, end), end};
+    }
+
+    /// Called once the modified range has been uploaded
+    void resetModifiedRange() {
+        modifiedBegin = std::numeric_limits<std::size_t>::max();
+        modifiedEnd = 0;
+    }
+
     // Indicates that the owner/producer will not modify this again
     bool isReleased() const { return released; }
 
@@ -56,6 +87,10 @@ protected:
     bool dirty = true;
     bool released = false;
 
+    // Elements changed since the last upload, everything until a buffer is first created
+    std::size_t modifiedBegin = 0;
+    std::size_t modifiedEnd = std::numeric_limits<std::size_t>::max();
+
     std::chrono::duration<double> lastModified = util::MonotonicTimer::now();
 };
 using VertexVectorBasePtr = std::shared_ptr<VertexVectorBase>;
@@ -98,6 +133,14 @@ public:
         return v.at(n);
     }
 
+    /// Overwrite the elements in [begin, end) without changing the size, so that only they are uploaded again
+    void fill(std::size_t begin, std::size_t end, const Vertex& value) {
+        assert(begin <= end && end <= v.size());
+        assert(!released);
+        std::fill(v.begin() + begin, v.begin() + end, value);
+        updateModified(begin, end);
+    }
+
     std::size_t elements() const { return v.size(); }
 
     std::size_t bytes() const { return v.size() * sizeof(Vertex); }
@@ -0,0 +1,319 @@
+#include <mbgl/gl/buffer_arena.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/util/instrumentation.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <optional>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+// Ranges start on this boundary, which satisfies the alignment of any vertex attribute or index type
+constexpr std::size_t rangeAlignment = 16;
+
+// Empty pages kept for reuse, so that a tile being replaced doesn't release and re-create a page
+constexpr std::size_t maxFreePages = 1;
+
+std::size_t alignSize(std::size_t size) {
+    return (size + rangeAlignment - 1) & ~(rangeAlignment - 1);
+}
+
+} // namespace
+
+struct BufferRange::Page {
+    UniqueBuffer buffer;
+
+    // Free ranges by offset. Adjacent free ranges are always merged.
+    std::map<std::size_t, std::size_t> freeRanges;
+
+    // Bytes held by live ranges and those waiting to be reclaimed
+    std::size_t used = 0;
+
+    Page(UniqueBuffer&& buffer_, std::size_t size)
+        : buffer(std::move(buffer_)),
+          freeRanges{{0, size}} {}
+
+    std::optional<std::size_t> take(std::size_t size) {
+        const auto it = std::find_if(
+            freeRanges.begin(), freeRanges.end(), [&](const auto& range) { return range.second >= size; });
+        if (it == freeRanges.end()) {
+            return std::nullopt;
+        }
+        const auto [offset, available] = *it;
+        freeRanges.erase(it);
+        if (available > size) {
+            freeRanges.emplace(offset + size, available - size);
+        }
+        used += size;
+        return offset;
+    }
+};
+
+BufferRange::BufferRange(BufferRange&& other) noexcept
+    : arena(other.arena),
+      page(other.page),
+      offset(other.offset),
+      size(other.size) {
+    other.arena = nullptr;
+    other.page = nullptr;
+}
+
+BufferRange& BufferRange::operator=(BufferRange&& other) noexcept {
+    if (this != &other) {
+        if (arena) {
+            arena->release(*page, offset, size);
+        }
+        arena = other.arena;
+        page = other.page;
+        offset = other.offset;
+        size = other.size;
+        other.arena = nullptr;
+        other.page = nullptr;
+    }
+    return *this;
+}
+
+BufferRange::~BufferRange() {
+    if (arena) {
+        arena->release(*page, offset, size);
+    }
+}
+
+BufferID BufferRange::getBufferID() const {
+    return page ? page->buffer.get() : 0;
+}
+
+BufferArena::BufferArena(Context& context_, GLenum target_, std::size_t pageSize_)
+    : context(context_),
+      target(target_),
+      pageSize(pageSize_) {
+    assert(target == GL_ARRAY_BUFFER || target == GL_ELEMENT_ARRAY_BUFFER);
+}
+
+BufferArena::~BufferArena() {
+    // The buffers are going away, so there's no need to wait for the draw calls using them
+    for (const auto& range : released) {
+        recycle(range);
+    }
+    for (const auto& frame : pending) {
+        for (const auto& range : frame.ranges) {
+            recycle(range);
+        }
+    }
+    released.clear();
+    pending.clear();
+
+    releaseEmptyPages(0);
+    assert(pages.empty());
+    updateStats();
+}
+
+BufferRange BufferArena::allocate(const void* data, std::size_t size) {
+    MLN_TRACE_FUNC();
+
+    if (size == 0 || size > maxAllocationSize()) {
+        return {};
+    }
+    const auto alignedSize = alignSize(size);
+
+    Page* page = currentPage;
+    std::optional<std::size_t> offset = page ? page->take(alignedSize) : std::nullopt;
+
+    if (!offset) {
+        // Fill the fullest pages first, so that the emptier ones can drain
+        std::vector<Page*> candidates;
+        candidates.reserve(pages.size());
+        for (const auto& candidate : pages) {
+            if (candidate.get() != currentPage && pageSize - candidate->used >= alignedSize) {
+                candidates.push_back(candidate.get());
+            }
+        }
+        std::sort(
+            candidates.begin(), candidates.end(), [](const Page* a, const Page* b) { return a->used > b->used; });
+        for (auto* candidate : candidates) {
+            if ((offset = candidate->take(alignedSize))) {
+                page = candidate;
+                break;
+            }
+        }
+    }
+
+    if (!offset) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        // NOLINTNEXTLINE(performance-move-const-arg)
+        UniqueBuffer buffer{std::move(id), {context}};
+        bind(buffer.get());
+        MBGL_CHECK_ERROR(glBufferData(target, pageSize, nullptr, GL_STATIC_DRAW));
+
+        auto& stats = context.renderingStats();
+        stats.numBuffers++;
+        stats.numArenaBuffers++;
+        if (target == GL_ARRAY_BUFFER) {
+            MLN_TRACE_ALLOC_VERTEX_BUFFER(buffer.get(), pageSize);
+            stats.memVertexBuffers += static_cast<int>(pageSize);
+        } else {
+            MLN_TRACE_ALLOC_INDEX_BUFFER(buffer.get(), pageSize);
+            stats.memIndexBuffers += static_cast<int>(pageSize);
+        }
+
+        pages.push_back(std::make_unique<Page>(std::move(buffer), pageSize));
+        page = pages.back().get();
+        offset = page->take(alignedSize);
+        assert(offset);
+    }
+
+    currentPage = page;
+    context.renderingStats().memArenaUsed += static_cast<int>(alignedSize);
+    statsDirty = true;
+
+    BufferRange range{*this, *page, *offset, alignedSize};
+    if (data) {
+        update(range, data, size, 0);
+    }
+    return range;
+}
+
+void BufferArena::update(const BufferRange& range, const void* data, std::size_t size, std::size_t offset) {
+    MLN_TRACE_FUNC();
+
+    assert(range.arena == this);
+    assert(offset + size <= range.size);
+    bind(range.getBufferID());
+    MBGL_CHECK_ERROR(glBufferSubData(target, range.offset + offset, size, data));
+}
+
+void BufferArena::reclaim(const std::shared_ptr<Fence>& frameFence) {
+    MLN_TRACE_FUNC();
+
+    if (!released.empty()) {
+        if (frameFence) {
+            pending.push_back({std::move(released), frameFence});
+        } else {
+            // No frame has been drawn yet
+            for (const auto& range : released) {
+                recycle(range);
+            }
+        }
+        released.clear();
+    }
+
+    // Frames complete in order, so stop at the first one still in flight
+    auto it = pending.begin();
+    for (; it != pending.end() && it->frameFence->isSignaled(); ++it) {
+        for (const auto& range : it->ranges) {
+            recycle(range);
+        }
+    }
+    pending.erase(pending.begin(), it);
+
+    releaseEmptyPages(maxFreePages);
+
+    if (statsDirty) {
+        updateStats();
+    }
+}
+
+void BufferArena::shrink() {
+    MLN_TRACE_FUNC();
+
+    releaseEmptyPages(0);
+    updateStats();
+}
+
+void BufferArena::release(Page& page, std::size_t offset, std::size_t size) {
+    released.push_back({&page, offset, size});
+}
+
+void BufferArena::recycle(const ReleasedRange& range) {
+    auto& ranges = range.page->freeRanges;
+    auto offset = range.offset;
+    auto size = range.size;
+
+    // Merge with the free neighbors
+    const auto next = ranges.lower_bound(offset);
+    if (next != ranges.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            ranges.erase(prev);
+        }
+    }
+    if (next != ranges.end() && offset + size == next->first) {
+        size += next->second;
+        ranges.erase(next);
+    }
+    ranges.emplace(offset, size);
+
+    assert(range.page->used >= range.size);
+    range.page->used -= range.size;
+    context.renderingStats().memArenaUsed -= static_cast<int>(range.size);
+    statsDirty = true;
+}
+
+void BufferArena::bind(BufferID id) {
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        // Don't change the index buffer of whichever vertex array object is bound
+        context.bindVertexArray = 0;
+        context.globalVertexArrayState.indexBuffer = id;
+    } else {
+        context.vertexBuffer = id;
+    }
+}
+
+void BufferArena::releaseEmptyPages(std::size_t keep) {
+    std::size_t empty = 0;
+    for (auto it = pages.begin(); it != pages.end();) {
+        auto& page = **it;
+        if (page.used > 0 || ++empty <= keep) {
+            ++it;
+            continue;
+        }
+
+        auto& stats = context.renderingStats();
+        stats.numArenaBuffers--;
+        if (target == GL_ARRAY_BUFFER) {
+            MLN_TRACE_FREE_VERTEX_BUFFER(page.buffer.get());
+            stats.memVertexBuffers -= static_cast<int>(pageSize);
+        } else {
+            MLN_TRACE_FREE_INDEX_BUFFER(page.buffer.get());
+            stats.memIndexBuffers -= static_cast<int>(pageSize);
+        }
+
+        if (currentPage == &page) {
+            currentPage = nullptr;
+        }
+        it = pages.erase(it);
+        statsDirty = true;
+    }
+}
+
+void BufferArena::updateStats() {
+    // Free space outside of the largest free range of each page can only be used by smaller allocations
+    std::size_t fragmented = 0;
+    for (const auto& page : pages) {
+        std::size_t total = 0;
+        std::size_t largest = 0;
+        for (const auto& range : page->freeRanges) {
+            total += range.second;
+            largest = std::max(largest, range.second);
+        }
+        fragmented += total - largest;
+    }
+
+    auto& stats = context.renderingStats();
+    stats.memArenaFragmented += static_cast<int>(fragmented) - static_cast<int>(fragmentedBytes);
+    fragmentedBytes = fragmented;
+    statsDirty = false;
+}
+
+} // namespace gl
+} // namespace mbgl
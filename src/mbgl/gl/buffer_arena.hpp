@@ -0,0 +1,123 @@
+#pragma once
+
+#include <mbgl/gl/fence.hpp>
+#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/types.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+class BufferArena;
+
+/// A range of a buffer shared through a `BufferArena`, released back to the arena on destruction.
+class BufferRange {
+public:
+    BufferRange() = default;
+    BufferRange(BufferRange&&) noexcept;
+    BufferRange& operator=(BufferRange&&) noexcept;
+    ~BufferRange();
+
+    BufferRange(const BufferRange&) = delete;
+    BufferRange& operator=(const BufferRange&) = delete;
+
+    explicit operator bool() const { return page != nullptr; }
+
+    BufferID getBufferID() const;
+    /// Offset of the range within its buffer, in bytes
+    std::size_t getOffset() const { return offset; }
+    std::size_t getSize() const { return size; }
+
+private:
+    friend class BufferArena;
+    struct Page;
+
+    BufferRange(BufferArena& arena_, Page& page_, std::size_t offset_, std::size_t size_)
+        : arena(&arena_),
+          page(&page_),
+          offset(offset_),
+          size(size_) {}
+
+    BufferArena* arena = nullptr;
+    Page* page = nullptr;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+};
+
+/// @brief Sub-allocates vertex or index data from large shared buffers ("pages"), so that the
+/// drawables uploaded together, typically those of one tile layer, share a buffer object.
+///
+/// Ranges are never moved once allocated, because vertex array objects capture their offsets.
+/// Released ranges are held until the fence of the last frame that could have drawn from them is
+/// signaled, and are then merged with their free neighbors. New allocations prefer the page that
+/// was last allocated from, then the fullest pages, so that sparsely used pages drain and are
+/// released once empty.
+class BufferArena : private util::noncopyable {
+public:
+    /// @param target `GL_ARRAY_BUFFER` or `GL_ELEMENT_ARRAY_BUFFER`
+    BufferArena(Context&, GLenum target, std::size_t pageSize);
+    ~BufferArena();
+
+    /// Allocations larger than this get their own buffer
+    std::size_t maxAllocationSize() const { return pageSize / 4; }
+
+    /// Allocate a range and upload its contents
+    /// @return An empty range if the size exceeds `maxAllocationSize()`
+    BufferRange allocate(const void* data, std::size_t size);
+
+    /// Update part of a range
+    void update(const BufferRange&, const void* data, std::size_t size, std::size_t offset);
+
+    /// Return the ranges released since the last call, which may still be used by the draw calls
+    /// issued before `frameFence`, and recycle the ones whose fences have been signaled.
+    void reclaim(const std::shared_ptr<Fence>& frameFence);
+
+    /// Release all the empty pages
+    void shrink();
+
+    std::size_t numPages() const { return pages.size(); }
+
+private:
+    friend class BufferRange;
+    using Page = BufferRange::Page;
+
+    struct ReleasedRange {
+        Page* page;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    struct PendingRelease {
+        std::vector<ReleasedRange> ranges;
+        std::shared_ptr<Fence> frameFence;
+    };
+
+    void release(Page&, std::size_t offset, std::size_t size);
+    void recycle(const ReleasedRange&);
+    void bind(BufferID);
+    void releaseEmptyPages(std::size_t keep);
+    void updateStats();
+
+    Context& context;
+    const GLenum target;
+    const std::size_t pageSize;
+
+    std::vector<std::unique_ptr<Page>> pages;
+    Page* currentPage = nullptr;
+
+    // Ranges released during the current frame, and those waiting for their frame to complete
+    std::vector<ReleasedRange> released;
+    std::vector<PendingRelease> pending;
+
+    std::size_t fragmentedBytes = 0;
+    bool statsDirty = false;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -11,7 +11,10 @@
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/offscreen_texture.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
+#include <mbgl/gl/multi_draw_extension.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
 #include <mbgl/gl/timestamp_query_extension.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
@@ -97,6 +100,11 @@ Context::Context(RendererBackend& backend_)
       backend(backend_) {
 #if MLN_DRAWABLE_RENDERER
     uboAllocator = std::make_unique<gl::UniformBufferAllocator>();
+
+    constexpr std::size_t vertexPageSize = 1024 * 1024;
+    constexpr std::size_t indexPageSize = 256 * 1024;
+    vertexArena = std::make_unique<BufferArena>(*this, GL_ARRAY_BUFFER, vertexPageSize);
+    indexArena = std::make_unique<BufferArena>(*this, GL_ELEMENT_ARRAY_BUFFER, indexPageSize);
 #endif
 
     texturePool = std::make_unique<Texture2DPool>(this);
@@ -106,6 +114,10 @@ Context::~Context() noexcept {
     if (cleanupOnDestruction) {
         backend.getThreadPool().runRenderJobs(true /* closeQueue */);
 
+        // Release the shared buffers before the abandoned ones are deleted
+        vertexArena.reset();
+        indexArena.reset();
+
         reset();
 
         // Delete all pooled resources while the context is still valid
@@ -124,6 +136,10 @@ void Context::beginFrame() {
     backend.getThreadPool().runRenderJobs();
 
 #if MLN_DRAWABLE_RENDERER
+    // Ranges of shared buffers released since the last frame may still be used by its draw calls
+    vertexArena->reclaim(frameInFlightFence);
+    indexArena->reclaim(frameInFlightFence);
+
     frameInFlightFence = std::make_shared<gl::Fence>();
 
     // Run allocator defragmentation on this frame interval.
@@ -176,14 +192,47 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
             debugging = std::make_unique<extension::Debugging>(fn);
         }
 
+        multiDraw = std::make_unique<extension::MultiDraw>(fn);
+        if (!multiDraw->multiDrawElementsBaseVertex) {
+            multiDraw.reset();
+        }
+
 // Currently GL timestamp queries are only used when Tracy profiling is enabled
 #ifdef MLN_TRACY_ENABLE
         extension::loadTimeStampQueryExtension(fn);
 #endif
     }
+
+    initializeProgramBinaryCache();
+
     MLN_TRACE_GL_CONTEXT();
 }
 
+void Context::initializeProgramBinaryCache() {
+    const auto setting = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH);
+    const auto* directory = setting.getString();
+    if (!directory || directory->empty()) {
+        return;
+    }
+
+    GLint numFormats = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats));
+    if (numFormats <= 0) {
+        Log::Info(Event::OpenGL, "Program binaries aren't supported, shaders will always be compiled");
+        return;
+    }
+
+    // Binaries are only valid for the driver that made them
+    std::string driver;
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        if (const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)))) {
+            driver.append(value);
+        }
+        driver.append("\n");
+    }
+    programBinaries = std::make_unique<ProgramBinaryCache>(*directory, std::move(driver));
+}
+
 void Context::enableDebugging() {
     if (!debugging || !debugging->debugMessageControl || !debugging->debugMessageCallback) {
         return;
@@ -239,11 +288,90 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     // AttributeLocations::getFirstAttribName.
     MBGL_CHECK_ERROR(glBindAttribLocation(result, 0, location0AttribName));
 
+    if (programBinaries) {
+        // Drivers may not keep what's needed by `glGetProgramBinary` unless asked before linking
+        MBGL_CHECK_ERROR(glProgramParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     linkProgram(result);
 
     return result;
 }
 
+UniqueProgram Context::createProgram(const std::initializer_list<const char*>& vertexSources,
+                                     const std::initializer_list<const char*>& fragmentSources,
+                                     const char* location0AttribName) {
+    MLN_TRACE_FUNC();
+
+    std::optional<std::uint64_t> key;
+    if (programBinaries) {
+        key = programBinaries->makeKey(vertexSources, fragmentSources, location0AttribName);
+        if (auto program = loadProgramBinary(*key)) {
+            stats.numProgramBinaryHits++;
+            return std::move(*program);
+        }
+        stats.numProgramBinaryMisses++;
+    }
+
+    // throws on compile or link error
+    auto program = createProgram(createShader(ShaderType::Vertex, vertexSources),
+                                 createShader(ShaderType::Fragment, fragmentSources),
+                                 location0AttribName);
+    if (key) {
+        storeProgramBinary(program, *key);
+    }
+    return program;
+}
+
+std::optional<UniqueProgram> Context::loadProgramBinary(const std::uint64_t key) {
+    MLN_TRACE_FUNC();
+
+    const auto binary = programBinaries->load(key);
+    if (!binary) {
+        return std::nullopt;
+    }
+
+    UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
+
+    // Not checked with `MBGL_CHECK_ERROR`, a format the driver no longer accepts isn't fatal
+    glProgramBinary(result, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size()));
+    const bool accepted = glGetError() == GL_NO_ERROR;
+
+    GLint status = GL_FALSE;
+    if (accepted) {
+        MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+    }
+    if (status != GL_TRUE) {
+        // Drivers reject binaries after updates that don't change their version string, rebuild it from source
+        Log::Warning(Event::OpenGL, "Discarding program binary rejected by the driver");
+        programBinaries->remove(key);
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+void Context::storeProgramBinary(const ProgramID program, const std::uint64_t key) {
+    MLN_TRACE_FUNC();
+
+    GLint length = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) {
+        return;
+    }
+
+    ProgramBinaryCache::Binary binary;
+    binary.data.resize(length);
+    GLsizei written = 0;
+    MBGL_CHECK_ERROR(glGetProgramBinary(program, length, &written, &binary.format, binary.data.data()));
+    if (written <= 0) {
+        return;
+    }
+    binary.data.resize(written);
+
+    programBinaries->store(key, binary);
+}
+
 void Context::linkProgram(ProgramID program_) {
     MLN_TRACE_FUNC();
 
@@ -713,6 +841,7 @@ void Context::clear(std::optional<mbgl::Color> color, std::optional<float> depth
     MBGL_CHECK_ERROR(glClear(mask));
 
     stats.numDrawCalls = 0;
+    stats.numDrawRanges = 0;
 }
 
 void Context::setCullFaceMode(const gfx::CullFaceMode& mode) {
@@ -799,10 +928,7 @@ std::shared_ptr<gl::Fence> Context::getCurrentFrameFence() const {
 }
 #endif
 
-void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::size_t indexLength) {
-    MLN_TRACE_FUNC();
-    MLN_TRACE_FUNC_GL();
-
+void Context::setDrawMode(const gfx::DrawMode& drawMode) {
     switch (drawMode.type) {
         case gfx::DrawModeType::Points:
             break;
@@ -814,6 +940,13 @@ void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::
         default:
             break;
     }
+}
+
+void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::size_t indexLength) {
+    MLN_TRACE_FUNC();
+    MLN_TRACE_FUNC_GL();
+
+    setDrawMode(drawMode);
 
     MBGL_CHECK_ERROR(glDrawElements(Enum<gfx::DrawModeType>::to(drawMode.type),
                                     static_cast<GLsizei>(indexLength),
@@ -821,6 +954,29 @@ void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::
                                     reinterpret_cast<GLvoid*>(sizeof(uint16_t) * indexOffset)));
 
     stats.numDrawCalls++;
+    stats.numDrawRanges++;
+}
+
+void Context::draw(const gfx::DrawMode& drawMode,
+                   const GLsizei* indexLengths,
+                   const GLvoid* const* indexOffsets,
+                   const GLint* vertexOffsets,
+                   std::size_t drawCount) {
+    MLN_TRACE_FUNC();
+    MLN_TRACE_FUNC_GL();
+
+    assert(multiDraw);
+    setDrawMode(drawMode);
+
+    MBGL_CHECK_ERROR(multiDraw->multiDrawElementsBaseVertex(Enum<gfx::DrawModeType>::to(drawMode.type),
+                                                            indexLengths,
+                                                            GL_UNSIGNED_SHORT,
+                                                            indexOffsets,
+                                                            static_cast<GLsizei>(drawCount),
+                                                            vertexOffsets));
+
+    stats.numDrawCalls++;
+    stats.numDrawRanges += static_cast<int>(drawCount);
 }
 
 void Context::performCleanup() {
@@ -909,6 +1065,13 @@ void Context::reduceMemoryUsage() {
     MLN_TRACE_FUNC();
     MLN_TRACE_FUNC_GL();
 
+    if (vertexArena) {
+        vertexArena->shrink();
+    }
+    if (indexArena) {
+        indexArena->shrink();
+    }
+
     performCleanup();
     assert(texturePool);
     texturePool->shrink();
@@ -6,6 +6,7 @@
 #include <mbgl/gfx/stencil_mode.hpp>
 #include <mbgl/gfx/color_mode.hpp>
 #include <mbgl/gfx/context.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/gl/object.hpp>
 #include <mbgl/gl/state.hpp>
 #include <mbgl/gl/value.hpp>
@@ -24,7 +25,9 @@
 #endif
 
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <optional>
 #include <vector>
 
 namespace mbgl {
@@ -32,10 +35,12 @@ namespace gl {
 
 using ProcAddress = void (*)();
 class RendererBackend;
+class ProgramBinaryCache;
 
 namespace extension {
 class VertexArray;
 class Debugging;
+class MultiDraw;
 } // namespace extension
 
 class Context final : public gfx::Context {
@@ -58,6 +63,11 @@ public:
 
     UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
     UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    /// Compile and link a program, or load it from the program binary cache if one is configured with
+    /// `platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH`.
+    UniqueProgram createProgram(const std::initializer_list<const char*>& vertexSources,
+                                const std::initializer_list<const char*>& fragmentSources,
+                                const char* location0AttribName);
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture(const Size& size, gfx::TexturePixelType format, gfx::TextureChannelDataType type);
@@ -87,6 +97,14 @@ public:
 
     void draw(const gfx::DrawMode&, std::size_t indexOffset, std::size_t indexLength);
 
+    /// Draw several ranges of the bound index buffer with a single call.
+    /// Requires the multi-draw extension, see `getMultiDrawExtension`.
+    void draw(const gfx::DrawMode&,
+              const GLsizei* indexLengths,
+              const GLvoid* const* indexOffsets,
+              const GLint* vertexOffsets,
+              std::size_t drawCount);
+
     void finish();
 
 #if MLN_DRAWABLE_RENDERER
@@ -115,6 +133,13 @@ public:
     }
 
     extension::Debugging* getDebuggingExtension() const { return debugging.get(); }
+    extension::MultiDraw* getMultiDrawExtension() const { return multiDraw.get(); }
+    /// The program binary cache, if enabled and supported by the driver
+    const ProgramBinaryCache* getProgramBinaryCache() const { return programBinaries.get(); }
+
+    /// Shared buffers for static vertex and index data, if enabled
+    BufferArena* getVertexArena() const { return vertexArena.get(); }
+    BufferArena* getIndexArena() const { return indexArena.get(); }
 
     void setCleanupOnDestruction(bool cleanup) { cleanupOnDestruction = cleanup; }
 
@@ -165,6 +190,8 @@ private:
     bool cleanupOnDestruction = true;
 
     std::unique_ptr<extension::Debugging> debugging;
+    std::unique_ptr<extension::MultiDraw> multiDraw;
+    std::unique_ptr<ProgramBinaryCache> programBinaries;
 #if MLN_DRAWABLE_RENDERER
     std::shared_ptr<gl::Fence> frameInFlightFence;
     std::unique_ptr<gl::UniformBufferAllocator> uboAllocator;
@@ -225,6 +252,10 @@ private:
     std::unique_ptr<gfx::DrawScopeResource> createDrawScopeResource() override;
 
     UniqueFramebuffer createFramebuffer();
+    void setDrawMode(const gfx::DrawMode&);
+    void initializeProgramBinaryCache();
+    std::optional<UniqueProgram> loadProgramBinary(std::uint64_t key);
+    void storeProgramBinary(ProgramID, std::uint64_t key);
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, gfx::TexturePixelType, bool flip);
 
 public:
@@ -249,6 +280,9 @@ private:
 
     std::unique_ptr<Texture2DPool> texturePool;
 
+    std::unique_ptr<BufferArena> vertexArena;
+    std::unique_ptr<BufferArena> indexArena;
+
 public:
 #if !defined(NDEBUG)
 public:
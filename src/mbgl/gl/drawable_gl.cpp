@@ -1,5 +1,6 @@
 #include <mbgl/gl/drawable_gl.hpp>
 #include <mbgl/gl/drawable_gl_impl.hpp>
+#include <mbgl/gl/index_buffer_resource.hpp>
 #include <mbgl/gl/texture2d.hpp>
 #include <mbgl/gl/upload_pass.hpp>
 #include <mbgl/gl/vertex_array.hpp>
@@ -13,6 +14,14 @@
 namespace mbgl {
 namespace gl {
 
+struct IndexBufferGL : public gfx::IndexBufferBase {
+    IndexBufferGL(std::unique_ptr<gfx::IndexBuffer>&& buffer_)
+        : buffer(std::move(buffer_)) {}
+    ~IndexBufferGL() override = default;
+
+    std::unique_ptr<mbgl::gfx::IndexBuffer> buffer;
+};
+
 DrawableGL::DrawableGL(std::string name_)
     : Drawable(std::move(name_)),
       impl(std::make_unique<Impl>()) {}
@@ -63,12 +72,30 @@ void DrawableGL::draw(PaintParameters& parameters) const {
     bindUniformBuffers();
     bindTextures();
 
-    for (const auto& seg : impl->segments) {
-        const auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
-        const auto& mlSeg = glSeg.getSegment();
-        if (mlSeg.indexLength > 0 && glSeg.getVertexArray().isValid()) {
-            context.bindVertexArray = glSeg.getVertexArray().getID();
-            context.draw(glSeg.getMode(), mlSeg.indexOffset, mlSeg.indexLength);
+    // The indexes may be stored in a range of a shared buffer
+    const auto indexBase = impl->indexes && impl->indexes->getBuffer()
+                               ? static_cast<const IndexBufferGL&>(*impl->indexes->getBuffer())
+                                     .buffer->getResource<gl::IndexBufferResource>()
+                                     .getIndexOffset()
+                               : 0;
+
+    if (impl->multiDrawVertexArray.isValid()) {
+        context.bindVertexArray = impl->multiDrawVertexArray.getID();
+        for (const auto& group : impl->multiDrawGroups) {
+            context.draw(group.mode,
+                         group.indexLengths.data(),
+                         group.indexOffsets.data(),
+                         group.vertexOffsets.data(),
+                         group.indexLengths.size());
+        }
+    } else {
+        for (const auto& seg : impl->segments) {
+            const auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
+            const auto& mlSeg = glSeg.getSegment();
+            if (mlSeg.indexLength > 0 && glSeg.getVertexArray().isValid()) {
+                context.bindVertexArray = glSeg.getVertexArray().getID();
+                context.draw(glSeg.getMode(), indexBase + mlSeg.indexOffset, mlSeg.indexLength);
+            }
         }
     }
     // Unbind the VAO so that future buffer commands outside Drawable do not change the current VAO state
@@ -83,6 +110,7 @@ void DrawableGL::draw(PaintParameters& parameters) const {
 void DrawableGL::setIndexData(gfx::IndexVectorBasePtr indexes, std::vector<UniqueDrawSegment> segments) {
     impl->indexes = std::move(indexes);
     impl->segments = std::move(segments);
+    resetMultiDraw();
 }
 
 void DrawableGL::updateVertexAttributes(gfx::VertexAttributeArrayPtr vertices,
@@ -113,6 +141,7 @@ void DrawableGL::updateVertexAttributes(gfx::VertexAttributeArrayPtr vertices,
 
     impl->indexes = std::move(indexes);
     impl->segments = std::move(drawSegs);
+    resetMultiDraw();
 }
 
 void DrawableGL::setVertices(std::vector<uint8_t>&& data, std::size_t count, gfx::AttributeDataType type_) {
@@ -161,14 +190,6 @@ void DrawableGL::unbindUniformBuffers() const {
     }
 }
 
-struct IndexBufferGL : public gfx::IndexBufferBase {
-    IndexBufferGL(std::unique_ptr<gfx::IndexBuffer>&& buffer_)
-        : buffer(std::move(buffer_)) {}
-    ~IndexBufferGL() override = default;
-
-    std::unique_ptr<mbgl::gfx::IndexBuffer> buffer;
-};
-
 void DrawableGL::upload(gfx::UploadPass& uploadPass) {
     if (isCustom) {
         return;
@@ -201,6 +222,7 @@ void DrawableGL::upload(gfx::UploadPass& uploadPass) {
         auto buffer = std::make_unique<IndexBufferGL>(std::move(indexBuffer));
         impl->indexes->setBuffer(std::move(buffer));
         impl->indexes->setDirty(false);
+        resetMultiDraw();
     }
 
     // Build the vertex attributes and bindings, if necessary
@@ -227,9 +249,30 @@ void DrawableGL::upload(gfx::UploadPass& uploadPass) {
                                                                     vertexBuffers);
 
         impl->attributeBuffers = std::move(vertexBuffers);
+        resetMultiDraw();
+    }
+
+    // With more than one segment, prefer a single VAO drawn with base vertexes over one VAO per segment
+    if (impl->segments.size() > 1 && impl->indexes && glContext.getMultiDrawExtension()) {
+        if (!impl->multiDrawVertexArray.isValid()) {
+            buildMultiDraw(glContext);
+        }
+    } else {
+        // Bind a VAO for each group of vertexes described by a segment
+        uploadSegments(glContext);
+    }
+
+    const auto needsUpload = [](const auto& texture) {
+        return texture && texture->needsUpload();
+    };
+    if (std::any_of(textures.begin(), textures.end(), needsUpload)) {
+        uploadTextures();
     }
 
-    // Bind a VAO for each group of vertexes described by a segment
+    attributeUpdateTime = util::MonotonicTimer::now();
+}
+
+void DrawableGL::uploadSegments(gl::Context& glContext) {
     for (const auto& seg : impl->segments) {
         MLN_TRACE_ZONE(segment);
         auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
@@ -255,15 +298,58 @@ void DrawableGL::upload(gfx::UploadPass& uploadPass) {
             }
         }
     }
+}
 
-    const auto needsUpload = [](const auto& texture) {
-        return texture && texture->needsUpload();
-    };
-    if (std::any_of(textures.begin(), textures.end(), needsUpload)) {
-        uploadTextures();
+void DrawableGL::buildMultiDraw(gl::Context& glContext) {
+    MLN_TRACE_FUNC();
+
+    for (auto& binding : impl->attributeBindings) {
+        if (binding) {
+            binding->vertexOffset = 0;
+        }
     }
 
-    attributeUpdateTime = util::MonotonicTimer::now();
+    const auto& indexBuffer = static_cast<IndexBufferGL&>(*impl->indexes->getBuffer());
+    auto vertexArray = glContext.createVertexArray();
+    vertexArray.bind(glContext, *indexBuffer.buffer, impl->attributeBindings);
+    assert(vertexArray.isValid());
+    if (!vertexArray.isValid()) {
+        return;
+    }
+
+    // The indexes may be stored in a range of a shared buffer
+    const auto indexBase = indexBuffer.buffer->getResource<gl::IndexBufferResource>().getIndexOffset();
+
+    impl->multiDrawGroups = groupMultiDraw(impl->segments, indexBase);
+    impl->multiDrawVertexArray = std::move(vertexArray);
+}
+
+std::vector<MultiDrawGroup> groupMultiDraw(const std::vector<gfx::Drawable::UniqueDrawSegment>& segments,
+                                           const std::size_t indexBase) {
+    std::vector<MultiDrawGroup> groups;
+    for (const auto& seg : segments) {
+        const auto& mlSeg = seg->getSegment();
+        if (mlSeg.indexLength == 0) {
+            continue;
+        }
+
+        const auto& mode = seg->getMode();
+        if (groups.empty() || groups.back().mode.type != mode.type || groups.back().mode.size != mode.size) {
+            groups.push_back({mode, {}, {}, {}});
+        }
+
+        auto& group = groups.back();
+        const auto indexOffset = sizeof(uint16_t) * (indexBase + mlSeg.indexOffset);
+        group.indexLengths.push_back(static_cast<GLsizei>(mlSeg.indexLength));
+        group.indexOffsets.push_back(reinterpret_cast<const GLvoid*>(indexOffset));
+        group.vertexOffsets.push_back(static_cast<GLint>(mlSeg.vertexOffset));
+    }
+    return groups;
+}
+
+void DrawableGL::resetMultiDraw() {
+    impl->multiDrawGroups.clear();
+    impl->multiDrawVertexArray = VertexArray{{nullptr, false}};
 }
 
 gfx::ColorMode DrawableGL::makeColorMode(PaintParameters& parameters) const {
@@ -23,6 +23,18 @@ namespace gl {
 
 using namespace platform;
 
+/// Consecutive segments with the same draw mode, submitted with a single multi-draw call
+struct MultiDrawGroup {
+    gfx::DrawMode mode;
+    std::vector<GLsizei> indexLengths;
+    std::vector<const GLvoid*> indexOffsets;
+    std::vector<GLint> vertexOffsets;
+};
+
+/// Group the segments into multi-draw calls, for indexes starting at `indexBase` in the bound index buffer.
+/// Each segment draws the same indexes with the same base vertex as when it is drawn on its own.
+std::vector<MultiDrawGroup> groupMultiDraw(const std::vector<gfx::Drawable::UniqueDrawSegment>&, std::size_t indexBase);
+
 class DrawableGL::Impl final {
 public:
     Impl() = default;
@@ -30,6 +42,11 @@ public:
 
     std::vector<UniqueDrawSegment> segments;
 
+    /// When multi-draw is available, all segments share one vertex array, and use the vertex
+    /// offset of each segment as a base vertex instead of a vertex array of their own.
+    std::vector<MultiDrawGroup> multiDrawGroups;
+    VertexArray multiDrawVertexArray{{nullptr, false}};
+
     std::vector<TextureID> textures;
 
     gfx::IndexVectorBasePtr indexes;
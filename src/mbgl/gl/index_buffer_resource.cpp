@@ -8,12 +8,20 @@ namespace gl {
 IndexBufferResource::IndexBufferResource(UniqueBuffer&& buffer_, int byteSize_)
     : buffer(std::move(buffer_)),
       byteSize(byteSize_) {
-    MLN_TRACE_ALLOC_INDEX_BUFFER(buffer.get(), byteSize);
+    MLN_TRACE_ALLOC_INDEX_BUFFER(buffer->get(), byteSize);
 }
 
+IndexBufferResource::IndexBufferResource(BufferRange&& range_, int byteSize_)
+    : range(std::move(range_)),
+      byteSize(byteSize_) {}
+
 IndexBufferResource::~IndexBufferResource() noexcept {
-    MLN_TRACE_FREE_INDEX_BUFFER(buffer.get());
-    auto& stats = buffer.get_deleter().context.renderingStats();
+    // Shared buffers are accounted for by their arena
+    if (!buffer) {
+        return;
+    }
+    MLN_TRACE_FREE_INDEX_BUFFER(buffer->get());
+    auto& stats = buffer->get_deleter().context.renderingStats();
     stats.memIndexBuffers -= byteSize;
     assert(stats.memIndexBuffers >= 0);
 }
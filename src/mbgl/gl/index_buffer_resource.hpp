@@ -1,17 +1,30 @@
 #pragma once
 
 #include <mbgl/gfx/index_buffer.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/gl/object.hpp>
 
+#include <optional>
+
 namespace mbgl {
 namespace gl {
 
 class IndexBufferResource : public gfx::IndexBufferResource {
 public:
     IndexBufferResource(UniqueBuffer&& buffer_, int byteSize_);
+    IndexBufferResource(BufferRange&& range_, int byteSize_);
     ~IndexBufferResource() noexcept override;
 
-    UniqueBuffer buffer;
+    /// The buffer holding the indexes, which may be shared with other resources
+    BufferID getBuffer() const { return buffer ? buffer->get() : range.getBufferID(); }
+    /// Offset of the first index within the buffer, in indexes
+    std::size_t getIndexOffset() const { return range.getOffset() / sizeof(uint16_t); }
+
+    /// The range of a shared buffer holding the indexes, if any
+    const BufferRange& getRange() const { return range; }
+
+    std::optional<UniqueBuffer> buffer;
+    BufferRange range;
     int byteSize;
 };
 
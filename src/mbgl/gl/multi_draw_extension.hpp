@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+using namespace platform;
+
+/// Draws several ranges of an index buffer, each with its own base vertex, in a single call.
+/// Core in OpenGL 3.2, and available through extensions on OpenGL ES.
+class MultiDraw {
+public:
+    template <typename Fn>
+    MultiDraw(const Fn& loadExtension)
+        : multiDrawElementsBaseVertex(
+              loadExtension({{"GL_ARB_draw_elements_base_vertex", "glMultiDrawElementsBaseVertex"},
+                             {"GL_EXT_draw_elements_base_vertex", "glMultiDrawElementsBaseVertexEXT"},
+                             {"GL_OES_draw_elements_base_vertex", "glMultiDrawElementsBaseVertexEXT"}})) {}
+
+    const ExtensionFunction<void(GLenum mode,
+                                 const GLsizei* count,
+                                 GLenum type,
+                                 const GLvoid* const* indices,
+                                 GLsizei drawcount,
+                                 const GLint* basevertex)>
+        multiDrawElementsBaseVertex;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -5,6 +5,7 @@
 #include <mbgl/gl/object.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/draw_scope_resource.hpp>
+#include <mbgl/gl/index_buffer_resource.hpp>
 #include <mbgl/gfx/vertex_buffer.hpp>
 #include <mbgl/gfx/index_buffer.hpp>
 #include <mbgl/gfx/uniform.hpp>
@@ -40,9 +41,7 @@ public:
         Instance(Context& context,
                  const std::initializer_list<const char*>& vertexSource,
                  const std::initializer_list<const char*>& fragmentSource)
-            : program(context.createProgram(context.createShader(ShaderType::Vertex, vertexSource),
-                                            context.createShader(ShaderType::Fragment, fragmentSource),
-                                            attributeLocations.getFirstAttribName())) {
+            : program(context.createProgram(vertexSource, fragmentSource, attributeLocations.getFirstAttribName())) {
             attributeLocations.queryLocations(program);
             uniformStates.queryLocations(program);
             // Texture units are specified via uniforms as well, so we need query their locations
@@ -129,7 +128,8 @@ public:
         auto& vertexArray = drawScope.getResource<gl::DrawScopeResource>().vertexArray;
         vertexArray.bind(context, indexBuffer, instance.attributeLocations.toBindingArray(attributeBindings));
 
-        context.draw(drawMode, indexOffset, indexLength);
+        const auto indexBase = indexBuffer.getResource<gl::IndexBufferResource>().getIndexOffset();
+        context.draw(drawMode, indexBase + indexOffset, indexLength);
     }
 
 private:
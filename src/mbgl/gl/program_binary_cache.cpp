@@ -0,0 +1,157 @@
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/util/hash.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+// Bump when the layout of the files changes
+constexpr std::string_view magic = "MLNPGB01";
+
+template <typename T>
+void append(std::string& out, const T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(std::string_view data_)
+        : data(data_) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (data.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool read(std::string_view& value, std::size_t size) {
+        if (data.size() < size) {
+            return false;
+        }
+        value = data.substr(0, size);
+        data.remove_prefix(size);
+        return true;
+    }
+
+    bool atEnd() const { return data.empty(); }
+
+private:
+    std::string_view data;
+};
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory_, std::string driver_)
+    : directory(std::move(directory_)),
+      driver(std::move(driver_)) {}
+
+std::uint64_t ProgramBinaryCache::makeKey(const std::initializer_list<const char*>& vertexSources,
+                                          const std::initializer_list<const char*>& fragmentSources,
+                                          const char* location0AttribName) const {
+    // The keys name files that outlive the process
+    util::FNV1a hash;
+    hash.addTerminated(magic);
+    hash.addTerminated(driver);
+    for (const auto* source : vertexSources) {
+        hash.add(source);
+    }
+    hash.addTerminated({});
+    for (const auto* source : fragmentSources) {
+        hash.add(source);
+    }
+    hash.addTerminated({});
+    hash.addTerminated(location0AttribName);
+    return hash.get();
+}
+
+std::string ProgramBinaryCache::getPath(const std::uint64_t key) const {
+    std::ostringstream path;
+    path << directory << "/program-" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return path.str();
+}
+
+std::optional<ProgramBinaryCache::Binary> ProgramBinaryCache::load(const std::uint64_t key) const {
+    MLN_TRACE_FUNC();
+
+    const auto file = util::readFile(getPath(key));
+    if (!file) {
+        return std::nullopt;
+    }
+
+    Reader reader(*file);
+    std::string_view fileMagic;
+    std::uint64_t fileKey = 0;
+    std::uint32_t driverLength = 0;
+    std::string_view fileDriver;
+    std::uint32_t format = 0;
+    std::uint32_t length = 0;
+    std::string_view data;
+    if (!reader.read(fileMagic, magic.size()) || fileMagic != magic || !reader.read(fileKey) || fileKey != key ||
+        !reader.read(driverLength) || !reader.read(fileDriver, driverLength) || fileDriver != driver ||
+        !reader.read(format) || !reader.read(length) || length == 0 || !reader.read(data, length) ||
+        !reader.atEnd()) {
+        Log::Warning(Event::OpenGL, "Ignoring invalid program binary " + getPath(key));
+        return std::nullopt;
+    }
+
+    return Binary{static_cast<platform::GLenum>(format), std::string(data)};
+}
+
+void ProgramBinaryCache::store(const std::uint64_t key, const Binary& binary) const {
+    MLN_TRACE_FUNC();
+
+    std::string file;
+    file.reserve(magic.size() + sizeof(std::uint64_t) + 3 * sizeof(std::uint32_t) + driver.size() +
+                 binary.data.size());
+    file.append(magic);
+    append(file, key);
+    append(file, static_cast<std::uint32_t>(driver.size()));
+    file.append(driver);
+    append(file, static_cast<std::uint32_t>(binary.format));
+    append(file, static_cast<std::uint32_t>(binary.data.size()));
+    file.append(binary.data);
+
+    // Write to a temporary file first, so that another process never reads a partial binary
+    const std::string path = getPath(key);
+    const std::string temporaryPath = path + ".tmp";
+    try {
+        util::write_file(temporaryPath, file);
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            // Renaming over an existing file fails on some platforms
+            util::deleteFile(path);
+            if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+                util::deleteFile(temporaryPath);
+                Log::Warning(Event::OpenGL, "Failed to store program binary " + path);
+            }
+        }
+    } catch (const std::exception& e) {
+        Log::Warning(Event::OpenGL, std::string("Failed to store program binary: ") + e.what());
+    }
+}
+
+void ProgramBinaryCache::remove(const std::uint64_t key) const {
+    try {
+        util::deleteFile(getPath(key));
+    } catch (const std::exception& e) {
+        Log::Warning(Event::OpenGL, std::string("Failed to remove program binary: ") + e.what());
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
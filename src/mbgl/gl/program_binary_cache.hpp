@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+
+namespace mbgl {
+namespace gl {
+
+/// Linked programs saved with `glGetProgramBinary`, so that later runs can skip compiling their shaders.
+///
+/// Each program is stored in its own file, named after a hash of its shader sources (which include the
+/// defines) and of the driver. The driver is also recorded in the file, a binary made by another GPU or
+/// driver version is never handed to `glProgramBinary`. Drivers may still reject a binary, callers are
+/// expected to fall back to building the program from source and to replace the stored binary.
+class ProgramBinaryCache : private util::noncopyable {
+public:
+    struct Binary {
+        platform::GLenum format = 0;
+        std::string data;
+    };
+
+    /// @param directory An existing directory to store the binaries in
+    /// @param driver Identifies the GL implementation, such as the vendor, renderer and version strings
+    ProgramBinaryCache(std::string directory, std::string driver);
+
+    /// Identify a program by the sources of its shaders and by the attribute bound to location 0
+    std::uint64_t makeKey(const std::initializer_list<const char*>& vertexSources,
+                          const std::initializer_list<const char*>& fragmentSources,
+                          const char* location0AttribName) const;
+
+    /// Returns nothing if there's no binary for the key, or if it's unreadable or from another driver
+    std::optional<Binary> load(std::uint64_t key) const;
+
+    /// Errors are logged and otherwise ignored, a missing binary only costs a compilation
+    void store(std::uint64_t key, const Binary&) const;
+    void remove(std::uint64_t key) const;
+
+    std::string getPath(std::uint64_t key) const;
+
+private:
+    const std::string directory;
+    const std::string driver;
+};
+
+} // namespace gl
+} // namespace mbgl
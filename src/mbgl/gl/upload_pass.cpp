@@ -32,6 +32,13 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
                                                                                   const std::size_t size,
                                                                                   const gfx::BufferUsageType usage,
                                                                                   bool /*persistent*/) {
+    // Static data is sub-allocated from shared buffers, unless it's too large to share a buffer
+    if (auto* arena = commandEncoder.context.getVertexArena(); arena && usage == gfx::BufferUsageType::StaticDraw) {
+        if (auto range = arena->allocate(data, size)) {
+            return std::make_unique<gl::VertexBufferResource>(std::move(range), static_cast<int>(size));
+        }
+    }
+
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
     commandEncoder.context.renderingStats().numBuffers++;
@@ -43,15 +50,29 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
     return std::make_unique<gl::VertexBufferResource>(std::move(result), static_cast<int>(size));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
-    commandEncoder.context.vertexBuffer = static_cast<gl::VertexBufferResource&>(resource).getBuffer();
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
+    auto& glResource = static_cast<gl::VertexBufferResource&>(resource);
+    if (const auto& range = glResource.getRange()) {
+        commandEncoder.context.getVertexArena()->update(range, data, size, offset);
+        return;
+    }
+    commandEncoder.context.vertexBuffer = glResource.getBuffer();
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
                                                                                 std::size_t size,
                                                                                 const gfx::BufferUsageType usage,
                                                                                 bool /*persistent*/) {
+    if (auto* arena = commandEncoder.context.getIndexArena(); arena && usage == gfx::BufferUsageType::StaticDraw) {
+        if (auto range = arena->allocate(data, size)) {
+            return std::make_unique<gl::IndexBufferResource>(std::move(range), static_cast<int>(size));
+        }
+    }
+
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
     commandEncoder.context.renderingStats().numBuffers++;
@@ -65,10 +86,15 @@ std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(
 }
 
 void UploadPass::updateIndexBufferResource(gfx::IndexBufferResource& resource, const void* data, std::size_t size) {
+    auto& glResource = static_cast<gl::IndexBufferResource&>(resource);
+    if (const auto& range = glResource.getRange()) {
+        commandEncoder.context.getIndexArena()->update(range, data, size, 0);
+        return;
+    }
     // Be sure to unbind any existing vertex array object before binding the
     // index buffer so that we don't mess up another VAO
     commandEncoder.context.bindVertexArray = 0;
-    commandEncoder.context.globalVertexArrayState.indexBuffer = static_cast<gl::IndexBufferResource&>(resource).buffer;
+    commandEncoder.context.globalVertexArrayState.indexBuffer = glResource.getBuffer();
     MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
 }
 
@@ -156,9 +182,17 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
 
             // If the already-allocated buffer is large enough, we can re-use it
             if (rawBufSize <= resource.getByteSize()) {
-                // If the source changed, update the buffer contents
+                // If the source changed, update the buffer contents, limited to the elements that were modified
                 if (vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    const auto [begin, end] = vec->getModifiedRange();
+                    if (begin < end) {
+                        const auto offset = begin * vec->getRawSize();
+                        updateVertexBufferResource(resource,
+                                                   static_cast<const uint8_t*>(rawBufPtr) + offset,
+                                                   (end - begin) * vec->getRawSize(),
+                                                   offset);
+                    }
+                    vec->resetModifiedRange();
                     resource.setLastUpdated(vec->getLastModified());
                 }
                 return rawData->resource;
@@ -169,6 +203,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer = std::make_unique<VertexBufferGL>();
             buffer->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer));
+            vec->resetModifiedRange();
             return static_cast<VertexBufferGL*>(vec->getBuffer())->resource;
         }
     }
@@ -7,7 +7,7 @@ namespace gl {
 
 void VertexArray::bind(Context& context, const gfx::IndexBuffer& indexBuffer, const AttributeBindingArray& bindings) {
     context.bindVertexArray = state->vertexArray;
-    state->indexBuffer = indexBuffer.getResource<gl::IndexBufferResource>().buffer;
+    state->indexBuffer = indexBuffer.getResource<gl::IndexBufferResource>().getBuffer();
 
     state->bindings.reserve(bindings.size());
 
@@ -8,12 +8,20 @@ namespace gl {
 VertexBufferResource::VertexBufferResource(UniqueBuffer&& buffer_, int byteSize_)
     : buffer(std::move(buffer_)),
       byteSize(byteSize_) {
-    MLN_TRACE_ALLOC_VERTEX_BUFFER(buffer.get(), byteSize);
+    MLN_TRACE_ALLOC_VERTEX_BUFFER(buffer->get(), byteSize);
 }
 
+VertexBufferResource::VertexBufferResource(BufferRange&& range_, int byteSize_)
+    : range(std::move(range_)),
+      byteSize(byteSize_) {}
+
 VertexBufferResource::~VertexBufferResource() noexcept {
-    MLN_TRACE_FREE_VERTEX_BUFFER(buffer.get());
-    auto& stats = buffer.get_deleter().context.renderingStats();
+    // Shared buffers are accounted for by their arena
+    if (!buffer) {
+        return;
+    }
+    MLN_TRACE_FREE_VERTEX_BUFFER(buffer->get());
+    auto& stats = buffer->get_deleter().context.renderingStats();
     stats.memVertexBuffers -= byteSize;
     assert(stats.memVertexBuffers >= 0);
 }
@@ -1,26 +1,37 @@
 #pragma once
 
 #include <mbgl/gfx/vertex_buffer.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/gl/object.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 
+#include <optional>
+
 namespace mbgl {
 namespace gl {
 
 class VertexBufferResource : public gfx::VertexBufferResource {
 public:
     VertexBufferResource(UniqueBuffer&& buffer_, int byteSize_);
+    VertexBufferResource(BufferRange&& range_, int byteSize_);
     ~VertexBufferResource() noexcept override;
 
     int getByteSize() const { return byteSize; }
 
-    const UniqueBuffer& getBuffer() const { return buffer; }
+    /// The buffer holding the vertexes, which may be shared with other resources
+    BufferID getBuffer() const { return buffer ? buffer->get() : range.getBufferID(); }
+    /// Offset of the vertexes within the buffer, in bytes
+    std::size_t getOffset() const { return range.getOffset(); }
+
+    /// The range of a shared buffer holding the vertexes, if any
+    const BufferRange& getRange() const { return range; }
 
     std::chrono::duration<double> getLastUpdated() const { return lastUpdated; }
     void setLastUpdated(std::chrono::duration<double> time) { lastUpdated = time; }
 
 protected:
-    UniqueBuffer buffer;
+    std::optional<UniqueBuffer> buffer;
+    BufferRange range;
     int byteSize;
     std::chrono::duration<double> lastUpdated = util::MonotonicTimer::now();
 };
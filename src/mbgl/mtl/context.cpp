@@ -191,6 +191,7 @@ MTLSamplerStatePtr Context::createMetalSamplerState(MTLSamplerDescriptorPtr samp
 
 void Context::performCleanup() {
     stats.numDrawCalls = 0;
+    stats.numDrawRanges = 0;
     stats.numFrames++;
     clipMaskUniformsBufferUsed = false;
 }
@@ -437,6 +438,7 @@ bool Context::renderTileClippingMasks(gfx::RenderPass& renderPass,
 #endif
 
     stats.numDrawCalls++;
+    stats.numDrawRanges++;
     stats.totalDrawCalls++;
     return true;
 }
@@ -307,6 +307,7 @@ void Drawable::draw(PaintParameters& parameters) const {
             }
 
             context.renderingStats().numDrawCalls++;
+            context.renderingStats().numDrawRanges++;
         }
     }
 
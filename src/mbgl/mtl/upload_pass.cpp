@@ -65,8 +65,11 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
         commandEncoder.context.createBuffer(data, size, usage, /*isIndexBuffer=*/false, persistent));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
-    static_cast<VertexBufferResource&>(resource).get().update(data, size, /*offset=*/0);
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
+    static_cast<VertexBufferResource&>(resource).get().update(data, size, offset);
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
@@ -133,7 +136,10 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             if (rawBufSize <= resource.getSizeInBytes()) {
                 // If the source changed, update the buffer contents
                 if (forceUpdate || vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    // Updating part of a MTLBuffer copies the whole of it into a new one, since the
+                    // old buffer may still be in use by a frame in flight, so upload the whole vector.
+                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize, /*offset=*/0);
+                    vec->resetModifiedRange();
                     resource.setLastUpdated(vec->getLastModified());
                 }
                 return rawData->resource;
@@ -144,6 +150,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer_ = std::make_unique<VertexBuffer>();
             buffer_->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer_));
+            vec->resetModifiedRange();
             return static_cast<VertexBuffer*>(vec->getBuffer())->resource;
         }
     }
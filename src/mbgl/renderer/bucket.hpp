@@ -54,6 +54,10 @@ public:
 
     virtual bool hasData() const = 0;
 
+    // Approximate size of the geometry created by layout, in bytes. Only
+    // meaningful before the first upload, which may move the data out.
+    virtual std::size_t getByteSize() const { return 0; }
+
     virtual float getQueryRadius(const RenderLayer&) const { return 0; };
 
     bool needsUpload() const { return hasData() && !uploaded; }
@@ -44,6 +44,10 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::getByteSize() const {
+    return vertices.bytes() + triangles.bytes();
+}
+
 template <class Property>
 static float get(const CirclePaintProperties::PossiblyEvaluated& evaluated,
                  const std::string& id,
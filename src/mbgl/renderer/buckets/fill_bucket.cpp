@@ -96,6 +96,14 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !basicLineSegments.empty();
 }
 
+std::size_t FillBucket::getByteSize() const {
+    std::size_t size = vertices.bytes() + triangles.bytes() + basicLines.bytes();
+#if MLN_TRIANGULATE_FILL_OUTLINES
+    size += lineVertices.bytes() + lineIndexes.bytes();
+#endif // MLN_TRIANGULATE_FILL_OUTLINES
+    return size;
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     using namespace style;
     const auto& evaluated = getEvaluated<FillLayerProperties>(layer.evaluatedProperties);
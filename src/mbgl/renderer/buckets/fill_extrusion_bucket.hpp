@@ -32,6 +32,7 @@ public:
                     const CanonicalTileID&) override;
 
     bool hasData() const override;
+    std::size_t getByteSize() const override;
 
     void upload(gfx::UploadPass&) override;
 
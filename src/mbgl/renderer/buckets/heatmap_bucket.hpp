@@ -25,6 +25,7 @@ public:
                     std::size_t,
                     const CanonicalTileID&) override;
     bool hasData() const override;
+    std::size_t getByteSize() const override;
 
     void upload(gfx::UploadPass&) override;
 
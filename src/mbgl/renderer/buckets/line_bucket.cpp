@@ -133,6 +133,10 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::getByteSize() const {
+    return vertices.bytes() + triangles.bytes();
+}
+
 template <class Property>
 static float get(const LinePaintProperties::PossiblyEvaluated& evaluated,
                  const std::string& id,
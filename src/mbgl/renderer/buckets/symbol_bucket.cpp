@@ -190,6 +190,25 @@ bool SymbolBucket::hasData() const {
            hasTextCollisionBoxData() || hasIconCollisionCircleData() || hasTextCollisionCircleData();
 }
 
+std::size_t SymbolBucket::getByteSize() const {
+    std::size_t size = symbolInstances.size() * sizeof(SymbolInstance);
+    for (const auto* buffer : {&text, &icon, &sdfIcon}) {
+        size += buffer->vertices().bytes() + buffer->dynamicVertices().bytes() + buffer->opacityVertices().bytes() +
+                buffer->triangles.bytes() + buffer->placedSymbols.size() * sizeof(PlacedSymbol);
+    }
+    for (const auto* buffer : {iconCollisionBox.get(), textCollisionBox.get()}) {
+        if (buffer) {
+            size += buffer->vertices().bytes() + buffer->dynamicVertices().bytes() + buffer->lines.bytes();
+        }
+    }
+    for (const auto* buffer : {iconCollisionCircle.get(), textCollisionCircle.get()}) {
+        if (buffer) {
+            size += buffer->vertices().bytes() + buffer->dynamicVertices().bytes() + buffer->triangles.bytes();
+        }
+    }
+    return size;
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
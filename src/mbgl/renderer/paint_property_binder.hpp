@@ -10,6 +10,7 @@
 #include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/paint_property_statistics.hpp>
 #include <mbgl/renderer/possibly_evaluated_property_value.hpp>
+#include <mbgl/util/containers.hpp>
 #include <mbgl/util/indexed_tuple.hpp>
 #include <mbgl/util/literal.hpp>
 #include <mbgl/util/type_list.hpp>
@@ -25,7 +26,7 @@ struct FeatureVertexRange {
     std::size_t end;
 };
 
-using FeatureVertexRangeMap = std::map<std::string, std::vector<FeatureVertexRange>>;
+using FeatureVertexRangeMap = mbgl::unordered_map<std::string, std::vector<FeatureVertexRange>>;
 
 /*
    ZoomInterpolatedAttribute<Attr> is a 'compound' attribute, representing two
@@ -267,7 +268,8 @@ public:
 
     SourceFunctionPaintPropertyBinder(style::PropertyExpression<T> expression_, T defaultValue_)
         : expression(std::move(expression_)),
-          defaultValue(std::move(defaultValue_)) {}
+          defaultValue(std::move(defaultValue_)),
+          featureStateConstant(style::expression::isFeatureStateConstant(expression.getExpression())) {}
     ~SourceFunctionPaintPropertyBinder() override { sharedVertexVector->release(); }
 
     void setPatternParameters(const std::optional<ImagePosition>&,
@@ -290,15 +292,20 @@ public:
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(BaseVertex{value});
         }
-        std::optional<std::string> idStr = featureIDtoString(feature.getID());
-        if (idStr) {
-            featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
+        // Only expressions reading the feature state need to find the vertices of a feature again
+        if (!featureStateConstant) {
+            if (auto idStr = featureIDtoString(feature.getID())) {
+                featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
+            }
         }
     }
 
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions&) override {
+        if (featureMap.empty()) {
+            return;
+        }
         for (const auto& it : states) {
             const auto positions = featureMap.find(it.first);
             if (positions == featureMap.end()) {
@@ -323,12 +330,7 @@ public:
         const auto evaluated = expression.evaluate(EvaluationContext(&feature).withFeatureState(&state), defaultValue);
         this->statistics.add(evaluated);
 
-        const auto value = BaseVertex{attributeValue(evaluated)};
-        for (std::size_t i = start; i < end; ++i) {
-            vertexVector.at(i) = value;
-        }
-
-        vertexVector.updateModified();
+        vertexVector.fill(start, end, BaseVertex{attributeValue(evaluated)});
     }
 
 #if MLN_LEGACY_RENDERER
@@ -375,6 +377,7 @@ private:
     std::optional<gfx::VertexBuffer<BaseVertex>> vertexBuffer;
 #endif // MLN_LEGACY_RENDERER
 
+    const bool featureStateConstant;
     FeatureVertexRangeMap featureMap;
 };
 
@@ -389,7 +392,8 @@ public:
     CompositeFunctionPaintPropertyBinder(style::PropertyExpression<T> expression_, float zoom, T defaultValue_)
         : expression(std::move(expression_)),
           defaultValue(std::move(defaultValue_)),
-          zoomRange({zoom, zoom + 1}) {}
+          zoomRange({zoom, zoom + 1}),
+          featureStateConstant(style::expression::isFeatureStateConstant(expression.getExpression())) {}
     ~CompositeFunctionPaintPropertyBinder() override { sharedVertexVector->release(); }
 
     void setPatternParameters(const std::optional<ImagePosition>&,
@@ -424,14 +428,19 @@ public:
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(Vertex{value});
         }
-        if (auto idStr = featureIDtoString(feature.getID())) {
-            featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
+        if (!featureStateConstant) {
+            if (auto idStr = featureIDtoString(feature.getID())) {
+                featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
+            }
         }
     }
 
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions&) override {
+        if (featureMap.empty()) {
+            return;
+        }
         for (const auto& it : states) {
             const auto positions = featureMap.find(it.first);
             if (positions == featureMap.end()) {
@@ -461,12 +470,7 @@ public:
 
         const Vertex value = Vertex{
             zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max))};
-
-        for (std::size_t i = start; i < end; ++i) {
-            vertexVector.at(i) = value;
-        }
-
-        vertexVector.updateModified();
+        vertexVector.fill(start, end, value);
     }
 
 #if MLN_LEGACY_RENDERER
@@ -520,6 +524,7 @@ private:
     std::optional<gfx::VertexBuffer<Vertex>> vertexBuffer;
 #endif // MLN_LEGACY_RENDERER
 
+    const bool featureStateConstant;
     FeatureVertexRangeMap featureMap;
 };
 
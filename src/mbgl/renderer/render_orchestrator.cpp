@@ -13,11 +13,13 @@
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/renderer/upload_parameters.hpp>
 #include <mbgl/renderer/pattern_atlas.hpp>
+#include <mbgl/renderer/shared_atlas.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/transition_parameters.hpp>
 #include <mbgl/renderer/property_evaluation_parameters.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/image_manager.hpp>
@@ -25,6 +27,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/layout_cache.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
@@ -122,12 +125,15 @@ RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_,
       imageManager(std::make_unique<ImageManager>()),
       lineAtlas(std::make_unique<LineAtlas>()),
       patternAtlas(std::make_unique<PatternAtlas>()),
+      sharedAtlas(SharedAtlas::create()),
+      sharedAtlasTextures(std::make_shared<TileAtlasTextures>()),
       imageImpls(makeMutable<std::vector<Immutable<style::Image::Impl>>>()),
       sourceImpls(makeMutable<std::vector<Immutable<style::Source::Impl>>>()),
       layerImpls(makeMutable<std::vector<Immutable<style::Layer::Impl>>>()),
       renderLight(makeMutable<Light::Impl>()),
       backgroundLayerAsColor(backgroundLayerAsColor_),
-      threadPool(threadPool_) {
+      threadPool(threadPool_),
+      layoutCache(std::make_shared<LayoutCache>(threadPool)) {
     glyphManager->setObserver(this);
     imageManager->setObserver(this);
 }
@@ -197,7 +203,10 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                         imageManager,
                                         glyphManager,
                                         updateParameters->prefetchZoomDelta,
-                                        threadPool};
+                                        threadPool,
+                                        layoutCache->getMaxSize() ? layoutCache : nullptr,
+                                        sharedAtlas,
+                                        sharedAtlasTextures};
 
     glyphManager->setURL(updateParameters->glyphURL);
 
@@ -472,6 +481,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
 
     // Symbol placement.
     assert((updateParameters->mode == MapMode::Tile) || !placedSymbolDataCollected);
+    const auto startPlacement = util::MonotonicTimer::now().count();
     bool symbolBucketsChanged = false;
     bool symbolBucketsAdded = false;
     std::set<std::string> usedSymbolLayers;
@@ -537,6 +547,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         renderTreeParameters->symbolFadeChange = 1.0f;
         renderTreeParameters->needsRepaint = false;
     }
+    renderTreeParameters->placementTime = util::MonotonicTimer::now().count() - startPlacement;
 
     if (!renderTreeParameters->needsRepaint && renderTreeParameters->loaded) {
         MLN_TRACE_ZONE(reduce);
@@ -741,6 +752,8 @@ void RenderOrchestrator::setFeatureState(const std::string& sourceID,
     if (RenderSource* renderSource = getRenderSource(sourceID)) {
         renderSource->setFeatureState(sourceLayerID, featureID, state);
     }
+    // Cached layouts don't receive feature state changes
+    layoutCache->remove(sourceID);
 }
 
 void RenderOrchestrator::getFeatureState(FeatureState& state,
@@ -763,6 +776,7 @@ void RenderOrchestrator::removeFeatureState(const std::string& sourceID,
     if (RenderSource* renderSource = getRenderSource(sourceID)) {
         renderSource->removeFeatureState(sourceLayerID, featureID, stateKey);
     }
+    layoutCache->remove(sourceID);
 }
 
 void RenderOrchestrator::setTileCacheEnabled(bool enable) {
@@ -777,6 +791,14 @@ bool RenderOrchestrator::getTileCacheEnabled() const {
     return tileCacheEnabled;
 }
 
+void RenderOrchestrator::setLayoutCacheSize(std::size_t bytes) {
+    layoutCache->setMaxSize(bytes);
+}
+
+LayoutCacheStats RenderOrchestrator::getLayoutCacheStats() const {
+    return layoutCache->getStats();
+}
+
 void RenderOrchestrator::reduceMemoryUse() {
     MLN_TRACE_FUNC();
 
@@ -784,6 +806,8 @@ void RenderOrchestrator::reduceMemoryUse() {
     for (const auto& entry : renderSources) {
         entry.second->reduceMemoryUse();
     }
+    layoutCache->clear();
+    sharedAtlas->evict();
     imageManager->reduceMemoryUse();
     observer->onInvalidate();
 }
@@ -883,6 +907,8 @@ void RenderOrchestrator::clearData() {
     renderLayers.clear();
 
     crossTileSymbolIndex.reset();
+    layoutCache->clear();
+    sharedAtlas->evict();
 
     if (!lineAtlas->isEmpty()) lineAtlas = std::make_unique<LineAtlas>();
     if (!patternAtlas->isEmpty()) patternAtlas = std::make_unique<PatternAtlas>();
@@ -891,6 +917,10 @@ void RenderOrchestrator::clearData() {
     glyphManager->evict(fontStacks(*layerImpls));
 }
 
+void RenderOrchestrator::uploadSharedAtlas(gfx::UploadPass& uploadPass, gfx::RenderingStats& stats) {
+    sharedAtlas->upload(uploadPass, *sharedAtlasTextures, *imageManager, stats);
+}
+
 #if MLN_DRAWABLE_RENDERER
 void RenderOrchestrator::addChanges(UniqueChangeRequestVec& changes) {
     pendingChanges.insert(
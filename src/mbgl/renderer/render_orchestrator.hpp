@@ -37,11 +37,16 @@ class GlyphManager;
 class ImageManager;
 class LineAtlas;
 class PatternAtlas;
+class SharedAtlas;
+class TileAtlasTextures;
 class CrossTileSymbolIndex;
 class RenderTree;
+class LayoutCache;
 
 namespace gfx {
 class ShaderRegistry;
+class UploadPass;
+struct RenderingStats;
 #if MLN_DRAWABLE_RENDERER
 class Drawable;
 using DrawablePtr = std::shared_ptr<Drawable>;
@@ -94,6 +99,8 @@ public:
 
     void setTileCacheEnabled(bool);
     bool getTileCacheEnabled() const;
+    void setLayoutCacheSize(std::size_t);
+    LayoutCacheStats getLayoutCacheStats() const;
     void reduceMemoryUse();
     void dumpDebugLogs();
     void collectPlacedSymbolData(bool);
@@ -102,6 +109,9 @@ public:
 
     void update(const std::shared_ptr<UpdateParameters>&);
 
+    /// Upload the changes to the glyph and icon atlases shared by the tiles
+    void uploadSharedAtlas(gfx::UploadPass&, gfx::RenderingStats&);
+
 #if MLN_DRAWABLE_RENDERER
     bool addLayerGroup(LayerGroupBasePtr);
     bool removeLayerGroup(const LayerGroupBasePtr&);
@@ -203,6 +213,8 @@ private:
     std::shared_ptr<ImageManager> imageManager;
     std::unique_ptr<LineAtlas> lineAtlas;
     std::unique_ptr<PatternAtlas> patternAtlas;
+    const std::shared_ptr<SharedAtlas> sharedAtlas;
+    const std::shared_ptr<TileAtlasTextures> sharedAtlasTextures;
 
     Immutable<std::vector<Immutable<style::Image::Impl>>> imageImpls;
     Immutable<std::vector<Immutable<style::Source::Impl>>> sourceImpls;
@@ -227,6 +239,7 @@ private:
     RenderLayerReferences layersNeedPlacement;
 
     TaggedScheduler threadPool;
+    const std::shared_ptr<LayoutCache> layoutCache;
 
 #if MLN_DRAWABLE_RENDERER
     std::vector<std::unique_ptr<ChangeRequest>> pendingChanges;
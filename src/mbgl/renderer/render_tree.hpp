@@ -89,6 +89,8 @@ public:
     bool needsRepaint = false;
     bool loaded = false;
     bool placementChanged = false;
+    // Time spent placing symbols for the frame, in seconds
+    double placementTime = 0.0;
 };
 
 class RenderTree {
@@ -142,6 +142,14 @@ bool Renderer::getTileCacheEnabled() const {
     return impl->orchestrator.getTileCacheEnabled();
 }
 
+void Renderer::setLayoutCacheSize(std::size_t bytes) {
+    impl->orchestrator.setLayoutCacheSize(bytes);
+}
+
+LayoutCacheStats Renderer::getLayoutCacheStats() const {
+    return impl->orchestrator.getLayoutCacheStats();
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard{impl->backend};
     impl->reduceMemoryUse();
@@ -182,6 +182,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     const auto& renderTreeParameters = renderTree.getParameters();
     staticData->has3D = renderTreeParameters.has3D;
     staticData->backendSize = backend.getDefaultRenderable().getSize();
+    context.renderingStats().placementTime += renderTreeParameters.placementTime;
 
     if (renderState == RenderState::Never) {
         observer->onWillStartRenderingMap();
@@ -231,6 +232,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
         staticData->upload(*uploadPass);
         renderTree.getLineAtlas().upload(*uploadPass);
         renderTree.getPatternAtlas().upload(*uploadPass);
+        orchestrator.uploadSharedAtlas(*uploadPass, context.renderingStats());
     }
 
 #if MLN_DRAWABLE_RENDERER
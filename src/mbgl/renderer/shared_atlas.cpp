@@ -0,0 +1,436 @@
+#include <mbgl/renderer/shared_atlas.hpp>
+#include <mbgl/gfx/context.hpp>
+#include <mbgl/gfx/rendering_stats.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
+#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/tile_render_data.hpp>
+#include <mbgl/util/instrumentation.hpp>
+
+#if MLN_DRAWABLE_RENDERER
+#include <mbgl/gfx/texture2d.hpp>
+#endif
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+namespace {
+
+// Same as the atlases of a single tile
+constexpr uint16_t padding = 1;
+constexpr uint16_t initialSize = 256;
+
+mapbox::ShelfPack::ShelfPackOptions shelfPackOptions() {
+    mapbox::ShelfPack::ShelfPackOptions options;
+    options.autoResize = false;
+    return options;
+}
+
+} // namespace
+
+template <class Image>
+SharedAtlas::Atlas<Image>::Atlas(const uint16_t size)
+    : pack(size, size, shelfPackOptions()),
+      image({size, size}) {}
+
+SharedAtlas::Reference::Reference(std::shared_ptr<SharedAtlas> atlas_)
+    : atlas(std::move(atlas_)) {}
+
+SharedAtlas::Reference::~Reference() {
+    atlas->release(*this);
+}
+
+std::shared_ptr<SharedAtlas> SharedAtlas::create(const uint16_t maxSize) {
+    return std::shared_ptr<SharedAtlas>(new SharedAtlas(maxSize));
+}
+
+SharedAtlas::SharedAtlas(const uint16_t maxSize_)
+    : maxSize(maxSize_),
+      glyphs(std::min(initialSize, maxSize_)),
+      icons(std::min(initialSize, maxSize_)) {}
+
+std::optional<SharedAtlas::Layout> SharedAtlas::add(const GlyphMap& glyphMap,
+                                                    const ImageMap& iconMap,
+                                                    const ImageMap& patternMap,
+                                                    const ImageVersionMap& versionMap) {
+    MLN_TRACE_FUNC();
+
+    // Created before locking, destroying it takes the lock
+    auto reference = std::shared_ptr<Reference>(new Reference(shared_from_this()));
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto fail = [&] {
+        // The entries stay in the atlases for other layouts
+        for (const auto& key : reference->glyphs) {
+            glyphEntries.at(key).refs--;
+        }
+        for (const auto& key : reference->images) {
+            imageEntries.at(key).refs--;
+        }
+        reference->glyphs.clear();
+        reference->images.clear();
+        return std::nullopt;
+    };
+
+    Layout result;
+    for (const auto& [fontStack, glyphs_] : glyphMap) {
+        GlyphPositionMap& positions = result.glyphPositions[fontStack];
+        for (const auto& [glyphID, glyph] : glyphs_) {
+            if (!glyph || !(*glyph)->bitmap.valid()) {
+                continue;
+            }
+            const auto rect = addGlyph(fontStack, *glyph, *reference);
+            if (!rect) {
+                return fail();
+            }
+            positions.emplace(glyphID, GlyphPosition{*rect, (*glyph)->metrics});
+        }
+    }
+
+    const auto addImages = [&](const ImageMap& images, const ImageType type, ImagePositions& positions) {
+        positions.reserve(images.size());
+        for (const auto& [id, image] : images) {
+            const auto it = versionMap.find(id);
+            const auto position = addImage(image, type, it != versionMap.end() ? it->second : 0, *reference);
+            if (!position) {
+                return false;
+            }
+            positions.emplace(id, *position);
+        }
+        return true;
+    };
+    if (!addImages(iconMap, ImageType::Icon, result.iconAtlas.iconPositions) ||
+        !addImages(patternMap, ImageType::Pattern, result.iconAtlas.patternPositions)) {
+        return fail();
+    }
+
+    result.reference = std::move(reference);
+    return result;
+}
+
+std::optional<Rect<uint16_t>> SharedAtlas::addGlyph(const FontStackHash fontStack,
+                                                    const Immutable<Glyph>& glyph,
+                                                    Reference& reference) {
+    const Size size = glyph->bitmap.size;
+    GlyphKey key{fontStack, glyph->id, size.width, size.height, 0};
+    const auto sameIDAndSize = [&](const GlyphKey& other) {
+        return std::get<0>(other) == fontStack && std::get<1>(other) == glyph->id &&
+               std::get<2>(other) == size.width && std::get<3>(other) == size.height;
+    };
+
+    // Reuse an entry with the same pixels, or draw over one that no layout refers to anymore. A glyph with
+    // the same ID and size, but from another request, may have been drawn differently.
+    auto found = glyphEntries.end();
+    auto unused = glyphEntries.end();
+    for (auto it = glyphEntries.lower_bound(key); it != glyphEntries.end() && sameIDAndSize(it->first); ++it) {
+        if (it->second.glyph == glyph || it->second.glyph->bitmap == glyph->bitmap) {
+            found = it;
+            break;
+        }
+        if (unused == glyphEntries.end() && it->second.refs == 0) {
+            unused = it;
+        }
+        if (std::get<4>(it->first) == std::get<4>(key)) {
+            std::get<4>(key)++;
+        }
+    }
+
+    auto it = found != glyphEntries.end() ? found : unused;
+    if (it == glyphEntries.end()) {
+        const uint32_t width = size.width + 2 * padding;
+        const uint32_t height = size.height + 2 * padding;
+        mapbox::Bin* bin = pack(glyphs, glyphEntries, width, height);
+        if (!bin) {
+            return std::nullopt;
+        }
+        const Rect<uint16_t> rect{static_cast<uint16_t>(bin->x),
+                                  static_cast<uint16_t>(bin->y),
+                                  static_cast<uint16_t>(width),
+                                  static_cast<uint16_t>(height)};
+        it = glyphEntries.emplace(key, GlyphEntry{bin, rect, glyph}).first;
+    }
+
+    GlyphEntry& entry = it->second;
+    if (found == glyphEntries.end()) {
+        assert(entry.refs == 0);
+        entry.glyph = glyph;
+        AlphaImage::clear(glyphs.image, {entry.rect.x, entry.rect.y}, {entry.rect.w, entry.rect.h});
+        AlphaImage::copy(glyph->bitmap,
+                         glyphs.image,
+                         {0, 0},
+                         {static_cast<uint32_t>(entry.rect.x + padding), static_cast<uint32_t>(entry.rect.y + padding)},
+                         size);
+        markDirty(glyphs, entry.rect);
+    }
+
+    entry.refs++;
+    reference.glyphs.push_back(it->first);
+    return entry.rect;
+}
+
+std::optional<ImagePosition> SharedAtlas::addImage(const Immutable<style::Image::Impl>& image,
+                                                   const ImageType type,
+                                                   const uint32_t version,
+                                                   Reference& reference) {
+    const Size size = image->image.size;
+    ImageKey key{image->id, type, size.width, size.height};
+
+    auto it = imageEntries.find(key);
+    const bool added = it == imageEntries.end();
+    if (added) {
+        const uint32_t width = size.width + 2 * padding;
+        const uint32_t height = size.height + 2 * padding;
+        mapbox::Bin* bin = pack(icons, imageEntries, width, height);
+        if (!bin) {
+            return std::nullopt;
+        }
+        const Rect<uint16_t> rect{static_cast<uint16_t>(bin->x),
+                                  static_cast<uint16_t>(bin->y),
+                                  static_cast<uint16_t>(width),
+                                  static_cast<uint16_t>(height)};
+        it = imageEntries.emplace(key, ImageEntry{bin, rect, image, version}).first;
+    }
+
+    ImageEntry& entry = it->second;
+    if (added || (entry.image != image && version >= entry.version)) {
+        entry.image = image;
+        entry.version = version;
+        writeImage(entry, type);
+    }
+
+    entry.refs++;
+    reference.images.push_back(std::move(key));
+
+    ImagePosition position{*entry.bin, *image, entry.version};
+    position.paddedRect = entry.rect;
+    return position;
+}
+
+void SharedAtlas::writeImage(const ImageEntry& entry, const ImageType type) {
+    const PremultipliedImage& src = entry.image->image;
+    const uint32_t x = entry.rect.x + padding;
+    const uint32_t y = entry.rect.y + padding;
+    const uint32_t w = src.size.width;
+    const uint32_t h = src.size.height;
+
+    PremultipliedImage::clear(icons.image, {entry.rect.x, entry.rect.y}, {entry.rect.w, entry.rect.h});
+    PremultipliedImage::copy(src, icons.image, {0, 0}, {x, y}, src.size);
+
+    if (type == ImageType::Pattern) {
+        // Add 1 pixel wrapped padding on each side of the image.
+        PremultipliedImage::copy(src, icons.image, {0, h - 1}, {x, y - 1}, {w, 1}); // T
+        PremultipliedImage::copy(src, icons.image, {0, 0}, {x, y + h}, {w, 1});     // B
+        PremultipliedImage::copy(src, icons.image, {w - 1, 0}, {x - 1, y}, {1, h}); // L
+        PremultipliedImage::copy(src, icons.image, {0, 0}, {x + w, y}, {1, h});     // R
+    }
+
+    markDirty(icons, entry.rect);
+}
+
+void SharedAtlas::release(Reference& reference) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& key : reference.glyphs) {
+        auto& entry = glyphEntries.at(key);
+        assert(entry.refs > 0);
+        entry.refs--;
+    }
+    for (const auto& key : reference.images) {
+        auto& entry = imageEntries.at(key);
+        assert(entry.refs > 0);
+        entry.refs--;
+    }
+}
+
+void SharedAtlas::evict() {
+    std::lock_guard<std::mutex> lock(mutex);
+    evictUnused(glyphs, glyphEntries);
+    evictUnused(icons, imageEntries);
+}
+
+template <class Image, class Entries>
+mapbox::Bin* SharedAtlas::pack(Atlas<Image>& atlas, Entries& entries, const uint32_t width, const uint32_t height) {
+    if (width > maxSize || height > maxSize) {
+        return nullptr;
+    }
+    while (true) {
+        if (mapbox::Bin* bin = atlas.pack.packOne(-1, width, height)) {
+            return bin;
+        }
+        // Make room by dropping unused entries before making the atlas bigger
+        if (!evictUnused(atlas, entries) && !grow(atlas)) {
+            return nullptr;
+        }
+    }
+}
+
+template <class Image, class Entries>
+bool SharedAtlas::evictUnused(Atlas<Image>& atlas, Entries& entries) {
+    bool evicted = false;
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.refs == 0) {
+            // The bin is reused for entries of the same size or smaller, which clear it first
+            atlas.pack.unref(*it->second.bin);
+            it = entries.erase(it);
+            evicted = true;
+        } else {
+            ++it;
+        }
+    }
+    return evicted;
+}
+
+template <class Image>
+bool SharedAtlas::grow(Atlas<Image>& atlas) const {
+    int32_t width = atlas.pack.width();
+    int32_t height = atlas.pack.height();
+    if (width >= maxSize && height >= maxSize) {
+        return false;
+    }
+
+    // Entries keep their position, the contents of the atlas are copied to the top left of the new image
+    if (width <= height && width < maxSize) {
+        width = std::min<int32_t>(width * 2, maxSize);
+    } else {
+        height = std::min<int32_t>(height * 2, maxSize);
+    }
+    atlas.pack.resize(width, height);
+    atlas.image.resize({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+    atlas.resized = true;
+    return true;
+}
+
+template <class Image>
+void SharedAtlas::markDirty(Atlas<Image>& atlas, const Rect<uint16_t>& rect) {
+    if (!atlas.dirty) {
+        atlas.dirty = Rect<uint32_t>{rect.x, rect.y, rect.w, rect.h};
+        return;
+    }
+    // A single region, uploaded at once
+    auto& dirty = *atlas.dirty;
+    const uint32_t right = std::max<uint32_t>(dirty.x + dirty.w, rect.x + rect.w);
+    const uint32_t bottom = std::max<uint32_t>(dirty.y + dirty.h, rect.y + rect.h);
+    dirty.x = std::min<uint32_t>(dirty.x, rect.x);
+    dirty.y = std::min<uint32_t>(dirty.y, rect.y);
+    dirty.w = right - dirty.x;
+    dirty.h = bottom - dirty.y;
+}
+
+void SharedAtlas::patchUpdatedImages(const ImageManager& imageManager) {
+    for (const auto& [id, version] : imageManager.updatedImageVersions) {
+        for (auto it = imageEntries.lower_bound(ImageKey{id, ImageType::Icon, 0, 0});
+             it != imageEntries.end() && std::get<0>(it->first) == id;
+             ++it) {
+            ImageEntry& entry = it->second;
+            if (entry.version == version) {
+                continue;
+            }
+            const auto* updated = imageManager.getSharedImage(id);
+            if (!updated || (*updated)->image.size != entry.image->image.size) {
+                // Resized images are laid out again, and added as new entries
+                continue;
+            }
+            entry.image = *updated;
+            entry.version = version;
+            writeImage(entry, std::get<1>(it->first));
+        }
+    }
+}
+
+void SharedAtlas::upload(gfx::UploadPass& uploadPass,
+                         TileAtlasTextures& textures,
+                         const ImageManager& imageManager,
+                         gfx::RenderingStats& stats) {
+    MLN_TRACE_FUNC();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    patchUpdatedImages(imageManager);
+
+#if MLN_DRAWABLE_RENDERER
+    // Drawables keep the textures, they're updated in place even when the atlases grow
+    if (!textures.glyph) {
+        textures.glyph = uploadPass.getContext().createTexture2D();
+        if (textures.glyph) {
+            textures.glyph->setSamplerConfiguration(
+                {gfx::TextureFilterType::Linear, gfx::TextureWrapType::Clamp, gfx::TextureWrapType::Clamp});
+        }
+        glyphs.resized = true;
+    }
+    if (!textures.icon) {
+        textures.icon = uploadPass.getContext().createTexture2D();
+        icons.resized = true;
+    }
+#endif
+
+    uploadAtlas(uploadPass, textures.glyph, glyphs, stats);
+    uploadAtlas(uploadPass, textures.icon, icons, stats);
+}
+
+template <class Image, class Texture>
+void SharedAtlas::uploadAtlas([[maybe_unused]] gfx::UploadPass& uploadPass,
+                              Texture& texture,
+                              Atlas<Image>& atlas,
+                              gfx::RenderingStats& stats) {
+    if (atlas.resized || !texture) {
+        std::size_t bytes = atlas.image.bytes();
+#if MLN_DRAWABLE_RENDERER
+        if (!texture) {
+            return;
+        }
+        texture->upload(atlas.image);
+#else
+        if (texture) {
+            uploadPass.updateTexture(*texture, atlas.image);
+        } else {
+            texture = uploadPass.createTexture(atlas.image);
+        }
+#endif
+        stats.atlasUploadBytes += bytes;
+        stats.memAtlases += static_cast<int>(bytes) - static_cast<int>(atlas.uploadedBytes);
+        atlas.uploadedBytes = bytes;
+    } else if (atlas.dirty) {
+        const auto& dirty = *atlas.dirty;
+        Image region({dirty.w, dirty.h});
+        Image::copy(atlas.image, region, {dirty.x, dirty.y}, {0, 0}, region.size);
+#if MLN_DRAWABLE_RENDERER
+        texture->uploadSubRegion(region, static_cast<uint16_t>(dirty.x), static_cast<uint16_t>(dirty.y));
+#else
+        uploadPass.updateTextureSub(*texture, region, static_cast<uint16_t>(dirty.x), static_cast<uint16_t>(dirty.y));
+#endif
+        stats.atlasUploadBytes += region.bytes();
+    }
+    atlas.resized = false;
+    atlas.dirty = std::nullopt;
+}
+
+Size SharedAtlas::getGlyphAtlasSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return glyphs.image.size;
+}
+
+Size SharedAtlas::getIconAtlasSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return icons.image.size;
+}
+
+std::size_t SharedAtlas::getGlyphCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return glyphEntries.size();
+}
+
+std::size_t SharedAtlas::getImageCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return imageEntries.size();
+}
+
+AlphaImage SharedAtlas::getGlyphAtlasImageForTests() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return glyphs.image.clone();
+}
+
+PremultipliedImage SharedAtlas::getIconAtlasImageForTests() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return icons.image.clone();
+}
+
+} // namespace mbgl
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <mbgl/renderer/image_atlas.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <mapbox/shelf-pack.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mbgl {
+
+namespace gfx {
+class UploadPass;
+struct RenderingStats;
+} // namespace gfx
+
+class ImageManager;
+class TileAtlasTextures;
+
+/// The glyph atlas and the icon atlas of all the tiles of a renderer.
+///
+/// Tile workers add the glyphs and images of a layout and get their positions, along with a reference
+/// keeping them in the atlases. Entries that aren't referenced anymore stay where they are, so that tiles
+/// laid out later can use them again, until their space is needed. Only the regions changed since the
+/// previous upload are uploaded to the textures.
+class SharedAtlas : public std::enable_shared_from_this<SharedAtlas>, private util::noncopyable {
+private:
+    // Sizes are part of the keys, a resized image can be in use at both sizes until tiles are laid out again.
+    // The last part of glyph keys tells apart glyphs with the same ID and size, drawn differently by other
+    // requests, while layouts refer to each of them.
+    using GlyphKey = std::tuple<FontStackHash, GlyphID, uint32_t, uint32_t, uint32_t>;
+    using ImageKey = std::tuple<std::string, ImageType, uint32_t, uint32_t>;
+
+public:
+    /// Keeps the glyphs and images of a layout in the atlases until destroyed
+    class Reference : private util::noncopyable {
+    public:
+        ~Reference();
+
+    private:
+        friend class SharedAtlas;
+        explicit Reference(std::shared_ptr<SharedAtlas>);
+
+        const std::shared_ptr<SharedAtlas> atlas;
+        std::vector<GlyphKey> glyphs;
+        std::vector<ImageKey> images;
+    };
+
+    struct Layout {
+        GlyphPositions glyphPositions;
+        /// Positions only, the image is in the shared atlas
+        ImageAtlas iconAtlas;
+        std::shared_ptr<const Reference> reference;
+    };
+
+    /// @param maxSize The largest width and height of each atlas
+    static std::shared_ptr<SharedAtlas> create(uint16_t maxSize = 2048);
+
+    /// Thread-safe. Returns nothing if the glyphs and images don't fit, the tile should then make its own atlases.
+    std::optional<Layout> add(const GlyphMap&, const ImageMap& icons, const ImageMap& patterns, const ImageVersionMap&);
+
+    /// Copies images updated since they were added, and uploads the changed regions of the atlases.
+    /// Must be called on the render thread, before the textures are used.
+    void upload(gfx::UploadPass&, TileAtlasTextures&, const ImageManager&, gfx::RenderingStats&);
+
+    /// Removes the entries no layout refers to
+    void evict();
+
+    Size getGlyphAtlasSize() const;
+    Size getIconAtlasSize() const;
+    std::size_t getGlyphCount() const;
+    std::size_t getImageCount() const;
+
+    AlphaImage getGlyphAtlasImageForTests() const;
+    PremultipliedImage getIconAtlasImageForTests() const;
+
+private:
+    explicit SharedAtlas(uint16_t maxSize);
+
+    template <class Image>
+    struct Atlas {
+        explicit Atlas(uint16_t size);
+
+        mapbox::ShelfPack pack;
+        Image image;
+        // The region changed since the previous upload
+        std::optional<Rect<uint32_t>> dirty;
+        bool resized = true;
+        // The size of the texture, for the rendering stats
+        std::size_t uploadedBytes = 0;
+    };
+
+    struct GlyphEntry {
+        mapbox::Bin* bin;
+        Rect<uint16_t> rect;
+        Immutable<Glyph> glyph;
+        uint32_t refs = 0;
+    };
+
+    struct ImageEntry {
+        mapbox::Bin* bin;
+        Rect<uint16_t> rect;
+        Immutable<style::Image::Impl> image;
+        uint32_t version;
+        uint32_t refs = 0;
+    };
+
+    std::optional<Rect<uint16_t>> addGlyph(FontStackHash, const Immutable<Glyph>&, Reference&);
+    std::optional<ImagePosition> addImage(const Immutable<style::Image::Impl>&,
+                                          ImageType,
+                                          uint32_t version,
+                                          Reference&);
+    void writeImage(const ImageEntry&, ImageType);
+    void patchUpdatedImages(const ImageManager&);
+    void release(Reference&);
+
+    template <class Image, class Entries>
+    mapbox::Bin* pack(Atlas<Image>&, Entries&, uint32_t width, uint32_t height);
+    template <class Image, class Entries>
+    static bool evictUnused(Atlas<Image>&, Entries&);
+    template <class Image>
+    bool grow(Atlas<Image>&) const;
+    template <class Image>
+    static void markDirty(Atlas<Image>&, const Rect<uint16_t>&);
+    template <class Image, class Texture>
+    static void uploadAtlas(gfx::UploadPass&, Texture&, Atlas<Image>&, gfx::RenderingStats&);
+
+    const uint16_t maxSize;
+
+    mutable std::mutex mutex;
+    Atlas<AlphaImage> glyphs;
+    Atlas<PremultipliedImage> icons;
+    std::map<GlyphKey, GlyphEntry> glyphEntries;
+    std::map<ImageKey, ImageEntry> imageEntries;
+};
+
+} // namespace mbgl
@@ -45,58 +45,49 @@ void SourceFeatureState::getState(FeatureState& result,
 void SourceFeatureState::coalesceChanges(std::vector<RenderTile>& tiles) {
     MLN_TRACE_FUNC();
 
+    // Fold the pending changes into the current states, collecting the complete new state of only the features
+    // that were touched.  Updates and deletions within the same source layer are merged.
     LayerFeatureStates changes;
-    for (const auto& layerStatesEntry : stateChanges) {
-        const auto& sourceLayer = layerStatesEntry.first;
-        FeatureStates layerStates;
-        for (const auto& featureStatesEntry : stateChanges[sourceLayer]) {
-            const auto& featureID = featureStatesEntry.first;
-            for (const auto& stateEntry : stateChanges[sourceLayer][featureID]) {
-                const auto& stateKey = stateEntry.first;
-                const auto& stateVal = stateEntry.second;
-
-                auto currentState = currentStates[sourceLayer][featureID].find(stateKey);
-                if (currentState != currentStates[sourceLayer][featureID].end()) {
-                    currentState->second = stateVal;
-                } else {
-                    currentStates[sourceLayer][featureID].insert(std::make_pair(stateKey, stateVal));
-                }
+    for (auto& [sourceLayer, layerChanges] : stateChanges) {
+        auto& layerStates = currentStates[sourceLayer];
+        auto& changedStates = changes[sourceLayer];
+        for (auto& [featureID, featureChanges] : layerChanges) {
+            auto& current = layerStates[featureID];
+            for (auto& [stateKey, stateVal] : featureChanges) {
+                current.insert_or_assign(stateKey, std::move(stateVal));
             }
-            layerStates[featureID] = currentStates[sourceLayer][featureID];
+            changedStates[featureID] = current;
         }
-        changes[sourceLayer] = std::move(layerStates);
     }
 
-    for (const auto& layerStatesEntry : deletedStates) {
-        const auto& sourceLayer = layerStatesEntry.first;
-        FeatureStates layerStates = {{}, {}};
-
-        if (deletedStates[sourceLayer].empty()) {
-            for (const auto& featureStatesEntry : currentStates[sourceLayer]) {
-                const auto& featureID = featureStatesEntry.first;
-                layerStates[featureID] = {};
-                currentStates[sourceLayer][featureID] = {};
+    for (auto& [sourceLayer, layerDeletions] : deletedStates) {
+        auto& layerStates = currentStates[sourceLayer];
+        auto& changedStates = changes[sourceLayer];
+        if (layerDeletions.empty()) {
+            for (auto& [featureID, current] : layerStates) {
+                current.clear();
+                changedStates[featureID] = {};
             }
-        } else {
-            for (const auto& feature : deletedStates[sourceLayer]) {
-                const auto& featureID = feature.first;
-                bool deleteWholeFeatureState = deletedStates[sourceLayer][featureID].empty();
-                if (deleteWholeFeatureState) {
-                    currentStates[sourceLayer][featureID] = {};
-                } else {
-                    for (const auto& stateEntry : deletedStates[sourceLayer][featureID]) {
-                        currentStates[sourceLayer][featureID].erase(stateEntry.first);
-                    }
+            continue;
+        }
+
+        for (const auto& [featureID, deletedKeys] : layerDeletions) {
+            auto& current = layerStates[featureID];
+            if (deletedKeys.empty()) {
+                current.clear();
+            } else {
+                for (const auto& stateEntry : deletedKeys) {
+                    current.erase(stateEntry.first);
                 }
-                layerStates[featureID] = currentStates[sourceLayer][featureID];
             }
+            changedStates[featureID] = current;
         }
-        changes[sourceLayer] = std::move(layerStates);
     }
 
     stateChanges.clear();
     deletedStates.clear();
 
+    std::erase_if(changes, [](const auto& entry) { return entry.second.empty(); });
     if (changes.empty()) {
         return;
     }
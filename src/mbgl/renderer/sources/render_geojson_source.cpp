@@ -6,6 +6,8 @@
 
 #include <mapbox/eternal.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -59,6 +61,30 @@ FeatureExtensionValue getClusterExpansionZoom(std::shared_ptr<style::GeoJSONData
     return Value{static_cast<uint64_t>(clusterData->getClusterExpansionZoom(clusterID))};
 }
 
+// Whether any of the regions overlaps the tile, including the buffer around it
+// into which geojson-vt clips features. Copies of the tile one world to either
+// side are checked as well, since geojson-vt wraps features across the antimeridian.
+bool touchesTile(const CanonicalTileID& id,
+                 double buffer,
+                 const std::vector<style::GeoJSONSource::Impl::Region>& regions) {
+    const double size = 1.0 / static_cast<double>(1u << id.z);
+    const double minX = (id.x - buffer) * size;
+    const double maxX = (id.x + 1 + buffer) * size;
+    const double minY = (id.y - buffer) * size;
+    const double maxY = (id.y + 1 + buffer) * size;
+    return std::any_of(regions.begin(), regions.end(), [&](const auto& region) {
+        if (region.min.y > maxY || region.max.y < minY) {
+            return false;
+        }
+        for (const double shift : {-1.0, 0.0, 1.0}) {
+            if (region.min.x + shift <= maxX && region.max.x + shift >= minX) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
 constexpr const auto extensionGetters = mapbox::eternal::hash_map<mapbox::eternal::string, FeatureExtensionGetterPtr>(
     {{"children", &getChildren}, {"leaves", &getLeaves}, {"expansion-zoom", &getClusterExpansionZoom}});
 
@@ -84,17 +110,27 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
     enabled = needsRendering;
 
     auto data_ = impl().getData().lock();
-    if (data.lock() != data_) {
+    auto previous = data.lock();
+    if (previous != data_) {
         data = data_;
         if (parameters.mode != MapMode::Continuous) {
             // Clearing the tile pyramid in order to avoid render tests being flaky.
             tilePyramid.clearAll();
         } else if (data_) {
+            // After an update by feature ID, only tiles that the changed features touch reload
+            const auto* changed = previous && !needsRelayout ? impl().getChangedRegions(*previous) : nullptr;
+            const double buffer = static_cast<double>(impl().getOptions()->buffer) / impl().getOptions()->tileSize;
+
             tilePyramid.reduceMemoryUse();
             const uint8_t maxZ = impl().getZoomRange().max;
             for (const auto& pair : tilePyramid.getTiles()) {
                 if (pair.first.canonical.z <= maxZ) {
-                    static_cast<GeoJSONTile*>(pair.second.get())->updateData(data_, needsRelayout);
+                    auto* tile = static_cast<GeoJSONTile*>(pair.second.get());
+                    if (changed && !touchesTile(pair.first.canonical, buffer, *changed)) {
+                        tile->retainData(data_);
+                    } else {
+                        tile->updateData(data_, needsRelayout);
+                    }
                 }
             }
         }
@@ -14,6 +14,9 @@ class FileSource;
 class AnnotationManager;
 class ImageManager;
 class GlyphManager;
+class LayoutCache;
+class SharedAtlas;
+class TileAtlasTextures;
 
 class TileParameters {
 public:
@@ -27,6 +30,11 @@ public:
     std::shared_ptr<GlyphManager> glyphManager;
     const uint8_t prefetchZoomDelta;
     TaggedScheduler threadPool;
+    // Null when the layout cache is disabled
+    std::shared_ptr<LayoutCache> layoutCache;
+    // The glyph and icon atlases shared by the tiles and their textures, tiles make their own when null
+    std::shared_ptr<SharedAtlas> sharedAtlas;
+    std::shared_ptr<TileAtlasTextures> sharedAtlasTextures;
 };
 
 } // namespace mbgl
@@ -6,6 +6,7 @@
 #include <mbgl/map/transform.hpp>
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
@@ -25,6 +26,19 @@ using namespace style;
 static TileObserver nullObserver;
 static const std::map<OverscaledTileID, std::unique_ptr<Tile>> emptyPrefetchedTiles;
 
+// Distance from the viewport center to the nearest point of the tile in tiles of the given zoom
+// level, plus one for every zoom level between the tile and that zoom. Low zoom tiles covering the
+// center thereby load right after the central ideal tiles, and before the ones at the edges.
+static float tileLoadOrder(const OverscaledTileID& id, const TileCoordinatePoint& center, int32_t zoom) {
+    const int32_t zoomDelta = zoom - id.canonical.z;
+    const double scale = std::pow(2.0, zoomDelta);
+    const double x0 = (id.canonical.x + id.wrap * std::pow(2.0, id.canonical.z)) * scale;
+    const double y0 = id.canonical.y * scale;
+    const double dx = std::max({x0 - center.x, center.x - (x0 + scale), 0.0});
+    const double dy = std::max({y0 - center.y, center.y - (y0 + scale), 0.0});
+    return static_cast<float>(std::hypot(dx, dy) + std::abs(zoomDelta));
+}
+
 TilePyramid::TilePyramid(const TaggedScheduler& threadPool_)
     : cache(threadPool_),
       observer(&nullObserver) {}
@@ -144,9 +158,17 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     // using, e.g. as a replacement for tile that aren't loaded yet.
     std::set<OverscaledTileID> retain;
 
+    // Pending tile requests are reordered on every update, so that panning moves the tiles that
+    // came into view ahead of the ones that are about to leave it. Tiles which are no longer
+    // retained become optional below, which cancels their pending network requests.
+    const int32_t loadOrderZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
+    const TileCoordinatePoint viewportCenter =
+        TileCoordinate::fromLatLng(loadOrderZoom, parameters.transformState.getLatLng()).p;
+
     auto retainTileFn = [&](Tile& tile, TileNecessity necessity) -> void {
         if (retain.emplace(tile.id).second) {
             tile.setUpdateParameters({minimumUpdateInterval, isVolatile});
+            tile.setLoadOrder(tileLoadOrder(tile.id, viewportCenter, loadOrderZoom));
             tile.setNecessity(necessity);
         }
 
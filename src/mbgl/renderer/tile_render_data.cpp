@@ -1,7 +1,29 @@
 #include <mbgl/renderer/tile_render_data.hpp>
+#include <mbgl/gfx/rendering_stats.hpp>
 
 namespace mbgl {
 
+TileAtlasTextures::~TileAtlasTextures() {
+    if (stats) {
+        stats->memAtlases -= static_cast<int>(glyphBytes + iconBytes);
+    }
+}
+
+void TileAtlasTextures::setGlyphBytes(gfx::RenderingStats& stats_, std::size_t bytes) {
+    setBytes(stats_, glyphBytes, bytes);
+}
+
+void TileAtlasTextures::setIconBytes(gfx::RenderingStats& stats_, std::size_t bytes) {
+    setBytes(stats_, iconBytes, bytes);
+}
+
+void TileAtlasTextures::setBytes(gfx::RenderingStats& stats_, std::size_t& current, std::size_t bytes) {
+    assert(!stats || stats == &stats_);
+    stats = &stats_;
+    stats->memAtlases += static_cast<int>(bytes) - static_cast<int>(current);
+    current = bytes;
+}
+
 TileRenderData::TileRenderData() = default;
 
 TileRenderData::TileRenderData(std::shared_ptr<TileAtlasTextures> atlasTextures_)
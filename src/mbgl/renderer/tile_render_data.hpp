@@ -16,6 +16,7 @@ using Texture2DPtr = std::shared_ptr<gfx::Texture2D>;
 #endif
 
 class UploadPass;
+struct RenderingStats;
 } // namespace gfx
 
 class Bucket;
@@ -24,6 +25,11 @@ class SourcePrepareParameters;
 
 class TileAtlasTextures {
 public:
+    TileAtlasTextures() = default;
+    TileAtlasTextures(const TileAtlasTextures&) = delete;
+    TileAtlasTextures& operator=(const TileAtlasTextures&) = delete;
+    ~TileAtlasTextures();
+
 #if MLN_DRAWABLE_RENDERER
     gfx::Texture2DPtr glyph;
     gfx::Texture2DPtr icon;
@@ -31,6 +37,18 @@ public:
     std::optional<gfx::Texture> glyph;
     std::optional<gfx::Texture> icon;
 #endif
+
+    // The size of the textures of a single tile's atlases, counted in `RenderingStats::memAtlases` until
+    // they're replaced or released. The shared atlas counts its textures itself.
+    void setGlyphBytes(gfx::RenderingStats&, std::size_t);
+    void setIconBytes(gfx::RenderingStats&, std::size_t);
+
+private:
+    void setBytes(gfx::RenderingStats&, std::size_t& current, std::size_t);
+
+    gfx::RenderingStats* stats = nullptr;
+    std::size_t glyphBytes = 0;
+    std::size_t iconBytes = 0;
 };
 
 class TileRenderData {
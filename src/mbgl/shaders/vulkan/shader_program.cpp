@@ -55,10 +55,23 @@ ShaderProgram::ShaderProgram(shaders::BuiltIn shaderID,
     constexpr auto messages = EShMsgSpvRules | EShMsgVulkanRules;
     const auto defaultResources = GetDefaultResources();
 
+    auto& context = static_cast<Context&>(backend.getContext());
+    const auto& pipelineCache = context.getPipelineCache();
+    bool compiled = false;
+
     const auto compileGlsl = [&](const EShLanguage& language, const std::string_view& data, const char* prelude) {
+        const auto preamble = defineStr + "\n" + prelude;
+
+        // Shaders compiled by a previous run
+        const auto key = pipelineCache.makeShaderKey(
+            language == EShLanguage::EShLangVertex ? "vertex" : "fragment", preamble, data);
+        if (auto spirv = pipelineCache.loadShader(key); !spirv.empty()) {
+            return spirv;
+        }
+        compiled = true;
+
         glslang::TShader glslShader(language);
 
-        const auto preamble = defineStr + "\n" + prelude;
         const char* shaderData = data.data();
         const int shaderDataSize = static_cast<int>(data.size());
 
@@ -88,6 +101,7 @@ ShaderProgram::ShaderProgram(shaders::BuiltIn shaderID,
         std::vector<uint32_t> spirv;
         glslang::GlslangToSpv(*intermediate, spirv);
 
+        pipelineCache.storeShader(key, spirv);
         return spirv;
     };
 
@@ -102,6 +116,15 @@ ShaderProgram::ShaderProgram(shaders::BuiltIn shaderID,
 
     if (vertexSpirv.empty() || fragmentSpirv.empty()) return;
 
+    if (pipelineCache.isPersistent()) {
+        auto& stats = context.renderingStats();
+        if (compiled) {
+            stats.numProgramBinaryMisses++;
+        } else {
+            stats.numProgramBinaryHits++;
+        }
+    }
+
     const auto& device = backend.getDevice();
 
     vertexShader = device->createShaderModuleUnique(
@@ -223,7 +246,9 @@ const vk::UniquePipeline& ShaderProgram::getPipeline(const PipelineInfo& pipelin
                                         .setLayout(pipelineLayout.get())
                                         .setRenderPass(pipelineInfo.renderPass);
 
-    pipeline = std::move(device->createGraphicsPipelineUnique(nullptr, pipelineCreateInfo).value);
+    pipeline = std::move(
+        device->createGraphicsPipelineUnique(context.getPipelineCache().get(), pipelineCreateInfo).value);
+    context.renderingStats().numCreatedPipelines++;
     backend.setDebugName(pipeline.get(), shaderName + "_pipeline");
 
     return pipeline;
@@ -44,6 +44,8 @@ public:
     auto end() const { return wrappers.end(); }
 
     void clear();
+    // Removes all the elements and returns them, in order.
+    WrapperVector release();
 
 protected:
     std::size_t index(const std::string&) const;
@@ -142,6 +144,15 @@ void CollectionBase<T>::clear() {
     wrappers.clear();
 }
 
+template <class T>
+typename CollectionBase<T>::WrapperVector CollectionBase<T>::release() {
+    mutate(impls, [&](auto& impls_) { impls_.clear(); });
+
+    WrapperVector result;
+    result.swap(wrappers);
+    return result;
+}
+
 template <class T>
 T* CollectionBase<T>::add(std::size_t wrapperIndex, std::size_t implIndex, std::unique_ptr<T> wrapper) {
     assert(wrapperIndex <= size());
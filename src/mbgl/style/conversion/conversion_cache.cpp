@@ -0,0 +1,28 @@
+#include <mbgl/style/conversion/conversion_cache.hpp>
+
+namespace mbgl {
+namespace style {
+namespace conversion {
+
+namespace {
+
+thread_local ConversionCache* currentCache = nullptr;
+
+} // namespace
+
+ConversionCache::ConversionCache()
+    : previous(currentCache) {
+    currentCache = this;
+}
+
+ConversionCache::~ConversionCache() {
+    currentCache = previous;
+}
+
+ConversionCache* ConversionCache::current() {
+    return currentCache;
+}
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <typeindex>
+
+namespace mbgl {
+namespace style {
+namespace conversion {
+
+/// Keeps the results of the conversions of values that can be reached more than once, the shared values of a
+/// style snapshot, so that a filter or property value used by many layers is converted once. Conversions on a
+/// thread use the cache while it exists, and results share their parsed expressions.
+class ConversionCache : private util::noncopyable {
+public:
+    ConversionCache();
+    ~ConversionCache();
+
+    /// Returns the kept result of converting `value` to `T` with the same options, or converts it with
+    /// `convert` and keeps the result if it succeeds.
+    template <class T, class Fn>
+    static std::optional<T> get(const Convertible& value, uint32_t options, Fn&& convert) {
+        ConversionCache* cache = current();
+        const void* id = cache ? identity(value) : nullptr;
+        if (!id) {
+            return convert();
+        }
+
+        const Key key{id, std::type_index(typeid(T)), options};
+        if (const auto it = cache->results.find(key); it != cache->results.end()) {
+            return *std::static_pointer_cast<const T>(it->second);
+        }
+        std::optional<T> result = convert();
+        if (result) {
+            cache->results.emplace(key, std::make_shared<const T>(*result));
+        }
+        return result;
+    }
+
+private:
+    static ConversionCache* current();
+
+    using Key = std::tuple<const void*, std::type_index, uint32_t>;
+    std::map<Key, std::shared_ptr<const void>> results;
+    ConversionCache* const previous;
+};
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
@@ -1,3 +1,4 @@
+#include <mbgl/style/conversion/conversion_cache.hpp>
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/style/expression/boolean_operator.hpp>
@@ -18,7 +19,7 @@ static bool isExpression(const Convertible& filter);
 ParseResult convertLegacyFilter(const Convertible& values, Error& error);
 std::optional<mbgl::Value> serializeLegacyFilter(const Convertible& values);
 
-std::optional<Filter> Converter<Filter>::operator()(const Convertible& value, Error& error) const {
+static std::optional<Filter> convertFilter(const Convertible& value, Error& error) {
     if (isExpression(value)) {
         ParsingContext parsingContext(type::Boolean);
         ParseResult parseResult = parsingContext.parseExpression(value);
@@ -38,6 +39,10 @@ std::optional<Filter> Converter<Filter>::operator()(const Convertible& value, Er
     }
 }
 
+std::optional<Filter> Converter<Filter>::operator()(const Convertible& value, Error& error) const {
+    return ConversionCache::get<Filter>(value, 0, [&] { return convertFilter(value, error); });
+}
+
 // This is a port from
 // https://github.com/mapbox/mapbox-gl-js/blob/master/src/style-spec/feature_filter/index.js
 bool isExpression(const Convertible& filter) {
@@ -1,3 +1,4 @@
+#include <mbgl/style/conversion/conversion_cache.hpp>
 #include <mbgl/style/conversion/position.hpp>
 #include <mbgl/style/conversion/property_value.hpp>
 #include <mbgl/style/conversion/rotation.hpp>
@@ -7,11 +8,13 @@ namespace mbgl {
 namespace style {
 namespace conversion {
 
+namespace {
+
 template <class T>
-std::optional<PropertyValue<T>> Converter<PropertyValue<T>>::operator()(const Convertible& value,
-                                                                        Error& error,
-                                                                        bool allowDataExpressions,
-                                                                        bool convertTokens) const {
+std::optional<PropertyValue<T>> convertPropertyValue(const Convertible& value,
+                                                     Error& error,
+                                                     bool allowDataExpressions,
+                                                     bool convertTokens) {
     using namespace mbgl::style::expression;
 
     if (isUndefined(value)) {
@@ -60,6 +63,18 @@ std::optional<PropertyValue<T>> Converter<PropertyValue<T>>::operator()(const Co
     }
 }
 
+} // namespace
+
+template <class T>
+std::optional<PropertyValue<T>> Converter<PropertyValue<T>>::operator()(const Convertible& value,
+                                                                        Error& error,
+                                                                        bool allowDataExpressions,
+                                                                        bool convertTokens) const {
+    const uint32_t options = (allowDataExpressions ? 1 : 0) | (convertTokens ? 2 : 0);
+    return ConversionCache::get<PropertyValue<T>>(
+        value, options, [&] { return convertPropertyValue<T>(value, error, allowDataExpressions, convertTokens); });
+}
+
 template std::optional<PropertyValue<bool>> Converter<PropertyValue<bool>>::operator()(conversion::Convertible const&,
                                                                                        conversion::Error&,
                                                                                        bool,
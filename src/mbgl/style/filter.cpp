@@ -1,12 +1,26 @@
 #include <mbgl/style/filter.hpp>
+#include <mbgl/style/filter_program.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 namespace mbgl {
 namespace style {
 
+Filter::Filter(expression::ParseResult _expression, std::optional<mbgl::Value> _filter)
+    : expression(std::move(*_expression)),
+      legacyFilter(std::move(_filter)) {
+    assert(!expression || *expression != nullptr);
+    if (expression) {
+        program = FilterProgram::compile(*expression);
+    }
+}
+
 bool Filter::operator()(const expression::EvaluationContext &context) const {
     if (!this->expression) return true;
 
+    if (program && context.feature) {
+        return (*program)(context);
+    }
+
     const expression::EvaluationResult result = (*this->expression)->evaluate(context);
     if (result) {
         const std::optional<bool> typed = expression::fromExpressionValue<bool>(*result);
@@ -16,5 +30,19 @@ bool Filter::operator()(const expression::EvaluationContext &context) const {
     }
 }
 
+bool Filter::operator()(const expression::EvaluationContext &context, const FilterKeyBinding &binding) const {
+    if (program && context.feature) {
+        return (*program)(context, &binding);
+    }
+    return (*this)(context);
+}
+
+std::optional<FilterKeyBinding> Filter::bind(const GeometryTileLayer &layer) const {
+    if (!program) {
+        return std::nullopt;
+    }
+    return program->bind(layer);
+}
+
 } // namespace style
 } // namespace mbgl
@@ -0,0 +1,468 @@
+#include <mbgl/style/filter_program.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace mbgl {
+namespace style {
+
+using namespace expression;
+
+namespace {
+
+std::vector<const Expression*> childrenOf(const Expression& node) {
+    std::vector<const Expression*> children;
+    node.eachChild([&](const Expression& child) { children.push_back(&child); });
+    return children;
+}
+
+const expression::Value* literalOf(const Expression& node) {
+    if (node.getKind() != Kind::Literal) {
+        return nullptr;
+    }
+    return &static_cast<const Literal&>(node).getValue();
+}
+
+const std::string* literalStringOf(const Expression& node) {
+    const auto* value = literalOf(node);
+    return value && value->is<std::string>() ? &value->get<std::string>() : nullptr;
+}
+
+bool isCompound(const Expression& node, const char* op) {
+    return node.getKind() == Kind::CompoundExpression && node.getOperator() == op;
+}
+
+// The key of a `["get", key]` expression reading a feature property
+const std::string* propertyKeyOf(const Expression& node) {
+    if (!isCompound(node, "get")) {
+        return nullptr;
+    }
+    const auto children = childrenOf(node);
+    return children.size() == 1 ? literalStringOf(*children[0]) : nullptr;
+}
+
+std::optional<std::uint32_t> featureTypeBit(const std::string& type) {
+    if (type == "Unknown") return 1u << static_cast<std::uint32_t>(FeatureType::Unknown);
+    if (type == "Point") return 1u << static_cast<std::uint32_t>(FeatureType::Point);
+    if (type == "LineString") return 1u << static_cast<std::uint32_t>(FeatureType::LineString);
+    if (type == "Polygon") return 1u << static_cast<std::uint32_t>(FeatureType::Polygon);
+    return std::nullopt;
+}
+
+// Compares a feature property or identifier with a constant the way the expression would after
+// converting the former into an expression value, where all numbers are doubles.
+template <typename T, typename Constant>
+bool equals(const T& value, const Constant& constant) {
+    return value.match(
+        [&](const NullValue&) { return constant.template is<NullValue>(); },
+        [&](bool b) { return constant.template is<bool>() && constant.template get<bool>() == b; },
+        [&](uint64_t n) { return constant.template is<double>() && constant.template get<double>() == double(n); },
+        [&](int64_t n) { return constant.template is<double>() && constant.template get<double>() == double(n); },
+        [&](double n) { return constant.template is<double>() && constant.template get<double>() == n; },
+        [&](const std::string& s) {
+            return constant.template is<std::string>() && constant.template get<std::string>() == s;
+        },
+        [&](const auto&) { return false; });
+}
+
+std::optional<double> numberOf(const mbgl::Value& value) {
+    return value.match([](double n) -> std::optional<double> { return n; },
+                       [](uint64_t n) -> std::optional<double> { return static_cast<double>(n); },
+                       [](int64_t n) -> std::optional<double> { return static_cast<double>(n); },
+                       [](const auto&) -> std::optional<double> { return std::nullopt; });
+}
+
+} // namespace
+
+struct FilterProgram::Context {
+    const EvaluationContext& evaluation;
+    const GeometryTileFeature& feature;
+    const FilterKeyBinding* binding;
+    // Owns the value returned by `lookup` when it has to be copied out of the feature
+    mutable std::optional<mbgl::Value> scratch;
+};
+
+class FilterProgram::Compiler {
+public:
+    explicit Compiler(FilterProgram& program_)
+        : program(program_) {}
+
+    // Returns false if the root expression can't be lowered
+    bool compileRoot(const Expression& node) { return lowerLeaf(node) || lowerBranch(node); }
+
+private:
+    void lower(const Expression& node) {
+        if (lowerLeaf(node) || lowerBranch(node)) {
+            return;
+        }
+        emit(Op::Fallback, 0, static_cast<std::uint32_t>(program.fallbacks.size()));
+        program.fallbacks.push_back(&node);
+    }
+
+    bool lowerBranch(const Expression& node) {
+        const auto children = childrenOf(node);
+        const Kind kind = node.getKind();
+        if (kind == Kind::All || kind == Kind::Any) {
+            const auto index = emit(kind == Kind::All ? Op::All : Op::Any);
+            program.code[index].count = static_cast<std::uint32_t>(children.size());
+            for (const auto* child : children) {
+                lower(*child);
+            }
+            finish(index);
+            return true;
+        }
+        if (isCompound(node, "!") && children.size() == 1) {
+            const auto index = emit(Op::Not);
+            lower(*children[0]);
+            finish(index);
+            return true;
+        }
+        return false;
+    }
+
+    bool lowerLeaf(const Expression& node) {
+        const auto children = childrenOf(node);
+        switch (node.getKind()) {
+            case Kind::Literal: {
+                const auto* value = literalOf(node);
+                if (!value->is<bool>()) return false;
+                emit(value->get<bool>() ? Op::True : Op::False);
+                return true;
+            }
+            case Kind::Comparison:
+                return lowerComparison(node, children);
+            case Kind::In: {
+                // ["in", ["get", key], ["literal", [...]]]
+                const auto* key = children.size() == 2 ? propertyKeyOf(*children[0]) : nullptr;
+                const auto* haystack = key ? literalOf(*children[1]) : nullptr;
+                if (!haystack || !haystack->is<std::vector<expression::Value>>()) return false;
+                return emitConstants(Op::GetIn, *key, haystack->get<std::vector<expression::Value>>());
+            }
+            case Kind::CompoundExpression:
+                return lowerCompound(node.getOperator(), children);
+            default:
+                return false;
+        }
+    }
+
+    // ["==" | "!=", ["get", key] | ["geometry-type"], literal], in either order
+    bool lowerComparison(const Expression& node, const std::vector<const Expression*>& children) {
+        const std::string op = node.getOperator();
+        // Collator comparisons have a third child
+        if ((op != "==" && op != "!=") || children.size() != 2) {
+            return false;
+        }
+
+        const auto* lhs = children[0];
+        const auto* rhs = children[1];
+        if (literalOf(*lhs)) {
+            std::swap(lhs, rhs);
+        }
+        const auto* literal = literalOf(*rhs);
+        if (!literal) {
+            return false;
+        }
+
+        std::optional<std::size_t> negation;
+        const auto negate = [&] {
+            if (op == "!=") {
+                negation = emit(Op::Not);
+            }
+        };
+
+        if (const auto* key = propertyKeyOf(*lhs)) {
+            const auto constant = constantOf(*literal);
+            if (!constant) return false;
+            negate();
+            emit(Op::GetEquals, keyIndex(*key), addConstant(*constant));
+        } else if (isCompound(*lhs, "geometry-type") && literal->is<std::string>()) {
+            negate();
+            emit(Op::TypeIn, 0, featureTypeBit(literal->get<std::string>()).value_or(0));
+        } else {
+            return false;
+        }
+
+        if (negation) {
+            finish(*negation);
+        }
+        return true;
+    }
+
+    bool lowerCompound(const std::string& op, const std::vector<const Expression*>& children) {
+        if (op == "has" || op == "filter-has") {
+            const auto* key = children.size() == 1 ? literalStringOf(*children[0]) : nullptr;
+            if (!key) return false;
+            emit(Op::Has, keyIndex(*key));
+            return true;
+        }
+        if (op == "filter-has-id") {
+            emit(Op::HasID);
+            return true;
+        }
+        if (op == "filter-type-==" || op == "filter-type-in") {
+            std::uint32_t mask = 0;
+            for (const auto* child : children) {
+                const auto* type = literalStringOf(*child);
+                if (!type) return false;
+                mask |= featureTypeBit(*type).value_or(0);
+            }
+            emit(Op::TypeIn, 0, mask);
+            return true;
+        }
+        if (op == "filter-id-==" || op == "filter-id-in") {
+            std::vector<expression::Value> values;
+            for (const auto* child : children) {
+                const auto* value = literalOf(*child);
+                if (!value) return false;
+                values.push_back(*value);
+            }
+            return emitConstants(Op::IDIn, {}, values);
+        }
+
+        // The remaining legacy filters all take a property key first
+        const auto* key = children.empty() ? nullptr : literalStringOf(*children[0]);
+        if (!key) {
+            return false;
+        }
+
+        std::vector<expression::Value> values;
+        for (std::size_t i = 1; i < children.size(); ++i) {
+            const auto* value = literalOf(*children[i]);
+            if (!value) return false;
+            values.push_back(*value);
+        }
+
+        if (op == "filter-in") {
+            if (values.empty()) {
+                emit(Op::False);
+                return true;
+            }
+            return emitConstants(Op::In, *key, values);
+        }
+
+        std::optional<Op> comparison;
+        if (op == "filter-==") {
+            comparison = Op::Equals;
+        } else if (op == "filter-<") {
+            comparison = Op::Less;
+        } else if (op == "filter-<=") {
+            comparison = Op::LessEqual;
+        } else if (op == "filter->") {
+            comparison = Op::Greater;
+        } else if (op == "filter->=") {
+            comparison = Op::GreaterEqual;
+        }
+        if (!comparison || values.size() != 1) {
+            return false;
+        }
+        const auto constant = constantOf(values[0]);
+        if (!constant || (*comparison != Op::Equals && !constant->is<double>() && !constant->is<std::string>())) {
+            return false;
+        }
+        emit(*comparison, keyIndex(*key), addConstant(*constant));
+        return true;
+    }
+
+    bool emitConstants(Op op, const std::string& key, const std::vector<expression::Value>& values) {
+        std::vector<Constant> converted;
+        converted.reserve(values.size());
+        for (const auto& value : values) {
+            auto constant = constantOf(value);
+            if (!constant) return false;
+            converted.push_back(std::move(*constant));
+        }
+
+        const auto first = static_cast<std::uint32_t>(program.constants.size());
+        std::move(converted.begin(), converted.end(), std::back_inserter(program.constants));
+        const auto index = emit(op, op == Op::IDIn ? 0 : keyIndex(key), first);
+        program.code[index].count = static_cast<std::uint32_t>(values.size());
+        return true;
+    }
+
+    static std::optional<Constant> constantOf(const expression::Value& value) {
+        return value.match([](const NullValue&) -> std::optional<Constant> { return Constant(NullValue()); },
+                           [](bool b) -> std::optional<Constant> { return Constant(b); },
+                           [](double n) -> std::optional<Constant> { return Constant(n); },
+                           [](const std::string& s) -> std::optional<Constant> { return Constant(s); },
+                           [](const auto&) -> std::optional<Constant> { return std::nullopt; });
+    }
+
+    std::uint32_t addConstant(Constant constant) {
+        program.constants.push_back(std::move(constant));
+        return static_cast<std::uint32_t>(program.constants.size() - 1);
+    }
+
+    std::uint32_t keyIndex(const std::string& key) {
+        auto it = std::find(program.keys.begin(), program.keys.end(), key);
+        if (it == program.keys.end()) {
+            it = program.keys.insert(it, key);
+        }
+        return static_cast<std::uint32_t>(it - program.keys.begin());
+    }
+
+    std::size_t emit(Op op, std::uint32_t key = 0, std::uint32_t first = 0) {
+        program.code.push_back({op, 1, key, first, 0});
+        return program.code.size() - 1;
+    }
+
+    // Record the extent of the subtree rooted at `index` once all of its children are emitted
+    void finish(std::size_t index) {
+        program.code[index].size = static_cast<std::uint32_t>(program.code.size() - index);
+    }
+
+    FilterProgram& program;
+};
+
+std::shared_ptr<const FilterProgram> FilterProgram::compile(std::shared_ptr<const Expression> filter) {
+    if (!filter || filter->getType() != type::Boolean) {
+        return nullptr;
+    }
+
+    auto program = std::make_shared<FilterProgram>();
+    if (!Compiler(*program).compileRoot(*filter)) {
+        return nullptr;
+    }
+    program->root = std::move(filter);
+    return program;
+}
+
+std::optional<FilterKeyBinding> FilterProgram::bind(const GeometryTileLayer& layer) const {
+    if (!layer.hasKeyTable()) {
+        return std::nullopt;
+    }
+
+    FilterKeyBinding binding;
+    binding.reserve(keys.size());
+    for (const auto& key : keys) {
+        binding.push_back(layer.keyIndex(key));
+    }
+    return binding;
+}
+
+bool FilterProgram::operator()(const EvaluationContext& evaluation, const FilterKeyBinding* binding) const {
+    assert(evaluation.feature);
+    assert(!binding || binding->size() == keys.size());
+    const Context context{evaluation, *evaluation.feature, binding, std::nullopt};
+    return run(0, context) == Result::True;
+}
+
+const mbgl::Value* FilterProgram::lookup(std::uint32_t key, const Context& context) const {
+    if (context.binding) {
+        const auto& index = (*context.binding)[key];
+        return index ? context.feature.getValueByKeyIndex(*index) : nullptr;
+    }
+    context.scratch = context.feature.getValue(keys[key]);
+    return context.scratch ? &*context.scratch : nullptr;
+}
+
+FilterProgram::Result FilterProgram::run(std::size_t pc, const Context& context) const {
+    const auto toResult = [](bool value) {
+        return value ? Result::True : Result::False;
+    };
+    const auto anyOf = [&](const Instruction& instruction, const auto& predicate) {
+        const auto begin = constants.begin() + instruction.first;
+        return std::any_of(begin, begin + instruction.count, predicate);
+    };
+
+    const Instruction& instruction = code[pc];
+    switch (instruction.op) {
+        case Op::True:
+            return Result::True;
+        case Op::False:
+            return Result::False;
+        case Op::All:
+        case Op::Any: {
+            // Stop at the first child that decides the result, or fails to evaluate
+            const Result decisive = instruction.op == Op::All ? Result::False : Result::True;
+            std::size_t child = pc + 1;
+            for (std::uint32_t i = 0; i < instruction.count; ++i) {
+                const Result result = run(child, context);
+                if (result == decisive || result == Result::Error) {
+                    return result;
+                }
+                child += code[child].size;
+            }
+            return instruction.op == Op::All ? Result::True : Result::False;
+        }
+        case Op::Not: {
+            const Result result = run(pc + 1, context);
+            return result == Result::Error ? result : toResult(result == Result::False);
+        }
+        case Op::Has:
+            return toResult(lookup(instruction.key, context) != nullptr);
+        case Op::HasID:
+            return toResult(!context.feature.getID().is<NullValue>());
+        case Op::Equals: {
+            const auto* value = lookup(instruction.key, context);
+            return toResult(value && equals(*value, constants[instruction.first]));
+        }
+        case Op::GetEquals: {
+            const auto* value = lookup(instruction.key, context);
+            const auto& constant = constants[instruction.first];
+            return toResult(value ? equals(*value, constant) : constant.is<NullValue>());
+        }
+        case Op::In: {
+            const auto* value = lookup(instruction.key, context);
+            return toResult(value && anyOf(instruction, [&](const Constant& c) { return equals(*value, c); }));
+        }
+        case Op::GetIn: {
+            const auto* value = lookup(instruction.key, context);
+            if (!value || value->is<NullValue>()) {
+                return Result::False;
+            }
+            if (value->is<std::vector<mbgl::Value>>() || value->is<PropertyMap>()) {
+                // `in` requires a boolean, string or number needle
+                return Result::Error;
+            }
+            return toResult(anyOf(instruction, [&](const Constant& c) { return equals(*value, c); }));
+        }
+        case Op::IDIn: {
+            const FeatureIdentifier id = context.feature.getID();
+            return toResult(anyOf(instruction, [&](const Constant& c) { return equals(id, c); }));
+        }
+        case Op::TypeIn:
+            return toResult((instruction.first & (1u << static_cast<std::uint32_t>(context.feature.getType()))) != 0);
+        case Op::Less:
+        case Op::LessEqual:
+        case Op::Greater:
+        case Op::GreaterEqual: {
+            const auto* value = lookup(instruction.key, context);
+            if (!value) {
+                return Result::False;
+            }
+            const auto compare = [&](const auto& lhs, const auto& rhs) {
+                switch (instruction.op) {
+                    case Op::Less:
+                        return lhs < rhs;
+                    case Op::LessEqual:
+                        return lhs <= rhs;
+                    case Op::Greater:
+                        return lhs > rhs;
+                    default:
+                        return lhs >= rhs;
+                }
+            };
+            const auto& constant = constants[instruction.first];
+            if (constant.is<double>()) {
+                const auto number = numberOf(*value);
+                return toResult(number && compare(*number, constant.get<double>()));
+            }
+            return toResult(value->is<std::string>() &&
+                            compare(value->get<std::string>(), constant.get<std::string>()));
+        }
+        case Op::Fallback: {
+            const EvaluationResult result = fallbacks[instruction.first]->evaluate(context.evaluation);
+            if (!result) {
+                return Result::Error;
+            }
+            return toResult(result->is<bool>() && result->get<bool>());
+        }
+    }
+    return Result::Error;
+}
+
+} // namespace style
+} // namespace mbgl
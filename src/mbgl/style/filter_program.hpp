@@ -0,0 +1,102 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/variant.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class GeometryTileFeature;
+class GeometryTileLayer;
+
+namespace style {
+
+/**
+ * @brief Flat, pre-compiled form of a filter expression.
+ *
+ * The common filter shapes (`all`, `any`, `!`, `has`, `==`/`!=` and `in` against literals, legacy
+ * property comparisons and `$type` tests) are lowered into a prefix-ordered instruction list which
+ * reads feature properties directly, without evaluating `Expression` nodes or converting feature
+ * values into expression values. Any other boolean sub-expression is kept as a leaf which evaluates
+ * the original expression tree, so the result is always identical to evaluating the expression.
+ *
+ * Property keys are collected into a table so that they can be resolved once per source layer into
+ * that layer's key indices, see `bind`.
+ */
+class FilterProgram {
+public:
+    /// Compile the given filter expression, or return null if its root can't be lowered
+    static std::shared_ptr<const FilterProgram> compile(std::shared_ptr<const expression::Expression>);
+
+    /// Resolve the property keys used by the program against the key table of `layer`, if it has one
+    std::optional<FilterKeyBinding> bind(const GeometryTileLayer& layer) const;
+
+    /// Evaluate the program for `context.feature`, which must be set. With a binding, the feature must
+    /// have been visited on the layer the binding was made for.
+    bool operator()(const expression::EvaluationContext& context, const FilterKeyBinding* binding = nullptr) const;
+
+    /// Number of instructions, and how many of those fall back to evaluating an expression tree
+    std::size_t size() const { return code.size(); }
+    std::size_t fallbackCount() const { return fallbacks.size(); }
+
+private:
+    class Compiler;
+
+    enum class Op : uint8_t {
+        True,
+        False,
+        All,          // `count` children follow
+        Any,          // `count` children follow
+        Not,          // one child follows
+        Has,          // property `key` is present
+        HasID,        // the feature has an identifier
+        Equals,       // property `key` is present and equal to constant `first` (legacy `==`)
+        GetEquals,    // property `key`, or null if absent, is equal to constant `first` (`["==", ["get", key], …]`)
+        In,           // property `key` is present and equal to one of `count` constants from `first` (legacy)
+        GetIn,        // property `key` is a scalar equal to one of `count` constants from `first`
+        IDIn,         // the feature identifier, or null, is equal to one of `count` constants from `first`
+        TypeIn,       // the feature type is in the bit mask `first`
+        Less,         // legacy ordering comparisons of property `key` against constant `first`
+        LessEqual,    //
+        Greater,      //
+        GreaterEqual, //
+        Fallback,     // evaluate expression `first` of `fallbacks`
+    };
+
+    struct Instruction {
+        Op op;
+        std::uint32_t size = 1; // Instructions in this subtree, including this one
+        std::uint32_t key = 0;
+        std::uint32_t first = 0;
+        std::uint32_t count = 0;
+    };
+
+    // Expression results can be errors, which have to propagate like they do in the tree
+    enum class Result : uint8_t {
+        False,
+        True,
+        Error
+    };
+
+    using Constant = variant<NullValue, bool, double, std::string>;
+
+    struct Context;
+
+    Result run(std::size_t pc, const Context&) const;
+    const Value* lookup(std::uint32_t key, const Context&) const;
+
+    std::shared_ptr<const expression::Expression> root;
+    std::vector<Instruction> code;
+    std::vector<Constant> constants;
+    std::vector<std::string> keys;
+    std::vector<const expression::Expression*> fallbacks;
+};
+
+} // namespace style
+} // namespace mbgl
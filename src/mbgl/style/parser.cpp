@@ -1,6 +1,7 @@
 #include <mbgl/style/parser.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
+#include <mbgl/style/conversion/conversion_cache.hpp>
 #include <mbgl/style/conversion/coordinate.hpp>
 #include <mbgl/style/conversion/source.hpp>
 #include <mbgl/style/conversion/layer.hpp>
@@ -8,7 +9,9 @@
 #include <mbgl/style/conversion/sprite.hpp>
 #include <mbgl/style/conversion/transition_options.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/style/snapshot_conversion.hpp>
 
+#include <mbgl/util/hash.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -25,11 +28,44 @@
 namespace mbgl {
 namespace style {
 
+namespace {
+
+void hashValue(util::FNV1a& hash, const conversion::Convertible& value) {
+    using namespace conversion;
+    if (isArray(value)) {
+        hash.add("[");
+        for (std::size_t i = 0; i < arrayLength(value); ++i) {
+            hashValue(hash, arrayMember(value, i));
+        }
+        hash.add("]");
+    } else if (isObject(value)) {
+        hash.add("{");
+        eachMember(value, [&](const std::string& name, const Convertible& member) {
+            hash.addTerminated(name);
+            hashValue(hash, member);
+            return std::optional<Error>();
+        });
+        hash.add("}");
+    } else if (isUndefined(value)) {
+        hash.add("n");
+    } else if (auto string = toString(value)) {
+        hash.add("s");
+        hash.addTerminated(*string);
+    } else if (auto number = toDouble(value)) {
+        hash.add("d");
+        hash.add(std::string_view(reinterpret_cast<const char*>(&*number), sizeof(double)));
+    } else if (auto boolean = toBool(value)) {
+        hash.add(*boolean ? "t" : "f");
+    }
+}
+
+} // namespace
+
 Parser::~Parser() = default;
 
-StyleParseResult Parser::parse(const std::string& json) {
-    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
-    document.Parse<0>(json.c_str());
+StyleParseResult Parser::parse(const std::string& data) {
+    JSDocument document;
+    document.Parse<0>(data.c_str());
 
     if (document.HasParseError()) {
         return std::make_exception_ptr(std::runtime_error(formatJSONParseError(document)));
@@ -39,10 +75,23 @@ StyleParseResult Parser::parse(const std::string& json) {
         return std::make_exception_ptr(std::runtime_error("style must be an object"));
     }
 
-    if (document.HasMember("version")) {
-        const JSValue& versionValue = document["version"];
-        const int version = versionValue.IsNumber() ? versionValue.GetInt() : 0;
-        if (version != 8) {
+    return parseDocument(conversion::Convertible(static_cast<const JSValue*>(&document)));
+}
+
+StyleParseResult Parser::parseSnapshot(const std::string& data) {
+    try {
+        // Values shared by several layers are converted once
+        conversion::ConversionCache cache;
+        return parseDocument(conversion::Convertible(snapshot::Node::root(data)));
+    } catch (const std::runtime_error&) {
+        return std::current_exception();
+    }
+}
+
+StyleParseResult Parser::parseDocument(const conversion::Convertible& document) {
+    if (auto versionValue = objectMember(document, "version")) {
+        const auto version = toDouble(*versionValue);
+        if (version != 8.0) {
             Log::Warning(Event::ParseStyle,
                          "current renderer implementation only supports style spec "
                          "version 8; using an outdated style "
@@ -50,17 +99,15 @@ StyleParseResult Parser::parse(const std::string& json) {
         }
     }
 
-    if (document.HasMember("name")) {
-        const JSValue& value = document["name"];
-        if (value.IsString()) {
-            name = {value.GetString(), value.GetStringLength()};
+    if (auto value = objectMember(document, "name")) {
+        if (auto string = toString(*value)) {
+            name = std::move(*string);
         }
     }
 
-    if (document.HasMember("center")) {
-        const JSValue& value = document["center"];
+    if (auto value = objectMember(document, "center")) {
         conversion::Error error;
-        auto convertedLatLng = conversion::convert<LatLng>(value, error);
+        auto convertedLatLng = conversion::convert<LatLng>(*value, error);
         if (convertedLatLng) {
             latLng = *convertedLatLng;
         } else {
@@ -68,51 +115,47 @@ StyleParseResult Parser::parse(const std::string& json) {
         }
     }
 
-    if (document.HasMember("zoom")) {
-        const JSValue& value = document["zoom"];
-        if (value.IsNumber()) {
-            zoom = value.GetDouble();
+    if (auto value = objectMember(document, "zoom")) {
+        if (auto number = toDouble(*value)) {
+            zoom = *number;
         }
     }
 
-    if (document.HasMember("bearing")) {
-        const JSValue& value = document["bearing"];
-        if (value.IsNumber()) {
-            bearing = value.GetDouble();
+    if (auto value = objectMember(document, "bearing")) {
+        if (auto number = toDouble(*value)) {
+            bearing = *number;
         }
     }
 
-    if (document.HasMember("pitch")) {
-        const JSValue& value = document["pitch"];
-        if (value.IsNumber()) {
-            pitch = value.GetDouble();
+    if (auto value = objectMember(document, "pitch")) {
+        if (auto number = toDouble(*value)) {
+            pitch = *number;
         }
     }
 
-    if (document.HasMember("transition")) {
-        parseTransition(document["transition"]);
+    if (auto value = objectMember(document, "transition")) {
+        parseTransition(*value);
     }
 
-    if (document.HasMember("light")) {
-        parseLight(document["light"]);
+    if (auto value = objectMember(document, "light")) {
+        parseLight(*value);
     }
 
-    if (document.HasMember("sources")) {
-        parseSources(document["sources"]);
+    if (auto value = objectMember(document, "sources")) {
+        parseSources(*value);
     }
 
-    if (document.HasMember("layers")) {
-        parseLayers(document["layers"]);
+    if (auto value = objectMember(document, "layers")) {
+        parseLayers(*value);
     }
 
-    if (document.HasMember("sprite")) {
-        parseSprites(document["sprite"]);
+    if (auto value = objectMember(document, "sprite")) {
+        parseSprites(*value);
     }
 
-    if (document.HasMember("glyphs")) {
-        const JSValue& glyphs = document["glyphs"];
-        if (glyphs.IsString()) {
-            glyphURL = {glyphs.GetString(), glyphs.GetStringLength()};
+    if (auto value = objectMember(document, "glyphs")) {
+        if (auto string = toString(*value)) {
+            glyphURL = std::move(*string);
         }
     }
 
@@ -122,7 +165,7 @@ StyleParseResult Parser::parse(const std::string& json) {
     return nullptr;
 }
 
-void Parser::parseTransition(const JSValue& value) {
+void Parser::parseTransition(const conversion::Convertible& value) {
     conversion::Error error;
     std::optional<TransitionOptions> converted = conversion::convert<TransitionOptions>(value, error);
     if (!converted) {
@@ -133,7 +176,7 @@ void Parser::parseTransition(const JSValue& value) {
     transition = std::move(*converted);
 }
 
-void Parser::parseLight(const JSValue& value) {
+void Parser::parseLight(const conversion::Convertible& value) {
     conversion::Error error;
     std::optional<Light> converted = conversion::convert<Light>(value, error);
     if (!converted) {
@@ -144,36 +187,39 @@ void Parser::parseLight(const JSValue& value) {
     light = *converted;
 }
 
-void Parser::parseSources(const JSValue& value) {
-    if (!value.IsObject()) {
+void Parser::parseSources(const conversion::Convertible& value) {
+    if (!isObject(value)) {
         Log::Warning(Event::ParseStyle, "sources must be an object");
         return;
     }
 
-    for (const auto& property : value.GetObject()) {
-        std::string id{property.name.GetString(), property.name.GetStringLength()};
-
+    eachMember(value, [&](const std::string& id, const conversion::Convertible& sourceValue) {
         conversion::Error error;
         std::optional<std::unique_ptr<Source>> source = conversion::convert<std::unique_ptr<Source>>(
-            property.value, error, id);
+            sourceValue, error, id);
         if (!source) {
             Log::Warning(Event::ParseStyle, error.message);
-            continue;
+            return std::optional<conversion::Error>();
         }
 
+        util::FNV1a fingerprint;
+        hashValue(fingerprint, sourceValue);
+        sourceFingerprints[id] = fingerprint.get();
+
         sources.emplace_back(std::move(*source));
-    }
+        return std::optional<conversion::Error>();
+    });
 }
 
-void Parser::parseSprites(const JSValue& value) {
-    if (value.IsString()) {
-        std::string url = {value.GetString(), value.GetStringLength()};
-        auto sprite = Sprite("default", url);
+void Parser::parseSprites(const conversion::Convertible& value) {
+    if (auto url = toString(value)) {
+        auto sprite = Sprite("default", *url);
         sprites.emplace_back(sprite);
-    } else if (value.IsArray()) {
+    } else if (isArray(value)) {
         std::unordered_set<std::string> spriteIds;
-        for (auto& spriteValue : value.GetArray()) {
-            if (!spriteValue.IsObject()) {
+        for (std::size_t i = 0; i < arrayLength(value); ++i) {
+            const conversion::Convertible spriteValue = arrayMember(value, i);
+            if (!isObject(spriteValue)) {
                 Log::Warning(Event::ParseStyle, "sprite child must be an object");
                 continue;
             }
@@ -199,39 +245,40 @@ void Parser::parseSprites(const JSValue& value) {
     }
 }
 
-void Parser::parseLayers(const JSValue& value) {
+void Parser::parseLayers(const conversion::Convertible& value) {
     std::vector<std::string> ids;
 
-    if (!value.IsArray()) {
+    if (!isArray(value)) {
         Log::Warning(Event::ParseStyle, "layers must be an array");
         return;
     }
 
-    for (auto& layerValue : value.GetArray()) {
-        if (!layerValue.IsObject()) {
+    for (std::size_t i = 0; i < arrayLength(value); ++i) {
+        conversion::Convertible layerValue = arrayMember(value, i);
+        if (!isObject(layerValue)) {
             Log::Warning(Event::ParseStyle, "layer must be an object");
             continue;
         }
 
-        if (!layerValue.HasMember("id")) {
+        const auto id = objectMember(layerValue, "id");
+        if (!id) {
             Log::Warning(Event::ParseStyle, "layer must have an id");
             continue;
         }
 
-        const JSValue& id = layerValue.FindMember("id")->value;
-        if (!id.IsString()) {
+        const auto layerID = toString(*id);
+        if (!layerID) {
             Log::Warning(Event::ParseStyle, "layer id must be a string");
             continue;
         }
 
-        const std::string layerID = {id.GetString(), id.GetStringLength()};
-        if (layersMap.find(layerID) != layersMap.end()) {
-            Log::Warning(Event::ParseStyle, "duplicate layer id " + layerID);
+        if (layersMap.find(*layerID) != layersMap.end()) {
+            Log::Warning(Event::ParseStyle, "duplicate layer id " + *layerID);
             continue;
         }
 
-        layersMap.emplace(layerID, std::pair<const JSValue&, std::unique_ptr<Layer>>{layerValue, nullptr});
-        ids.push_back(layerID);
+        layersMap.emplace(*layerID, std::make_pair(std::move(layerValue), std::unique_ptr<Layer>()));
+        ids.push_back(*layerID);
     }
 
     for (const auto& id : ids) {
@@ -249,7 +296,7 @@ void Parser::parseLayers(const JSValue& value) {
     }
 }
 
-void Parser::parseLayer(const std::string& id, const JSValue& value, std::unique_ptr<Layer>& layer) {
+void Parser::parseLayer(const std::string& id, const conversion::Convertible& value, std::unique_ptr<Layer>& layer) {
     if (layer) {
         // Skip parsing this again. We already have a valid layer definition.
         return;
@@ -261,18 +308,17 @@ void Parser::parseLayer(const std::string& id, const JSValue& value, std::unique
         return;
     }
 
-    if (value.HasMember("ref")) {
+    if (auto refVal = objectMember(value, "ref")) {
         // This layer is referencing another layer. Recursively parse that layer.
-        const JSValue& refVal = value["ref"];
-        if (!refVal.IsString()) {
+        const auto ref = toString(*refVal);
+        if (!ref) {
             Log::Warning(Event::ParseStyle, "layer ref of '" + id + "' must be a string");
             return;
         }
 
-        const std::string ref{refVal.GetString(), refVal.GetStringLength()};
-        auto it = layersMap.find(ref);
+        auto it = layersMap.find(*ref);
         if (it == layersMap.end()) {
-            Log::Warning(Event::ParseStyle, "layer '" + id + "' references unknown layer " + ref);
+            Log::Warning(Event::ParseStyle, "layer '" + id + "' references unknown layer " + *ref);
             return;
         }
 
@@ -287,7 +333,7 @@ void Parser::parseLayer(const std::string& id, const JSValue& value, std::unique
         }
 
         layer = reference->cloneRef(id);
-        conversion::setPaintProperties(*layer, conversion::Convertible(&value));
+        conversion::setPaintProperties(*layer, value);
     } else {
         conversion::Error error;
         std::optional<std::unique_ptr<Layer>> converted = conversion::convert<std::unique_ptr<Layer>>(value, error);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/sprite.hpp>
 #include <mbgl/style/source.hpp>
@@ -9,6 +10,7 @@
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/geo.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <stdexcept>
@@ -26,11 +28,15 @@ public:
     ~Parser();
 
     StyleParseResult parse(const std::string&);
+    /// Parses a style snapshot, see `snapshot::encode`
+    StyleParseResult parseSnapshot(const std::string&);
 
     std::vector<Sprite> sprites;
     std::string glyphURL;
 
     std::vector<std::unique_ptr<Source>> sources;
+    // Hash of the definition of each source, to tell whether it changed from one style to the next.
+    std::unordered_map<std::string, uint64_t> sourceFingerprints;
     std::vector<std::unique_ptr<Layer>> layers;
 
     TransitionOptions transition{{util::DEFAULT_TRANSITION_DURATION}};
@@ -46,14 +52,15 @@ public:
     std::set<FontStack> fontStacks() const;
 
 private:
-    void parseTransition(const JSValue&);
-    void parseLight(const JSValue&);
-    void parseSources(const JSValue&);
-    void parseSprites(const JSValue&);
-    void parseLayers(const JSValue&);
-    void parseLayer(const std::string& id, const JSValue&, std::unique_ptr<Layer>&);
-
-    std::unordered_map<std::string, std::pair<const JSValue&, std::unique_ptr<Layer>>> layersMap;
+    StyleParseResult parseDocument(const conversion::Convertible&);
+    void parseTransition(const conversion::Convertible&);
+    void parseLight(const conversion::Convertible&);
+    void parseSources(const conversion::Convertible&);
+    void parseSprites(const conversion::Convertible&);
+    void parseLayers(const conversion::Convertible&);
+    void parseLayer(const std::string& id, const conversion::Convertible&, std::unique_ptr<Layer>&);
+
+    std::unordered_map<std::string, std::pair<conversion::Convertible, std::unique_ptr<Layer>>> layersMap;
 
     // Store a stack of layer IDs we're parsing right now. This is to prevent reference cycles.
     std::forward_list<std::string> stack;
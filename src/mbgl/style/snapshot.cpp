@@ -0,0 +1,477 @@
+#include <mbgl/style/snapshot_conversion.hpp>
+#include <mbgl/style/rapidjson_conversion.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+namespace snapshot {
+
+namespace {
+
+constexpr std::string_view magicPrefix = "MLNSTY";
+// Bump the version when the layout changes
+constexpr std::string_view magic = "MLNSTY01";
+// Snapshots are written in the byte order of the machine that makes them
+constexpr uint32_t byteOrderMark = 0x01020304;
+constexpr std::size_t rootOffsetPosition = magic.size() + sizeof(uint32_t);
+constexpr std::size_t headerSize = rootOffsetPosition + sizeof(uint32_t);
+
+// Nodes, each starting with its tag:
+//   Null, False, True
+//   Int, Uint, Double     the value, 8 bytes
+//   String                length, characters
+//   Array                 count, the distance back to each item
+//   Object                count, the distance back to the name (a String node) and value of each member
+// Nodes only refer to nodes written before them, so a snapshot can't have cycles.
+constexpr std::size_t countSize = sizeof(uint32_t);
+constexpr std::size_t referenceSize = sizeof(uint32_t);
+
+// Limits of the document a snapshot expands to, well beyond those of real styles. Shared nodes make a
+// snapshot a graph rather than a tree: a few hundred bytes of arrays each referring twice to the previous
+// one would expand to billions of values for the parser to visit.
+constexpr uint64_t maxValues = uint64_t(1) << 22;
+constexpr uint32_t maxDepth = 128;
+
+template <class T>
+T read(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template <class T>
+void append(std::string& out, const T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+[[noreturn]] void invalid(const std::string& reason) {
+    throw std::runtime_error("Invalid style snapshot: " + reason);
+}
+
+// Checks every node once, so that reading nodes afterwards doesn't need any bounds check, and so that the
+// document it expands to is within the limits
+void validate(const std::string& snapshot) {
+    MLN_TRACE_FUNC();
+
+    if (snapshot.size() < headerSize || std::string_view(snapshot).substr(0, magic.size()) != magic) {
+        invalid("unknown format or version");
+    }
+    if (read<uint32_t>(snapshot.data() + magic.size()) != byteOrderMark) {
+        invalid("made on a machine of another byte order");
+    }
+
+    // The tag of the node starting at each position, plus one
+    std::vector<uint8_t> nodes(snapshot.size(), 0);
+    const auto checkReference = [&](const std::size_t position,
+                                    const char* reference,
+                                    const std::optional<Tag> expected = std::nullopt) {
+        const auto distance = read<uint32_t>(reference);
+        if (distance == 0 || distance > position || nodes[position - distance] == 0 ||
+            (expected && nodes[position - distance] != static_cast<uint8_t>(*expected) + 1)) {
+            invalid("bad reference");
+        }
+        return position - distance;
+    };
+
+    // The number of values and the depth of the document each array and object expands to.
+    // Other nodes are a single value.
+    struct Extent {
+        uint64_t values = 1;
+        uint32_t depth = 1;
+    };
+    std::unordered_map<std::size_t, Extent> extents;
+    const auto extentOf = [&](const std::size_t position) {
+        const auto it = extents.find(position);
+        return it != extents.end() ? it->second : Extent();
+    };
+
+    std::size_t position = headerSize;
+    while (position < snapshot.size()) {
+        const char* data = snapshot.data() + position;
+        const std::size_t available = snapshot.size() - position;
+        const auto tag = static_cast<Tag>(*data);
+
+        std::size_t length = 1;
+        switch (tag) {
+            case Tag::Null:
+            case Tag::False:
+            case Tag::True:
+                break;
+            case Tag::Int:
+            case Tag::Uint:
+            case Tag::Double:
+                length += sizeof(uint64_t);
+                break;
+            case Tag::String:
+            case Tag::Array:
+            case Tag::Object: {
+                if (available < 1 + countSize) {
+                    invalid("truncated");
+                }
+                const std::size_t count = read<uint32_t>(data + 1);
+                if (count > available) {
+                    invalid("truncated");
+                }
+                const std::size_t itemSize = tag == Tag::String  ? 1
+                                             : tag == Tag::Array ? referenceSize
+                                                                 : 2 * referenceSize;
+                length += countSize + count * itemSize;
+                break;
+            }
+            default:
+                invalid("unknown value type");
+        }
+        if (length > available) {
+            invalid("truncated");
+        }
+
+        if (tag == Tag::Array || tag == Tag::Object) {
+            const std::size_t count = read<uint32_t>(data + 1);
+            const char* reference = data + 1 + countSize;
+            Extent extent;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (tag == Tag::Object) {
+                    checkReference(position, reference, Tag::String);
+                    reference += referenceSize;
+                    extent.values++;
+                }
+                const Extent item = extentOf(checkReference(position, reference));
+                reference += referenceSize;
+                extent.values += item.values;
+                extent.depth = std::max(extent.depth, item.depth + 1);
+            }
+            // Items are within the limits, so the sums can't overflow
+            if (extent.values > maxValues) {
+                invalid("expands to too many values");
+            }
+            if (extent.depth > maxDepth) {
+                invalid("nested too deeply");
+            }
+            extents.emplace(position, extent);
+        }
+
+        nodes[position] = static_cast<uint8_t>(tag) + 1;
+        position += length;
+    }
+
+    const auto root = read<uint32_t>(snapshot.data() + rootOffsetPosition);
+    if (root >= snapshot.size() || nodes[root] != static_cast<uint8_t>(Tag::Object) + 1) {
+        invalid("the style must be an object");
+    }
+}
+
+class Encoder {
+public:
+    Encoder() {
+        out.append(magic);
+        append(out, byteOrderMark);
+        append<uint32_t>(out, 0);
+    }
+
+    std::string finish(const JSValue& root) {
+        const uint32_t offset = write(root);
+        std::memcpy(out.data() + rootOffsetPosition, &offset, sizeof(offset));
+        return std::move(out);
+    }
+
+private:
+    uint32_t write(const JSValue& value) {
+        std::string key;
+        switch (value.GetType()) {
+            case rapidjson::kNullType:
+                key.push_back(static_cast<char>(Tag::Null));
+                break;
+            case rapidjson::kFalseType:
+                key.push_back(static_cast<char>(Tag::False));
+                break;
+            case rapidjson::kTrueType:
+                key.push_back(static_cast<char>(Tag::True));
+                break;
+            case rapidjson::kNumberType:
+                // The same preference as the conversion of RapidJSON values
+                if (value.IsUint64()) {
+                    key.push_back(static_cast<char>(Tag::Uint));
+                    append(key, value.GetUint64());
+                } else if (value.IsInt64()) {
+                    key.push_back(static_cast<char>(Tag::Int));
+                    append(key, value.GetInt64());
+                } else {
+                    key.push_back(static_cast<char>(Tag::Double));
+                    append(key, value.GetDouble());
+                }
+                break;
+            case rapidjson::kStringType:
+                return writeString({value.GetString(), value.GetStringLength()});
+            case rapidjson::kArrayType: {
+                std::vector<uint32_t> items;
+                items.reserve(value.Size());
+                for (const auto& item : value.GetArray()) {
+                    items.push_back(write(item));
+                }
+                key.push_back(static_cast<char>(Tag::Array));
+                append(key, static_cast<uint32_t>(items.size()));
+                for (const uint32_t item : items) {
+                    append(key, item);
+                }
+                break;
+            }
+            case rapidjson::kObjectType: {
+                std::vector<uint32_t> members;
+                members.reserve(2 * value.MemberCount());
+                for (const auto& member : value.GetObject()) {
+                    members.push_back(writeString({member.name.GetString(), member.name.GetStringLength()}));
+                    members.push_back(write(member.value));
+                }
+                key.push_back(static_cast<char>(Tag::Object));
+                append(key, static_cast<uint32_t>(members.size() / 2));
+                for (const uint32_t member : members) {
+                    append(key, member);
+                }
+                break;
+            }
+        }
+        return intern(std::move(key));
+    }
+
+    uint32_t writeString(std::string_view string) {
+        std::string key;
+        key.reserve(1 + countSize + string.size());
+        key.push_back(static_cast<char>(Tag::String));
+        append(key, static_cast<uint32_t>(string.size()));
+        key.append(string);
+        return intern(std::move(key));
+    }
+
+    // Writes a node unless an identical one was written already. The keys of arrays and objects hold the
+    // offsets of the nodes they refer to, turned into distances when written.
+    uint32_t intern(std::string&& key) {
+        if (out.size() + key.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Style is too large for a snapshot");
+        }
+        const auto offset = static_cast<uint32_t>(out.size());
+        const auto [it, added] = offsets.try_emplace(std::move(key), offset);
+        if (!added) {
+            return it->second;
+        }
+
+        const std::string& node = it->first;
+        out.append(node);
+        const auto tag = static_cast<Tag>(node.front());
+        if (tag == Tag::Array || tag == Tag::Object) {
+            for (std::size_t i = 1 + countSize; i < node.size(); i += referenceSize) {
+                const uint32_t distance = offset - read<uint32_t>(node.data() + i);
+                std::memcpy(out.data() + offset + i, &distance, sizeof(distance));
+            }
+        }
+        return offset;
+    }
+
+    std::string out;
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+template <class Writer>
+void write(Writer& writer, const Node& node) {
+    switch (node.tag()) {
+        case Tag::Null:
+            writer.Null();
+            break;
+        case Tag::False:
+            writer.Bool(false);
+            break;
+        case Tag::True:
+            writer.Bool(true);
+            break;
+        case Tag::Int:
+            writer.Int64(node.getInt());
+            break;
+        case Tag::Uint:
+            writer.Uint64(node.getUint());
+            break;
+        case Tag::Double:
+            writer.Double(node.getDouble());
+            break;
+        case Tag::String: {
+            const auto string = node.getString();
+            writer.String(string.data(), static_cast<rapidjson::SizeType>(string.size()));
+            break;
+        }
+        case Tag::Array:
+            writer.StartArray();
+            for (std::size_t i = 0; i < node.size(); ++i) {
+                write(writer, node.arrayMember(i));
+            }
+            writer.EndArray();
+            break;
+        case Tag::Object:
+            writer.StartObject();
+            for (std::size_t i = 0; i < node.size(); ++i) {
+                const auto name = node.memberName(i);
+                writer.Key(name.data(), static_cast<rapidjson::SizeType>(name.size()));
+                write(writer, node.memberValue(i));
+            }
+            writer.EndObject();
+            break;
+    }
+}
+
+JSValue toJSValue(const Node& node, rapidjson::CrtAllocator& allocator) {
+    switch (node.tag()) {
+        case Tag::False:
+            return JSValue(false);
+        case Tag::True:
+            return JSValue(true);
+        case Tag::Int:
+            return JSValue(node.getInt());
+        case Tag::Uint:
+            return JSValue(node.getUint());
+        case Tag::Double:
+            return JSValue(node.getDouble());
+        case Tag::String: {
+            const auto string = node.getString();
+            return JSValue(string.data(), static_cast<rapidjson::SizeType>(string.size()), allocator);
+        }
+        case Tag::Array: {
+            JSValue array(rapidjson::kArrayType);
+            array.Reserve(static_cast<rapidjson::SizeType>(node.size()), allocator);
+            for (std::size_t i = 0; i < node.size(); ++i) {
+                array.PushBack(toJSValue(node.arrayMember(i), allocator), allocator);
+            }
+            return array;
+        }
+        case Tag::Object: {
+            JSValue object(rapidjson::kObjectType);
+            for (std::size_t i = 0; i < node.size(); ++i) {
+                const auto name = node.memberName(i);
+                object.AddMember(JSValue(name.data(), static_cast<rapidjson::SizeType>(name.size()), allocator),
+                                 toJSValue(node.memberValue(i), allocator),
+                                 allocator);
+            }
+            return object;
+        }
+        default:
+            return JSValue();
+    }
+}
+
+} // namespace
+
+bool isSnapshot(const std::string& data) {
+    // Style JSON starts with whitespace or a brace, snapshots of other versions are rejected when read
+    return std::string_view(data).substr(0, magicPrefix.size()) == magicPrefix;
+}
+
+std::string encode(const std::string& json) {
+    MLN_TRACE_FUNC();
+
+    JSDocument document;
+    document.Parse<0>(json.c_str());
+    if (document.HasParseError()) {
+        throw std::runtime_error(formatJSONParseError(document));
+    }
+    if (!document.IsObject()) {
+        throw std::runtime_error("style must be an object");
+    }
+    return Encoder().finish(document);
+}
+
+std::string decode(const std::string& snapshot) {
+    MLN_TRACE_FUNC();
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    write(writer, Node::root(snapshot));
+    return {buffer.GetString(), buffer.GetSize()};
+}
+
+Node Node::root(const std::string& snapshot) {
+    validate(snapshot);
+    return Node(snapshot.data() + read<uint32_t>(snapshot.data() + rootOffsetPosition));
+}
+
+int64_t Node::getInt() const {
+    assert(tag() == Tag::Int);
+    return read<int64_t>(data + 1);
+}
+
+uint64_t Node::getUint() const {
+    assert(tag() == Tag::Uint);
+    return read<uint64_t>(data + 1);
+}
+
+double Node::getDouble() const {
+    assert(tag() == Tag::Double);
+    return read<double>(data + 1);
+}
+
+double Node::getNumber() const {
+    switch (tag()) {
+        case Tag::Int:
+            return static_cast<double>(getInt());
+        case Tag::Uint:
+            return static_cast<double>(getUint());
+        default:
+            return getDouble();
+    }
+}
+
+std::string_view Node::getString() const {
+    assert(tag() == Tag::String);
+    return {data + 1 + countSize, read<uint32_t>(data + 1)};
+}
+
+std::size_t Node::size() const {
+    assert(tag() == Tag::Array || tag() == Tag::Object);
+    return read<uint32_t>(data + 1);
+}
+
+Node Node::arrayMember(const std::size_t i) const {
+    assert(tag() == Tag::Array && i < size());
+    return Node(data - read<uint32_t>(data + 1 + countSize + i * referenceSize));
+}
+
+std::string_view Node::memberName(const std::size_t i) const {
+    assert(tag() == Tag::Object && i < size());
+    return Node(data - read<uint32_t>(data + 1 + countSize + 2 * i * referenceSize)).getString();
+}
+
+Node Node::memberValue(const std::size_t i) const {
+    assert(tag() == Tag::Object && i < size());
+    return Node(data - read<uint32_t>(data + 1 + countSize + (2 * i + 1) * referenceSize));
+}
+
+std::optional<Node> Node::objectMember(const std::string_view name) const {
+    for (std::size_t i = 0; i < size(); ++i) {
+        if (memberName(i) == name) {
+            return memberValue(i);
+        }
+    }
+    return {};
+}
+
+} // namespace snapshot
+
+namespace conversion {
+
+std::optional<GeoJSON> ConversionTraits<snapshot::Node>::toGeoJSON(const snapshot::Node& value, Error& error) {
+    // Only inline GeoJSON sources get here, they're converted from RapidJSON values as usual
+    rapidjson::CrtAllocator allocator;
+    const JSValue json = snapshot::toJSValue(value, allocator);
+    return ConversionTraits<const JSValue*>::toGeoJSON(&json, error);
+}
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/style/snapshot.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mbgl {
+namespace style {
+namespace snapshot {
+
+enum class Tag : uint8_t {
+    Null,
+    False,
+    True,
+    Int,
+    Uint,
+    Double,
+    String,
+    Array,
+    Object,
+};
+
+/// A value of a snapshot, read in place. Only valid while the snapshot data is.
+class Node {
+public:
+    /// Throws `std::runtime_error` if the snapshot is truncated, corrupted, of another version, or expands to a
+    /// document beyond the limits
+    static Node root(const std::string& snapshot);
+
+    Tag tag() const { return static_cast<Tag>(*data); }
+
+    int64_t getInt() const;
+    uint64_t getUint() const;
+    double getDouble() const;
+    /// Int, Uint or Double
+    double getNumber() const;
+    std::string_view getString() const;
+
+    /// Number of array items or object members
+    std::size_t size() const;
+    Node arrayMember(std::size_t) const;
+    std::string_view memberName(std::size_t) const;
+    Node memberValue(std::size_t) const;
+    std::optional<Node> objectMember(std::string_view name) const;
+
+    /// Identical values are stored once, as the same node
+    const void* identity() const { return data; }
+
+private:
+    explicit Node(const char* data_)
+        : data(data_) {}
+
+    const char* data;
+};
+
+} // namespace snapshot
+
+namespace conversion {
+
+template <>
+class ConversionTraits<snapshot::Node> {
+public:
+    using Tag = snapshot::Tag;
+
+    static bool isUndefined(const snapshot::Node& value) { return value.tag() == Tag::Null; }
+
+    static bool isArray(const snapshot::Node& value) { return value.tag() == Tag::Array; }
+
+    static std::size_t arrayLength(const snapshot::Node& value) { return value.size(); }
+
+    static snapshot::Node arrayMember(const snapshot::Node& value, std::size_t i) { return value.arrayMember(i); }
+
+    static bool isObject(const snapshot::Node& value) { return value.tag() == Tag::Object; }
+
+    static std::optional<snapshot::Node> objectMember(const snapshot::Node& value, const char* name) {
+        return value.objectMember(name);
+    }
+
+    template <class Fn>
+    static std::optional<Error> eachMember(const snapshot::Node& value, Fn&& fn) {
+        assert(value.tag() == Tag::Object);
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            std::optional<Error> result = fn(std::string(value.memberName(i)), value.memberValue(i));
+            if (result) {
+                return result;
+            }
+        }
+        return {};
+    }
+
+    static std::optional<bool> toBool(const snapshot::Node& value) {
+        switch (value.tag()) {
+            case Tag::False:
+                return false;
+            case Tag::True:
+                return true;
+            default:
+                return {};
+        }
+    }
+
+    static std::optional<float> toNumber(const snapshot::Node& value) {
+        if (const auto number = toDouble(value)) {
+            return static_cast<float>(*number);
+        }
+        return {};
+    }
+
+    static std::optional<double> toDouble(const snapshot::Node& value) {
+        switch (value.tag()) {
+            case Tag::Int:
+            case Tag::Uint:
+            case Tag::Double:
+                return value.getNumber();
+            default:
+                return {};
+        }
+    }
+
+    static std::optional<std::string> toString(const snapshot::Node& value) {
+        if (value.tag() != Tag::String) {
+            return {};
+        }
+        return std::string(value.getString());
+    }
+
+    // Same as the conversion of RapidJSON values
+    static std::optional<Value> toValue(const snapshot::Node& value) {
+        switch (value.tag()) {
+            case Tag::Null:
+            case Tag::False:
+                return {false};
+            case Tag::True:
+                return {true};
+            case Tag::String:
+                return {std::string(value.getString())};
+            case Tag::Uint:
+                return {value.getUint()};
+            case Tag::Int:
+                return {value.getInt()};
+            case Tag::Double:
+                return {value.getDouble()};
+            default:
+                return {};
+        }
+    }
+
+    static std::optional<GeoJSON> toGeoJSON(const snapshot::Node& value, Error& error);
+
+    // Only arrays and objects, whose conversions are worth keeping
+    static const void* identity(const snapshot::Node& value) {
+        return isArray(value) || isObject(value) ? value.identity() : nullptr;
+    }
+};
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
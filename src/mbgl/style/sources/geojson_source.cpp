@@ -10,10 +10,103 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/identity.hpp>
+#include <mbgl/math/angles.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 namespace style {
 
+namespace {
+
+using Features = GeoJSONData::Features;
+using Region = GeoJSONSource::Impl::Region;
+
+// Changes are tracked relative to this many earlier versions of the data, so
+// that several updates between two frames still reload only the touched tiles.
+constexpr std::size_t maxTrackedChanges = 8;
+
+// Whether the source keeps the features, for `updateGeoJSON`
+bool keepFeatures(const GeoJSONOptions& options, const GeoJSON& geoJSON) {
+    if (!options.updatable || !geoJSON.is<Features>()) {
+        return false;
+    }
+    const auto& features = geoJSON.get<Features>();
+    return std::all_of(features.begin(), features.end(), [](const auto& feature) {
+        return bool(featureIDtoString(feature.id));
+    });
+}
+
+// The bounds of a feature projected as geojson-vt does it before tiling
+void addRegion(const GeoJSONFeature& feature, std::vector<Region>& regions) {
+    const auto envelope = mapbox::geometry::envelope(feature.geometry);
+    if (envelope.min.x > envelope.max.x) {
+        return; // No coordinates
+    }
+    const auto projectY = [](double lat) {
+        const double sin = std::sin(util::deg2rad(lat));
+        const double y = 0.5 - 0.25 * std::log((1.0 + sin) / (1.0 - sin)) / M_PI;
+        return util::clamp(y, 0.0, 1.0);
+    };
+    regions.push_back({{envelope.min.x / 360.0 + 0.5, projectY(envelope.max.y)},
+                       {envelope.max.x / 360.0 + 0.5, projectY(envelope.min.y)}});
+}
+
+Features applyDiff(const Features& current, const GeoJSONSourceDiff& diff, std::vector<Region>& regions) {
+    std::unordered_set<std::string> removed;
+    for (const auto& id : diff.remove) {
+        if (auto key = featureIDtoString(id)) {
+            removed.insert(std::move(*key));
+        }
+    }
+
+    // Added features by ID, the last one winning when an ID repeats. Entries are
+    // cleared once the feature is in the result.
+    std::unordered_map<std::string, const GeoJSONFeature*> added;
+    for (const auto& feature : diff.add) {
+        added[*featureIDtoString(feature.id)] = &feature;
+    }
+
+    Features result;
+    result.reserve(current.size() + diff.add.size());
+    if (!diff.removeAll) {
+        for (const auto& feature : current) {
+            const auto key = *featureIDtoString(feature.id);
+            if (removed.count(key)) {
+                addRegion(feature, regions);
+            } else if (const auto it = added.find(key); it != added.end()) {
+                addRegion(feature, regions);
+                if (it->second) {
+                    result.push_back(*it->second);
+                    addRegion(*it->second, regions);
+                    it->second = nullptr;
+                }
+            } else {
+                result.push_back(feature);
+            }
+        }
+    }
+
+    for (const auto& feature : diff.add) {
+        auto& entry = added[*featureIDtoString(feature.id)];
+        if (entry == &feature) {
+            result.push_back(feature);
+            addRegion(feature, regions);
+            entry = nullptr;
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
 // static
 Immutable<GeoJSONOptions> GeoJSONOptions::defaultOptions() {
     static Immutable<GeoJSONOptions> options = makeMutable<GeoJSONOptions>();
@@ -42,7 +135,59 @@ void GeoJSONSource::setURL(const std::string& url_) {
 }
 
 void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
-    setGeoJSONData(GeoJSONData::create(geoJSON, sequencedScheduler, impl().getOptions()));
+    req.reset();
+    auto data = GeoJSONData::create(geoJSON, sequencedScheduler, impl().getOptions());
+    auto features = keepFeatures(*impl().getOptions(), geoJSON) ? std::make_shared<const GeoJSON>(geoJSON) : nullptr;
+    baseImpl = makeMutable<Impl>(impl(), std::move(data), std::move(features));
+    observer->onSourceChanged(*this);
+}
+
+void GeoJSONSource::setGeoJSON(GeoJSON&& geoJSON) {
+    req.reset();
+    auto data = GeoJSONData::create(geoJSON, sequencedScheduler, impl().getOptions());
+    auto features = keepFeatures(*impl().getOptions(), geoJSON) ? std::make_shared<const GeoJSON>(std::move(geoJSON))
+                                                                : nullptr;
+    baseImpl = makeMutable<Impl>(impl(), std::move(data), std::move(features));
+    observer->onSourceChanged(*this);
+}
+
+void GeoJSONSource::updateGeoJSON(const GeoJSONSourceDiff& diff) {
+    const auto& current = impl();
+    if (!current.getGeoJSON()) {
+        throw std::runtime_error("GeoJSON source \"" + getID() +
+                                 "\" can only be updated when it is updatable and all of its features have an ID");
+    }
+    for (const auto& feature : diff.add) {
+        if (!featureIDtoString(feature.id)) {
+            throw std::runtime_error("Features added to GeoJSON source \"" + getID() + "\" must have an ID");
+        }
+    }
+
+    std::vector<Region> regions;
+    auto geoJSON = std::make_shared<const GeoJSON>(applyDiff(current.getGeoJSON()->get<Features>(), diff, regions));
+    auto data = GeoJSONData::create(*geoJSON, sequencedScheduler, current.getOptions());
+
+    // Clusters merge points over a distance that depends on the whole data set,
+    // so clustered sources reload all of their tiles.
+    std::vector<Impl::DataChange> changes;
+    const auto previous = current.getData().lock();
+    if (previous && !diff.removeAll && !current.getOptions()->cluster) {
+        changes.push_back({previous, regions});
+        for (const auto& change : current.getChanges()) {
+            if (changes.size() == maxTrackedChanges) {
+                break;
+            }
+            if (!change.from.expired()) {
+                auto combined = change;
+                combined.regions.insert(combined.regions.end(), regions.begin(), regions.end());
+                changes.push_back(std::move(combined));
+            }
+        }
+    }
+
+    req.reset();
+    baseImpl = makeMutable<Impl>(current, std::move(data), std::move(geoJSON), std::move(changes));
+    observer->onSourceChanged(*this);
 }
 
 void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
@@ -89,14 +234,18 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                     auto& current = static_cast<const Impl&>(*currentImpl);
                     conversion::Error error;
                     std::shared_ptr<GeoJSONData> geoJSONData;
+                    std::shared_ptr<const GeoJSON> updatableGeoJSON;
                     if (std::optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*data, error)) {
                         geoJSONData = GeoJSONData::create(*geoJSON, std::move(seqScheduler), current.getOptions());
+                        if (keepFeatures(*current.getOptions(), *geoJSON)) {
+                            updatableGeoJSON = std::make_shared<const GeoJSON>(std::move(*geoJSON));
+                        }
                     } else {
                         // Create an empty GeoJSON VT object to make sure we're not
                         // infinitely waiting for tiles to load.
                         Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: " + error.message);
                     }
-                    return makeMutable<Impl>(current, std::move(geoJSONData));
+                    return makeMutable<Impl>(current, std::move(geoJSONData), std::move(updatableGeoJSON));
                 },
                 /* onImplReady */
                 [this, self = makeWeakPtr(), capturedReq = req.get()](Immutable<Source::Impl> newImpl) {
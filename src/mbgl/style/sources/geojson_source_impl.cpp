@@ -135,10 +135,15 @@ GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
     : Source::Impl(SourceType::GeoJSON, std::move(id_)),
       options(std::move(options_)) {}
 
-GeoJSONSource::Impl::Impl(const GeoJSONSource::Impl& other, std::shared_ptr<GeoJSONData> data_)
+GeoJSONSource::Impl::Impl(const GeoJSONSource::Impl& other,
+                          std::shared_ptr<GeoJSONData> data_,
+                          std::shared_ptr<const GeoJSON> geoJSON_,
+                          std::vector<DataChange> changes_)
     : Source::Impl(other),
       options(other.options),
-      data(std::move(data_)) {}
+      data(std::move(data_)),
+      geoJSON(std::move(geoJSON_)),
+      changes(std::move(changes_)) {}
 
 GeoJSONSource::Impl::~Impl() = default;
 
@@ -150,6 +155,16 @@ std::weak_ptr<GeoJSONData> GeoJSONSource::Impl::getData() const {
     return data;
 }
 
+const std::vector<GeoJSONSource::Impl::Region>* GeoJSONSource::Impl::getChangedRegions(
+    const GeoJSONData& from) const {
+    for (const auto& change : changes) {
+        if (change.from.lock().get() == &from) {
+            return &change.regions;
+        }
+    }
+    return nullptr;
+}
+
 std::optional<std::string> GeoJSONSource::Impl::getAttribution() const {
     return {};
 }
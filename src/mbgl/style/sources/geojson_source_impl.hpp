@@ -4,6 +4,10 @@
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <mapbox/geometry/box.hpp>
+
+#include <vector>
+
 namespace mbgl {
 
 class AsyncRequest;
@@ -13,19 +17,43 @@ namespace style {
 
 class GeoJSONSource::Impl final : public Source::Impl {
 public:
+    // An area in normalized web mercator coordinates, where the world spans
+    // [0, 1] on both axes as in geojson-vt.
+    using Region = mapbox::geometry::box<double>;
+
+    // The data differs from earlier data of the same source only within these
+    // regions, so tiles elsewhere don't need to reload.
+    struct DataChange {
+        std::weak_ptr<GeoJSONData> from;
+        std::vector<Region> regions;
+    };
+
     Impl(std::string id, Immutable<GeoJSONOptions>);
-    Impl(const GeoJSONSource::Impl&, std::shared_ptr<GeoJSONData>);
+    Impl(const GeoJSONSource::Impl&,
+         std::shared_ptr<GeoJSONData>,
+         std::shared_ptr<const GeoJSON> = nullptr,
+         std::vector<DataChange> = {});
     ~Impl() final;
 
     Range<uint8_t> getZoomRange() const;
     std::weak_ptr<GeoJSONData> getData() const;
     const Immutable<GeoJSONOptions>& getOptions() const { return options; }
 
+    // The features the data was created from, kept only if they can be updated by ID.
+    const std::shared_ptr<const GeoJSON>& getGeoJSON() const { return geoJSON; }
+    const std::vector<DataChange>& getChanges() const { return changes; }
+
+    // Regions in which the data differs from the given earlier data, or null if
+    // the difference isn't known.
+    const std::vector<Region>* getChangedRegions(const GeoJSONData& from) const;
+
     std::optional<std::string> getAttribution() const final;
 
 private:
     Immutable<GeoJSONOptions> options;
     std::shared_ptr<GeoJSONData> data;
+    std::shared_ptr<const GeoJSON> geoJSON;
+    std::vector<DataChange> changes;
 };
 
 } // namespace style
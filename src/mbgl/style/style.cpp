@@ -15,16 +15,22 @@ Style::Style(std::shared_ptr<FileSource> fileSource, float pixelRatio, const Tag
 
 Style::~Style() = default;
 
-void Style::loadJSON(const std::string& json) {
+void Style::loadJSON(const std::string& json, LoadMode mode) {
     MLN_TRACE_FUNC();
 
-    impl->loadJSON(json);
+    impl->loadJSON(json, mode);
 }
 
-void Style::loadURL(const std::string& url) {
+void Style::loadURL(const std::string& url, LoadMode mode) {
     MLN_TRACE_FUNC();
 
-    impl->loadURL(url);
+    impl->loadURL(url, mode);
+}
+
+void Style::loadSnapshot(const std::string& snapshot, LoadMode mode) {
+    MLN_TRACE_FUNC();
+
+    impl->loadSnapshot(snapshot, mode);
 }
 
 std::string Style::getJSON() const {
@@ -101,6 +107,7 @@ std::vector<Source*> Style::getSources() {
     MLN_TRACE_FUNC();
 
     impl->mutated = true;
+    impl->sourceFingerprints.clear();
     return impl->getSources();
 }
 
@@ -114,6 +121,7 @@ Source* Style::getSource(const std::string& id) {
     MLN_TRACE_FUNC();
 
     impl->mutated = true;
+    impl->sourceFingerprints.erase(id);
     return impl->getSource(id);
 }
 
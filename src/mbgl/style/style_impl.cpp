@@ -16,6 +16,7 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/observer.hpp>
 #include <mbgl/style/parser.hpp>
+#include <mbgl/style/snapshot.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/style_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
@@ -23,7 +24,9 @@
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/string.hpp>
+#include <algorithm>
 #include <sstream>
+#include <unordered_set>
 
 namespace mbgl {
 namespace style {
@@ -39,15 +42,23 @@ Style::Impl::Impl(std::shared_ptr<FileSource> fileSource_, float pixelRatio, con
 
 Style::Impl::~Impl() = default;
 
-void Style::Impl::loadJSON(const std::string& json_) {
+void Style::Impl::loadJSON(const std::string& json_, LoadMode mode) {
     lastError = nullptr;
     observer->onStyleLoading();
 
     url.clear();
-    parse(json_);
+    parse(json_, mode);
 }
 
-void Style::Impl::loadURL(const std::string& url_) {
+void Style::Impl::loadSnapshot(const std::string& snapshot_, LoadMode mode) {
+    lastError = nullptr;
+    observer->onStyleLoading();
+
+    url.clear();
+    parse(snapshot_, mode, true);
+}
+
+void Style::Impl::loadURL(const std::string& url_, LoadMode mode) {
     if (!fileSource) {
         observer->onStyleError(
             std::make_exception_ptr(util::StyleLoadException("Unable to find resource provider for style url.")));
@@ -60,7 +71,7 @@ void Style::Impl::loadURL(const std::string& url_) {
     loaded = false;
     url = url_;
 
-    styleRequest = fileSource->request(Resource::style(url), [this](const Response& res) {
+    styleRequest = fileSource->request(Resource::style(url), [this, mode](const Response& res) {
         // Don't allow a loaded, mutated style to be overwritten with a new version.
         if (mutated && loaded) {
             return;
@@ -74,15 +85,15 @@ void Style::Impl::loadURL(const std::string& url_) {
         } else if (res.notModified || res.noContent) {
             return;
         } else {
-            parse(*res.data);
+            parse(*res.data, mode);
         }
     });
 }
 
-void Style::Impl::parse(const std::string& json_) {
+void Style::Impl::parse(const std::string& json_, LoadMode mode, bool isSnapshot) {
     Parser parser;
 
-    if (auto error = parser.parse(json_)) {
+    if (auto error = isSnapshot ? parser.parseSnapshot(json_) : parser.parse(json_)) {
         std::string message = "Failed to parse style: " + util::toString(error);
         Log::Error(Event::ParseStyle, message.c_str());
         observer->onStyleError(std::make_exception_ptr(util::StyleParseException(message)));
@@ -94,15 +105,35 @@ void Style::Impl::parse(const std::string& json_) {
     loaded = false;
     json = json_;
 
-    sources.clear();
-    layers.clear();
-    images = makeMutable<ImageImpls>();
+    // The images of the current style, including the ones added at runtime, are kept along with its sprites
+    const bool sameSprites = mode == LoadMode::Diff && !spritesLoadingStatus.empty() &&
+                             std::equal(sprites.begin(),
+                                        sprites.end(),
+                                        parser.sprites.begin(),
+                                        parser.sprites.end(),
+                                        [](const Sprite& a, const Sprite& b) {
+                                            return a.id == b.id && a.spriteURL == b.spriteURL;
+                                        });
+
+    if (mode == LoadMode::Diff) {
+        diffSources(parser);
+        diffLayers(parser);
+    } else {
+        sources.clear();
+        layers.clear();
+    }
+    if (!sameSprites) {
+        images = makeMutable<ImageImpls>();
+    }
 
     transitionOptions = parser.transition;
 
     for (auto& source : parser.sources) {
-        addSource(std::move(source));
+        if (source) {
+            addSource(std::move(source));
+        }
     }
+    sourceFingerprints = std::move(parser.sourceFingerprints);
 
     for (auto& layer : parser.layers) {
         addLayer(std::move(layer));
@@ -116,7 +147,9 @@ void Style::Impl::parse(const std::string& json_) {
 
     setLight(std::make_unique<Light>(parser.light));
 
-    if (fileSource) {
+    if (sameSprites) {
+        // Already loaded, or being loaded
+    } else if (fileSource) {
         if (parser.sprites.empty()) {
             // We identify no sprite with 'default' as string in the sprite loading status.
             spritesLoadingStatus["default"] = false;
@@ -133,13 +166,63 @@ void Style::Impl::parse(const std::string& json_) {
         onSpriteError(std::nullopt,
                       std::make_exception_ptr(std::runtime_error("Unable to find resource provider for sprite url.")));
     }
+    sprites = std::move(parser.sprites);
     glyphURL = parser.glyphURL;
 
     loaded = true;
     observer->onStyleLoaded();
 }
 
+// Keeps the current sources whose definition didn't change, and their tiles. The parsed ones are left for the
+// sources to add.
+void Style::Impl::diffSources(Parser& parser) {
+    std::unordered_set<std::string> ids;
+    for (auto& source : parser.sources) {
+        const std::string id = source->getID();
+        ids.insert(id);
+
+        if (!sources.get(id)) {
+            continue;
+        }
+        const auto current = sourceFingerprints.find(id);
+        if (current != sourceFingerprints.end() && current->second == parser.sourceFingerprints[id]) {
+            source.reset();
+        } else {
+            // The layers using it are replaced as well
+            sources.remove(id)->setObserver(nullptr);
+        }
+    }
+
+    for (auto* source : sources.getWrappers()) {
+        if (!ids.contains(source->getID())) {
+            sources.remove(source->getID())->setObserver(nullptr);
+        }
+    }
+}
+
+// Replaces the layers with the parsed ones. The current `Layer` objects are kept for the layers of the same ID and
+// type, with the new definition, so that the renderer updates them rather than creating them again.
+void Style::Impl::diffLayers(Parser& parser) {
+    std::unordered_map<std::string, std::unique_ptr<Layer>> current;
+    for (auto& layer : layers.release()) {
+        const std::string id = layer->getID();
+        current.emplace(id, std::move(layer));
+    }
+
+    for (auto& layer : parser.layers) {
+        const auto it = current.find(layer->getID());
+        if (it != current.end() && it->second->getTypeInfo() == layer->getTypeInfo()) {
+            it->second->baseImpl = layer->baseImpl;
+            layer = std::move(it->second);
+        }
+    }
+}
+
 std::string Style::Impl::getJSON() const {
+    if (snapshot::isSnapshot(json)) {
+        // Only turned back into JSON when asked for, it was valid when loaded
+        return snapshot::decode(json);
+    }
     return json;
 }
 
@@ -181,6 +264,7 @@ std::unique_ptr<Source> Style::Impl::removeSource(const std::string& id) {
 
     if (source) {
         source->setObserver(nullptr);
+        sourceFingerprints.erase(id);
     }
 
     return source;
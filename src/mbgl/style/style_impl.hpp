@@ -9,6 +9,7 @@
 #include <mbgl/style/light_observer.hpp>
 #include <mbgl/sprite/sprite_loader_observer.hpp>
 #include <mbgl/style/image.hpp>
+#include <mbgl/style/sprite.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/collection.hpp>
@@ -18,6 +19,7 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/geo.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +33,8 @@ class SpriteLoader;
 
 namespace style {
 
+class Parser;
+
 class Style::Impl : public SpriteLoaderObserver,
                     public SourceObserver,
                     public LayerObserver,
@@ -40,8 +44,9 @@ public:
     Impl(std::shared_ptr<FileSource>, float pixelRatio, const TaggedScheduler& threadPool_);
     ~Impl() override;
 
-    void loadJSON(const std::string&);
-    void loadURL(const std::string&);
+    void loadJSON(const std::string&, LoadMode = LoadMode::Replace);
+    void loadURL(const std::string&, LoadMode = LoadMode::Replace);
+    void loadSnapshot(const std::string&, LoadMode = LoadMode::Replace);
 
     std::string getJSON() const;
     std::string getURL() const;
@@ -92,8 +97,13 @@ public:
     bool mutated = false;
     bool loaded = false;
 
+    // Hash of the definition of the sources that come from the style, and weren't changed since.
+    std::unordered_map<std::string, uint64_t> sourceFingerprints;
+
 private:
-    void parse(const std::string&);
+    void parse(const std::string&, LoadMode, bool isSnapshot = false);
+    void diffSources(Parser&);
+    void diffLayers(Parser&);
 
     std::shared_ptr<FileSource> fileSource;
 
@@ -110,6 +120,7 @@ private:
     TransitionOptions transitionOptions;
     std::unique_ptr<Light> light;
     std::unordered_map<std::string, bool> spritesLoadingStatus;
+    std::vector<Sprite> sprites;
 
     // Defaults
     std::string name;
@@ -12,6 +12,7 @@
 
 #include <mbgl/renderer/buckets/symbol_bucket.hpp> // For PlacedSymbol: pull out to another location
 
+#include <algorithm>
 #include <cmath>
 
 namespace mbgl {
@@ -54,7 +55,7 @@ float CollisionIndex::approximateTileDistance(const TileDistance& tileDistance,
                                               const float lastSegmentAngle,
                                               const float pixelsToTileUnits,
                                               const float cameraToAnchorDistance,
-                                              const bool pitchWithMap) {
+                                              const bool pitchWithMap) const {
     // This is a quick and dirty solution for chosing which collision circles to
     // use (since collision circles are laid out in tile units). Ideally, I
     // think we should generate collision circles on the fly in viewport
@@ -174,38 +175,52 @@ std::pair<bool, bool> CollisionIndex::placeFeature(
 
         return {true, isOffscreen(collisionBoundaries)};
     } else {
-        return placeLineFeature(feature,
-                                posMatrix,
-                                labelPlaneMatrix,
-                                textPixelRatio,
-                                symbol,
-                                scale,
-                                fontSize,
-                                allowOverlap,
-                                pitchWithMap,
-                                collisionDebug,
-                                avoidEdges,
-                                collisionGroupPredicate,
-                                projectedBoxes);
+        return placeProjectedLineFeature(
+            projectLineFeature(
+                feature, posMatrix, labelPlaneMatrix, textPixelRatio, symbol, scale, fontSize, pitchWithMap),
+            allowOverlap,
+            collisionDebug,
+            avoidEdges,
+            collisionGroupPredicate,
+            projectedBoxes);
     }
 }
 
-std::pair<bool, bool> CollisionIndex::placeLineFeature(
-    const CollisionFeature& feature,
-    const mat4& posMatrix,
-    const mat4& labelPlaneMatrix,
-    const float textPixelRatio,
-    const PlacedSymbol& symbol,
-    const float scale,
-    const float fontSize,
-    const bool allowOverlap,
-    const bool pitchWithMap,
-    const bool collisionDebug,
-    const std::optional<CollisionBoundaries>& avoidEdges,
-    const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& collisionGroupPredicate,
-    std::vector<ProjectedCollisionBox>& projectedBoxes) {
+CollisionIndex::ProjectedLineFeature CollisionIndex::ProjectedLineFeature::translated(Point<float> offset) const {
+    ProjectedLineFeature result{std::vector<ProjectedCollisionBox>(circles.size()), fits};
+    for (size_t i = 0; i < circles.size(); i++) {
+        if (circles[i].isCircle()) {
+            const auto& circle = circles[i].circle();
+            result.circles[i] = ProjectedCollisionBox{
+                circle.center.x + offset.x, circle.center.y + offset.y, circle.radius};
+        }
+    }
+    return result;
+}
+
+std::optional<Point<float>> CollisionIndex::viewportShift(const mat4& from, const mat4& to, const Size size) {
+    if (from == to) {
+        return Point<float>{0.0f, 0.0f};
+    }
+    // Without perspective over the tile plane, w is the same for every point and the pan
+    // moves all of them alike.
+    if (from[3] != 0 || from[7] != 0 || from[14] != to[14] || from[15] != to[15] ||
+        !std::equal(from.begin(), from.begin() + 12, to.begin())) {
+        return std::nullopt;
+    }
+    return Point<float>{static_cast<float>((to[12] - from[12]) / from[15] / 2 * size.width),
+                        static_cast<float>(-(to[13] - from[13]) / from[15] / 2 * size.height)};
+}
+
+CollisionIndex::ProjectedLineFeature CollisionIndex::projectLineFeature(const CollisionFeature& feature,
+                                                                        const mat4& posMatrix,
+                                                                        const mat4& labelPlaneMatrix,
+                                                                        const float textPixelRatio,
+                                                                        const PlacedSymbol& symbol,
+                                                                        const float scale,
+                                                                        const float fontSize,
+                                                                        const bool pitchWithMap) const {
     assert(feature.alongLine);
-    assert(projectedBoxes.empty());
     const auto tileUnitAnchorPoint = symbol.anchorPoint;
     const auto projectedAnchor = projectAnchor(posMatrix, tileUnitAnchorPoint);
 
@@ -225,9 +240,11 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
                                                           labelPlaneMatrix,
                                                           /*return tile distance*/ true);
 
-    bool collisionDetected = false;
-    bool inGrid = false;
-    bool entirelyOffscreen = true;
+    ProjectedLineFeature result{std::vector<ProjectedCollisionBox>(feature.boxes.size()), bool(firstAndLastGlyph)};
+    if (!firstAndLastGlyph) {
+        // The label doesn't fit on its line, so none of the circles are used
+        return result;
+    }
 
     const auto tileToViewport = projectedAnchor.first * textPixelRatio;
     // pixelsToTileUnits is used for translating line geometry to tile units
@@ -235,31 +252,24 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
     // equivalent to pixel_to_tile_units
     const auto pixelsToTileUnits = 1 / (textPixelRatio * scale);
 
-    float firstTileDistance = 0.f;
-    float lastTileDistance = 0.f;
-    if (firstAndLastGlyph) {
-        firstTileDistance = approximateTileDistance(*(firstAndLastGlyph->first.tileDistance),
-                                                    firstAndLastGlyph->first.angle,
-                                                    pixelsToTileUnits,
-                                                    projectedAnchor.second,
-                                                    pitchWithMap);
-        lastTileDistance = approximateTileDistance(*(firstAndLastGlyph->second.tileDistance),
-                                                   firstAndLastGlyph->second.angle,
-                                                   pixelsToTileUnits,
-                                                   projectedAnchor.second,
-                                                   pitchWithMap);
-    }
+    const float firstTileDistance = approximateTileDistance(*(firstAndLastGlyph->first.tileDistance),
+                                                            firstAndLastGlyph->first.angle,
+                                                            pixelsToTileUnits,
+                                                            projectedAnchor.second,
+                                                            pitchWithMap);
+    const float lastTileDistance = approximateTileDistance(*(firstAndLastGlyph->second.tileDistance),
+                                                           firstAndLastGlyph->second.angle,
+                                                           pixelsToTileUnits,
+                                                           projectedAnchor.second,
+                                                           pitchWithMap);
 
     bool previousCirclePlaced = false;
-    projectedBoxes.resize(feature.boxes.size());
     for (size_t i = 0; i < feature.boxes.size(); i++) {
         const CollisionBox& circle = feature.boxes[i];
         const float boxSignedDistanceFromAnchor = circle.signedDistanceFromAnchor;
-        if (!firstAndLastGlyph || (boxSignedDistanceFromAnchor < -firstTileDistance) ||
-            (boxSignedDistanceFromAnchor > lastTileDistance)) {
-            // The label either doesn't fit on its line or we
-            // don't need to use this circle because the label
-            // doesn't extend this far. Either way, mark the circle unused.
+        if ((boxSignedDistanceFromAnchor < -firstTileDistance) || (boxSignedDistanceFromAnchor > lastTileDistance)) {
+            // We don't need to use this circle because the label
+            // doesn't extend this far. Mark the circle unused.
             previousCirclePlaced = false;
             continue;
         }
@@ -269,7 +279,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
         const float radius = tileUnitRadius * tileToViewport;
 
         if (previousCirclePlaced) {
-            const ProjectedCollisionBox& previousCircle = projectedBoxes[i - 1];
+            const ProjectedCollisionBox& previousCircle = result.circles[i - 1];
             assert(previousCircle.isCircle());
             const auto& previousCenter = previousCircle.circle().center;
             const float dx = projectedPoint.x - previousCenter.x;
@@ -302,19 +312,43 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
         }
 
         previousCirclePlaced = true;
+        result.circles[i] = ProjectedCollisionBox{projectedPoint.x, projectedPoint.y, radius};
+    }
+
+    return result;
+}
+
+std::pair<bool, bool> CollisionIndex::placeProjectedLineFeature(
+    const ProjectedLineFeature& feature,
+    const bool allowOverlap,
+    const bool collisionDebug,
+    const std::optional<CollisionBoundaries>& avoidEdges,
+    const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& collisionGroupPredicate,
+    std::vector<ProjectedCollisionBox>& projectedBoxes) const {
+    assert(projectedBoxes.empty());
+    bool collisionDetected = false;
+    bool inGrid = false;
+    bool entirelyOffscreen = true;
+
+    projectedBoxes.resize(feature.circles.size());
+    for (size_t i = 0; i < feature.circles.size(); i++) {
+        if (!feature.circles[i].isCircle()) {
+            continue;
+        }
 
-        CollisionBoundaries collisionBoundaries{{projectedPoint.x - radius,
-                                                 projectedPoint.y - radius,
-                                                 projectedPoint.x + radius,
-                                                 projectedPoint.y + radius}};
+        const auto& circle = feature.circles[i].circle();
+        CollisionBoundaries collisionBoundaries{{circle.center.x - circle.radius,
+                                                 circle.center.y - circle.radius,
+                                                 circle.center.x + circle.radius,
+                                                 circle.center.y + circle.radius}};
 
-        projectedBoxes[i] = ProjectedCollisionBox{projectedPoint.x, projectedPoint.y, radius};
+        projectedBoxes[i] = feature.circles[i];
 
         entirelyOffscreen &= isOffscreen(collisionBoundaries);
         inGrid |= isInsideGrid(collisionBoundaries);
 
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes[i].circle(), collisionGroupPredicate))) {
+            (!allowOverlap && collisionGrid.hitTest(circle, collisionGroupPredicate))) {
             if (!collisionDebug) {
                 return {false, false};
             } else {
@@ -325,7 +359,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
         }
     }
 
-    return {!collisionDetected && firstAndLastGlyph && inGrid, entirelyOffscreen};
+    return {!collisionDetected && feature.fits && inGrid, entirelyOffscreen};
 }
 
 void CollisionIndex::insertFeature(const CollisionFeature& feature,
@@ -7,6 +7,7 @@
 #include <mbgl/map/transform_state.hpp>
 
 #include <array>
+#include <functional>
 
 namespace mbgl {
 
@@ -29,6 +30,23 @@ class CollisionIndex {
 public:
     using CollisionGrid = GridIndex<IndexedSubfeature>;
 
+    // The collision circles of a line label in viewport coordinates. Projecting
+    // them does not depend on what has been placed already, so it can be done
+    // ahead of the collision tests and on other threads.
+    struct ProjectedLineFeature {
+        // Circles not used by the label are left without geometry
+        std::vector<ProjectedCollisionBox> circles;
+        // Whether the label fits on its line
+        bool fits = false;
+
+        ProjectedLineFeature translated(Point<float> offset) const;
+    };
+
+    // The viewport offset of everything projected with `to` instead of `from`, if the two
+    // tile matrices only differ by a pan of a flat view. Line features projected with `from`
+    // can then be translated by it instead of projected again.
+    static std::optional<Point<float>> viewportShift(const mat4& from, const mat4& to, Size);
+
     explicit CollisionIndex(const TransformState&, MapMode);
     IntersectStatus intersectsTileEdges(const CollisionBox&,
                                         Point<float> shift,
@@ -52,6 +70,25 @@ public:
         std::vector<ProjectedCollisionBox>& /*out*/
     );
 
+    ProjectedLineFeature projectLineFeature(const CollisionFeature& feature,
+                                            const mat4& posMatrix,
+                                            const mat4& labelPlaneMatrix,
+                                            float textPixelRatio,
+                                            const PlacedSymbol& symbol,
+                                            float scale,
+                                            float fontSize,
+                                            bool pitchWithMap) const;
+
+    // Same as placeFeature() for a line label, with circles from projectLineFeature()
+    std::pair<bool, bool> placeProjectedLineFeature(
+        const ProjectedLineFeature& feature,
+        bool allowOverlap,
+        bool collisionDebug,
+        const std::optional<CollisionBoundaries>& avoidEdges,
+        const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& collisionGroupPredicate,
+        std::vector<ProjectedCollisionBox>& /*out*/
+    ) const;
+
     void insertFeature(const CollisionFeature& feature,
                        const std::vector<ProjectedCollisionBox>&,
                        bool ignorePlacement,
@@ -72,27 +109,11 @@ private:
     bool isInsideTile(const CollisionBoundaries& boundaries, const CollisionBoundaries& tileBoundaries) const;
     bool overlapsTile(const CollisionBoundaries& boundaries, const CollisionBoundaries& tileBoundaries) const;
 
-    std::pair<bool, bool> placeLineFeature(
-        const CollisionFeature& feature,
-        const mat4& posMatrix,
-        const mat4& labelPlaneMatrix,
-        float textPixelRatio,
-        const PlacedSymbol& symbol,
-        float scale,
-        float fontSize,
-        bool allowOverlap,
-        bool pitchWithMap,
-        bool collisionDebug,
-        const std::optional<CollisionBoundaries>& avoidEdges,
-        const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& collisionGroupPredicate,
-        std::vector<ProjectedCollisionBox>& /*out*/
-    );
-
     float approximateTileDistance(const TileDistance& tileDistance,
                                   float lastSegmentAngle,
                                   float pixelsToTileUnits,
                                   float cameraToAnchorDistance,
-                                  bool pitchWithMap);
+                                  bool pitchWithMap) const;
 
     std::pair<float, float> projectAnchor(const mat4& posMatrix, const Point<float>& point) const;
     std::pair<Point<float>, float> projectAndGetPerspectiveRatio(const mat4& posMatrix,
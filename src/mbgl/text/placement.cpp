@@ -1,5 +1,6 @@
 #include <mbgl/text/placement.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -10,7 +11,12 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <list>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace mbgl {
@@ -231,6 +237,54 @@ Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor,
     }
     return shift;
 }
+
+// Line labels projected by one background task
+constexpr std::size_t lineLabelsPerTask = 64;
+
+// Calls fn(begin, end) for chunks of [0, count), on the background threads and on the
+// calling thread, and returns once all of them are done.
+template <typename Fn>
+void parallelFor(std::size_t count, std::size_t chunkSize, const Fn& fn) {
+    const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+    if (chunks <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::size_t done = 0;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    const auto state = std::make_shared<State>();
+    // Tasks that start late find no chunk left and never touch `fn`
+    const auto work = [state, chunks, chunkSize, count, &fn] {
+        for (std::size_t chunk = state->next++; chunk < chunks; chunk = state->next++) {
+            fn(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (++state->done == chunks) {
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    const auto scheduler = Scheduler::GetBackground();
+    const std::size_t helpers = std::min<std::size_t>(chunks - 1, std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t i = 0; i < helpers; ++i) {
+        scheduler->scheduleWithPriority(util::SimpleIdentity::Empty, TaskPriority::High, work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done == chunks; });
+}
+
+bool sameCamera(const TransformState& a, const TransformState& b) {
+    return a.getSize() == b.getSize() && a.getZoom() == b.getZoom() && a.getBearing() == b.getBearing() &&
+           a.getPitch() == b.getPitch() && a.getCameraToCenterDistance() == b.getCameraToCenterDistance();
+}
+
 } // namespace
 
 void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<uint32_t>& seenCrossTileIDs) {
@@ -243,10 +297,13 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
                          placementZoom,
                          collisionGroups.get(params.sourceId),
                          getAvoidEdges(symbolBucket, renderTile.matrix)};
-    for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
+    const SymbolInstanceReferences symbols = getSortedSymbols(params, ctx.pixelRatio);
+    const auto projectedLineLabels = projectLineLabels(symbols, ctx, seenCrossTileIDs);
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        const SymbolInstance& symbol = symbols[i];
         if (!symbol.check(SYM_GUARD_LOC)) continue;
         if (seenCrossTileIDs.contains(symbol.getCrossTileID())) continue;
-        placeSymbol(symbol, ctx);
+        placeSymbol(symbol, ctx, projectedLineLabels[i]);
 
         // Prevent a flickering issue while zooming out.
         if (symbol.getCrossTileID() != SymbolInstance::invalidCrossTileID && !ctx.getRenderTile().holdForFade()) {
@@ -265,7 +322,88 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
         std::forward_as_tuple(symbolBucket.bucketInstanceId, params.featureIndex, ctx.getOverscaledID()));
 }
 
-JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext& ctx) {
+std::vector<const CollisionIndex::ProjectedLineFeature*> Placement::projectLineLabels(
+    const SymbolInstanceReferences& symbols,
+    const PlacementContext& ctx,
+    const std::set<uint32_t>& seenCrossTileIDs) {
+    MLN_TRACE_FUNC();
+    std::vector<const CollisionIndex::ProjectedLineFeature*> result(symbols.size(), nullptr);
+    // Line placement has no variable anchors, so its text is always placed with the default
+    // horizontal collision feature.
+    if (ctx.placementType == SymbolPlacementType::Point || ctx.getRenderTile().holdForFade()) {
+        return result;
+    }
+
+    const SymbolBucket& bucket = ctx.getBucket();
+    const mat4& posMatrix = ctx.getRenderTile().matrix;
+    auto& projections = lineLabelProjections[bucket.bucketInstanceId];
+    projections.posMatrix = posMatrix;
+    projections.features.resize(bucket.symbolInstances.size());
+
+    // The projections of the previous placement, and how far they have moved since. They are
+    // only reused when the view is a flat pan of the previous one, where translating them gives
+    // the same circles as projecting again; any other camera change projects every label anew.
+    const LineLabelProjections* previous = nullptr;
+    Point<float> shift{0.0f, 0.0f};
+    const Placement* prev = getPrevPlacement();
+    if (prev && prev->placementZoom == placementZoom &&
+        sameCamera(prev->collisionIndex.getTransformState(), collisionIndex.getTransformState())) {
+        const auto it = prev->lineLabelProjections.find(bucket.bucketInstanceId);
+        if (it != prev->lineLabelProjections.end() && it->second.features.size() == projections.features.size()) {
+            const auto offset = CollisionIndex::viewportShift(
+                it->second.posMatrix, posMatrix, ctx.getTransformState().getSize());
+            if (offset) {
+                previous = &it->second;
+                shift = *offset;
+            }
+        }
+    }
+
+    // Positions in `symbols` and in the bucket of the labels left to project
+    std::vector<std::pair<std::size_t, std::size_t>> pending;
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        const SymbolInstance& symbol = symbols[i];
+        if (!symbol.check(SYM_GUARD_LOC) || symbol.getCrossTileID() == SymbolInstance::invalidCrossTileID ||
+            seenCrossTileIDs.contains(symbol.getCrossTileID()) || !symbol.getDefaultHorizontalPlacedTextIndex() ||
+            !symbol.getTextCollisionFeature().alongLine) {
+            continue;
+        }
+        const auto index = static_cast<std::size_t>(&symbol - bucket.symbolInstances.data());
+        if (previous && previous->features[index]) {
+            projections.features[index] = previous->features[index]->translated(shift);
+            result[i] = &*projections.features[index];
+        } else {
+            pending.emplace_back(i, index);
+        }
+    }
+
+    // Every label has its own slot, so the tasks don't share anything they write to
+    parallelFor(pending.size(), lineLabelsPerTask, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p) {
+            const SymbolInstance& symbol = symbols[pending[p].first];
+            const PlacedSymbol& placedSymbol = bucket.text.placedSymbols.at(
+                *symbol.getDefaultHorizontalPlacedTextIndex());
+            projections.features[pending[p].second] = collisionIndex.projectLineFeature(
+                symbol.getTextCollisionFeature(),
+                posMatrix,
+                ctx.textLabelPlaneMatrix,
+                ctx.pixelRatio,
+                placedSymbol,
+                ctx.scale,
+                evaluateSizeForFeature(ctx.partiallyEvaluatedTextSize, placedSymbol),
+                ctx.pitchTextWithMap);
+        }
+    });
+
+    for (const auto& [i, index] : pending) {
+        result[i] = &*projections.features[index];
+    }
+    return result;
+}
+
+JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance,
+                                      const PlacementContext& ctx,
+                                      const CollisionIndex::ProjectedLineFeature* projectedText) {
     static const JointPlacement kUnplaced(false, false, false);
     if (!symbolInstance.check(SYM_GUARD_LOC)) return kUnplaced;
     if (symbolInstance.getCrossTileID() == SymbolInstance::invalidCrossTileID) return kUnplaced;
@@ -328,20 +466,28 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
             const auto placeFeature = [&](const CollisionFeature& collisionFeature,
                                           style::TextWritingModeType orientation) {
                 textBoxes.clear();
-                auto placedFeature = collisionIndex.placeFeature(collisionFeature,
-                                                                 {},
-                                                                 posMatrix,
-                                                                 ctx.textLabelPlaneMatrix,
-                                                                 ctx.pixelRatio,
-                                                                 placedSymbol,
-                                                                 ctx.scale,
-                                                                 fontSize,
-                                                                 ctx.textAllowOverlap,
-                                                                 ctx.pitchTextWithMap,
-                                                                 showCollisionBoxes,
-                                                                 ctx.avoidEdges,
-                                                                 collisionGroup.second,
-                                                                 textBoxes);
+                auto placedFeature =
+                    projectedText && &collisionFeature == &symbolInstance.getTextCollisionFeature()
+                        ? collisionIndex.placeProjectedLineFeature(*projectedText,
+                                                                   ctx.textAllowOverlap,
+                                                                   showCollisionBoxes,
+                                                                   ctx.avoidEdges,
+                                                                   collisionGroup.second,
+                                                                   textBoxes)
+                        : collisionIndex.placeFeature(collisionFeature,
+                                                      {},
+                                                      posMatrix,
+                                                      ctx.textLabelPlaneMatrix,
+                                                      ctx.pixelRatio,
+                                                      placedSymbol,
+                                                      ctx.scale,
+                                                      fontSize,
+                                                      ctx.textAllowOverlap,
+                                                      ctx.pitchTextWithMap,
+                                                      showCollisionBoxes,
+                                                      ctx.avoidEdges,
+                                                      collisionGroup.second,
+                                                      textBoxes);
                 if (placedFeature.first) {
                     placedOrientations.emplace(symbolInstance.getCrossTileID(), orientation);
                 }
@@ -145,7 +145,13 @@ public:
 protected:
     friend SymbolBucket;
     virtual void placeSymbolBucket(const BucketPlacementData&, std::set<uint32_t>& seenCrossTileIDs);
-    JointPlacement placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext&);
+    JointPlacement placeSymbol(const SymbolInstance& symbolInstance,
+                               const PlacementContext&,
+                               const CollisionIndex::ProjectedLineFeature* projectedText = nullptr);
+    // Projects the line labels among the given symbols ahead of their placement, in
+    // parallel. Returns the projected text for each symbol, or null for other symbols.
+    std::vector<const CollisionIndex::ProjectedLineFeature*> projectLineLabels(
+        const SymbolInstanceReferences&, const PlacementContext&, const std::set<uint32_t>& seenCrossTileIDs);
     void placeLayer(const RenderLayer&, std::set<uint32_t>&);
     virtual void commit();
     virtual void newSymbolPlaced(const SymbolInstance&,
@@ -201,6 +207,15 @@ protected:
     mutable std::optional<Immutable<Placement>> prevPlacement;
     bool showCollisionBoxes = false;
 
+    // Line labels projected by this placement, by bucket instance ID. The next placement
+    // reuses them when the camera has only panned a flat view.
+    struct LineLabelProjections {
+        mat4 posMatrix;
+        // By symbol index in the bucket
+        std::vector<std::optional<CollisionIndex::ProjectedLineFeature>> features;
+    };
+    std::unordered_map<uint32_t, LineLabelProjections> lineLabelProjections;
+
     // Cache being used by placeSymbol()
     std::vector<ProjectedCollisionBox> textBoxes;
     std::vector<ProjectedCollisionBox> iconBoxes;
@@ -0,0 +1,190 @@
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/util/hash.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+// The metrics of the glyph of each character in the tile, or nothing for glyphs that aren't loaded.
+// Shaping skips the missing glyphs and breaks lines by the advances of the others, so a shaping is
+// only valid for tiles with the same glyphs for every character, not just for the positioned ones.
+std::vector<std::optional<GlyphMetrics>> glyphMetrics(const TaggedString& string, const GlyphMap& glyphMap) {
+    std::vector<std::optional<GlyphMetrics>> result(string.length());
+    for (std::size_t i = 0; i < string.length(); ++i) {
+        const auto glyphs = glyphMap.find(string.getSection(i).fontStackHash);
+        if (glyphs == glyphMap.end()) {
+            continue;
+        }
+        const auto glyph = glyphs->second.find(string.getCharCodeAt(i));
+        if (glyph != glyphs->second.end() && glyph->second) {
+            result[i] = (*glyph->second)->metrics;
+        }
+    }
+    return result;
+}
+
+// Use the glyph atlas positions of the requesting tile.
+// Fails if the metrics of a glyph differ from those the shaping was made with.
+bool updateGlyphPositions(Shaping& shaping, const GlyphPositions& glyphPositions) {
+    for (auto& line : shaping.positionedLines) {
+        for (auto& glyph : line.positionedGlyphs) {
+            const auto font = glyphPositions.find(glyph.font);
+            if (font == glyphPositions.end()) {
+                return false;
+            }
+            const auto position = font->second.find(glyph.glyph);
+            if (position == font->second.end()) {
+                // Glyphs without a bitmap, like spaces, aren't in the atlas
+                glyph.rect = {};
+            } else if (position->second.metrics == glyph.metrics) {
+                glyph.rect = position->second.rect;
+            } else {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::size_t ShapingCache::KeyHasher::operator()(const Key& key) const {
+    std::size_t seed = util::hash(key.text.first,
+                                  key.maxWidth,
+                                  key.lineHeight,
+                                  key.spacing,
+                                  key.translate[0],
+                                  key.translate[1],
+                                  static_cast<uint8_t>(key.textAnchor),
+                                  static_cast<uint8_t>(key.textJustify),
+                                  static_cast<uint8_t>(key.writingMode),
+                                  key.allowVerticalPlacement);
+    for (const auto& section : key.sections) {
+        util::hash_combine(seed, section.first);
+        util::hash_combine(seed, section.second);
+    }
+    return seed;
+}
+
+ShapingCache& ShapingCache::getInstance() {
+    static ShapingCache instance;
+    return instance;
+}
+
+Shaping ShapingCache::getShaping(const TaggedString& string,
+                                 const float maxWidth,
+                                 const float lineHeight,
+                                 const style::SymbolAnchorType textAnchor,
+                                 const style::TextJustifyType textJustify,
+                                 const float spacing,
+                                 const std::array<float, 2>& translate,
+                                 const WritingModeType writingMode,
+                                 BiDi& bidi,
+                                 const GlyphMap& glyphMap,
+                                 const GlyphPositions& glyphPositions,
+                                 const ImagePositions& imagePositions,
+                                 float layoutTextSize,
+                                 float layoutTextSizeAtBucketZoomLevel,
+                                 bool allowVerticalPlacement) {
+    const auto shape = [&] {
+        return mbgl::getShaping(string,
+                                maxWidth,
+                                lineHeight,
+                                textAnchor,
+                                textJustify,
+                                spacing,
+                                translate,
+                                writingMode,
+                                bidi,
+                                glyphMap,
+                                glyphPositions,
+                                imagePositions,
+                                layoutTextSize,
+                                layoutTextSizeAtBucketZoomLevel,
+                                allowVerticalPlacement);
+    };
+
+    const auto& sections = string.getSections();
+    const bool hasImages = std::any_of(
+        sections.begin(), sections.end(), [](const SectionOptions& section) { return section.imageID.has_value(); });
+    if (hasImages || maxEntries == 0) {
+        return shape();
+    }
+
+    // The text size only matters for images, so it's not part of the key
+    Key key{string.getStyledText(),
+            {},
+            maxWidth,
+            lineHeight,
+            spacing,
+            translate,
+            textAnchor,
+            textJustify,
+            writingMode,
+            allowVerticalPlacement};
+    key.sections.reserve(sections.size());
+    for (const auto& section : sections) {
+        key.sections.emplace_back(section.scale, section.fontStackHash);
+    }
+
+    std::shared_ptr<const Entry> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = entries.find(key);
+        if (it != entries.end()) {
+            cached = it->second;
+            lru.touch(key);
+        }
+    }
+
+    auto metrics = glyphMetrics(string, glyphMap);
+    if (cached && cached->glyphMetrics == metrics) {
+        Shaping shaping = cached->shaping;
+        if (updateGlyphPositions(shaping, glyphPositions)) {
+            hits++;
+            return shaping;
+        }
+    }
+    misses++;
+
+    Shaping shaping = shape();
+    auto entry = std::make_shared<const Entry>(Entry{shaping, std::move(metrics)});
+
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.touch(key);
+    entries.insert_or_assign(std::move(key), std::move(entry));
+    evict();
+
+    return shaping;
+}
+
+void ShapingCache::setMaxEntries(std::size_t value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxEntries = value;
+    evict();
+}
+
+void ShapingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lru = {};
+    hits = 0;
+    misses = 0;
+}
+
+ShapingCache::Stats ShapingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {hits, misses, entries.size()};
+}
+
+void ShapingCache::evict() {
+    while (entries.size() > maxEntries) {
+        entries.erase(lru.evict());
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/util/lru_cache.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+/// @brief Shapings of the labels laid out recently, shared by all the tile workers.
+///
+/// Labels such as road names repeat across neighboring tiles and zoom levels, and shaping them is
+/// independent of the tile except for the position of each glyph in the tile's glyph atlas. A cached
+/// shaping is returned with the atlas positions of the requesting tile, and is only reused if that
+/// tile has the same glyphs, with the same metrics, for every character of the text. Text with
+/// images isn't cached, because image sizes depend on the tile's image atlas and on the text size.
+class ShapingCache : private util::noncopyable {
+public:
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::size_t entries = 0;
+    };
+
+    static constexpr std::size_t defaultMaxEntries = 2048;
+
+    static ShapingCache& getInstance();
+
+    /// Same as `mbgl::getShaping`, using a cached shaping if possible
+    Shaping getShaping(const TaggedString& string,
+                       float maxWidth,
+                       float lineHeight,
+                       style::SymbolAnchorType textAnchor,
+                       style::TextJustifyType textJustify,
+                       float spacing,
+                       const std::array<float, 2>& translate,
+                       WritingModeType,
+                       BiDi& bidi,
+                       const GlyphMap& glyphMap,
+                       const GlyphPositions& glyphPositions,
+                       const ImagePositions& imagePositions,
+                       float layoutTextSize,
+                       float layoutTextSizeAtBucketZoomLevel,
+                       bool allowVerticalPlacement);
+
+    /// Set the maximum number of cached shapings, zero disables the cache
+    void setMaxEntries(std::size_t);
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    ShapingCache() = default;
+
+    struct Key {
+        StyledText text;
+        std::vector<std::pair<double, FontStackHash>> sections;
+        float maxWidth;
+        float lineHeight;
+        float spacing;
+        std::array<float, 2> translate;
+        style::SymbolAnchorType textAnchor;
+        style::TextJustifyType textJustify;
+        WritingModeType writingMode;
+        bool allowVerticalPlacement;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHasher {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Entry {
+        Shaping shaping;
+        // The metrics of the glyph of each character when shaped, empty for the missing ones
+        std::vector<std::optional<GlyphMetrics>> glyphMetrics;
+    };
+
+    void evict();
+
+    mutable std::mutex mutex;
+    std::atomic<std::size_t> maxEntries{defaultMaxEntries};
+    LRU<Key, KeyHasher> lru;
+    std::unordered_map<Key, std::shared_ptr<const Entry>, KeyHasher> entries;
+
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+} // namespace mbgl
@@ -58,6 +58,7 @@ void CustomGeometryTile::invalidateTileData() {
 //  Only required tiles make fetchTile requests. Attempt to cancel a tile
 //  that is no longer required.
 void CustomGeometryTile::setNecessity(TileNecessity newNecessity) {
+    GeometryTile::setNecessity(newNecessity);
     if (newNecessity != necessity || stale) {
         necessity = newNecessity;
         if (necessity == TileNecessity::Required) {
@@ -19,11 +19,15 @@ public:
                 TileObserver* observer = nullptr);
 
     void updateData(std::shared_ptr<style::GeoJSONData> data, bool needsRelayout = false);
+    // Switches to data that has the same features in this tile, without reloading.
+    void retainData(std::shared_ptr<style::GeoJSONData> data);
 
     void querySourceFeatures(std::vector<Feature>& result, const SourceQueryOptions&) override;
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
+    // Identifies the latest request for tile features, so that earlier replies are ignored
+    uint64_t dataRequest = 0;
     mapbox::base::WeakPtrFactory<GeoJSONTile> weakFactory{this};
     // Do not add members here, see `WeakPtrFactory`
 };
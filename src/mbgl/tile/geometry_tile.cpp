@@ -18,6 +18,7 @@
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile_worker.hpp>
+#include <mbgl/tile/layout_cache.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
@@ -28,6 +29,29 @@
 
 namespace mbgl {
 
+GeometryTile::LayoutResult::LayoutResult(mbgl::unordered_map<std::string, LayerRenderData> renderData_,
+                                         std::unique_ptr<FeatureIndex> featureIndex_,
+                                         std::optional<AlphaImage> glyphAtlasImage_,
+                                         ImageAtlas iconAtlas_,
+                                         std::shared_ptr<const SharedAtlas::Reference> atlasReference_)
+    : layerRenderData(std::move(renderData_)),
+      featureIndex(std::move(featureIndex_)),
+      glyphAtlasImage(std::move(glyphAtlasImage_)),
+      iconAtlas(std::move(iconAtlas_)),
+      atlasReference(std::move(atlasReference_)) {
+    // Layers with the same layout share a bucket
+    std::set<const Bucket*> buckets;
+    for (const auto& entry : layerRenderData) {
+        if (entry.second.bucket && buckets.insert(entry.second.bucket.get()).second) {
+            byteSize += entry.second.bucket->getByteSize();
+        }
+    }
+    if (glyphAtlasImage) {
+        byteSize += glyphAtlasImage->bytes();
+    }
+    byteSize += iconAtlas.image.bytes();
+}
+
 LayerRenderData* GeometryTile::LayoutResult::getLayerRenderData(const style::Layer::Impl& layerImpl) {
     MLN_TRACE_FUNC();
     MLN_ZONE_STR(layerImpl.id);
@@ -95,6 +119,9 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 
     assert(atlasTextures);
 
+    // This tile's own atlases, used when its glyphs or images didn't fit in the shared ones
+    auto& stats = uploadPass.getContext().renderingStats();
+
     if (layoutResult->glyphAtlasImage && layoutResult->glyphAtlasImage->valid()) {
 #if MLN_DRAWABLE_RENDERER
         atlasTextures->glyph = uploadPass.getContext().createTexture2D();
@@ -104,6 +131,8 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 #else
         atlasTextures->glyph = uploadPass.createTexture(*layoutResult->glyphAtlasImage);
 #endif
+        stats.atlasUploadBytes += layoutResult->glyphAtlasImage->bytes();
+        atlasTextures->setGlyphBytes(stats, layoutResult->glyphAtlasImage->bytes());
         layoutResult->glyphAtlasImage = {};
     }
 
@@ -114,6 +143,8 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 #else
         atlasTextures->icon = uploadPass.createTexture(layoutResult->iconAtlas.image);
 #endif
+        stats.atlasUploadBytes += layoutResult->iconAtlas.image.bytes();
+        atlasTextures->setIconBytes(stats, layoutResult->iconAtlas.image.bytes());
         layoutResult->iconAtlas.image = {};
     }
 
@@ -129,6 +160,7 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
                                         imagePatch.paddedRect.x + ImagePosition::padding,
                                         imagePatch.paddedRect.y + ImagePosition::padding);
 #endif
+            stats.atlasUploadBytes += imagePatch.image->image.bytes();
         }
         imagePatches.clear();
     }
@@ -137,7 +169,8 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 void GeometryTileRenderData::prepare(const SourcePrepareParameters& parameters) {
     MLN_TRACE_FUNC();
 
-    if (!layoutResult) return;
+    // The shared atlas is patched once for all the tiles
+    if (!layoutResult || layoutResult->atlasReference) return;
     imagePatches = layoutResult->iconAtlas.getImagePatchesAndUpdateVersions(parameters.imageManager);
 }
 
@@ -182,12 +215,16 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
              obsolete,
              parameters.mode,
              parameters.pixelRatio,
-             parameters.debugOptions & MapDebugOptions::Collision),
+             parameters.debugOptions & MapDebugOptions::Collision,
+             parameters.sharedAtlas),
       fileSource(parameters.fileSource),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
+      sharedAtlasTextures(parameters.sharedAtlasTextures),
       mode(parameters.mode),
-      showCollisionBoxes(parameters.debugOptions & MapDebugOptions::Collision) {}
+      pixelRatio(parameters.pixelRatio),
+      showCollisionBoxes(parameters.debugOptions & MapDebugOptions::Collision),
+      layoutCache(parameters.layoutCache) {}
 
 GeometryTile::~GeometryTile() {
     MLN_TRACE_FUNC();
@@ -202,6 +239,18 @@ GeometryTile::~GeometryTile() {
         observer->onTileAction(id, sourceID, TileOperation::Cancelled);
     }
 
+    if (layoutResult && layoutCache && encodedData && layoutLayers && layoutCorrelationID == correlationID) {
+        // The layout is up to date with the tile's data and layers, keep it for when the tile is created again
+        LayoutCache::Key key{
+            sourceID, id, mode, pixelRatio, showCollisionBoxes, LayoutCache::hashLayers(*layoutLayers)};
+        layoutCache->add(std::move(key),
+                         {std::move(*layoutLayers),
+                          std::move(encodedData),
+                          std::move(layoutImages),
+                          std::move(layoutResult),
+                          std::move(atlasTextures)});
+    }
+
     if (layoutResult) {
         threadPool.runOnRenderThread(
             [layoutResult_{std::move(layoutResult)}, atlasTextures_{std::move(atlasTextures)}]() {});
@@ -222,7 +271,7 @@ void GeometryTile::setError(std::exception_ptr err) {
     observer->onTileError(*this, std::move(err));
 }
 
-void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
+void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_, std::shared_ptr<const std::string> encoded) {
     MLN_TRACE_FUNC();
 
     if (obsolete) {
@@ -238,8 +287,27 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     pending = true;
 
     ++correlationID;
-    worker.self().invoke(
-        &GeometryTileWorker::setData, std::move(data_), imageManager->getAvailableImages(), correlationID);
+    std::set<std::string> availableImages = imageManager->getAvailableImages();
+
+    if (layoutCache) {
+        encodedData = std::move(encoded);
+        layoutImages = availableImages;
+
+        if (encodedData && layoutLayers) {
+            LayoutCache::Key key{
+                sourceID, id, mode, pixelRatio, showCollisionBoxes, LayoutCache::hashLayers(*layoutLayers)};
+            if (auto entry = layoutCache->take(key, *layoutLayers, *encodedData, layoutImages)) {
+                // The worker only needs the data for later layouts
+                worker.self().invoke(
+                    &GeometryTileWorker::setLaidOutData, std::move(data_), std::move(availableImages), correlationID);
+                atlasTextures = std::move(entry->atlasTextures);
+                onLayout(std::move(entry->layoutResult), correlationID);
+                return;
+            }
+        }
+    }
+
+    worker.self().invoke(&GeometryTileWorker::setData, std::move(data_), std::move(availableImages), correlationID);
 }
 
 void GeometryTile::reset() {
@@ -256,6 +324,9 @@ void GeometryTile::reset() {
     // after clearing the tile's pending status.
     loaded = false;
 
+    layoutLayers.reset();
+    encodedData.reset();
+
     // Reset the worker to the `NeedsParse` state.
     ++correlationID;
     worker.self().invoke(&GeometryTileWorker::reset, correlationID);
@@ -267,6 +338,10 @@ std::unique_ptr<TileRenderData> GeometryTile::createRenderData() {
     return std::make_unique<GeometryTileRenderData>(layoutResult, atlasTextures);
 }
 
+void GeometryTile::setNecessity(TileNecessity necessity) {
+    worker.setPriority(workerPriority(necessity));
+}
+
 void GeometryTile::setLayers(const std::vector<Immutable<LayerProperties>>& layers) {
     MLN_TRACE_FUNC();
 
@@ -295,9 +370,19 @@ void GeometryTile::setLayers(const std::vector<Immutable<LayerProperties>>& laye
         impls.push_back(layer);
     }
 
+    std::set<std::string> availableImages = imageManager->getAvailableImages();
+
+    if (layoutCache) {
+        layoutLayers.emplace();
+        layoutLayers->reserve(impls.size());
+        for (const auto& layer : impls) {
+            layoutLayers->push_back(layer->baseImpl);
+        }
+        layoutImages = availableImages;
+    }
+
     ++correlationID;
-    worker.self().invoke(
-        &GeometryTileWorker::setLayers, std::move(impls), imageManager->getAvailableImages(), correlationID);
+    worker.self().invoke(&GeometryTileWorker::setLayers, std::move(impls), std::move(availableImages), correlationID);
 }
 
 void GeometryTile::setShowCollisionBoxes(const bool showCollisionBoxes_) {
@@ -321,7 +406,11 @@ void GeometryTile::onLayout(std::shared_ptr<LayoutResult> result, const uint64_t
     }
 
     layoutResult = std::move(result);
-    if (!atlasTextures) {
+    layoutCorrelationID = resultCorrelationID;
+    if (layoutResult && layoutResult->atlasReference) {
+        atlasTextures = sharedAtlasTextures;
+    } else if (!atlasTextures || atlasTextures == sharedAtlasTextures) {
+        // The shared textures never get the atlases of a single tile
         atlasTextures = std::make_shared<TileAtlasTextures>();
     }
 
@@ -4,6 +4,7 @@
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/gfx/texture.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/shared_atlas.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/tile/geometry_tile_worker.hpp>
@@ -12,6 +13,8 @@
 
 #include <atomic>
 #include <memory>
+#include <set>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <optional>
@@ -25,6 +28,7 @@ class TileParameters;
 class GlyphAtlas;
 class ImageAtlas;
 class TileAtlasTextures;
+class LayoutCache;
 
 class GeometryTile : public Tile, public GlyphRequestor, public ImageRequestor {
 public:
@@ -38,12 +42,15 @@ public:
     ~GeometryTile() override;
 
     void setError(std::exception_ptr);
-    void setData(std::unique_ptr<const GeometryTileData>);
+    // The encoded form of the data, if given, lets the tile reuse a layout
+    // from the layout cache and keep its own layout there when destroyed.
+    void setData(std::unique_ptr<const GeometryTileData>, std::shared_ptr<const std::string> encoded = nullptr);
     // Resets the tile's data and layers and leaves the tile in pending state,
     // waiting for the new data and layers to come.
     void reset();
 
     std::unique_ptr<TileRenderData> createRenderData() override;
+    void setNecessity(TileNecessity) override;
     void setLayers(const std::vector<Immutable<style::LayerProperties>>&) override;
     void setShowCollisionBoxes(bool showCollisionBoxes) override;
 
@@ -75,17 +82,19 @@ public:
         std::shared_ptr<FeatureIndex> featureIndex;
         std::optional<AlphaImage> glyphAtlasImage;
         ImageAtlas iconAtlas;
+        // Set when the glyphs and images are in the shared atlases instead of the images above
+        std::shared_ptr<const SharedAtlas::Reference> atlasReference;
+
+        // Approximate size of the buckets and atlases, measured before upload
+        std::size_t byteSize = 0;
 
         LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
 
         LayoutResult(mbgl::unordered_map<std::string, LayerRenderData> renderData_,
                      std::unique_ptr<FeatureIndex> featureIndex_,
                      std::optional<AlphaImage> glyphAtlasImage_,
-                     ImageAtlas iconAtlas_)
-            : layerRenderData(std::move(renderData_)),
-              featureIndex(std::move(featureIndex_)),
-              glyphAtlasImage(std::move(glyphAtlasImage_)),
-              iconAtlas(std::move(iconAtlas_)) {}
+                     ImageAtlas iconAtlas_,
+                     std::shared_ptr<const SharedAtlas::Reference> atlasReference_ = nullptr);
     };
     void onLayout(std::shared_ptr<LayoutResult>, uint64_t correlationID);
 
@@ -122,11 +131,20 @@ private:
 
     std::shared_ptr<LayoutResult> layoutResult;
     std::shared_ptr<TileAtlasTextures> atlasTextures;
+    const std::shared_ptr<TileAtlasTextures> sharedAtlasTextures;
+    uint64_t layoutCorrelationID = 0;
 
     const MapMode mode;
+    const float pixelRatio;
 
     bool showCollisionBoxes;
 
+    // The inputs of the current layout, identifying it in the layout cache
+    const std::shared_ptr<LayoutCache> layoutCache;
+    std::optional<std::vector<Immutable<style::Layer::Impl>>> layoutLayers;
+    std::shared_ptr<const std::string> encodedData;
+    std::set<std::string> layoutImages;
+
     enum class FadeState {
         Loaded,
         NeedsFirstPlacement,
@@ -20,6 +20,16 @@ using namespace std::numbers;
 
 namespace mbgl {
 
+void GeometryTileLayer::visitFeatures(const FeatureVisitor& visitor) const {
+    const std::size_t count = featureCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto feature = getFeature(i);
+        if (feature && !visitor(i, *feature)) {
+            return;
+        }
+    }
+}
+
 static double signedArea(const GeometryCoordinates& ring) {
     double sum = 0;
 
@@ -4,7 +4,9 @@
 #include <mbgl/util/feature.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <optional>
@@ -56,6 +58,11 @@ public:
     virtual const PropertyMap& getProperties() const;
     virtual FeatureIdentifier getID() const { return NullValue{}; }
     virtual const GeometryCollection& getGeometries() const;
+
+    // Returns the property for the given index into the key table of the layer the feature was
+    // visited on, without copying it, or nullptr if the feature doesn't have it. Only supported
+    // by features passed to `GeometryTileLayer::visitFeatures` of layers with a key table.
+    virtual const Value* getValueByKeyIndex(std::uint32_t) const { return nullptr; }
 };
 
 class GeometryTileLayer {
@@ -67,6 +74,18 @@ public:
     // returned feature object may *not* outlive the layer object.
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
 
+    // Calls the visitor with each feature and its position within the layer, in order,
+    // stopping early if the visitor returns false. The feature object is only valid for
+    // the duration of the call, which allows implementations to reuse a single feature
+    // and its buffers rather than allocating one per feature.
+    using FeatureVisitor = std::function<bool(std::size_t, const GeometryTileFeature&)>;
+    virtual void visitFeatures(const FeatureVisitor&) const;
+
+    // Layers that index the property keys of their features return true here, and the index of
+    // a key from `keyIndex`, for use with `GeometryTileFeature::getValueByKeyIndex`.
+    virtual bool hasKeyTable() const { return false; }
+    virtual std::optional<std::uint32_t> keyIndex(std::string_view) const { return std::nullopt; }
+
     virtual std::string getName() const = 0;
 };
 
@@ -14,6 +14,7 @@
 #include <mbgl/renderer/layers/render_line_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/renderer/shared_atlas.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/constants.hpp>
@@ -37,7 +38,8 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_,
                                        const float pixelRatio_,
-                                       const bool showCollisionBoxes_)
+                                       const bool showCollisionBoxes_,
+                                       std::shared_ptr<SharedAtlas> sharedAtlas_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       scheduler(scheduler_),
@@ -46,6 +48,7 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
       obsolete(obsolete_),
       mode(mode_),
       pixelRatio(pixelRatio_),
+      sharedAtlas(std::move(sharedAtlas_)),
       showCollisionBoxes(showCollisionBoxes_) {}
 
 GeometryTileWorker::~GeometryTileWorker() {
@@ -152,6 +155,35 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
     }
 }
 
+void GeometryTileWorker::setLaidOutData(std::unique_ptr<const GeometryTileData> data_,
+                                        std::set<std::string> availableImages_,
+                                        uint64_t correlationID_) {
+    MLN_TRACE_FUNC();
+
+    data = std::move(data_);
+    correlationID = correlationID_;
+    availableImages = std::move(availableImages_);
+    firstLoad = false;
+
+    // The tile took its layout from the layout cache, so any parse result
+    // or pending work is outdated. Symbol dependencies arriving later find
+    // no layouts to finish.
+    featureIndex.reset();
+    renderData.clear();
+    layouts.clear();
+
+    switch (state) {
+        case Idle:
+        case Coalescing:
+            break;
+
+        case NeedsParse:
+        case NeedsSymbolLayout:
+            state = Coalescing;
+            break;
+    }
+}
+
 void GeometryTileWorker::setLayers(std::vector<Immutable<LayerProperties>> layers_,
                                    std::set<std::string> availableImages_,
                                    uint64_t correlationID_) {
@@ -441,18 +473,22 @@ void GeometryTileWorker::parse() {
             const Filter& filter = leaderImpl.filter;
             const std::string& sourceLayerID = leaderImpl.sourceLayer;
             std::shared_ptr<Bucket> bucket = LayerManager::get()->createBucket(parameters, group);
+            const std::optional<FilterKeyBinding> filterBinding = filter.bind(*geometryLayer);
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+            geometryLayer->visitFeatures([&](std::size_t i, const GeometryTileFeature& feature) {
+                if (obsolete) {
+                    return false;
+                }
 
-                if (!filter(expression::EvaluationContext(static_cast<float>(this->id.overscaledZ), feature.get())
-                                .withCanonicalTileID(&id.canonical)))
-                    continue;
+                const auto context = expression::EvaluationContext(static_cast<float>(this->id.overscaledZ), &feature)
+                                         .withCanonicalTileID(&id.canonical);
+                if (!(filterBinding ? filter(context, *filterBinding) : filter(context))) return true;
 
-                const GeometryCollection& geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i, id.canonical);
+                const GeometryCollection& geometries = feature.getGeometries();
+                bucket->addFeature(feature, geometries, {}, PatternLayerMap(), i, id.canonical);
                 featureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
-            }
+                return true;
+            });
 
             if (!bucket->hasData()) {
                 continue;
@@ -497,26 +533,43 @@ void GeometryTileWorker::finalizeLayout() {
 
     MBGL_TIMING_START(watch)
     std::optional<AlphaImage> glyphAtlasImage;
-    ImageAtlas iconAtlas = makeImageAtlas(imageMap, patternMap, versionMap);
-    if (!layouts.empty()) {
-        GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
-        glyphAtlasImage = std::move(glyphAtlas.image);
-
-        for (auto& layout : layouts) {
-            if (obsolete) {
-                return;
-            }
+    GlyphPositions glyphPositions;
+    ImageAtlas iconAtlas;
+    std::shared_ptr<const SharedAtlas::Reference> atlasReference;
+
+    std::optional<SharedAtlas::Layout> shared;
+    if (sharedAtlas) {
+        // Only symbol layouts need glyphs
+        const GlyphMap noGlyphs;
+        shared = sharedAtlas->add(layouts.empty() ? noGlyphs : glyphMap, imageMap, patternMap, versionMap);
+    }
+    if (shared) {
+        glyphPositions = std::move(shared->glyphPositions);
+        iconAtlas = std::move(shared->iconAtlas);
+        atlasReference = std::move(shared->reference);
+    } else {
+        iconAtlas = makeImageAtlas(imageMap, patternMap, versionMap);
+        if (!layouts.empty()) {
+            GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
+            glyphAtlasImage = std::move(glyphAtlas.image);
+            glyphPositions = std::move(glyphAtlas.positions);
+        }
+    }
 
-            layout->prepareSymbols(glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions);
+    for (auto& layout : layouts) {
+        if (obsolete) {
+            return;
+        }
 
-            if (!layout->hasSymbolInstances()) {
-                continue;
-            }
+        layout->prepareSymbols(glyphMap, glyphPositions, imageMap, iconAtlas.iconPositions);
 
-            // layout adds the bucket to buckets
-            layout->createBucket(
-                iconAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
+        if (!layout->hasSymbolInstances()) {
+            continue;
         }
+
+        // layout adds the bucket to buckets
+        layout->createBucket(
+            iconAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
     }
 
     layouts.clear();
@@ -530,8 +583,11 @@ void GeometryTileWorker::finalizeLayout() {
                                    << id.canonical.y << " Time");
 
     parent.invoke(&GeometryTile::onLayout,
-                  std::make_shared<GeometryTile::LayoutResult>(
-                      std::move(renderData), std::move(featureIndex), std::move(glyphAtlasImage), std::move(iconAtlas)),
+                  std::make_shared<GeometryTile::LayoutResult>(std::move(renderData),
+                                                               std::move(featureIndex),
+                                                               std::move(glyphAtlasImage),
+                                                               std::move(iconAtlas),
+                                                               std::move(atlasReference)),
                   correlationID);
 }
 
@@ -21,6 +21,7 @@ namespace mbgl {
 class GeometryTile;
 class GeometryTileData;
 class Layout;
+class SharedAtlas;
 
 namespace style {
 class Layer;
@@ -36,7 +37,8 @@ public:
                        const std::atomic<bool>&,
                        MapMode,
                        float pixelRatio,
-                       bool showCollisionBoxes_);
+                       bool showCollisionBoxes_,
+                       std::shared_ptr<SharedAtlas> sharedAtlas_);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::LayerProperties>>,
@@ -45,6 +47,10 @@ public:
     void setData(std::unique_ptr<const GeometryTileData>,
                  std::set<std::string> availableImages,
                  uint64_t correlationID);
+    // Like `setData`, for data the tile already has an up to date layout of
+    void setLaidOutData(std::unique_ptr<const GeometryTileData>,
+                        std::set<std::string> availableImages,
+                        uint64_t correlationID);
     void reset(uint64_t correlationID_);
     void setShowCollisionBoxes(bool showCollisionBoxes_, uint64_t correlationID_);
 
@@ -79,6 +85,8 @@ private:
     const std::atomic<bool>& obsolete;
     const MapMode mode;
     const float pixelRatio;
+    // Null if the tile makes its own atlases
+    const std::shared_ptr<SharedAtlas> sharedAtlas;
 
     std::unique_ptr<FeatureIndex> featureIndex;
     mbgl::unordered_map<std::string, LayerRenderData> renderData;
@@ -0,0 +1,170 @@
+#include <mbgl/tile/layout_cache.hpp>
+
+#include <mbgl/util/hash.hpp>
+#include <mbgl/util/instrumentation.hpp>
+
+#include <iterator>
+#include <tuple>
+
+namespace mbgl {
+
+bool LayoutCache::Key::operator<(const Key& rhs) const {
+    return std::tie(layersHash, tileID, sourceID, mode, pixelRatio, showCollisionBoxes) <
+           std::tie(rhs.layersHash, rhs.tileID, rhs.sourceID, rhs.mode, rhs.pixelRatio, rhs.showCollisionBoxes);
+}
+
+LayoutCache::LayoutCache(const TaggedScheduler& threadPool_, std::size_t maxBytes_)
+    : threadPool(threadPool_),
+      maxBytes(maxBytes_) {}
+
+LayoutCache::~LayoutCache() {
+    clear();
+}
+
+void LayoutCache::setMaxSize(std::size_t bytes_) {
+    MLN_TRACE_FUNC();
+
+    std::vector<Entry> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxBytes = bytes_;
+        evict(0, dropped);
+    }
+    release(std::move(dropped));
+}
+
+std::size_t LayoutCache::getMaxSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxBytes;
+}
+
+std::size_t LayoutCache::hashLayers(const Layers& layers) {
+    std::size_t seed = layers.size();
+    for (const auto& layer : layers) {
+        util::hash_combine(seed, layer.get());
+    }
+    return seed;
+}
+
+void LayoutCache::add(Key key, Entry entry) {
+    MLN_TRACE_FUNC();
+
+    std::vector<Entry> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // The encoded data stays alive with the entry, so it counts towards its size
+        const std::size_t size = entry.layoutResult->byteSize + (entry.data ? entry.data->size() : 0);
+
+        if (const auto it = index.find(key); it != index.end()) {
+            erase(it->second, dropped);
+        }
+
+        if (size > maxBytes) {
+            dropped.push_back(std::move(entry));
+        } else {
+            evict(size, dropped);
+            items.push_front({key, std::move(entry), size});
+            index.emplace(std::move(key), items.begin());
+            bytes += size;
+        }
+    }
+    release(std::move(dropped));
+}
+
+std::optional<LayoutCache::Entry> LayoutCache::take(const Key& key,
+                                                    const Layers& layers,
+                                                    const std::string& data,
+                                                    const std::set<std::string>& availableImages) {
+    MLN_TRACE_FUNC();
+
+    std::vector<Entry> dropped;
+    std::optional<Entry> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const auto it = index.find(key);
+        if (it == index.end()) {
+            ++misses;
+            return std::nullopt;
+        }
+
+        Entry& entry = it->second->entry;
+        const bool matches = entry.layers == layers && entry.availableImages == availableImages && entry.data &&
+                             (entry.data.get() == &data || *entry.data == data);
+        if (matches) {
+            ++hits;
+            bytes -= it->second->bytes;
+            result = std::move(entry);
+            items.erase(it->second);
+            index.erase(it);
+        } else {
+            // The tile has new data or images since, so this entry can't be used again
+            ++misses;
+            erase(it->second, dropped);
+        }
+    }
+    release(std::move(dropped));
+    return result;
+}
+
+void LayoutCache::remove(const std::string& sourceID) {
+    MLN_TRACE_FUNC();
+
+    std::vector<Entry> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = items.begin(); it != items.end();) {
+            auto next = std::next(it);
+            if (it->key.sourceID == sourceID) {
+                erase(it, dropped);
+            }
+            it = next;
+        }
+    }
+    release(std::move(dropped));
+}
+
+void LayoutCache::clear() {
+    MLN_TRACE_FUNC();
+
+    std::vector<Entry> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dropped.reserve(items.size());
+        for (auto& item : items) {
+            dropped.push_back(std::move(item.entry));
+        }
+        items.clear();
+        index.clear();
+        bytes = 0;
+    }
+    release(std::move(dropped));
+}
+
+LayoutCacheStats LayoutCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {hits, misses, evictions, items.size(), bytes, maxBytes};
+}
+
+void LayoutCache::evict(std::size_t size, std::vector<Entry>& dropped) {
+    while (!items.empty() && bytes + size > maxBytes) {
+        erase(std::prev(items.end()), dropped);
+        ++evictions;
+    }
+}
+
+void LayoutCache::erase(Items::iterator it, std::vector<Entry>& dropped) {
+    bytes -= it->bytes;
+    index.erase(it->key);
+    dropped.push_back(std::move(it->entry));
+    items.erase(it);
+}
+
+void LayoutCache::release(std::vector<Entry>&& dropped) {
+    if (!dropped.empty()) {
+        threadPool.runOnRenderThread([dropped_{std::move(dropped)}]() {});
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/layout_cache_stats.hpp>
+#include <mbgl/style/layer_impl.hpp>
+#include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/immutable.hpp>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * @brief Keeps the layout results of destroyed geometry tiles, so that a tile which is created again
+ * for the same data and layers can skip parsing, filtering, symbol shaping and bucket creation.
+ *
+ * Entries are kept as the in-memory buckets, feature index and atlases they were laid out into, and
+ * are evicted in least recently used order to stay within a byte budget. An entry is handed over to
+ * the tile which takes it, and returns to the cache when that tile is destroyed.
+ *
+ * All methods may be called from any thread. Dropped entries are released on the render thread,
+ * since they can own graphics resources.
+ */
+class LayoutCache {
+public:
+    using Layers = std::vector<Immutable<style::Layer::Impl>>;
+
+    struct Key {
+        std::string sourceID;
+        OverscaledTileID tileID;
+        MapMode mode;
+        float pixelRatio;
+        bool showCollisionBoxes;
+        std::size_t layersHash;
+
+        bool operator<(const Key&) const;
+    };
+
+    struct Entry {
+        /// The layers the tile was laid out with, compared by identity
+        Layers layers;
+        /// The encoded tile data
+        std::shared_ptr<const std::string> data;
+        /// The images which were available to the layout
+        std::set<std::string> availableImages;
+
+        std::shared_ptr<GeometryTile::LayoutResult> layoutResult;
+        std::shared_ptr<TileAtlasTextures> atlasTextures;
+    };
+
+    LayoutCache(const TaggedScheduler& threadPool, std::size_t maxBytes = 0);
+    ~LayoutCache();
+
+    /// Change the byte budget. Zero disables the cache and drops all entries.
+    void setMaxSize(std::size_t bytes);
+    std::size_t getMaxSize() const;
+
+    static std::size_t hashLayers(const Layers&);
+
+    /// Add the layout of a tile which is going away, replacing any entry with the same key
+    void add(Key, Entry);
+
+    /// Remove and return the entry for `key`, if it was laid out from the same layers, data and images
+    std::optional<Entry> take(const Key& key,
+                              const Layers& layers,
+                              const std::string& data,
+                              const std::set<std::string>& availableImages);
+
+    /// Drop all entries of the given source
+    void remove(const std::string& sourceID);
+    void clear();
+
+    LayoutCacheStats getStats() const;
+
+private:
+    struct Item {
+        Key key;
+        Entry entry;
+        std::size_t bytes;
+    };
+    using Items = std::list<Item>;
+
+    void evict(std::size_t bytes, std::vector<Entry>& dropped);
+    void erase(Items::iterator, std::vector<Entry>& dropped);
+    void release(std::vector<Entry>&&);
+
+    TaggedScheduler threadPool;
+
+    mutable std::mutex mutex;
+    // Most recently added first
+    Items items;
+    std::map<Key, Items::iterator> index;
+    std::size_t maxBytes;
+    std::size_t bytes = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+};
+
+} // namespace mbgl
@@ -147,12 +147,17 @@ void RasterDEMTile::setMask(TileMask&& mask) {
 
 void RasterDEMTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
+    worker.setPriority(workerPriority(necessity));
 }
 
 void RasterDEMTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
 
+void RasterDEMTile::setLoadOrder(float order) {
+    loader.setLoadOrder(order);
+}
+
 void RasterDEMTile::cancel() {
     markObsolete();
 }
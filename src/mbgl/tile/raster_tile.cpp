@@ -100,12 +100,17 @@ void RasterTile::setMask(TileMask&& mask) {
 
 void RasterTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
+    worker.setPriority(workerPriority(necessity));
 }
 
 void RasterTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
 
+void RasterTile::setLoadOrder(float order) {
+    loader.setLoadOrder(order);
+}
+
 void RasterTile::cancel() {
     markObsolete();
 }
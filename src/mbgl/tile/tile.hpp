@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/feature.hpp>
@@ -68,6 +69,9 @@ public:
 
     virtual void setUpdateParameters(const TileUpdateParameters&) {}
 
+    // Orders the pending network requests of this tile against those of other tiles, lower first.
+    virtual void setLoadOrder(float) {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
@@ -149,6 +153,11 @@ public:
     bool usedByRenderedLayers = false;
 
 protected:
+    // Worker tasks for tiles the current viewport needs run ahead of those for prefetched or retained tiles
+    static TaskPriority workerPriority(TileNecessity necessity) {
+        return necessity == TileNecessity::Required ? TaskPriority::High : TaskPriority::Normal;
+    }
+
     bool triedOptional = false;
     bool renderable = false;
     bool pending = false;
@@ -96,7 +96,8 @@ void TileCache::deferPendingReleases() {
         deferredSignal.notify_all();
     }};
 
-    threadPool.schedule(std::move(func));
+    // Releasing evicted tiles can wait until visible tiles have been parsed
+    threadPool.schedule(TaskPriority::Low, std::move(func));
 }
 
 void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile) {
@@ -25,6 +25,8 @@ public:
 
     void setNecessity(TileNecessity newNecessity);
     void setUpdateParameters(const TileUpdateParameters&);
+    // Takes effect on requests in flight, as they share the load order of the resource
+    void setLoadOrder(float order) { resource.setLoadOrder(order); }
 
 private:
     // called when the tile is one of the ideal tiles that we want to show
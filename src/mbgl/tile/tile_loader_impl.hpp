@@ -31,6 +31,9 @@ TileLoader<T>::TileLoader(T& tile_,
       fileSource(parameters.fileSource) {
     assert(!request);
 
+    // Share the load order with all requests made for this resource, before the first one is made
+    resource.setLoadOrder(0.0f);
+
     shared = std::make_shared<Shared>();
 
     if (!fileSource) {
@@ -22,12 +22,17 @@ VectorTile::~VectorTile() {
 
 void VectorTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
+    GeometryTile::setNecessity(necessity);
 }
 
 void VectorTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
 
+void VectorTile::setLoadOrder(float order) {
+    loader.setLoadOrder(order);
+}
+
 void VectorTile::setMetadata(std::optional<Timestamp> modified_, std::optional<Timestamp> expires_) {
     modified = std::move(modified_);
     expires = std::move(expires_);
@@ -38,7 +43,7 @@ void VectorTile::setData(const std::shared_ptr<const std::string>& data_) {
         return;
     }
 
-    GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_) : nullptr);
+    GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_) : nullptr, data_);
 }
 
 } // namespace mbgl
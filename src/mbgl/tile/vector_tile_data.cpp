@@ -3,8 +3,74 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
 namespace mbgl {
 
+namespace {
+
+// Field numbers from the vector tile specification
+namespace LayerField {
+constexpr protozero::pbf_tag_type Features = 2;
+constexpr protozero::pbf_tag_type Keys = 3;
+constexpr protozero::pbf_tag_type Values = 4;
+constexpr protozero::pbf_tag_type Extent = 5;
+constexpr protozero::pbf_tag_type Version = 15;
+} // namespace LayerField
+
+namespace FeatureField {
+constexpr protozero::pbf_tag_type ID = 1;
+constexpr protozero::pbf_tag_type Tags = 2;
+constexpr protozero::pbf_tag_type Type = 3;
+constexpr protozero::pbf_tag_type Geometry = 4;
+} // namespace FeatureField
+
+namespace ValueField {
+constexpr protozero::pbf_tag_type String = 1;
+constexpr protozero::pbf_tag_type Float = 2;
+constexpr protozero::pbf_tag_type Double = 3;
+constexpr protozero::pbf_tag_type Int = 4;
+constexpr protozero::pbf_tag_type UInt = 5;
+constexpr protozero::pbf_tag_type SInt = 6;
+constexpr protozero::pbf_tag_type Bool = 7;
+} // namespace ValueField
+
+enum class Command : std::uint32_t {
+    MoveTo = 1,
+    LineTo = 2,
+    ClosePath = 7
+};
+
+Value decodeValue(const protozero::data_view& view) {
+    protozero::pbf_reader reader(view);
+    while (reader.next()) {
+        switch (reader.tag()) {
+            case ValueField::String:
+                return reader.get_string();
+            case ValueField::Float:
+                return static_cast<double>(reader.get_float());
+            case ValueField::Double:
+                return reader.get_double();
+            case ValueField::Int:
+                return reader.get_int64();
+            case ValueField::UInt:
+                return reader.get_uint64();
+            case ValueField::SInt:
+                return reader.get_sint64();
+            case ValueField::Bool:
+                return reader.get_bool();
+            default:
+                reader.skip();
+                break;
+        }
+    }
+    return NullValue{};
+}
+
+} // namespace
+
 VectorTileFeature::VectorTileFeature(const mapbox::vector_tile::layer& layer, const protozero::data_view& view)
     : feature(view, layer) {}
 
@@ -57,9 +123,261 @@ const GeometryCollection& VectorTileFeature::getGeometries() const {
     return *lines;
 }
 
-VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_, const protozero::data_view& view)
+VectorTileLayerTable::VectorTileLayerTable(const protozero::data_view& view) {
+    protozero::pbf_reader reader(view);
+    while (reader.next()) {
+        switch (reader.tag()) {
+            case LayerField::Features:
+                features.push_back(reader.get_view());
+                break;
+            case LayerField::Keys: {
+                const auto key = reader.get_view();
+                const auto index = static_cast<std::uint32_t>(keys.size());
+                keys.emplace_back(key.data(), key.size());
+                keyIndices.emplace(keys.back(), index);
+                break;
+            }
+            case LayerField::Values:
+                values.push_back(reader.get_view());
+                break;
+            case LayerField::Extent:
+                extent = reader.get_uint32();
+                break;
+            case LayerField::Version:
+                version = reader.get_uint32();
+                break;
+            default:
+                reader.skip();
+                break;
+        }
+    }
+    decodedValues.resize(values.size());
+}
+
+std::optional<std::uint32_t> VectorTileLayerTable::keyIndex(std::string_view key) const {
+    const auto it = keyIndices.find(key);
+    if (it == keyIndices.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const Value& VectorTileLayerTable::getValue(std::uint32_t index) const {
+    auto& value = decodedValues.at(index);
+    if (!value) {
+        value = decodeValue(values[index]);
+    }
+    return *value;
+}
+
+VectorTileFeatureView::VectorTileFeatureView(const VectorTileLayerTable& table_)
+    : table(table_) {}
+
+void VectorTileFeatureView::reset(const protozero::data_view& view) {
+    id = NullValue{};
+    type = FeatureType::Unknown;
+    tags = {};
+    geometry = {};
+    linesDecoded = false;
+    propertiesDecoded = false;
+
+    protozero::pbf_reader reader(view);
+    while (reader.next()) {
+        switch (reader.tag()) {
+            case FeatureField::ID:
+                id = reader.get_uint64();
+                break;
+            case FeatureField::Tags:
+                tags = reader.get_packed_uint32();
+                break;
+            case FeatureField::Type:
+                switch (reader.get_enum()) {
+                    case 1:
+                        type = FeatureType::Point;
+                        break;
+                    case 2:
+                        type = FeatureType::LineString;
+                        break;
+                    case 3:
+                        type = FeatureType::Polygon;
+                        break;
+                    default:
+                        type = FeatureType::Unknown;
+                        break;
+                }
+                break;
+            case FeatureField::Geometry:
+                geometry = reader.get_packed_uint32();
+                break;
+            default:
+                reader.skip();
+                break;
+        }
+    }
+}
+
+std::optional<Value> VectorTileFeatureView::getValue(const std::string& key) const {
+    if (const auto index = table.keyIndex(key)) {
+        if (const auto* value = getValueByKeyIndex(*index)) {
+            return *value;
+        }
+    }
+    return std::nullopt;
+}
+
+const Value* VectorTileFeatureView::getValueByKeyIndex(std::uint32_t keyIndex) const {
+    for (auto it = tags.begin(); it != tags.end();) {
+        const auto key = *it++;
+        if (it == tags.end()) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+        const auto value = *it++;
+        if (key == keyIndex) {
+            if (value >= table.valueCount()) {
+                throw std::runtime_error("feature referenced out of range value");
+            }
+            const auto& result = table.getValue(value);
+            return result.is<NullValue>() ? nullptr : &result;
+        }
+    }
+    return nullptr;
+}
+
+const PropertyMap& VectorTileFeatureView::getProperties() const {
+    if (!propertiesDecoded) {
+        properties.clear();
+        for (auto it = tags.begin(); it != tags.end();) {
+            const auto key = *it++;
+            if (it == tags.end()) {
+                throw std::runtime_error("uneven number of feature tag ids");
+            }
+            const auto value = *it++;
+            if (key >= table.keyCount() || value >= table.valueCount()) {
+                throw std::runtime_error("feature referenced out of range key or value");
+            }
+            properties.emplace(std::string(table.getKey(key)), table.getValue(value));
+        }
+        propertiesDecoded = true;
+    }
+    return properties;
+}
+
+const GeometryCollection& VectorTileFeatureView::getGeometries() const {
+    MLN_TRACE_FUNC();
+
+    if (!linesDecoded) {
+        try {
+            decodeGeometries(lines);
+        } catch (const std::runtime_error& ex) {
+            Log::Error(Event::ParseTile, "Could not get geometries: " + std::string(ex.what()));
+            lines.clear();
+        }
+
+        if (table.getVersion() < 2 && type == FeatureType::Polygon) {
+            lines = fixupPolygons(lines);
+        }
+        linesDecoded = true;
+    }
+    return lines;
+}
+
+void VectorTileFeatureView::decodeGeometries(GeometryCollection& result) const {
+    using Coordinate = GeometryCollection::coordinate_type;
+    constexpr auto minCoordinate = static_cast<float>(std::numeric_limits<Coordinate>::min());
+    constexpr auto maxCoordinate = static_cast<float>(std::numeric_limits<Coordinate>::max());
+
+    const auto scale = static_cast<float>(util::EXTENT) / static_cast<float>(table.getExtent());
+
+    // Rings are cleared rather than destroyed, so their storage is reused for the next feature
+    std::size_t ringCount = 0;
+    const auto nextRing = [&]() -> GeometryCoordinates& {
+        if (ringCount == result.size()) {
+            result.emplace_back();
+        }
+        auto& ring = result[ringCount++];
+        ring.clear();
+        return ring;
+    };
+
+    GeometryCoordinates* ring = &nextRing();
+    std::int64_t x = 0;
+    std::int64_t y = 0;
+    auto it = geometry.begin();
+    const auto end = geometry.end();
+    while (it != end) {
+        const std::uint32_t commandInteger = *it++;
+        const auto command = static_cast<Command>(commandInteger & 0x7);
+        std::uint32_t count = commandInteger >> 3;
+
+        if (command == Command::ClosePath) {
+            if (!ring->empty()) {
+                ring->push_back((*ring)[0]);
+            }
+            continue;
+        }
+        if (command != Command::MoveTo && command != Command::LineTo) {
+            throw std::runtime_error("unknown command");
+        }
+
+        for (; count > 0; --count) {
+            if (it == end) {
+                throw std::runtime_error("geometry ended before command parameters");
+            }
+            const auto dx = protozero::decode_zigzag32(*it++);
+            if (it == end) {
+                throw std::runtime_error("geometry ended before command parameters");
+            }
+            const auto dy = protozero::decode_zigzag32(*it++);
+
+            // Each point of a multi-point starts a new ring, as in the full decoder
+            if (command == Command::MoveTo && !ring->empty()) {
+                ring = &nextRing();
+            }
+
+            x += dx;
+            y += dy;
+            const float px = std::round(static_cast<float>(x) * scale);
+            const float py = std::round(static_cast<float>(y) * scale);
+            if (px > maxCoordinate || px < minCoordinate || py > maxCoordinate || py < minCoordinate) {
+                throw std::runtime_error("paths outside valid range of coordinate_type");
+            }
+            ring->emplace_back(static_cast<Coordinate>(px), static_cast<Coordinate>(py));
+        }
+    }
+
+    // Drop rings left over from a previous feature with more of them
+    result.resize(ringCount);
+}
+
+VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_, const protozero::data_view& view_)
     : data(std::move(data_)),
-      layer(view) {}
+      view(view_),
+      layer(view_) {}
+
+const VectorTileLayerTable& VectorTileLayer::getTable() const {
+    if (!table) {
+        table.emplace(view);
+    }
+    return *table;
+}
+
+std::optional<std::uint32_t> VectorTileLayer::keyIndex(std::string_view key) const {
+    return getTable().keyIndex(key);
+}
+
+void VectorTileLayer::visitFeatures(const FeatureVisitor& visitor) const {
+    MLN_TRACE_FUNC();
+
+    const auto& layerTable = getTable();
+    VectorTileFeatureView feature(layerTable);
+    const std::size_t count = layerTable.featureCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        feature.reset(layerTable.getFeature(i));
+        if (!visitor(i, feature)) {
+            return;
+        }
+    }
+}
 
 std::size_t VectorTileLayer::featureCount() const {
     return layer.featureCount();
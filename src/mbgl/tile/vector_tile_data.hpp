@@ -12,10 +12,13 @@
 #pragma warning(pop)
 #endif
 
+#include <mbgl/util/containers.hpp>
+
 #include <protozero/pbf_reader.hpp>
 
 #include <unordered_map>
 #include <functional>
+#include <string_view>
 #include <utility>
 
 namespace mbgl {
@@ -36,17 +39,91 @@ private:
     mutable std::optional<PropertyMap> properties;
 };
 
+// Key, value and feature tables of a vector tile layer. Keys are interned so that
+// features can be queried by key index, and values are only decoded when used.
+class VectorTileLayerTable {
+public:
+    explicit VectorTileLayerTable(const protozero::data_view&);
+
+    std::size_t featureCount() const { return features.size(); }
+    const protozero::data_view& getFeature(std::size_t i) const { return features.at(i); }
+
+    std::uint32_t getExtent() const { return extent; }
+    std::uint32_t getVersion() const { return version; }
+
+    // Returns the index of the given key in the layer's key table, if present
+    std::optional<std::uint32_t> keyIndex(std::string_view key) const;
+    std::size_t keyCount() const { return keys.size(); }
+    std::string_view getKey(std::uint32_t index) const { return keys[index]; }
+
+    // Returns the decoded value at the given index of the layer's value table
+    const Value& getValue(std::uint32_t index) const;
+    std::size_t valueCount() const { return values.size(); }
+
+private:
+    std::uint32_t extent = 4096;
+    std::uint32_t version = 1;
+    std::vector<std::string_view> keys;
+    mbgl::unordered_map<std::string_view, std::uint32_t> keyIndices;
+    std::vector<protozero::data_view> values;
+    mutable std::vector<std::optional<Value>> decodedValues;
+    std::vector<protozero::data_view> features;
+};
+
+// A reusable, non-owning view of one feature of a vector tile layer at a time.
+// Rebinding it with `reset` keeps the geometry and property buffers allocated
+// for the previous feature, and property lookups by key index avoid building a
+// property map entirely.
+class VectorTileFeatureView final : public GeometryTileFeature {
+public:
+    explicit VectorTileFeatureView(const VectorTileLayerTable&);
+
+    // Point the view at another feature of the same layer
+    void reset(const protozero::data_view&);
+
+    FeatureType getType() const override { return type; }
+    std::optional<Value> getValue(const std::string& key) const override;
+    const PropertyMap& getProperties() const override;
+    FeatureIdentifier getID() const override { return id; }
+    const GeometryCollection& getGeometries() const override;
+    const Value* getValueByKeyIndex(std::uint32_t keyIndex) const override;
+
+    // Decode the feature geometry into the given collection, reusing its storage
+    void decodeGeometries(GeometryCollection&) const;
+
+private:
+    using PackedRange = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
+
+    const VectorTileLayerTable& table;
+    FeatureIdentifier id;
+    FeatureType type = FeatureType::Unknown;
+    PackedRange tags;
+    PackedRange geometry;
+
+    mutable GeometryCollection lines;
+    mutable bool linesDecoded = false;
+    mutable PropertyMap properties;
+    mutable bool propertiesDecoded = false;
+};
+
 class VectorTileLayer : public GeometryTileLayer {
 public:
     VectorTileLayer(std::shared_ptr<const std::string> data, const protozero::data_view&);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
+    void visitFeatures(const FeatureVisitor&) const override;
+    bool hasKeyTable() const override { return true; }
+    std::optional<std::uint32_t> keyIndex(std::string_view key) const override;
     std::string getName() const override;
 
+    const VectorTileLayerTable& getTable() const;
+
 private:
     std::shared_ptr<const std::string> data;
+    protozero::data_view view;
     mapbox::vector_tile::layer layer;
+    mutable std::optional<VectorTileLayerTable> table;
 };
 
 class VectorTileData : public GeometryTileData {
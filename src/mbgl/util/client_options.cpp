@@ -6,6 +6,10 @@ class ClientOptions::Impl {
 public:
     std::string name;
     std::string version;
+    bool http2Multiplexing = true;
+    uint32_t maxConnectionsPerHost = 0;
+    std::chrono::seconds dnsCacheTimeout{60};
+    std::chrono::seconds keepAliveInterval{0};
 };
 
 // These requires the complete type of Impl.
@@ -46,4 +50,40 @@ const std::string& ClientOptions::version() const {
     return impl_->version;
 }
 
+ClientOptions& ClientOptions::withHTTP2Multiplexing(bool enabled) {
+    impl_->http2Multiplexing = enabled;
+    return *this;
+}
+
+bool ClientOptions::http2Multiplexing() const {
+    return impl_->http2Multiplexing;
+}
+
+ClientOptions& ClientOptions::withMaxConnectionsPerHost(uint32_t count) {
+    impl_->maxConnectionsPerHost = count;
+    return *this;
+}
+
+uint32_t ClientOptions::maxConnectionsPerHost() const {
+    return impl_->maxConnectionsPerHost;
+}
+
+ClientOptions& ClientOptions::withDNSCacheTimeout(std::chrono::seconds timeout) {
+    impl_->dnsCacheTimeout = timeout;
+    return *this;
+}
+
+std::chrono::seconds ClientOptions::dnsCacheTimeout() const {
+    return impl_->dnsCacheTimeout;
+}
+
+ClientOptions& ClientOptions::withKeepAliveInterval(std::chrono::seconds interval) {
+    impl_->keepAliveInterval = interval;
+    return *this;
+}
+
+std::chrono::seconds ClientOptions::keepAliveInterval() const {
+    return impl_->keepAliveInterval;
+}
+
 } // namespace mbgl
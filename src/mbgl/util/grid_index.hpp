@@ -4,13 +4,14 @@
 #include <mapbox/geometry/box.hpp>
 #include <mbgl/math/minmax.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <limits>
 #include <optional>
-#include <unordered_set>
 #include <vector>
 
 namespace mbgl {
@@ -51,18 +52,31 @@ constexpr bool operator!=(circle<T> const& lhs, circle<T> const& rhs) {
  at least one cell. As long as the geometries are relatively
  uniformly distributed across the plane, this greatly reduces
  the number of comparisons necessary.
+
+ The contents of all cells live in fixed-size blocks of a single
+ pool, chained per cell in insertion order. Each block keeps the
+ bounds of its elements next to each other, so that a query tests
+ a whole block at once. The pool is handed over to the next index
+ built on the same thread, so that indexes rebuilt with every
+ placement don't allocate it again.
 */
 
 template <class T>
 class GridIndex {
 public:
     GridIndex(float width_, float height_, uint32_t cellSize_);
+    ~GridIndex();
+
+    GridIndex(const GridIndex&) = default;
+    GridIndex(GridIndex&&) noexcept = default;
+    GridIndex& operator=(const GridIndex&) = delete;
+    GridIndex& operator=(GridIndex&&) = delete;
 
     using BBox = mapbox::geometry::box<float>;
     using BCircle = geometry::circle<float>;
 
     /// Set the expected number of elements per cell to avoid small re-allocations for populated cells
-    void reserve(std::size_t value) { estimatedElementsPerCell = value; }
+    void reserve(std::size_t value);
 
     void insert(T&& t, const BBox&);
     void insert(T&& t, const BCircle&);
@@ -70,31 +84,75 @@ public:
     std::vector<T> query(const BBox&) const;
     std::vector<std::pair<T, BBox>> queryWithBoxes(const BBox&) const;
 
-    bool hitTest(const BBox&, std::optional<std::function<bool(const T&)>> predicate = std::nullopt) const;
-    bool hitTest(const BCircle&, std::optional<std::function<bool(const T&)>> predicate = std::nullopt) const;
+    bool hitTest(const BBox&) const;
+    bool hitTest(const BCircle&) const;
+
+    /// Only elements for which `predicate` holds are hits. Any callable taking a `const T&` can be used.
+    template <typename Predicate>
+    bool hitTest(const BBox&, const std::optional<Predicate>& predicate) const;
+    template <typename Predicate>
+    bool hitTest(const BCircle&, const std::optional<Predicate>& predicate) const;
 
     bool empty() const;
 
+    /// Removes all elements, keeping the allocated cell storage
+    void clear();
+
 private:
+    static constexpr uint32_t blockSize = 4;
+    static constexpr uint32_t noBlock = std::numeric_limits<uint32_t>::max();
+    // Blocks kept for the next index on the same thread, beyond which they are freed
+    static constexpr std::size_t maxSpareBlocks = 16384;
+
+    struct Block {
+        // Bounds of the elements, or of their bounding box for circles
+        std::array<float, blockSize> minX{};
+        std::array<float, blockSize> minY{};
+        std::array<float, blockSize> maxX{};
+        std::array<float, blockSize> maxY{};
+        std::array<uint32_t, blockSize> uids{};
+        uint32_t count = 0;
+        uint32_t next = noBlock;
+    };
+
+    struct Cell {
+        uint32_t head = noBlock;
+        uint32_t tail = noBlock;
+    };
+
+    static std::vector<Block>& spareBlocks();
+
     bool noIntersection(const BBox& queryBBox) const;
     bool completeIntersection(const BBox& queryBBox) const;
     BBox convertToBox(const BCircle& circle) const;
 
-    void query(const BBox&, std::function<bool(const T&, const BBox&)>) const;
-    void query(const BCircle&, std::function<bool(const T&, const BBox&)>) const;
+    template <typename Fn>
+    void query(const BBox&, const Fn& resultFn) const;
+    template <typename Fn>
+    void query(const BCircle&, const Fn& resultFn) const;
+    // Calls fn(uid) for the elements of the cell at (x, y) whose bounds overlap `queryBBox`,
+    // unless they were visited in an earlier cell of the query, until fn returns true
+    template <typename Fn>
+    bool visitCell(const Cell&,
+                   std::size_t x,
+                   std::size_t y,
+                   const BBox& queryBBox,
+                   std::size_t cx1,
+                   std::size_t cy1,
+                   const Fn& fn) const;
+
+    void insertIntoCells(std::vector<Cell>& cells, uint32_t uid, const BBox&);
+    uint32_t overlaps(const Block&, const BBox&) const;
 
     std::size_t convertToXCellCoord(float x) const;
     std::size_t convertToYCellCoord(float y) const;
 
-    bool boxesCollide(const BBox&, const BBox&) const;
     bool circlesCollide(const BCircle&, const BCircle&) const;
     bool circleAndBoxCollide(const BCircle&, const BBox&) const;
 
     const float width;
     const float height;
 
-    std::size_t estimatedElementsPerCell = 0;
-
     const std::size_t xCellCount;
     const std::size_t yCellCount;
     const double xScale;
@@ -103,8 +161,9 @@ private:
     std::vector<std::pair<T, BBox>> boxElements;
     std::vector<std::pair<T, BCircle>> circleElements;
 
-    std::vector<std::vector<uint32_t>> boxCells;
-    std::vector<std::vector<uint32_t>> circleCells;
+    std::vector<Cell> boxCells;
+    std::vector<Cell> circleCells;
+    std::vector<Block> blocks;
 };
 
 template <class T>
@@ -114,18 +173,45 @@ GridIndex<T>::GridIndex(const float width_, const float height_, const uint32_t
       xCellCount(static_cast<size_t>(std::ceil(width / cellSize_))),
       yCellCount(static_cast<size_t>(std::ceil(height / cellSize_))),
       xScale(xCellCount / width),
-      yScale(yCellCount / height) {
+      yScale(yCellCount / height),
+      blocks(std::move(spareBlocks())) {
     assert(width > 0.0f);
     assert(height > 0.0f);
     boxCells.resize(xCellCount * yCellCount);
     circleCells.resize(xCellCount * yCellCount);
+    blocks.clear();
 }
 
 template <class T>
-void GridIndex<T>::insert(T&& t, const BBox& bbox) {
-    assert(boxElements.size() < std::numeric_limits<uint32_t>::max());
-    const auto uid = static_cast<uint32_t>(boxElements.size());
+GridIndex<T>::~GridIndex() {
+    auto& spare = spareBlocks();
+    if (blocks.capacity() > spare.capacity() && blocks.capacity() <= maxSpareBlocks) {
+        spare = std::move(blocks);
+    }
+}
 
+template <class T>
+std::vector<typename GridIndex<T>::Block>& GridIndex<T>::spareBlocks() {
+    static thread_local std::vector<Block> spare;
+    return spare;
+}
+
+template <class T>
+void GridIndex<T>::reserve(std::size_t value) {
+    blocks.reserve(blocks.size() + boxCells.size() * ((value + blockSize - 1) / blockSize));
+}
+
+template <class T>
+void GridIndex<T>::clear() {
+    boxElements.clear();
+    circleElements.clear();
+    std::fill(boxCells.begin(), boxCells.end(), Cell{});
+    std::fill(circleCells.begin(), circleCells.end(), Cell{});
+    blocks.clear();
+}
+
+template <class T>
+void GridIndex<T>::insertIntoCells(std::vector<Cell>& cells, const uint32_t uid, const BBox& bbox) {
     const auto cx1 = convertToXCellCoord(bbox.min.x);
     const auto cy1 = convertToYCellCoord(bbox.min.y);
     const auto cx2 = convertToXCellCoord(bbox.max.x);
@@ -133,14 +219,35 @@ void GridIndex<T>::insert(T&& t, const BBox& bbox) {
 
     for (std::size_t x = cx1; x <= cx2; ++x) {
         for (std::size_t y = cy1; y <= cy2; ++y) {
-            auto& cell = boxCells[xCellCount * y + x];
-            if (estimatedElementsPerCell && cell.empty()) {
-                cell.reserve(estimatedElementsPerCell);
+            auto& cell = cells[xCellCount * y + x];
+            if (cell.tail == noBlock || blocks[cell.tail].count == blockSize) {
+                assert(blocks.size() < noBlock);
+                const auto index = static_cast<uint32_t>(blocks.size());
+                blocks.emplace_back();
+                if (cell.tail == noBlock) {
+                    cell.head = index;
+                } else {
+                    blocks[cell.tail].next = index;
+                }
+                cell.tail = index;
             }
-            cell.push_back(uid);
+
+            auto& block = blocks[cell.tail];
+            block.minX[block.count] = bbox.min.x;
+            block.minY[block.count] = bbox.min.y;
+            block.maxX[block.count] = bbox.max.x;
+            block.maxY[block.count] = bbox.max.y;
+            block.uids[block.count] = uid;
+            ++block.count;
         }
     }
+}
 
+template <class T>
+void GridIndex<T>::insert(T&& t, const BBox& bbox) {
+    assert(boxElements.size() < std::numeric_limits<uint32_t>::max());
+    const auto uid = static_cast<uint32_t>(boxElements.size());
+    insertIntoCells(boxCells, uid, bbox);
     boxElements.emplace_back(std::move(t), bbox);
 }
 
@@ -148,22 +255,7 @@ template <class T>
 void GridIndex<T>::insert(T&& t, const BCircle& bcircle) {
     assert(circleElements.size() < std::numeric_limits<uint32_t>::max());
     const auto uid = static_cast<uint32_t>(circleElements.size());
-
-    const auto cx1 = convertToXCellCoord(bcircle.center.x - bcircle.radius);
-    const auto cy1 = convertToYCellCoord(bcircle.center.y - bcircle.radius);
-    const auto cx2 = convertToXCellCoord(bcircle.center.x + bcircle.radius);
-    const auto cy2 = convertToYCellCoord(bcircle.center.y + bcircle.radius);
-
-    for (std::size_t x = cx1; x <= cx2; ++x) {
-        for (std::size_t y = cy1; y <= cy2; ++y) {
-            auto& cell = circleCells[xCellCount * y + x];
-            if (estimatedElementsPerCell && cell.empty()) {
-                cell.reserve(estimatedElementsPerCell);
-            }
-            cell.push_back(uid);
-        }
-    }
-
+    insertIntoCells(circleCells, uid, convertToBox(bcircle));
     circleElements.emplace_back(std::move(t), bcircle);
 }
 
@@ -188,30 +280,38 @@ std::vector<std::pair<T, typename GridIndex<T>::BBox>> GridIndex<T>::queryWithBo
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BBox& queryBBox, std::optional<std::function<bool(const T&)>> predicate) const {
+bool GridIndex<T>::hitTest(const BBox& queryBBox) const {
     bool hit = false;
-    query(queryBBox, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
-    });
+    query(queryBBox, [&](const T&, const BBox&) -> bool { return hit = true; });
     return hit;
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BCircle& queryBCircle, std::optional<std::function<bool(const T&)>> predicate) const {
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle) const {
     bool hit = false;
-    query(queryBCircle, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
-    });
+    query(queryBCircle, [&](const T&, const BBox&) -> bool { return hit = true; });
+    return hit;
+}
+
+template <class T>
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BBox& queryBBox, const std::optional<Predicate>& predicate) const {
+    if (!predicate) {
+        return hitTest(queryBBox);
+    }
+    bool hit = false;
+    query(queryBBox, [&](const T& t, const BBox&) -> bool { return hit = (*predicate)(t); });
+    return hit;
+}
+
+template <class T>
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle, const std::optional<Predicate>& predicate) const {
+    if (!predicate) {
+        return hitTest(queryBCircle);
+    }
+    bool hit = false;
+    query(queryBCircle, [&](const T& t, const BBox&) -> bool { return hit = (*predicate)(t); });
     return hit;
 }
 
@@ -232,10 +332,50 @@ typename GridIndex<T>::BBox GridIndex<T>::convertToBox(const BCircle& circle) co
 }
 
 template <class T>
-void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, const BBox&)> resultFn) const {
-    std::unordered_set<uint32_t> seenBoxes;
-    std::unordered_set<uint32_t> seenCircles;
+uint32_t GridIndex<T>::overlaps(const Block& block, const BBox& queryBBox) const {
+    // Branchless over the whole block, so that compilers turn it into vector compares
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < blockSize; ++i) {
+        const bool overlap = (block.minX[i] <= queryBBox.max.x) & (block.minY[i] <= queryBBox.max.y) &
+                             (block.maxX[i] >= queryBBox.min.x) & (block.maxY[i] >= queryBBox.min.y);
+        mask |= static_cast<uint32_t>(overlap) << i;
+    }
+    return mask & ((1u << block.count) - 1);
+}
+
+template <class T>
+template <typename Fn>
+bool GridIndex<T>::visitCell(const Cell& cell,
+                             const std::size_t x,
+                             const std::size_t y,
+                             const BBox& queryBBox,
+                             const std::size_t cx1,
+                             const std::size_t cy1,
+                             const Fn& fn) const {
+    for (auto b = cell.head; b != noBlock; b = blocks[b].next) {
+        const Block& block = blocks[b];
+        for (auto mask = overlaps(block, queryBBox); mask; mask &= mask - 1) {
+            uint32_t i = 0;
+            while (!(mask & (1u << i))) {
+                ++i;
+            }
+            // An element is in every cell its bounds touch. Visit it only in the first of
+            // those cells that the query reaches, instead of keeping track of the ones seen.
+            if (x != std::max(cx1, convertToXCellCoord(block.minX[i])) ||
+                y != std::max(cy1, convertToYCellCoord(block.minY[i]))) {
+                continue;
+            }
+            if (fn(block.uids[i])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
+template <class T>
+template <typename Fn>
+void GridIndex<T>::query(const BBox& queryBBox, const Fn& resultFn) const {
     if (noIntersection(queryBBox)) {
         return;
     } else if (completeIntersection(queryBBox)) {
@@ -257,50 +397,32 @@ void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, con
     auto cx2 = convertToXCellCoord(queryBBox.max.x);
     auto cy2 = convertToYCellCoord(queryBBox.max.y);
 
-    std::size_t x;
-    std::size_t y;
-    std::size_t cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            // Look up other boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (!seenBoxes.contains(uid)) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (boxesCollide(queryBBox, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            const std::size_t cellIndex = xCellCount * y + x;
+            // Look up other boxes; their bounds are exact
+            if (visitCell(boxCells[cellIndex], x, y, queryBBox, cx1, cy1, [&](uint32_t uid) {
+                    auto& pair = boxElements[uid];
+                    return resultFn(pair.first, pair.second);
+                })) {
+                return;
             }
 
             // Look up circles
-            for (auto uid : circleCells[cellIndex]) {
-                if (!seenCircles.contains(uid)) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circleAndBoxCollide(bcircle, queryBBox)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
-                    }
-                }
+            if (visitCell(circleCells[cellIndex], x, y, queryBBox, cx1, cy1, [&](uint32_t uid) {
+                    auto& pair = circleElements[uid];
+                    return circleAndBoxCollide(pair.second, queryBBox) &&
+                           resultFn(pair.first, convertToBox(pair.second));
+                })) {
+                return;
             }
         }
     }
 }
 
 template <class T>
-void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T&, const BBox&)> resultFn) const {
-    std::unordered_set<size_t> seenBoxes;
-    std::unordered_set<size_t> seenCircles;
-
+template <typename Fn>
+void GridIndex<T>::query(const BCircle& queryBCircle, const Fn& resultFn) const {
     BBox queryBBox = convertToBox(queryBCircle);
     if (noIntersection(queryBBox)) {
         return;
@@ -315,47 +437,32 @@ void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T
                 return;
             }
         }
+        return;
     }
 
-    auto cx1 = convertToXCellCoord(queryBCircle.center.x - queryBCircle.radius);
-    auto cy1 = convertToYCellCoord(queryBCircle.center.y - queryBCircle.radius);
-    auto cx2 = convertToXCellCoord(queryBCircle.center.x + queryBCircle.radius);
-    auto cy2 = convertToYCellCoord(queryBCircle.center.y + queryBCircle.radius);
-
-    std::size_t x;
-    std::size_t y;
-    std::size_t cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
+    auto cx1 = convertToXCellCoord(queryBBox.min.x);
+    auto cy1 = convertToYCellCoord(queryBBox.min.y);
+    auto cx2 = convertToXCellCoord(queryBBox.max.x);
+    auto cy2 = convertToYCellCoord(queryBBox.max.y);
+
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            const std::size_t cellIndex = xCellCount * y + x;
             // Look up boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (!seenBoxes.contains(uid)) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (circleAndBoxCollide(queryBCircle, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
+            if (visitCell(boxCells[cellIndex], x, y, queryBBox, cx1, cy1, [&](uint32_t uid) {
+                    auto& pair = boxElements[uid];
+                    return circleAndBoxCollide(queryBCircle, pair.second) && resultFn(pair.first, pair.second);
+                })) {
+                return;
             }
 
             // Look up other circles
-            for (auto uid : circleCells[cellIndex]) {
-                if (!seenCircles.contains(uid)) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circlesCollide(queryBCircle, bcircle)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
-                    }
-                }
+            if (visitCell(circleCells[cellIndex], x, y, queryBBox, cx1, cy1, [&](uint32_t uid) {
+                    auto& pair = circleElements[uid];
+                    return circlesCollide(queryBCircle, pair.second) &&
+                           resultFn(pair.first, convertToBox(pair.second));
+                })) {
+                return;
             }
         }
     }
@@ -371,12 +478,6 @@ std::size_t GridIndex<T>::convertToYCellCoord(const float y) const {
     return static_cast<size_t>(util::max(0.0, util::min(yCellCount - 1.0, std::floor(y * yScale))));
 }
 
-template <class T>
-bool GridIndex<T>::boxesCollide(const BBox& first, const BBox& second) const {
-    return first.min.x <= second.max.x && first.min.y <= second.max.y && first.max.x >= second.min.x &&
-           first.max.y >= second.min.y;
-}
-
 template <class T>
 bool GridIndex<T>::circlesCollide(const BCircle& first, const BCircle& second) const {
     auto dx = second.center.x - first.center.x;
@@ -2,18 +2,24 @@
 
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MLN_PREMULTIPLY_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MLN_PREMULTIPLY_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace mbgl {
 namespace util {
 
-PremultipliedImage premultiply(UnassociatedImage&& src) {
-    PremultipliedImage dst;
+namespace {
 
-    dst.size = src.size;
-    src.size = {0, 0};
-    dst.data = std::move(src.data);
+// Both kernels compute exactly what the scalar loops compute, so that the results don't depend on the platform.
+// SSE2 and NEON are part of the x86-64 and ARM64 baselines, so they don't need to be detected at runtime.
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+void premultiplyScalar(uint8_t* data, std::size_t bytes) {
+    for (size_t i = 0; i < bytes; i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -22,19 +28,10 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
         g = (g * a + 127) / 255;
         b = (b * a + 127) / 255;
     }
-
-    return dst;
 }
 
-UnassociatedImage unpremultiply(PremultipliedImage&& src) {
-    UnassociatedImage dst;
-
-    dst.size = src.size;
-    src.size = {0, 0};
-    dst.data = std::move(src.data);
-
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+void unpremultiplyScalar(uint8_t* data, std::size_t bytes) {
+    for (size_t i = 0; i < bytes; i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -45,6 +42,156 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
             b = static_cast<uint8_t>((255 * b + (a / 2)) / a);
         }
     }
+}
+
+#if MLN_PREMULTIPLY_SSE2
+
+// `(c * a + 127) / 255` for the eight 16-bit lanes of two pixels.
+// `x / 255 == (x + 1 + (x >> 8)) >> 8` holds for all `x <= 255 * 255 + 127`.
+inline __m128i premultiplyPixels(__m128i pixels) {
+    const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                                              _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i x = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(127));
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+std::size_t premultiplySIMD(uint8_t* data, std::size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    std::size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        auto* ptr = reinterpret_cast<__m128i*>(data + i);
+        const __m128i pixels = _mm_loadu_si128(ptr);
+        const __m128i lo = premultiplyPixels(_mm_unpacklo_epi8(pixels, zero));
+        const __m128i hi = premultiplyPixels(_mm_unpackhi_epi8(pixels, zero));
+        const __m128i result = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, pixels)));
+    }
+    return i;
+}
+
+// `(255 * c + a / 2) / a` for one pixel in 32-bit lanes. The numerator is below 2^24, so it's exact as a float,
+// and a correctly rounded division never rounds a non-integer quotient up to the next integer.
+inline __m128i unpremultiplyPixel(__m128i pixel) {
+    const __m128i alpha = _mm_shuffle_epi32(pixel, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(pixel, 8), pixel), _mm_srli_epi32(alpha, 1));
+    const __m128i quotient = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(numerator), _mm_cvtepi32_ps(alpha)));
+
+    // Keep the alpha channel, and the color of fully transparent pixels
+    const __m128i keep = _mm_or_si128(_mm_cmpeq_epi32(alpha, _mm_setzero_si128()), _mm_set_epi32(-1, 0, 0, 0));
+    const __m128i result = _mm_and_si128(quotient, _mm_set1_epi32(0xFF));
+    return _mm_or_si128(_mm_andnot_si128(keep, result), _mm_and_si128(keep, pixel));
+}
+
+std::size_t unpremultiplySIMD(uint8_t* data, std::size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        auto* ptr = reinterpret_cast<__m128i*>(data + i);
+        const __m128i pixels = _mm_loadu_si128(ptr);
+        const __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        const __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        const __m128i p0 = unpremultiplyPixel(_mm_unpacklo_epi16(lo, zero));
+        const __m128i p1 = unpremultiplyPixel(_mm_unpackhi_epi16(lo, zero));
+        const __m128i p2 = unpremultiplyPixel(_mm_unpacklo_epi16(hi, zero));
+        const __m128i p3 = unpremultiplyPixel(_mm_unpackhi_epi16(hi, zero));
+        _mm_storeu_si128(ptr, _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+    }
+    return i;
+}
+
+#elif MLN_PREMULTIPLY_NEON
+
+// `(c * a + 127) / 255` for eight pixels, using `x / 255 == (x + 1 + (x >> 8)) >> 8`
+inline uint8x8_t premultiplyChannel(uint8x8_t color, uint8x8_t alpha) {
+    const uint16x8_t x = vaddq_u16(vmull_u8(color, alpha), vdupq_n_u16(127));
+    return vmovn_u16(vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8));
+}
+
+std::size_t premultiplySIMD(uint8_t* data, std::size_t bytes) {
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        uint8x8x4_t pixels = vld4_u8(data + i);
+        pixels.val[0] = premultiplyChannel(pixels.val[0], pixels.val[3]);
+        pixels.val[1] = premultiplyChannel(pixels.val[1], pixels.val[3]);
+        pixels.val[2] = premultiplyChannel(pixels.val[2], pixels.val[3]);
+        vst4_u8(data + i, pixels);
+    }
+    return i;
+}
+
+inline uint32x4_t divide(uint16x4_t numerator, float32x4_t alpha) {
+    return vcvtq_u32_f32(vdivq_f32(vcvtq_f32_u32(vmovl_u16(numerator)), alpha));
+}
+
+// `(255 * c + a / 2) / a` for eight pixels. The numerator is below 2^24, so it's exact as a float, and a
+// correctly rounded division never rounds a non-integer quotient up to the next integer.
+inline uint8x8_t unpremultiplyChannel(
+    uint8x8_t color, uint16x8_t halfAlpha, float32x4_t alphaLo, float32x4_t alphaHi, uint8x8_t transparent) {
+    const uint16x8_t numerator = vaddq_u16(vmull_u8(color, vdup_n_u8(255)), halfAlpha);
+    const uint16x8_t quotient = vcombine_u16(vmovn_u32(divide(vget_low_u16(numerator), alphaLo)),
+                                             vmovn_u32(divide(vget_high_u16(numerator), alphaHi)));
+    // Keep the color of fully transparent pixels
+    return vbsl_u8(transparent, color, vmovn_u16(quotient));
+}
+
+std::size_t unpremultiplySIMD(uint8_t* data, std::size_t bytes) {
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        uint8x8x4_t pixels = vld4_u8(data + i);
+        const uint16x8_t alpha = vmovl_u8(pixels.val[3]);
+        const uint16x8_t halfAlpha = vshrq_n_u16(alpha, 1);
+        const float32x4_t alphaLo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(alpha)));
+        const float32x4_t alphaHi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(alpha)));
+        const uint8x8_t transparent = vceq_u8(pixels.val[3], vdup_n_u8(0));
+        for (int c = 0; c < 3; ++c) {
+            pixels.val[c] = unpremultiplyChannel(pixels.val[c], halfAlpha, alphaLo, alphaHi, transparent);
+        }
+        vst4_u8(data + i, pixels);
+    }
+    return i;
+}
+
+#else
+
+std::size_t premultiplySIMD(uint8_t*, std::size_t) {
+    return 0;
+}
+
+std::size_t unpremultiplySIMD(uint8_t*, std::size_t) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+PremultipliedImage premultiply(UnassociatedImage&& src) {
+    PremultipliedImage dst;
+
+    dst.size = src.size;
+    src.size = {0, 0};
+    dst.data = std::move(src.data);
+
+    uint8_t* data = dst.data.get();
+    const std::size_t done = premultiplySIMD(data, dst.bytes());
+    premultiplyScalar(data + done, dst.bytes() - done);
+
+    return dst;
+}
+
+UnassociatedImage unpremultiply(PremultipliedImage&& src) {
+    UnassociatedImage dst;
+
+    dst.size = src.size;
+    src.size = {0, 0};
+    dst.data = std::move(src.data);
+
+    uint8_t* data = dst.data.get();
+    const std::size_t done = unpremultiplySIMD(data, dst.bytes());
+    unpremultiplyScalar(data + done, dst.bytes() - done);
 
     return dst;
 }
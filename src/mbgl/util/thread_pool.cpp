@@ -9,6 +9,17 @@
 
 namespace mbgl {
 
+ThreadedSchedulerBase::ThreadedSchedulerBase(SchedulingMode mode_, std::size_t workerCount)
+    : mode(mode_) {
+    if (mode == SchedulingMode::WorkStealing) {
+        assert(workerCount > 0);
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+    }
+}
+
 ThreadedSchedulerBase::~ThreadedSchedulerBase() = default;
 
 void ThreadedSchedulerBase::terminate() {
@@ -34,75 +45,267 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
 
         owningThreadPool.set(this);
 
-        while (true) {
-            std::unique_lock<std::mutex> conditionLock(workerMutex);
-            if (!terminated && taskCount == 0) {
-                cvAvailable.wait(conditionLock);
-            }
+        if (mode == SchedulingMode::WorkStealing) {
+            runWorkStealing(index);
+        } else {
+            runSharedQueue();
+        }
+    });
+}
 
-            if (terminated) {
-                platform::detachThread();
-                break;
-            }
+void ThreadedSchedulerBase::runSharedQueue() {
+    while (true) {
+        std::unique_lock<std::mutex> conditionLock(workerMutex);
+        if (!terminated && taskCount == 0) {
+            cvAvailable.wait(conditionLock);
+        }
 
-            // Let other threads run
-            conditionLock.unlock();
+        if (terminated) {
+            platform::detachThread();
+            break;
+        }
 
-            std::vector<std::shared_ptr<Queue>> pending;
-            {
-                // 1. Gather buckets for us to visit this iteration
-                std::lock_guard<std::mutex> lock(taggedQueueLock);
-                for (const auto& [tag, queue] : taggedQueue) {
-                    pending.push_back(queue);
-                }
+        // Let other threads run
+        conditionLock.unlock();
+
+        // Only take tasks from one lane this iteration
+        const std::size_t lane = pickLane();
+        if (lane == laneCount) {
+            continue;
+        }
+
+        std::vector<std::shared_ptr<Queue>> pending;
+        {
+            // 1. Gather buckets for us to visit this iteration
+            std::lock_guard<std::mutex> lock(taggedQueueLock);
+            for (const auto& [tag, queue] : taggedQueue) {
+                pending.push_back(queue);
             }
+        }
 
-            // 2. Visit a task from each
-            for (auto& q : pending) {
-                std::function<void()> tasklet;
-                {
-                    std::lock_guard<std::mutex> lock(q->lock);
-                    if (q->queue.size()) {
-                        q->runningCount++;
-                        tasklet = std::move(q->queue.front());
-                        q->queue.pop();
-                    }
-                    if (!tasklet) continue;
+        // 2. Visit a task from each
+        for (auto& q : pending) {
+            std::function<void()> tasklet;
+            {
+                std::lock_guard<std::mutex> lock(q->lock);
+                auto& queue = q->lanes[lane];
+                if (queue.size()) {
+                    q->runningCount++;
+                    tasklet = std::move(queue.front());
+                    queue.pop();
                 }
+                if (!tasklet) continue;
+            }
 
-                assert(taskCount > 0);
-                taskCount--;
+            assert(taskCount > 0);
+            taskCount--;
+            laneTaskCount[lane]--;
 
-                try {
-                    tasklet();
-                    tasklet = {}; // destroy the function and release its captures before unblocking `waitForEmpty`
+            try {
+                tasklet();
+                tasklet = {}; // destroy the function and release its captures before unblocking `waitForEmpty`
 
-                    if (!--q->runningCount) {
-                        std::lock_guard<std::mutex> lock(q->lock);
-                        if (q->queue.empty()) {
-                            q->cv.notify_all();
-                        }
-                    }
-                } catch (...) {
+                if (!--q->runningCount) {
                     std::lock_guard<std::mutex> lock(q->lock);
-                    if (handler) {
-                        handler(std::current_exception());
+                    if (!q->pending()) {
+                        q->cv.notify_all();
                     }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(q->lock);
+                if (handler) {
+                    handler(std::current_exception());
+                }
 
-                    tasklet = {};
+                tasklet = {};
 
-                    if (!--q->runningCount && q->queue.empty()) {
-                        q->cv.notify_all();
-                    }
+                if (!--q->runningCount && !q->pending()) {
+                    q->cv.notify_all();
+                }
 
-                    if (handler) {
-                        continue;
-                    }
-                    throw;
+                if (handler) {
+                    continue;
                 }
+                throw;
             }
         }
-    });
+    }
+}
+
+void ThreadedSchedulerBase::runWorkStealing(std::size_t index) {
+    while (true) {
+        if (terminated) {
+            platform::detachThread();
+            break;
+        }
+
+        if (auto task = findTask(index)) {
+            assert(taskCount > 0);
+            taskCount--;
+            runTask(std::move(task));
+            continue;
+        }
+
+        // Nothing to run or steal, sleep until a producer signals new work.
+        // `sleepingWorkers` is raised before re-checking `taskCount`, and producers raise `taskCount` before
+        // checking `sleepingWorkers`, so one side always observes the other and no wakeup is lost.
+        std::unique_lock<std::mutex> conditionLock(workerMutex);
+        sleepingWorkers++;
+        cvAvailable.wait(conditionLock, [&] { return terminated || taskCount > 0; });
+        sleepingWorkers--;
+    }
+}
+
+std::size_t ThreadedSchedulerBase::pickLane() {
+    // The most urgent lane that has any tasks...
+    std::size_t lane = 0;
+    while (lane < laneCount && laneTaskCount[lane] == 0) {
+        lane++;
+    }
+    if (lane == laneCount) {
+        return laneCount;
+    }
+
+    // ...unless a less urgent one waited long enough
+    for (std::size_t lower = lane + 1; lower < laneCount; ++lower) {
+        if (laneTaskCount[lower] > 0 && ++laneSkips[lower] >= agingInterval) {
+            lane = lower;
+            break;
+        }
+    }
+    laneSkips[lane] = 0;
+    return lane;
+}
+
+std::unique_ptr<ThreadedSchedulerBase::Task> ThreadedSchedulerBase::findTask(std::size_t index) {
+    if (const auto lane = pickLane(); lane < laneCount) {
+        if (auto task = findTask(index, lane)) {
+            return task;
+        }
+    }
+
+    // The lane counts are only a hint while other threads take and schedule tasks
+    for (std::size_t lane = 0; lane < laneCount; ++lane) {
+        if (auto task = findTask(index, lane)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<ThreadedSchedulerBase::Task> ThreadedSchedulerBase::findTask(std::size_t index, std::size_t lane) {
+    // 1. Tasks of the tags assigned to this worker
+    {
+        auto& self = *workers[index];
+        std::lock_guard<std::mutex> lock(self.lock);
+        auto& queue = self.queues[lane];
+        if (!queue.empty()) {
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            laneTaskCount[lane]--;
+            return task;
+        }
+    }
+
+    // 2. Steal the oldest task of another worker, without waiting on its lock
+    for (std::size_t i = 1; i < workers.size(); ++i) {
+        auto& victim = *workers[(index + i) % workers.size()];
+        std::unique_lock<std::mutex> lock(victim.lock, std::try_to_lock);
+        auto& queue = victim.queues[lane];
+        if (lock.owns_lock() && !queue.empty()) {
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            laneTaskCount[lane]--;
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadedSchedulerBase::runTask(std::unique_ptr<Task> task) {
+    auto tagState = std::move(task->tagState);
+
+    const auto finish = [&] {
+        // destroy the function and release its captures before unblocking `waitForEmpty`
+        task.reset();
+        if (!--tagState->outstanding) {
+            std::lock_guard<std::mutex> lock(tagState->lock);
+            tagState->cv.notify_all();
+        }
+    };
+
+    try {
+        MLN_TRACE_ZONE(task);
+        task->fn();
+    } catch (...) {
+        if (!handler) {
+            finish();
+            throw;
+        }
+        handler(std::current_exception());
+    }
+    finish();
+}
+
+void ThreadedSchedulerBase::scheduleWorkStealing(const util::SimpleIdentity tag,
+                                                 std::size_t lane,
+                                                 std::function<void()>&& fn) {
+    std::shared_ptr<TagState> tagState;
+    {
+        MLN_TRACE_ZONE(queue);
+        auto& shard = shardFor(tag);
+        std::lock_guard<std::mutex> lock(shard.lock);
+        auto& entry = shard.states[tag];
+        if (!entry) {
+            entry = std::make_shared<TagState>();
+        }
+        tagState = entry;
+    }
+    tagState->outstanding++;
+
+    // Count the task before publishing it so a worker can never take it before it's accounted for
+    taskCount++;
+
+    // Tasks of a tag always go to the same queue, whichever thread schedules them, to keep their order
+    auto task = std::make_unique<Task>(Task{std::move(fn), std::move(tagState)});
+    {
+        auto& worker = workerFor(tag);
+        std::lock_guard<std::mutex> lock(worker.lock);
+        worker.queues[lane].push_back(std::move(task));
+        laneTaskCount[lane]++;
+    }
+
+    // Only take the worker lock when someone may actually be waiting on it
+    if (sleepingWorkers > 0) {
+        std::lock_guard<std::mutex> workerLock(workerMutex);
+        cvAvailable.notify_one();
+    }
+}
+
+void ThreadedSchedulerBase::waitForEmptyWorkStealing(const util::SimpleIdentity tag) {
+    auto& shard = shardFor(tag);
+    std::shared_ptr<TagState> tagState;
+    {
+        std::lock_guard<std::mutex> lock(shard.lock);
+        auto it = shard.states.find(tag);
+        if (it == shard.states.end()) {
+            return;
+        }
+        tagState = it->second;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(tagState->lock);
+        tagState->cv.wait(lock, [&] { return tagState->outstanding == 0; });
+    }
+
+    // After waiting for the tag to drain, go ahead and erase it, unless it was replaced in the meantime.
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.states.find(tag);
+    if (it != shard.states.end() && it->second == tagState) {
+        shard.states.erase(it);
+    }
 }
 
 void ThreadedSchedulerBase::schedule(std::function<void()>&& fn) {
@@ -110,10 +313,26 @@ void ThreadedSchedulerBase::schedule(std::function<void()>&& fn) {
 }
 
 void ThreadedSchedulerBase::schedule(const util::SimpleIdentity tag, std::function<void()>&& fn) {
+    enqueue(tag, laneIndex(TaskPriority::Normal), std::move(fn));
+}
+
+void ThreadedSchedulerBase::scheduleWithPriority(const util::SimpleIdentity tag,
+                                                 TaskPriority priority,
+                                                 std::function<void()>&& fn) {
+    enqueue(tag.isEmpty() ? uniqueID : tag, laneIndex(priority), std::move(fn));
+}
+
+void ThreadedSchedulerBase::enqueue(const util::SimpleIdentity tag, std::size_t lane, std::function<void()>&& fn) {
     MLN_TRACE_FUNC();
     assert(fn);
+    assert(lane < laneCount);
     if (!fn) return;
 
+    if (mode == SchedulingMode::WorkStealing) {
+        scheduleWorkStealing(tag, lane, std::move(fn));
+        return;
+    }
+
     std::shared_ptr<Queue> q;
     {
         MLN_TRACE_ZONE(queue);
@@ -133,7 +352,8 @@ void ThreadedSchedulerBase::schedule(const util::SimpleIdentity tag, std::functi
     {
         MLN_TRACE_ZONE(push);
         std::lock_guard<std::mutex> lock(q->lock);
-        q->queue.push(std::move(fn));
+        q->lanes[lane].push(std::move(fn));
+        laneTaskCount[lane]++;
         taskCount++;
     }
 
@@ -148,6 +368,11 @@ void ThreadedSchedulerBase::waitForEmpty(const util::SimpleIdentity tag) {
     if (!thisThreadIsOwned()) {
         const auto tagToFind = tag.isEmpty() ? uniqueID : tag;
 
+        if (mode == SchedulingMode::WorkStealing) {
+            waitForEmptyWorkStealing(tagToFind);
+            return;
+        }
+
         std::shared_ptr<Queue> q;
         {
             std::lock_guard<std::mutex> lock(taggedQueueLock);
@@ -159,7 +384,7 @@ void ThreadedSchedulerBase::waitForEmpty(const util::SimpleIdentity tag) {
         }
 
         std::unique_lock<std::mutex> queueLock(q->lock);
-        while (q->queue.size() + q->runningCount) {
+        while (q->pending() + q->runningCount) {
             q->cv.wait(queueLock);
         }
 
@@ -8,8 +8,11 @@
 #include <mbgl/util/instrumentation.hpp>
 
 #include <algorithm>
+#include <array>
 #include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -17,6 +20,16 @@
 
 namespace mbgl {
 
+/// How a threaded scheduler distributes tasks among its worker threads
+enum class SchedulingMode : uint8_t {
+    /// All workers take tasks from a single set of per-tag queues guarded by shared locks
+    SharedQueue,
+    /// Each worker owns the queue of a share of the tags, and idle workers steal from the others.
+    /// All the tasks of a tag go through one queue, whether scheduled from inside the pool or not, so they start
+    /// in submission order. With a single worker, all the tasks do.
+    WorkStealing,
+};
+
 class ThreadedSchedulerBase : public Scheduler {
 public:
     /// @brief Schedule a generic task not assigned to any particular owner.
@@ -28,10 +41,22 @@ public:
     /// @param tag Identifier object to indicate ownership of `fn`
     /// @param fn Task to run
     void schedule(const util::SimpleIdentity tag, std::function<void()>&& fn) override;
+
+    /// @brief Schedule a task assigned to the given owner `tag` in the given priority lane.
+    /// Pending tasks in a higher priority lane are started before any in a lower one, unless the lower lane was
+    /// passed over `agingInterval` times in a row.
+    /// @param tag Identifier object to indicate ownership of `fn`
+    /// @param priority Lane to queue `fn` in
+    /// @param fn Task to run
+    void scheduleWithPriority(const util::SimpleIdentity tag,
+                              TaskPriority priority,
+                              std::function<void()>&& fn) override;
     const util::SimpleIdentity uniqueID;
 
+    SchedulingMode getMode() const noexcept { return mode; }
+
 protected:
-    ThreadedSchedulerBase() = default;
+    ThreadedSchedulerBase(SchedulingMode = SchedulingMode::SharedQueue, std::size_t workerCount = 0);
     ~ThreadedSchedulerBase() override;
 
     void terminate();
@@ -52,16 +77,88 @@ protected:
     std::mutex taggedQueueLock;
     util::ThreadLocal<ThreadedSchedulerBase> owningThreadPool;
     std::atomic<size_t> taskCount{0};
-    bool terminated{false};
+    std::atomic<bool> terminated{false};
+    const SchedulingMode mode;
+
+    static constexpr std::size_t laneCount = 3;
+    static std::size_t laneIndex(TaskPriority priority) { return static_cast<std::size_t>(priority); }
+
+    // A lane with pending tasks that was passed over this many times in a row for more urgent ones is served next,
+    // so that the lower lanes keep a bounded share of the turns under sustained load on the higher ones.
+    static constexpr std::size_t agingInterval = 8;
+
+    // Pending task count per priority lane
+    std::array<std::atomic<std::size_t>, laneCount> laneTaskCount{};
+    // Times each lane was passed over while it had pending tasks
+    std::array<std::atomic<std::size_t>, laneCount> laneSkips{};
+
+    /// Lane to take tasks from on this turn, `laneCount` if none has any
+    std::size_t pickLane();
 
     // Task queues bucketed by tag address
     struct Queue {
-        std::atomic<std::size_t> runningCount;   /* running tasks */
-        std::condition_variable cv;              /* queue empty condition */
-        std::mutex lock;                         /* lock */
-        std::queue<std::function<void()>> queue; /* pending task queue */
+        std::atomic<std::size_t> runningCount;                          /* running tasks */
+        std::condition_variable cv;                                     /* queue empty condition */
+        std::mutex lock;                                                /* lock */
+        std::array<std::queue<std::function<void()>>, laneCount> lanes; /* pending tasks by priority */
+
+        std::size_t pending() const {
+            std::size_t count = 0;
+            for (const auto& lane : lanes) {
+                count += lane.size();
+            }
+            return count;
+        }
     };
     mbgl::unordered_map<util::SimpleIdentity, std::shared_ptr<Queue>> taggedQueue;
+
+private:
+    void enqueue(util::SimpleIdentity tag, std::size_t lane, std::function<void()>&& fn);
+    void runSharedQueue();
+    void runWorkStealing(std::size_t index);
+
+    // Work-stealing mode state
+
+    // Outstanding (pending or running) task count for a tag
+    struct TagState {
+        std::atomic<std::size_t> outstanding{0};
+        std::mutex lock;
+        std::condition_variable cv;
+    };
+
+    struct Task {
+        std::function<void()> fn;
+        std::shared_ptr<TagState> tagState;
+    };
+
+    struct Worker {
+        // Pending tasks of the tags assigned to this worker, oldest first
+        std::mutex lock;
+        std::array<std::deque<std::unique_ptr<Task>>, laneCount> queues;
+    };
+
+    // Tag states are sharded to reduce contention between producers using different tags
+    struct TagShard {
+        std::mutex lock;
+        mbgl::unordered_map<util::SimpleIdentity, std::shared_ptr<TagState>> states;
+    };
+    static constexpr std::size_t tagShardCount = 16;
+
+    void scheduleWorkStealing(util::SimpleIdentity tag, std::size_t lane, std::function<void()>&& fn);
+    void waitForEmptyWorkStealing(util::SimpleIdentity tag);
+    std::unique_ptr<Task> findTask(std::size_t index);
+    std::unique_ptr<Task> findTask(std::size_t index, std::size_t lane);
+    void runTask(std::unique_ptr<Task>);
+    TagShard& shardFor(util::SimpleIdentity tag) {
+        return tagShards[std::hash<util::SimpleIdentity>{}(tag) % tagShardCount];
+    }
+    Worker& workerFor(util::SimpleIdentity tag) {
+        return *workers[std::hash<util::SimpleIdentity>{}(tag) % workers.size()];
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::array<TagShard, tagShardCount> tagShards;
+    std::atomic<std::size_t> sleepingWorkers{0};
 };
 
 /**
@@ -74,8 +171,9 @@ protected:
  */
 class ThreadedScheduler : public ThreadedSchedulerBase {
 public:
-    ThreadedScheduler(std::size_t n)
-        : threads(n) {
+    ThreadedScheduler(std::size_t n, SchedulingMode mode_ = SchedulingMode::SharedQueue)
+        : ThreadedSchedulerBase(mode_, n),
+          threads(n) {
         for (std::size_t i = 0u; i < threads.size(); ++i) {
             threads[i] = makeSchedulerThread(i);
         }
@@ -161,20 +259,25 @@ private:
 
 class SequencedScheduler : public ThreadedScheduler {
 public:
-    SequencedScheduler()
-        : ThreadedScheduler(1) {}
+    explicit SequencedScheduler(SchedulingMode mode_ = SchedulingMode::SharedQueue)
+        : ThreadedScheduler(1, mode_) {}
 };
 
 class ParallelScheduler : public ThreadedScheduler {
 public:
-    ParallelScheduler(std::size_t extra)
-        : ThreadedScheduler(1 + extra) {}
+    ParallelScheduler(std::size_t extra, SchedulingMode mode_ = SchedulingMode::SharedQueue)
+        : ThreadedScheduler(1 + extra, mode_) {}
 };
 
 class ThreadPool : public ParallelScheduler {
 public:
-    ThreadPool()
-        : ParallelScheduler(3) {}
+    static constexpr std::size_t defaultThreadCount = 4;
+
+    explicit ThreadPool(SchedulingMode mode_ = SchedulingMode::SharedQueue)
+        : ThreadPool(defaultThreadCount, mode_) {}
+
+    explicit ThreadPool(std::size_t threadCount, SchedulingMode mode_ = SchedulingMode::SharedQueue)
+        : ParallelScheduler(std::max<std::size_t>(threadCount, 1) - 1, mode_) {}
 };
 
 } // namespace mbgl
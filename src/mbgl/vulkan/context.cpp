@@ -56,6 +56,8 @@ Context::Context(RendererBackend& backend_)
         glslang::InitializeProcess();
     }
 
+    pipelineCache = std::make_unique<PipelineCache>(backend);
+
     initFrameResources();
 }
 
@@ -132,6 +134,15 @@ void Context::destroyResources() {
 
     // all resources have unique handles
     frameResources.clear();
+
+    // saves the pipelines for the next run
+    pipelineCache.reset();
+}
+
+void Context::reduceMemoryUsage() {
+    if (pipelineCache) {
+        pipelineCache->save();
+    }
 }
 
 void Context::enqueueDeletion(std::function<void(Context&)>&& function) {
@@ -552,6 +563,7 @@ bool Context::renderTileClippingMasks(gfx::RenderPass& renderPass,
     }
 
     stats.numDrawCalls++;
+    stats.numDrawRanges++;
     stats.totalDrawCalls++;
     return true;
 }
@@ -301,6 +301,7 @@ void Drawable::draw(PaintParameters& parameters) const {
         }
 
         context.renderingStats().numDrawCalls++;
+        context.renderingStats().numDrawRanges++;
     }
 }
 
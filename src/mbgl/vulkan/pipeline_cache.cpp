@@ -0,0 +1,179 @@
+#include <mbgl/vulkan/pipeline_cache.hpp>
+
+#include <mbgl/platform/settings.hpp>
+#include <mbgl/util/hash.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+
+namespace mbgl {
+namespace vulkan {
+
+namespace {
+
+// Bump when the layout of the shader files changes
+constexpr std::string_view shaderMagic = "MLNSPV01";
+constexpr uint32_t spirvMagic = 0x07230203;
+
+// Write to a temporary file first, so that another process never reads a partial file
+void replaceFile(const std::string& path, const std::string& data) {
+    const std::string temporaryPath = path + ".tmp";
+    try {
+        util::write_file(temporaryPath, data);
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            // Renaming over an existing file fails on some platforms
+            util::deleteFile(path);
+            if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+                util::deleteFile(temporaryPath);
+                Log::Warning(Event::Render, "Failed to write " + path);
+            }
+        }
+    } catch (const std::exception& e) {
+        Log::Warning(Event::Render, std::string("Failed to write shader cache: ") + e.what());
+    }
+}
+
+// Drivers are supposed to ignore data from another device, but some crash instead
+bool isCompatible(const std::string& data, const vk::PhysicalDeviceProperties& properties) {
+    // VkPipelineCacheHeaderVersionOne
+    struct Header {
+        uint32_t headerSize;
+        uint32_t headerVersion;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    } header;
+    static_assert(sizeof(Header) == 16 + VK_UUID_SIZE);
+
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(Header));
+    return header.headerSize >= sizeof(Header) &&
+           header.headerVersion == static_cast<uint32_t>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE) &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+}
+
+} // namespace
+
+PipelineCache::PipelineCache(const RendererBackend& backend_)
+    : backend(backend_) {
+    const auto setting = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH);
+    if (const auto* path = setting.getString()) {
+        directory = *path;
+    }
+
+    std::string data;
+    if (isPersistent()) {
+        if (auto file = util::readFile(getPipelineCachePath())) {
+            if (isCompatible(*file, backend.getDeviceProperties())) {
+                data = std::move(*file);
+            } else {
+                Log::Info(Event::Render, "Ignoring pipeline cache of another device or driver");
+            }
+        }
+    }
+
+    const auto& device = backend.getDevice();
+    try {
+        cache = device->createPipelineCacheUnique(
+            vk::PipelineCacheCreateInfo().setInitialDataSize(data.size()).setPInitialData(data.data()));
+    } catch (const vk::SystemError& e) {
+        Log::Warning(Event::Render, std::string("Ignoring saved pipeline cache: ") + e.what());
+        cache = device->createPipelineCacheUnique(vk::PipelineCacheCreateInfo());
+    }
+
+    backend.setDebugName(cache.get(), "PipelineCache");
+}
+
+PipelineCache::~PipelineCache() {
+    save();
+}
+
+void PipelineCache::save() const {
+    MLN_TRACE_FUNC();
+
+    if (!isPersistent() || !cache) {
+        return;
+    }
+
+    try {
+        const auto data = backend.getDevice()->getPipelineCacheData(cache.get());
+        replaceFile(getPipelineCachePath(), std::string(data.begin(), data.end()));
+    } catch (const vk::SystemError& e) {
+        Log::Warning(Event::Render, std::string("Failed to save pipeline cache: ") + e.what());
+    }
+}
+
+std::uint64_t PipelineCache::makeShaderKey(std::string_view stage,
+                                           std::string_view preamble,
+                                           std::string_view source) const {
+    util::FNV1a hash;
+    hash.addTerminated(shaderMagic);
+    hash.addTerminated(stage);
+    hash.addTerminated(preamble);
+    hash.addTerminated(source);
+    return hash.get();
+}
+
+std::vector<uint32_t> PipelineCache::loadShader(const std::uint64_t key) const {
+    MLN_TRACE_FUNC();
+
+    if (!isPersistent()) {
+        return {};
+    }
+
+    const auto file = util::readFile(getShaderPath(key));
+    if (!file) {
+        return {};
+    }
+
+    const std::size_t headerSize = shaderMagic.size() + sizeof(key);
+    std::uint64_t fileKey = 0;
+    std::vector<uint32_t> spirv;
+    if (file->size() > headerSize && (file->size() - headerSize) % sizeof(uint32_t) == 0 &&
+        std::string_view(*file).substr(0, shaderMagic.size()) == shaderMagic) {
+        std::memcpy(&fileKey, file->data() + shaderMagic.size(), sizeof(key));
+        spirv.resize((file->size() - headerSize) / sizeof(uint32_t));
+        std::memcpy(spirv.data(), file->data() + headerSize, file->size() - headerSize);
+    }
+
+    if (fileKey != key || spirv.empty() || spirv.front() != spirvMagic) {
+        Log::Warning(Event::Render, "Ignoring invalid shader " + getShaderPath(key));
+        return {};
+    }
+    return spirv;
+}
+
+void PipelineCache::storeShader(const std::uint64_t key, const std::vector<uint32_t>& spirv) const {
+    if (!isPersistent() || spirv.empty()) {
+        return;
+    }
+
+    std::string file;
+    file.reserve(shaderMagic.size() + sizeof(key) + spirv.size() * sizeof(uint32_t));
+    file.append(shaderMagic);
+    file.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.append(reinterpret_cast<const char*>(spirv.data()), spirv.size() * sizeof(uint32_t));
+    replaceFile(getShaderPath(key), file);
+}
+
+std::string PipelineCache::getPipelineCachePath() const {
+    return directory + "/vulkan-pipeline-cache.bin";
+}
+
+std::string PipelineCache::getShaderPath(const std::uint64_t key) const {
+    std::ostringstream path;
+    path << directory << "/shader-" << std::hex << std::setw(16) << std::setfill('0') << key << ".spv";
+    return path.str();
+}
+
+} // namespace vulkan
+} // namespace mbgl
@@ -34,8 +34,11 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
         commandEncoder.context.createBuffer(data, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, persistent));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
-    static_cast<VertexBufferResource&>(resource).get().update(data, size, /*offset=*/0);
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
+    static_cast<VertexBufferResource&>(resource).get().update(data, size, offset);
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
@@ -96,8 +99,21 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
 
             // If it's changed, update it
             if (rawBufSize <= resource.getSizeInBytes()) {
-                if (forceUpdate || vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                if (forceUpdate) {
+                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize, /*offset=*/0);
+                    vec->resetModifiedRange();
+                    resource.setLastUpdated(vec->getLastModified());
+                } else if (vec->isModifiedAfter(resource.getLastUpdated())) {
+                    // Limit the update to the elements that were modified
+                    const auto [begin, end] = vec->getModifiedRange();
+                    if (begin < end) {
+                        const auto offset = begin * vec->getRawSize();
+                        updateVertexBufferResource(resource,
+                                                   static_cast<const uint8_t*>(rawBufPtr) + offset,
+                                                   (end - begin) * vec->getRawSize(),
+                                                   offset);
+                    }
+                    vec->resetModifiedRange();
                     resource.setLastUpdated(vec->getLastModified());
                 }
                 return rawData->resource;
@@ -108,6 +124,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer = std::make_unique<VertexBuffer>();
             buffer->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer));
+            vec->resetModifiedRange();
             return static_cast<VertexBuffer*>(vec->getBuffer())->resource;
         }
     }
@@ -383,4 +383,30 @@ TEST(Buckets, RasterBucketMaskComplex) {
     EXPECT_EQ(expectedSegments, bucket.segments);
 }
 
+TEST(Buckets, VertexVectorModifiedRange) {
+    gfx::VertexVector<float> vertices;
+    vertices.extend(100, 0.0f);
+    vertices.updateModified();
+
+    // Until it's uploaded, the whole vector is modified
+    EXPECT_EQ(std::make_pair(std::size_t(0), std::size_t(100)), vertices.getModifiedRange());
+    vertices.resetModifiedRange();
+    const auto uploaded = vertices.getLastModified();
+
+    // In-place updates accumulate, without the untouched elements in between being included
+    vertices.fill(10, 20, 1.0f);
+    vertices.fill(40, 50, 2.0f);
+    EXPECT_TRUE(vertices.isModifiedAfter(uploaded));
+    EXPECT_EQ(std::make_pair(std::size_t(10), std::size_t(50)), vertices.getModifiedRange());
+    EXPECT_EQ(1.0f, vertices.vector()[19]);
+    EXPECT_EQ(0.0f, vertices.vector()[20]);
+    vertices.resetModifiedRange();
+
+    // A change in size requires a full update again
+    vertices.fill(40, 50, 3.0f);
+    vertices.emplace_back(4.0f);
+    vertices.updateModified();
+    EXPECT_EQ(std::make_pair(std::size_t(0), std::size_t(101)), vertices.getModifiedRange());
+}
+
 #endif
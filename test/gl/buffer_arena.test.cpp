@@ -0,0 +1,97 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t pageSize = 64 * 1024;
+
+} // namespace
+
+TEST(BufferArena, SharesPages) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+    const auto& stats = context.renderingStats();
+
+    {
+        gl::BufferArena arena{context, GL_ARRAY_BUFFER, pageSize};
+        const std::vector<uint8_t> data(1000, 1);
+
+        auto a = arena.allocate(data.data(), data.size());
+        auto b = arena.allocate(data.data(), 10);
+        ASSERT_TRUE(a);
+        ASSERT_TRUE(b);
+        EXPECT_EQ(a.getBufferID(), b.getBufferID());
+        EXPECT_EQ(0u, a.getOffset());
+        EXPECT_EQ(1008u, b.getOffset());
+        EXPECT_EQ(1u, arena.numPages());
+        EXPECT_EQ(1, stats.numArenaBuffers);
+        EXPECT_EQ(1024, stats.memArenaUsed);
+
+        // Large data gets its own buffer
+        EXPECT_FALSE(arena.allocate(nullptr, arena.maxAllocationSize() + 1));
+
+        // Fill the page, the next allocation needs another one
+        std::vector<gl::BufferRange> ranges;
+        for (std::size_t i = 0; i < 4; ++i) {
+            ranges.push_back(arena.allocate(nullptr, arena.maxAllocationSize()));
+        }
+        EXPECT_EQ(2u, arena.numPages());
+        EXPECT_NE(a.getBufferID(), ranges.back().getBufferID());
+    }
+
+    EXPECT_EQ(0, stats.numArenaBuffers);
+    EXPECT_EQ(0, stats.memArenaUsed);
+    EXPECT_EQ(0, stats.memArenaFragmented);
+}
+
+TEST(BufferArena, ReclaimsReleasedRanges) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+    const auto& stats = context.renderingStats();
+
+    gl::BufferArena arena{context, GL_ELEMENT_ARRAY_BUFFER, pageSize};
+    auto a = arena.allocate(nullptr, 256);
+    auto b = arena.allocate(nullptr, 256);
+    auto c = arena.allocate(nullptr, 256);
+
+    // Released ranges are kept until the frame using them has completed
+    b = {};
+    auto frame = std::make_shared<gl::Fence>();
+    arena.reclaim(frame);
+    EXPECT_EQ(768, stats.memArenaUsed);
+    EXPECT_EQ(768u, arena.allocate(nullptr, 256).getOffset());
+
+    frame->insert();
+    context.finish();
+    arena.reclaim(nullptr);
+    EXPECT_EQ(512, stats.memArenaUsed);
+    EXPECT_EQ(256, stats.memArenaFragmented);
+
+    // Free neighbors are merged, and the empty page is kept for reuse
+    a = {};
+    c = {};
+    arena.reclaim(nullptr);
+    EXPECT_EQ(0, stats.memArenaUsed);
+    EXPECT_EQ(0, stats.memArenaFragmented);
+    EXPECT_EQ(1u, arena.numPages());
+    EXPECT_EQ(0u, arena.allocate(nullptr, pageSize / 4).getOffset());
+
+    arena.reclaim(nullptr);
+    arena.shrink();
+    EXPECT_EQ(0u, arena.numPages());
+    EXPECT_EQ(0, stats.numArenaBuffers);
+}
+
+#endif
@@ -0,0 +1,284 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/draw_mode.hpp>
+#include <mbgl/gfx/drawable_impl.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/drawable_gl_impl.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/renderable_resource.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/util/image.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::platform;
+
+namespace {
+
+// The parameters of drawing one range of indexes: mode, line width, byte offset of the
+// first index, index count and base vertex
+using Draw = std::tuple<gfx::DrawModeType, float, std::uintptr_t, std::size_t, std::size_t>;
+
+void addSegment(std::vector<gfx::Drawable::UniqueDrawSegment>& segments,
+                const gfx::DrawMode& mode,
+                std::size_t vertexOffset,
+                std::size_t indexOffset,
+                std::size_t indexLength) {
+    segments.push_back(std::make_unique<gfx::Drawable::DrawSegment>(
+        mode, SegmentBase(vertexOffset, indexOffset, indexLength, indexLength)));
+}
+
+// What DrawableGL draws without multi-draw: a call for each non-empty segment, with a vertex
+// array starting at the vertex offset of the segment
+std::vector<Draw> perSegmentDraws(const std::vector<gfx::Drawable::UniqueDrawSegment>& segments,
+                                  std::size_t indexBase) {
+    std::vector<Draw> draws;
+    for (const auto& seg : segments) {
+        const auto& mlSeg = seg->getSegment();
+        if (mlSeg.indexLength > 0) {
+            draws.emplace_back(seg->getMode().type,
+                               seg->getMode().size,
+                               sizeof(uint16_t) * (indexBase + mlSeg.indexOffset),
+                               mlSeg.indexLength,
+                               mlSeg.vertexOffset);
+        }
+    }
+    return draws;
+}
+
+std::vector<Draw> multiDraws(const std::vector<gl::MultiDrawGroup>& groups) {
+    std::vector<Draw> draws;
+    for (const auto& group : groups) {
+        EXPECT_EQ(group.indexLengths.size(), group.indexOffsets.size());
+        EXPECT_EQ(group.indexLengths.size(), group.vertexOffsets.size());
+        for (std::size_t i = 0; i < group.indexLengths.size(); ++i) {
+            draws.emplace_back(group.mode.type,
+                               group.mode.size,
+                               reinterpret_cast<std::uintptr_t>(group.indexOffsets[i]),
+                               static_cast<std::size_t>(group.indexLengths[i]),
+                               static_cast<std::size_t>(group.vertexOffsets[i]));
+        }
+    }
+    return draws;
+}
+
+const GLchar* vertexShaderSource = R"MBGL_SHADER(
+#ifdef GL_ES
+precision mediump float;
+#endif
+attribute vec2 a_pos;
+void main() {
+    gl_Position = vec4(a_pos, 0, 1);
+}
+)MBGL_SHADER";
+
+const GLchar* fragmentShaderSource = R"MBGL_SHADER(
+#ifdef GL_ES
+precision mediump float;
+#endif
+void main() {
+    gl_FragColor = vec4(0, 1, 0, 1);
+}
+)MBGL_SHADER";
+
+struct Shader {
+    Shader(const GLchar* vertex, const GLchar* fragment) {
+        program = MBGL_CHECK_ERROR(glCreateProgram());
+        vertexShader = MBGL_CHECK_ERROR(glCreateShader(GL_VERTEX_SHADER));
+        fragmentShader = MBGL_CHECK_ERROR(glCreateShader(GL_FRAGMENT_SHADER));
+        MBGL_CHECK_ERROR(glShaderSource(vertexShader, 1, &vertex, nullptr));
+        MBGL_CHECK_ERROR(glCompileShader(vertexShader));
+        MBGL_CHECK_ERROR(glAttachShader(program, vertexShader));
+        MBGL_CHECK_ERROR(glShaderSource(fragmentShader, 1, &fragment, nullptr));
+        MBGL_CHECK_ERROR(glCompileShader(fragmentShader));
+        MBGL_CHECK_ERROR(glAttachShader(program, fragmentShader));
+        MBGL_CHECK_ERROR(glLinkProgram(program));
+        a_pos = MBGL_CHECK_ERROR(glGetAttribLocation(program, "a_pos"));
+    }
+
+    ~Shader() {
+        MBGL_CHECK_ERROR(glDetachShader(program, vertexShader));
+        MBGL_CHECK_ERROR(glDetachShader(program, fragmentShader));
+        MBGL_CHECK_ERROR(glDeleteShader(vertexShader));
+        MBGL_CHECK_ERROR(glDeleteShader(fragmentShader));
+        MBGL_CHECK_ERROR(glDeleteProgram(program));
+    }
+
+    GLuint program = 0;
+    GLuint vertexShader = 0;
+    GLuint fragmentShader = 0;
+    GLuint a_pos = 0;
+};
+
+template <class T>
+struct Buffer {
+    Buffer(GLenum target, const std::vector<T>& data) {
+        MBGL_CHECK_ERROR(glGenBuffers(1, &buffer));
+        MBGL_CHECK_ERROR(glBindBuffer(target, buffer));
+        MBGL_CHECK_ERROR(glBufferData(target, data.size() * sizeof(T), data.data(), GL_STATIC_DRAW));
+    }
+
+    ~Buffer() { MBGL_CHECK_ERROR(glDeleteBuffers(1, &buffer)); }
+
+    GLuint buffer = 0;
+};
+
+// The vertex positions start at the given vertex, as in the vertex array of a segment drawn on its own
+struct VertexArray {
+    VertexArray(GLuint vertexBuffer, GLuint indexBuffer, GLuint a_pos, std::size_t vertexOffset) {
+        MBGL_CHECK_ERROR(glGenVertexArrays(1, &id));
+        MBGL_CHECK_ERROR(glBindVertexArray(id));
+        MBGL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer));
+        MBGL_CHECK_ERROR(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer));
+        MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
+        MBGL_CHECK_ERROR(glVertexAttribPointer(
+            a_pos, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(2 * sizeof(GLfloat) * vertexOffset)));
+    }
+
+    ~VertexArray() {
+        MBGL_CHECK_ERROR(glBindVertexArray(0));
+        MBGL_CHECK_ERROR(glDeleteVertexArrays(1, &id));
+    }
+
+    GLuint id = 0;
+};
+
+} // namespace
+
+TEST(MultiDraw, SamePixelsAsPerSegmentDraws) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{64, 64}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+    if (!context.getMultiDrawExtension()) {
+        // Drawables are drawn one segment at a time
+        return;
+    }
+    backend.getDefaultRenderable().getResource<gl::RenderableResource>().bind();
+
+    // A quad in each corner of the viewport, and a line across the middle, each segment with vertexes
+    // of its own and indexes starting from zero, so that a wrong base vertex draws another segment.
+    std::vector<GLfloat> vertexes;
+    const auto addQuad = [&](GLfloat x, GLfloat y) {
+        vertexes.insert(vertexes.end(), {x, y, x + 0.5f, y, x + 0.5f, y + 0.5f, x, y + 0.5f});
+    };
+    addQuad(-0.75f, 0.25f);
+    addQuad(0.25f, 0.25f);
+    vertexes.insert(vertexes.end(), {-0.9f, 0.0f, 0.9f, 0.0f});
+    addQuad(-0.75f, -0.75f);
+    addQuad(0.25f, -0.75f);
+
+    // Indexes before those of the drawable, as in a shared index buffer
+    constexpr std::size_t indexBase = 6;
+    std::vector<uint16_t> indexes(indexBase, 1);
+    const std::vector<uint16_t> quad{0, 1, 2, 0, 2, 3};
+    for (int i = 0; i < 2; ++i) {
+        indexes.insert(indexes.end(), quad.begin(), quad.end());
+    }
+    indexes.insert(indexes.end(), {0, 1});
+    for (int i = 0; i < 2; ++i) {
+        indexes.insert(indexes.end(), quad.begin(), quad.end());
+    }
+
+    std::vector<gfx::Drawable::UniqueDrawSegment> segments;
+    addSegment(segments, gfx::Triangles(), 0, 0, 6);
+    addSegment(segments, gfx::Triangles(), 4, 6, 6);
+    addSegment(segments, gfx::Triangles(), 8, 12, 0);
+    addSegment(segments, gfx::Lines(1.0f), 8, 12, 2);
+    addSegment(segments, gfx::Triangles(), 10, 14, 6);
+    addSegment(segments, gfx::Triangles(), 14, 20, 6);
+
+    Shader shader(vertexShaderSource, fragmentShaderSource);
+    const Buffer<GLfloat> vertexBuffer(GL_ARRAY_BUFFER, vertexes);
+    const Buffer<uint16_t> indexBuffer(GL_ELEMENT_ARRAY_BUFFER, indexes);
+    MBGL_CHECK_ERROR(glUseProgram(shader.program));
+
+    const auto clear = [] {
+        MBGL_CHECK_ERROR(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+        MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+    };
+
+    // Each segment with a vertex array of its own
+    clear();
+    for (const auto& seg : segments) {
+        const auto& mlSeg = seg->getSegment();
+        if (mlSeg.indexLength > 0) {
+            const VertexArray vertexArray(
+                vertexBuffer.buffer, indexBuffer.buffer, shader.a_pos, mlSeg.vertexOffset);
+            context.draw(seg->getMode(), indexBase + mlSeg.indexOffset, mlSeg.indexLength);
+        }
+    }
+    const PremultipliedImage perSegment = backend.readStillImage();
+
+    // All of them with a single vertex array and base vertexes
+    clear();
+    {
+        const VertexArray vertexArray(vertexBuffer.buffer, indexBuffer.buffer, shader.a_pos, 0);
+        for (const auto& group : gl::groupMultiDraw(segments, indexBase)) {
+            context.draw(group.mode,
+                         group.indexLengths.data(),
+                         group.indexOffsets.data(),
+                         group.vertexOffsets.data(),
+                         group.indexLengths.size());
+        }
+    }
+    const PremultipliedImage multiDraw = backend.readStillImage();
+
+    // The quads were drawn, in the corners
+    const auto green = [&](uint32_t x, uint32_t y) {
+        return perSegment.data[(y * perSegment.size.width + x) * 4 + 1] == 255;
+    };
+    EXPECT_TRUE(green(16, 16));
+    EXPECT_TRUE(green(48, 16));
+    EXPECT_TRUE(green(16, 48));
+    EXPECT_TRUE(green(48, 48));
+    EXPECT_FALSE(green(32, 8));
+
+    EXPECT_TRUE(perSegment == multiDraw);
+    MBGL_CHECK_ERROR(glUseProgram(0));
+}
+
+TEST(MultiDraw, SameRangesAsPerSegmentDraws) {
+    std::vector<gfx::Drawable::UniqueDrawSegment> segments;
+    addSegment(segments, gfx::Triangles(), 0, 0, 300);
+    addSegment(segments, gfx::Triangles(), 1000, 300, 0);
+    addSegment(segments, gfx::Triangles(), 1000, 300, 600);
+    addSegment(segments, gfx::Lines(2.0f), 2000, 900, 40);
+    addSegment(segments, gfx::Lines(4.0f), 2020, 940, 40);
+    addSegment(segments, gfx::Lines(4.0f), 2040, 980, 40);
+    addSegment(segments, gfx::Triangles(), 65000, 1020, 3);
+
+    for (const std::size_t indexBase : {std::size_t(0), std::size_t(4096)}) {
+        const auto groups = gl::groupMultiDraw(segments, indexBase);
+
+        // Each segment is drawn once, in order, with the indexes and base vertex it is drawn with on its own
+        EXPECT_EQ(perSegmentDraws(segments, indexBase), multiDraws(groups));
+
+        // Consecutive segments are only batched when they have the same draw mode, including the line width
+        ASSERT_EQ(4u, groups.size());
+        EXPECT_EQ(2u, groups[0].indexLengths.size());
+        EXPECT_EQ(1u, groups[1].indexLengths.size());
+        EXPECT_EQ(2u, groups[2].indexLengths.size());
+        EXPECT_EQ(1u, groups[3].indexLengths.size());
+    }
+}
+
+TEST(MultiDraw, EmptySegments) {
+    std::vector<gfx::Drawable::UniqueDrawSegment> segments;
+    EXPECT_TRUE(gl::groupMultiDraw(segments, 0).empty());
+
+    addSegment(segments, gfx::Triangles(), 0, 0, 0);
+    EXPECT_TRUE(gl::groupMultiDraw(segments, 0).empty());
+}
+
+#endif
@@ -0,0 +1,145 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/fixture_log_observer.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/platform/settings.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr const char* directory = "test/fixtures/program_binary_cache";
+
+const char* vertexSource = R"(#version 300 es
+in vec2 a_pos;
+void main() {
+    gl_Position = vec4(a_pos, 0, 1);
+})";
+
+const char* fragmentSource = R"(#version 300 es
+precision mediump float;
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(0, 1, 0, 1);
+})";
+
+// Enables the program binary cache for the contexts created during its lifetime
+class ProgramBinaryCacheSetting {
+public:
+    ProgramBinaryCacheSetting() {
+        platform::Settings::getInstance().set(platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH, directory);
+    }
+    ~ProgramBinaryCacheSetting() {
+        platform::Settings::getInstance().set(platform::EXPERIMENTAL_PROGRAM_BINARY_CACHE_PATH, mapbox::base::Value{});
+    }
+};
+
+} // namespace
+
+TEST(ProgramBinaryCache, TEST_REQUIRES_WRITE(StoreAndLoad)) {
+    const gl::ProgramBinaryCache cache{directory, "driver"};
+    const auto key = cache.makeKey({vertexSource}, {fragmentSource}, "a_pos");
+    cache.remove(key);
+    EXPECT_FALSE(cache.load(key));
+
+    cache.store(key, {0x1234, "binary"});
+    const auto binary = cache.load(key);
+    ASSERT_TRUE(binary);
+    EXPECT_EQ(0x1234u, binary->format);
+    EXPECT_EQ("binary", binary->data);
+
+    cache.remove(key);
+    EXPECT_FALSE(cache.load(key));
+}
+
+TEST(ProgramBinaryCache, Keys) {
+    const gl::ProgramBinaryCache cache{directory, "driver"};
+    const auto key = cache.makeKey({"#define A\n", vertexSource}, {fragmentSource}, "a_pos");
+    EXPECT_EQ(key, cache.makeKey({"#define A\n", vertexSource}, {fragmentSource}, "a_pos"));
+    // Only the concatenated source matters
+    const std::string concatenated = "#define A\n" + std::string(vertexSource);
+    EXPECT_EQ(key, cache.makeKey({concatenated.c_str()}, {fragmentSource}, "a_pos"));
+    EXPECT_NE(key, cache.makeKey({"#define B\n", vertexSource}, {fragmentSource}, "a_pos"));
+    EXPECT_NE(key, cache.makeKey({"#define A\n", vertexSource}, {fragmentSource}, "a_color"));
+    EXPECT_NE(key, cache.makeKey({vertexSource}, {"#define A\n", fragmentSource}, "a_pos"));
+
+    const gl::ProgramBinaryCache otherDriver{directory, "other driver"};
+    EXPECT_NE(key, otherDriver.makeKey({"#define A\n", vertexSource}, {fragmentSource}, "a_pos"));
+}
+
+TEST(ProgramBinaryCache, TEST_REQUIRES_WRITE(InvalidFiles)) {
+    FixtureLog log;
+    const gl::ProgramBinaryCache cache{directory, "driver"};
+    const auto key = cache.makeKey({vertexSource}, {fragmentSource}, "a_pos");
+
+    // Truncated
+    cache.store(key, {0x1234, "binary"});
+    const std::string file = util::read_file(cache.getPath(key));
+    util::write_file(cache.getPath(key), file.substr(0, file.size() - 1));
+    EXPECT_FALSE(cache.load(key));
+
+    // Made by another driver, with a colliding key
+    const gl::ProgramBinaryCache otherDriver{directory, "other driver"};
+    otherDriver.store(key, {0x1234, "binary"});
+    EXPECT_FALSE(cache.load(key));
+
+    EXPECT_EQ(2u,
+              log.count({EventSeverity::Warning, Event::OpenGL, -1, "Ignoring invalid program binary"},
+                        /*substring=*/true));
+    cache.remove(key);
+}
+
+TEST(ProgramBinaryCache, TEST_REQUIRES_WRITE(Context)) {
+    FixtureLog log;
+    const ProgramBinaryCacheSetting setting;
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+    const auto& stats = context.renderingStats();
+
+    const auto* cache = context.getProgramBinaryCache();
+    if (!cache) {
+        // The driver can't save programs, they're always compiled
+        context.createProgram({vertexSource}, {fragmentSource}, "a_pos");
+        EXPECT_EQ(0, stats.numProgramBinaryHits + stats.numProgramBinaryMisses);
+        return;
+    }
+
+    const auto key = cache->makeKey({vertexSource}, {fragmentSource}, "a_pos");
+    cache->remove(key);
+
+    // Built from source the first time, then loaded
+    context.createProgram({vertexSource}, {fragmentSource}, "a_pos");
+    EXPECT_EQ(0, stats.numProgramBinaryHits);
+    EXPECT_EQ(1, stats.numProgramBinaryMisses);
+    ASSERT_TRUE(cache->load(key));
+
+    const auto program = context.createProgram({vertexSource}, {fragmentSource}, "a_pos");
+    EXPECT_EQ(1, stats.numProgramBinaryHits);
+    EXPECT_EQ(1, stats.numProgramBinaryMisses);
+    platform::GLint status = 0;
+    MBGL_CHECK_ERROR(platform::glGetProgramiv(program, GL_LINK_STATUS, &status));
+    EXPECT_EQ(GL_TRUE, status);
+
+    // A binary rejected by the driver is replaced by one built from source
+    const auto format = cache->load(key)->format;
+    cache->store(key, {format, "not a program"});
+    const auto rebuilt = context.createProgram({vertexSource}, {fragmentSource}, "a_pos");
+    EXPECT_EQ(1, stats.numProgramBinaryHits);
+    EXPECT_EQ(2, stats.numProgramBinaryMisses);
+    MBGL_CHECK_ERROR(platform::glGetProgramiv(rebuilt, GL_LINK_STATUS, &status));
+    EXPECT_EQ(GL_TRUE, status);
+    EXPECT_EQ(
+        1u, log.count({EventSeverity::Warning, Event::OpenGL, -1, "Discarding program binary rejected by the driver"}));
+    EXPECT_NE("not a program", cache->load(key)->data);
+
+    cache->remove(key);
+}
+
+#endif
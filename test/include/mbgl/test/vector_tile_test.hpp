@@ -43,7 +43,10 @@ public:
                          imageManager,
                          glyphManager,
                          0,
-                         threadPool},
+                         threadPool,
+                         nullptr,
+                         nullptr,
+                         nullptr},
           style{fileSource, 1, threadPool} {}
 
     ~VectorTileTest() {
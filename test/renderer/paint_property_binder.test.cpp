@@ -0,0 +1,93 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/programs/attributes.hpp>
+#include <mbgl/renderer/paint_property_binder.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/property_expression.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+using RadiusBinder = SourceFunctionPaintPropertyBinder<float, attributes::radius>;
+using RadiusVertexVector = gfx::VertexVector<gfx::VertexType<attributes::radius>>;
+
+constexpr std::size_t verticesPerFeature = 4;
+
+class StubGeometryTileLayer : public GeometryTileLayer {
+public:
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubGeometryTileFeature>(features.at(i));
+    }
+    std::string getName() const override { return "layer"; }
+
+    std::vector<StubGeometryTileFeature> features;
+};
+
+// Three features with the IDs 1, 2 and 3, each with the same number of vertices
+StubGeometryTileLayer makeLayer() {
+    StubGeometryTileLayer layer;
+    for (uint64_t id = 1; id <= 3; ++id) {
+        layer.features.emplace_back(id, FeatureType::Point, GeometryCollection{{{0, 0}}}, PropertyMap{{"r", 3.0}});
+    }
+    return layer;
+}
+
+// Fills the binder with the vertices of every feature, and marks them as uploaded
+RadiusVertexVector& populate(RadiusBinder& binder, const StubGeometryTileLayer& layer) {
+    for (std::size_t i = 0; i < layer.features.size(); ++i) {
+        binder.populateVertexVector(
+            layer.features[i], (i + 1) * verticesPerFeature, i, {}, std::nullopt, CanonicalTileID(0, 0, 0), {});
+    }
+    auto& vertices = static_cast<RadiusVertexVector&>(*binder.getSharedVertexVector());
+    vertices.updateModified();
+    vertices.resetModifiedRange();
+    return vertices;
+}
+
+} // namespace
+
+TEST(PaintPropertyBinder, FeatureStateUpdatesModifiedRange) {
+    const auto layer = makeLayer();
+    RadiusBinder binder(
+        PropertyExpression<float>(
+            expression::dsl::createExpression(R"(["case", ["boolean", ["feature-state", "hover"], false], 10, 5])")),
+        0.0f);
+    auto& vertices = populate(binder, layer);
+    ASSERT_EQ(3 * verticesPerFeature, vertices.elements());
+    const auto uploaded = vertices.getLastModified();
+
+    // Only the vertices of the second feature are rewritten and need to be uploaded again
+    binder.updateVertexVectors({{"2", FeatureState{{"hover", true}}}}, layer, {});
+    EXPECT_TRUE(vertices.isModifiedAfter(uploaded));
+    EXPECT_EQ(std::make_pair(verticesPerFeature, 2 * verticesPerFeature), vertices.getModifiedRange());
+    for (std::size_t i = 0; i < vertices.elements(); ++i) {
+        const bool hovered = i >= verticesPerFeature && i < 2 * verticesPerFeature;
+        EXPECT_EQ(hovered ? 10.0f : 5.0f, vertices.vector()[i].a1[0]) << "vertex " << i;
+    }
+    vertices.resetModifiedRange();
+
+    // Changes to several features are uploaded as the range covering all of them
+    binder.updateVertexVectors(
+        {{"1", FeatureState{{"hover", true}}}, {"3", FeatureState{{"hover", true}}}, {"4", FeatureState{}}}, layer, {});
+    EXPECT_EQ(std::make_pair(std::size_t(0), 3 * verticesPerFeature), vertices.getModifiedRange());
+    EXPECT_EQ(10.0f, vertices.vector()[0].a1[0]);
+    EXPECT_EQ(10.0f, vertices.vector()[3 * verticesPerFeature - 1].a1[0]);
+}
+
+TEST(PaintPropertyBinder, FeatureStateConstantSkipsUpdates) {
+    const auto layer = makeLayer();
+    RadiusBinder binder(PropertyExpression<float>(expression::dsl::createExpression(R"(["get", "r"])")), 0.0f);
+    auto& vertices = populate(binder, layer);
+    const auto uploaded = vertices.getLastModified();
+
+    // An expression not reading the feature state leaves the vertices alone
+    binder.updateVertexVectors({{"2", FeatureState{{"hover", true}}}}, layer, {});
+    EXPECT_FALSE(vertices.isModifiedAfter(uploaded));
+    const auto [begin, end] = vertices.getModifiedRange();
+    EXPECT_EQ(begin, end);
+    EXPECT_EQ(3.0f, vertices.vector()[verticesPerFeature].a1[0]);
+}
@@ -0,0 +1,192 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/rendering_stats.hpp>
+#include <mbgl/renderer/shared_atlas.hpp>
+#include <mbgl/renderer/tile_render_data.hpp>
+#include <mbgl/style/image_impl.hpp>
+#include <mbgl/util/image.hpp>
+
+#include <set>
+#include <tuple>
+#include <utility>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<Glyph> makeGlyph(const GlyphID id, const Size size, const uint8_t value = 255) {
+    auto glyph = makeMutable<Glyph>();
+    glyph->id = id;
+    glyph->bitmap = AlphaImage(size);
+    glyph->bitmap.fill(value);
+    return glyph;
+}
+
+Immutable<style::Image::Impl> makeImage(const std::string& id, const Size size) {
+    PremultipliedImage image(size);
+    image.fill(255);
+    return makeMutable<style::Image::Impl>(id, std::move(image), 1.0f);
+}
+
+} // namespace
+
+TEST(SharedAtlas, Glyphs) {
+    const auto atlas = SharedAtlas::create();
+    const auto a = makeGlyph(u'a', {10, 12});
+    const auto b = makeGlyph(u'b', {8, 14});
+    const auto c = makeGlyph(u'c', {9, 9});
+
+    auto first = atlas->add(GlyphMap{{0, {{u'a', a}, {u'b', b}}}}, {}, {}, {});
+    ASSERT_TRUE(first);
+    auto second = atlas->add(GlyphMap{{0, {{u'b', b}, {u'c', c}}}}, {}, {}, {});
+    ASSERT_TRUE(second);
+    EXPECT_EQ(3u, atlas->getGlyphCount());
+
+    // Layouts share the glyphs they have in common
+    const auto rect = first->glyphPositions.at(0).at(u'b').rect;
+    EXPECT_EQ(rect, second->glyphPositions.at(0).at(u'b').rect);
+    EXPECT_EQ(10, rect.w);
+    EXPECT_EQ(16, rect.h);
+
+    // Glyphs are padded with transparent pixels
+    const auto image = atlas->getGlyphAtlasImageForTests();
+    EXPECT_EQ(atlas->getGlyphAtlasSize(), image.size);
+    EXPECT_EQ(0, image.data[rect.y * image.size.width + rect.x]);
+    EXPECT_EQ(255, image.data[(rect.y + 1) * image.size.width + rect.x + 1]);
+
+    // Glyphs are only evicted once no layout refers to them
+    first.reset();
+    atlas->evict();
+    EXPECT_EQ(2u, atlas->getGlyphCount());
+    second.reset();
+    atlas->evict();
+    EXPECT_EQ(0u, atlas->getGlyphCount());
+}
+
+TEST(SharedAtlas, GlyphsDrawnDifferently) {
+    const auto atlas = SharedAtlas::create();
+    const auto pixel = [&](const Rect<uint16_t>& rect) {
+        const auto image = atlas->getGlyphAtlasImageForTests();
+        return image.data[(rect.y + 1) * image.size.width + rect.x + 1];
+    };
+
+    auto first = atlas->add(GlyphMap{{0, {{u'a', makeGlyph(u'a', {10, 12}, 100)}}}}, {}, {}, {});
+    ASSERT_TRUE(first);
+    const auto firstRect = first->glyphPositions.at(0).at(u'a').rect;
+
+    // Another request drew the glyph differently, the layout using the first one keeps its pixels
+    const auto second = atlas->add(GlyphMap{{0, {{u'a', makeGlyph(u'a', {10, 12}, 200)}}}}, {}, {}, {});
+    ASSERT_TRUE(second);
+    const auto secondRect = second->glyphPositions.at(0).at(u'a').rect;
+    EXPECT_FALSE(firstRect == secondRect);
+    EXPECT_EQ(2u, atlas->getGlyphCount());
+    EXPECT_EQ(100, pixel(firstRect));
+    EXPECT_EQ(200, pixel(secondRect));
+
+    // Glyphs with the same pixels share an entry
+    const auto third = atlas->add(GlyphMap{{0, {{u'a', makeGlyph(u'a', {10, 12}, 200)}}}}, {}, {}, {});
+    ASSERT_TRUE(third);
+    EXPECT_EQ(secondRect, third->glyphPositions.at(0).at(u'a').rect);
+    EXPECT_EQ(2u, atlas->getGlyphCount());
+
+    // Entries no layout refers to anymore are drawn over
+    first.reset();
+    const auto fourth = atlas->add(GlyphMap{{0, {{u'a', makeGlyph(u'a', {10, 12}, 50)}}}}, {}, {}, {});
+    ASSERT_TRUE(fourth);
+    EXPECT_EQ(firstRect, fourth->glyphPositions.at(0).at(u'a').rect);
+    EXPECT_EQ(2u, atlas->getGlyphCount());
+    EXPECT_EQ(50, pixel(firstRect));
+    EXPECT_EQ(200, pixel(secondRect));
+}
+
+TEST(SharedAtlas, Full) {
+    // Room for a single glyph
+    const auto atlas = SharedAtlas::create(16);
+    const auto a = makeGlyph(u'a', {12, 12});
+    const auto b = makeGlyph(u'b', {12, 12});
+
+    auto first = atlas->add(GlyphMap{{0, {{u'a', a}}}}, {}, {}, {});
+    ASSERT_TRUE(first);
+
+    // The tile makes its own atlas
+    EXPECT_FALSE(atlas->add(GlyphMap{{0, {{u'a', a}, {u'b', b}}}}, {}, {}, {}));
+
+    // Unused glyphs make room for new ones
+    first.reset();
+    const auto second = atlas->add(GlyphMap{{0, {{u'b', b}}}}, {}, {}, {});
+    ASSERT_TRUE(second);
+    EXPECT_EQ(1u, atlas->getGlyphCount());
+    EXPECT_EQ((Size{16, 16}), atlas->getGlyphAtlasSize());
+}
+
+TEST(SharedAtlas, Grows) {
+    const auto atlas = SharedAtlas::create(512);
+    EXPECT_EQ((Size{256, 256}), atlas->getGlyphAtlasSize());
+
+    // Twenty 64x64 bins don't fit in 256x256
+    GlyphMap glyphs;
+    for (GlyphID id = 1; id <= 20; ++id) {
+        glyphs[0].emplace(id, makeGlyph(id, {62, 62}, static_cast<uint8_t>(id)));
+    }
+    const auto layout = atlas->add(glyphs, {}, {}, {});
+    ASSERT_TRUE(layout);
+    EXPECT_EQ((Size{512, 256}), atlas->getGlyphAtlasSize());
+
+    // The glyphs packed before growing kept their pixels
+    const auto image = atlas->getGlyphAtlasImageForTests();
+    std::set<std::pair<uint16_t, uint16_t>> origins;
+    for (const auto& [id, position] : layout->glyphPositions.at(0)) {
+        const auto& rect = position.rect;
+        EXPECT_TRUE(origins.emplace(rect.x, rect.y).second);
+        EXPECT_EQ(id, image.data[(rect.y + 1) * image.size.width + rect.x + 1]);
+    }
+}
+
+TEST(SharedAtlas, Images) {
+    const auto atlas = SharedAtlas::create();
+    const auto image = makeImage("image", {4, 2});
+    const ImageMap images{{"image", image}};
+
+    const auto first = atlas->add({}, images, images, {});
+    ASSERT_TRUE(first);
+    EXPECT_FALSE(first->iconAtlas.image.valid());
+    EXPECT_EQ(2u, atlas->getImageCount());
+
+    const auto icon = first->iconAtlas.iconPositions.at("image").paddedRect;
+    const auto pattern = first->iconAtlas.patternPositions.at("image").paddedRect;
+    EXPECT_FALSE(icon == pattern);
+    EXPECT_EQ(6, icon.w);
+    EXPECT_EQ(4, icon.h);
+
+    // Patterns are padded with wrapped pixels, icons with transparent ones
+    const auto pixels = atlas->getIconAtlasImageForTests();
+    const auto alpha = [&](uint32_t x, uint32_t y) {
+        return pixels.data[(y * pixels.size.width + x) * 4 + 3];
+    };
+    EXPECT_EQ(0, alpha(icon.x, icon.y + 1));
+    EXPECT_EQ(255, alpha(icon.x + 1, icon.y + 1));
+    EXPECT_EQ(255, alpha(pattern.x, pattern.y + 1));
+
+    // Layouts using a resized image get a new entry, the old one stays for the others
+    const auto resized = makeImage("image", {8, 8});
+    const auto second = atlas->add({}, ImageMap{{"image", resized}}, {}, {});
+    ASSERT_TRUE(second);
+    EXPECT_EQ(3u, atlas->getImageCount());
+    EXPECT_EQ(10, second->iconAtlas.iconPositions.at("image").paddedRect.w);
+}
+
+TEST(SharedAtlas, FallbackAtlasBytes) {
+    gfx::RenderingStats stats;
+    {
+        // The atlases of a tile that didn't fit in the shared ones are counted while it has them
+        TileAtlasTextures textures;
+        textures.setGlyphBytes(stats, 1000);
+        textures.setIconBytes(stats, 4000);
+        EXPECT_EQ(5000, stats.memAtlases);
+
+        // A new layout of the tile replaces its textures
+        textures.setGlyphBytes(stats, 200);
+        EXPECT_EQ(4200, stats.memAtlases);
+    }
+    EXPECT_EQ(0, stats.memAtlases);
+}
@@ -0,0 +1,57 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/source_state.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+FeatureState stateOf(const SourceFeatureState& states, const std::string& featureID) {
+    FeatureState result;
+    states.getState(result, std::string("layer"), featureID);
+    return result;
+}
+
+} // namespace
+
+TEST(SourceFeatureState, CoalesceUpdates) {
+    SourceFeatureState states;
+    std::vector<RenderTile> tiles;
+
+    states.updateState(std::string("layer"), "1", {{"hover", true}, {"selected", false}});
+    states.coalesceChanges(tiles);
+    states.updateState(std::string("layer"), "1", {{"selected", true}});
+    states.updateState(std::string("layer"), "2", {{"hover", true}});
+
+    // Pending changes are visible before they are coalesced
+    EXPECT_TRUE((FeatureState{{"hover", true}, {"selected", true}}) == stateOf(states, "1"));
+
+    states.coalesceChanges(tiles);
+    EXPECT_TRUE((FeatureState{{"hover", true}, {"selected", true}}) == stateOf(states, "1"));
+    EXPECT_TRUE((FeatureState{{"hover", true}}) == stateOf(states, "2"));
+}
+
+TEST(SourceFeatureState, CoalesceUpdatesAndRemovals) {
+    SourceFeatureState states;
+    std::vector<RenderTile> tiles;
+
+    states.updateState(std::string("layer"), "1", {{"hover", true}, {"selected", true}});
+    states.updateState(std::string("layer"), "2", {{"hover", true}});
+    states.coalesceChanges(tiles);
+
+    // Updates and removals in the same source layer are both applied
+    states.updateState(std::string("layer"), "3", {{"hover", true}});
+    states.removeState(std::string("layer"), std::string("1"), std::string("hover"));
+    states.removeState(std::string("layer"), std::string("2"), std::nullopt);
+    states.coalesceChanges(tiles);
+
+    EXPECT_TRUE((FeatureState{{"selected", true}}) == stateOf(states, "1"));
+    EXPECT_TRUE(stateOf(states, "2").empty());
+    EXPECT_TRUE((FeatureState{{"hover", true}}) == stateOf(states, "3"));
+
+    states.removeState(std::string("layer"), std::nullopt, std::nullopt);
+    states.coalesceChanges(tiles);
+    EXPECT_TRUE(stateOf(states, "1").empty());
+    EXPECT_TRUE(stateOf(states, "3").empty());
+}
@@ -8,6 +8,7 @@
 #define CPPHTTPLIB_THREAD_POOL_COUNT 4
 #include <httplib.h>
 
+#include <algorithm>
 #include <atomic>
 
 using namespace std::literals::string_literals;
@@ -186,6 +187,31 @@ void runServer(std::unique_ptr<httplib::Server>& server) {
         res.set_content("Request " + std::string(numbers), "text/plain");
     });
 
+    // Responds with the largest number of these requests seen in progress at once while serving this one
+    std::atomic_int concurrentRequests(0);
+    server->Get("/concurrent", [&](const Request&, Response& res) {
+        const int atStart = ++concurrentRequests;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const int atEnd = concurrentRequests--;
+        res.status = 200;
+        res.set_content(std::to_string(std::max(atStart, atEnd)), "text/plain");
+    });
+
+    // Simulates the latency of a tile server
+    server->Get(R"(/tile/(\d+))", [](const Request& req, Response& res) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        res.status = 200;
+        res.set_content("Tile " + std::string(req.matches[1]), "text/plain");
+    });
+
+    server->Get(R"(/tile/(\d+)/(\d+)/(\d+))", [](const Request& req, Response& res) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        res.status = 200;
+        res.set_content("Tile " + std::string(req.matches[1]) + "/" + std::string(req.matches[2]) + "/" +
+                            std::string(req.matches[3]),
+                        "text/plain");
+    });
+
     server->Get(R"(/online/(.*))", [](const Request req, Response& res) {
         res.status = 200;
         auto file = "test/fixtures/map/online/"s + std::string(req.matches[1]);
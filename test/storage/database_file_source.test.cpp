@@ -1,3 +1,4 @@
+#include <mbgl/storage/database_file_source.hpp>
 #include <mbgl/storage/file_source_manager.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/resource_options.hpp>
@@ -54,4 +55,40 @@ TEST(DatabaseFileSource, VolatileResource) {
         });
     });
     loop.run();
-}
\ No newline at end of file
+}
+
+TEST(DatabaseFileSource, ReadsPendingWrites) {
+    util::RunLoop loop;
+
+    std::shared_ptr<DatabaseFileSource> dbfs = std::static_pointer_cast<DatabaseFileSource>(
+        FileSourceManager::get()->getFileSource(FileSourceType::Database, ResourceOptions{}));
+
+    const Resource resource{Resource::Unknown, "http://127.0.0.1:3000/pending", {}, Resource::LoadingMethod::CacheOnly};
+    Response response{};
+    response.data = std::make_shared<std::string>("Pending value");
+
+    // Without a callback the write waits for its batch, but is visible to reads right away
+    dbfs->put(resource, response);
+    auto req = dbfs->request(resource, [&](const Response& res) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Pending value", *res.data);
+        loop.stop();
+    });
+    loop.run();
+
+    // Once the batch is flushed the value comes from the database
+    bool stored = false;
+    dbfs->forward(resource, response, [&] {
+        stored = true;
+        req = dbfs->request(resource, [&](const Response& res) {
+            req.reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Pending value", *res.data);
+            loop.stop();
+        });
+    });
+    loop.run();
+    EXPECT_TRUE(stored);
+}
@@ -6,6 +6,9 @@
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/storage/resource_options.hpp>
+#include <mbgl/util/client_options.hpp>
+
+#include <vector>
 
 using namespace mbgl;
 
@@ -207,3 +210,70 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Load)) {
 
     loop.run();
 }
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(ConnectionOptions)) {
+    util::RunLoop loop;
+    HTTPFileSource fs(ResourceOptions::Default(),
+                      ClientOptions()
+                          .withHTTP2Multiplexing(false)
+                          .withMaxConnectionsPerHost(1)
+                          .withDNSCacheTimeout(Seconds(5))
+                          .withKeepAliveInterval(Seconds(30)));
+
+    // With a single connection, the requests are served one after the other
+    int pending = 4;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    for (int i = 0; i < pending; i++) {
+        reqs.push_back(fs.request({Resource::Unknown, "http://127.0.0.1:3000/concurrent"}, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("1", *res.data);
+            if (--pending == 0) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+}
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Multiplexing)) {
+    util::RunLoop loop;
+    // Multiplexing is on by default. Plain HTTP requests use HTTP/1.1, and so do all requests when libcurl is
+    // built without HTTP/2 support.
+    HTTPFileSource fs(ResourceOptions::Default(), ClientOptions().withHTTP2Multiplexing(true));
+
+    int pending = 4;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    for (int i = 0; i < pending; i++) {
+        reqs.push_back(fs.request({Resource::Unknown, "http://127.0.0.1:3000/test"}, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Hello World!", *res.data);
+            if (--pending == 0) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+}
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Timing)) {
+    util::RunLoop loop;
+    HTTPFileSource fs(ResourceOptions::Default(), ClientOptions());
+
+    auto req = fs.request({Resource::Unknown, "http://127.0.0.1:3000/test"}, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        // Not every platform implementation measures timings
+        if (res.timing) {
+            const auto& timing = *res.timing;
+            EXPECT_EQ(Duration::zero(), timing.tls);
+            EXPECT_LT(Duration::zero(), timing.total);
+            EXPECT_GE(timing.total, timing.dns + timing.connect + timing.firstByte + timing.transfer);
+        }
+        loop.stop();
+    });
+
+    loop.run();
+}
@@ -1145,6 +1145,65 @@ TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, PutAmbientResources) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    db.setMaximumAmbientCacheSize(1024 * 100);
+
+    Response response;
+    response.data = randomString(1024);
+
+    Response error;
+    error.error = std::make_unique<Response::Error>(Response::Error::Reason::Server, "500");
+
+    // Fill the cache, then add a batch which needs room.
+    for (uint32_t i = 1; i <= 90; ++i) {
+        db.put(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+
+    std::list<std::tuple<Resource, Response>> batch;
+    for (uint32_t i = 91; i <= 101; ++i) {
+        batch.emplace_back(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+    batch.emplace_back(Resource::style("http://example.com/error"), error);
+
+    EXPECT_EQ(11u, db.putAmbientResources(batch));
+
+    for (uint32_t i = 91; i <= 101; ++i) {
+        EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/"s + util::toString(i))))) << i;
+    }
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/error"))));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, PutAmbientResourcesLargerThanCache) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    db.setMaximumAmbientCacheSize(1024 * 100);
+
+    Response response;
+    response.data = randomString(1024);
+
+    // There's no room for the whole batch, but the resources are still written one by one
+    std::list<std::tuple<Resource, Response>> batch;
+    for (uint32_t i = 1; i <= 150; ++i) {
+        batch.emplace_back(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+
+    EXPECT_EQ(150u, db.putAmbientResources(batch));
+    EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/150"))));
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+
+    EXPECT_EQ(1u,
+              log.count({EventSeverity::Info,
+                         Event::Database,
+                         -1,
+                         "Unable to make space for the batch of entries, writing them one by one"}));
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, OfflineRegionDoesNotAffectAmbientCacheSize) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1445,6 +1504,65 @@ TEST(OfflineDatabase, BatchInsertionMapboxTileCountExceeded) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, BatchInsertionReturnsSizes) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    Response small;
+    small.data = randomString(100);
+    Response large;
+    large.data = randomString(1000);
+    std::list<std::tuple<Resource, Response>> resources;
+    resources.emplace_back(Resource::style("http://example.com/"), small);
+    resources.emplace_back(Resource::tile("http://example.com/{z}/{x}/{y}", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), large);
+
+    OfflineRegionStatus status;
+    EXPECT_EQ((std::vector<uint64_t>{100u, 1000u}), db.putRegionResources(region->getID(), resources, status));
+    EXPECT_EQ(1100u, status.completedResourceSize);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, RegionTileCheckpoints) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region1 = db.createRegion(definition, OfflineRegionMetadata());
+    auto region2 = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region1);
+    ASSERT_TRUE(region2);
+
+    EXPECT_FALSE(db.getRegionTileCheckpoint(region1->getID(), "source"));
+
+    db.putRegionTileCheckpoint(region1->getID(), "source", {100, 90, 4096});
+    db.putRegionTileCheckpoint(region1->getID(), "source", {200, 180, 8192});
+    db.putRegionTileCheckpoint(region1->getID(), "other", {10, 10, 512});
+    db.putRegionTileCheckpoint(region2->getID(), "source", {50, 50, 1024});
+
+    auto checkpoint = db.getRegionTileCheckpoint(region1->getID(), "source");
+    ASSERT_TRUE(checkpoint);
+    EXPECT_EQ(200u, checkpoint->position);
+    EXPECT_EQ(180u, checkpoint->tileCount);
+    EXPECT_EQ(8192u, checkpoint->tileSize);
+
+    db.deleteRegionTileCheckpoints(region1->getID());
+    EXPECT_FALSE(db.getRegionTileCheckpoint(region1->getID(), "source"));
+    EXPECT_FALSE(db.getRegionTileCheckpoint(region1->getID(), "other"));
+
+    // Checkpoints are removed along with their region
+    const int64_t region2ID = region2->getID();
+    ASSERT_TRUE(db.getRegionTileCheckpoint(region2ID, "source"));
+    db.deleteRegion(std::move(*region2));
+    EXPECT_FALSE(db.getRegionTileCheckpoint(region2ID, "source"));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, MigrateFromV2Schema) {
     // v2.db is a v2 database containing a single offline region with a small number of resources.
     FixtureLog log;
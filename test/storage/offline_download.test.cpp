@@ -4,20 +4,28 @@
 #include <mbgl/test/stub_map_observer.hpp>
 #include <mbgl/test/fixture_log_observer.hpp>
 #include <mbgl/test/sqlite3_test_fs.hpp>
+#include <mbgl/test/util.hpp>
 
 #include <mbgl/gfx/headless_frontend.hpp>
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
 #include <mbgl/storage/http_file_source.hpp>
+#include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/util/client_options.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/compression.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <mbgl/storage/sqlite3.hpp>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <set>
+
 using namespace mbgl;
 using namespace std::literals::string_literals;
 using mapbox::sqlite::ResultCode;
@@ -1160,3 +1168,163 @@ TEST(OfflineDownload, NoFreezingOnNotFoundError) {
     test.loop.run();
     // Passes if does not freeze.
 }
+
+// Tile progress is checkpointed whenever a batch of tiles is stored, so that an interrupted
+// download skips the stored tiles instead of checking each of them again.
+TEST(OfflineDownload, ResumeFromTileCheckpoint) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    const OfflineTilePyramidRegionDefinition definition(
+        "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 4.0, 1.0, false);
+    // More tiles than are stored in one batch
+    constexpr uint64_t tileCount = 1 + 4 + 16 + 64 + 256;
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    std::size_t tileRequests = 0;
+    test.fileSource.tileResponse = [&](const Resource&) {
+        tileRequests++;
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    {
+        OfflineDownload download(region->getID(), definition, test.db, test.fileSource);
+
+        auto observer = std::make_unique<MockObserver>();
+        bool interrupted = false;
+        observer->statusChangedFn = [&](OfflineRegionStatus status) {
+            if (!interrupted && status.completedTileCount > 0) {
+                interrupted = true;
+                EXPECT_FALSE(status.complete());
+                test.loop.schedule([&]() {
+                    download.setState(OfflineRegionDownloadState::Inactive);
+                    test.loop.stop();
+                });
+            }
+        };
+
+        download.setObserver(std::move(observer));
+        download.setState(OfflineRegionDownloadState::Active);
+        test.loop.run();
+    }
+
+    tileRequests = 0;
+    OfflineDownload download(region->getID(), definition, test.db, test.fileSource);
+
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(tileCount, status.requiredTileCount);
+            EXPECT_EQ(tileCount, status.completedTileCount);
+
+            // The progress restored from the checkpoint matches the stored region
+            const auto stored = test.db.getRegionCompletedStatus(region->getID());
+            ASSERT_TRUE(stored);
+            EXPECT_EQ(stored->completedTileCount, status.completedTileCount);
+            EXPECT_EQ(stored->completedTileSize, status.completedTileSize);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    EXPECT_LT(tileRequests, tileCount / 2);
+}
+
+TEST(OfflineDownload, BoundsOnTileBoundaries) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    // The equator, the antimeridian and the meridians at 90 degrees are tile boundaries from z2
+    OfflineDownload download(region->getID(),
+                             OfflineTilePyramidRegionDefinition("http://127.0.0.1:3000/style.json",
+                                                                LatLngBounds::hull({0, -90}, {util::LATITUDE_MAX, 90}),
+                                                                0.0,
+                                                                4.0,
+                                                                1.0,
+                                                                false),
+                             test.db,
+                             test.fileSource);
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    std::set<std::string> tiles;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        const Resource::TileData& tile = *resource.tileData;
+        tiles.insert(util::toString(tile.z) + "/" + util::toString(tile.x) + "/" + util::toString(tile.y));
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        // The required counts are those of the tiles downloaded, so the download completes
+        if (status.complete()) {
+            EXPECT_EQ(tiles.size(), status.requiredTileCount);
+            EXPECT_EQ(tiles.size(), status.completedTileCount);
+
+            download.setState(OfflineRegionDownloadState::Inactive);
+            EXPECT_EQ(status.requiredTileCount, download.getStatus().requiredTileCount);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    EXPECT_FALSE(tiles.empty());
+}
+
+// Downloads a region from the local test server, with offline requests on a budget of their own,
+// and records the rate at which tiles are stored.
+TEST(OfflineDownload, TEST_REQUIRES_SERVER(BulkDownloadThroughput)) {
+    OfflineTest test;
+    OnlineFileSource fileSource(ResourceOptions::Default(), ClientOptions());
+    fileSource.setProperty(MAX_CONCURRENT_OFFLINE_REQUESTS_KEY, 32u);
+
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    const std::string styleURL = "http://127.0.0.1:3000/offline/style.json";
+    OfflineDownload download(
+        region->getID(), OfflineTilePyramidRegionDefinition(styleURL, LatLngBounds::world(), 0.0, 4.0, 1.0, false),
+        test.db,
+        fileSource);
+    constexpr uint64_t tileCount = 1 + 4 + 16 + 64 + 256;
+
+    // The test server answers any tile path after a simulated latency, with a body naming the tile
+    Response style;
+    style.data = std::make_shared<std::string>(
+        R"({"version": 8, "sources": {"tiles": {"type": "vector",)"
+        R"( "tiles": ["http://127.0.0.1:3000/tile/{z}/{x}/{y}"]}}, "layers": []})");
+    test.db.put(Resource::style(styleURL), style);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration elapsed{};
+
+    auto observer = std::make_unique<MockObserver>();
+    observer->responseErrorFn = [&](Response::Error error) {
+        ADD_FAILURE() << error.message;
+    };
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            elapsed = std::chrono::steady_clock::now() - start;
+            EXPECT_EQ(tileCount, status.completedTileCount);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    EXPECT_EQ(tileCount, test.db.getRegionCompletedStatus(region->getID()).value().completedTileCount);
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    RecordProperty("tilesPerSecond", static_cast<int>(static_cast<double>(tileCount) / seconds));
+}
@@ -11,6 +11,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 using namespace mbgl;
 
 #ifdef WIN32
@@ -603,6 +605,60 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(LowHighPriorityRequestsMany)) {
     loop.run();
 }
 
+// A pan leaves a queue of tile requests in the order the tiles were first needed. Reordering them
+// in place brings the tiles of the current viewport to the front. Records the time until all of
+// them are loaded.
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(LoadOrderViewportComplete)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+
+    constexpr std::size_t concurrentRequests = 2;
+    constexpr std::size_t requestCount = 40;
+    constexpr std::size_t viewportStride = 5;
+    constexpr std::size_t viewportCount = requestCount / viewportStride;
+
+    fs->setProperty(MAX_CONCURRENT_REQUESTS_KEY, static_cast<uint64_t>(concurrentRequests));
+    fs->pause();
+
+    std::vector<Resource> resources;
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    std::size_t responses = 0;
+    std::size_t viewportResponses = 0;
+    std::size_t viewportCompleteAfter = 0;
+    std::chrono::steady_clock::duration viewportCompleteTime{};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < requestCount; ++i) {
+        resources.emplace_back(Resource::Tile, "http://127.0.0.1:3000/tile/" + util::toString(i));
+        resources.back().setLoadOrder(static_cast<float>(requestCount + i));
+        const bool inViewport = i % viewportStride == viewportStride - 1;
+        requests.push_back(fs->request(resources.back(), [&, inViewport](const Response& res) {
+            EXPECT_EQ(nullptr, res.error);
+            ++responses;
+            if (inViewport && ++viewportResponses == viewportCount) {
+                viewportCompleteAfter = responses;
+                viewportCompleteTime = std::chrono::steady_clock::now() - start;
+            }
+            if (responses == requestCount) {
+                loop.stop();
+            }
+        }));
+    }
+
+    // The viewport moved while all requests were waiting
+    for (std::size_t i = viewportStride - 1; i < requestCount; i += viewportStride) {
+        resources[i].setLoadOrder(static_cast<float>(i / viewportStride));
+    }
+
+    fs->resume();
+    loop.run();
+
+    // Only the requests which were sent before the reordering may finish ahead of the viewport
+    EXPECT_LE(viewportCompleteAfter, viewportCount + concurrentRequests);
+    const auto viewportCompleteMs = std::chrono::duration_cast<std::chrono::milliseconds>(viewportCompleteTime);
+    RecordProperty("viewportCompleteMs", static_cast<int>(viewportCompleteMs.count()));
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentRequests)) {
     util::RunLoop loop;
     std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
@@ -613,6 +669,18 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentRequests)) {
     ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint(), 10u);
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentOfflineRequests)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+
+    // Offline requests share the regular budget unless they are given one
+    ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_OFFLINE_REQUESTS_KEY).getUint(), 0u);
+
+    fs->setProperty(MAX_CONCURRENT_OFFLINE_REQUESTS_KEY, 4u);
+    ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_OFFLINE_REQUESTS_KEY).getUint(), 4u);
+    ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint(), 20u);
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RequestSameUrlMultipleTimes)) {
     util::RunLoop loop;
     std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
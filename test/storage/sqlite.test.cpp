@@ -30,6 +30,27 @@ TEST(SQLite, Statement) {
     ASSERT_EQ(query2.changes(), 1u);
 }
 
+TEST(SQLite, BlobView) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(":memory:", mapbox::sqlite::ReadWriteCreate);
+    db.exec("CREATE TABLE test (id INTEGER, data BLOB);");
+    db.exec("INSERT INTO test VALUES (1, x'00010203'), (2, NULL);");
+
+    mapbox::sqlite::Statement stmt{db, "SELECT data FROM test WHERE id = ?1;"};
+    {
+        mapbox::sqlite::Query query{stmt};
+        query.bind(1, 1);
+        ASSERT_TRUE(query.run());
+        EXPECT_EQ(std::string_view("\x00\x01\x02\x03", 4), query.get<std::string_view>(0));
+        EXPECT_EQ(std::string_view("\x00\x01\x02\x03", 4), query.get<std::optional<std::string_view>>(0));
+    }
+    {
+        mapbox::sqlite::Query query{stmt};
+        query.bind(1, 2);
+        ASSERT_TRUE(query.run());
+        EXPECT_FALSE(query.get<std::optional<std::string_view>>(0));
+    }
+}
+
 TEST(SQLite, TEST_REQUIRES_WRITE(TryOpen)) {
     FixtureLog log;
 
@@ -1,6 +1,7 @@
 #include <mbgl/style/expression/collator_expression.hpp>
 #include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/expression/format_section_override.hpp>
+#include <mbgl/style/expression/is_constant.hpp>
 #include <mbgl/style/layers/custom_layer_impl.hpp>
 #include <mbgl/test/util.hpp>
 
@@ -83,6 +84,16 @@ TEST(ExpressionDependencies, Distance) {
     EXPECT_EQ(Dependency::Feature, expression->dependencies);
 }
 
+TEST(ExpressionDependencies, FeatureState) {
+    const auto expression = createExpression(R"(["case", ["boolean", ["feature-state", "hover"], false], 2, 1])");
+    EXPECT_EQ(Dependency::Feature, expression->dependencies);
+    EXPECT_FALSE(isFeatureStateConstant(*expression));
+
+    // Reading properties or the ID does not depend on the state
+    EXPECT_TRUE(isFeatureStateConstant(*number(get("property"))));
+    EXPECT_TRUE(isFeatureStateConstant(*id()));
+}
+
 TEST(ExpressionDependencies, CustomLayer) {
     auto impl = makeMutable<CustomLayer::Impl>("", nullptr);
     EXPECT_EQ(Dependency::None, CustomLayerProperties{std::move(impl)}.getDependencies());
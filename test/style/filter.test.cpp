@@ -2,6 +2,8 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/test/stub_geometry_tile_feature.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 
 #include <mbgl/util/rapidjson.hpp>
 #include <rapidjson/writer.h>
@@ -9,6 +11,7 @@
 #include <mbgl/style/conversion/stringify.hpp>
 
 #include <mbgl/style/filter.hpp>
+#include <mbgl/style/filter_program.hpp>
 #include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/util/rapidjson.hpp>
@@ -384,3 +387,111 @@ TEST(Filter, LegacyExpressionInvalidType) {
     std::optional<Filter> result = conversion::convert<Filter>(conversion::Convertible(&value), error);
     EXPECT_FALSE(result);
 }
+
+TEST(Filter, CompiledMatchesExpression) {
+    const char* filters[] = {
+        R"(["==", "class", "park"])",
+        R"(["!=", "class", "park"])",
+        R"(["==", "rank", 2])",
+        R"(["in", "class", "park", "pitch", 2, true])",
+        R"(["!in", "class", "park", "pitch"])",
+        R"(["has", "name"])",
+        R"(["!has", "name"])",
+        R"(["<", "rank", 3])",
+        R"([">=", "rank", 3])",
+        R"(["<=", "name", "m"])",
+        R"(["==", "$type", "Polygon"])",
+        R"(["in", "$type", "Point", "LineString"])",
+        R"(["==", "$id", 1])",
+        R"(["in", "$id", 1, "two"])",
+        R"(["has", "$id"])",
+        R"(["all", ["==", "class", "park"], ["has", "name"]])",
+        R"(["any", ["==", "class", "park"], ["<", "rank", 3]])",
+        R"(["none", ["==", "class", "park"], ["<", "rank", 3]])",
+        R"(["==", ["get", "class"], "park"])",
+        R"(["!=", ["get", "class"], "park"])",
+        R"(["==", ["get", "missing"], null])",
+        R"(["==", "park", ["get", "class"]])",
+        R"(["in", ["get", "class"], ["literal", ["park", "pitch", 2]]])",
+        R"(["!", ["has", "name"]])",
+        R"(["==", ["geometry-type"], "Polygon"])",
+        R"(["!=", ["geometry-type"], "Point"])",
+        R"(["all", ["==", ["get", "class"], "park"], [">", ["get", "rank"], 1]])",
+        R"(["any", [">", ["get", "rank"], 1], ["in", ["get", "class"], ["literal", ["park"]]]])",
+        R"(["any", ["in", ["get", "list"], ["literal", ["park"]]], ["==", ["get", "class"], "park"]])",
+        R"(["all", ["!", ["<", ["get", "rank"], 2]], ["has", "rank"]])",
+    };
+
+    const std::vector<PropertyMap> properties = {
+        {},
+        {{"class", std::string("park")}},
+        {{"class", std::string("pitch")}, {"rank", int64_t(2)}, {"name", std::string("a")}},
+        {{"class", std::string("park")}, {"rank", uint64_t(4)}, {"name", std::string("z")}},
+        {{"class", int64_t(2)}, {"rank", std::string("2")}},
+        {{"class", true}, {"rank", 2.5}, {"missing", mapbox::feature::null_value}},
+        {{"list", std::vector<Value>{std::string("park")}}, {"rank", int64_t(0)}},
+    };
+    const std::vector<FeatureIdentifier> ids = {{}, {uint64_t(1)}, {std::string("two")}};
+    const FeatureType types[] = {FeatureType::Point, FeatureType::LineString, FeatureType::Polygon};
+
+    for (const char* json : filters) {
+        conversion::Error error;
+        std::optional<Filter> filter = conversion::convertJSON<Filter>(json, error);
+        ASSERT_TRUE(bool(filter)) << json << ": " << error.message;
+
+        for (const auto& props : properties) {
+            for (const auto& id : ids) {
+                for (const auto type : types) {
+                    StubGeometryTileFeature feature{id, type, {}, props};
+                    const expression::EvaluationContext context{0.0f, &feature};
+
+                    const auto result = (**filter->expression).evaluate(context);
+                    const bool expected = result && result->is<bool>() && result->get<bool>();
+                    EXPECT_EQ(expected, (*filter)(context)) << json;
+                }
+            }
+        }
+    }
+}
+
+TEST(Filter, CompiledFallback) {
+    const auto compile = [](const char* json) {
+        conversion::Error error;
+        std::optional<Filter> filter = conversion::convertJSON<Filter>(json, error);
+        EXPECT_TRUE(bool(filter));
+        return FilterProgram::compile(*filter->expression);
+    };
+
+    auto program = compile(R"(["all", ["==", "class", "park"], ["in", "$type", "Polygon"], ["!has", "name"]])");
+    ASSERT_TRUE(program);
+    EXPECT_EQ(0u, program->fallbackCount());
+
+    // Unsupported branches evaluate the expression tree
+    program = compile(R"(["any", ["==", ["get", "class"], "park"], ["<", ["get", "rank"], ["zoom"]]])");
+    ASSERT_TRUE(program);
+    EXPECT_EQ(1u, program->fallbackCount());
+
+    // An unsupported root isn't compiled at all
+    EXPECT_FALSE(compile(R"(["==", ["get", "two"], ["zoom"]])"));
+}
+
+TEST(Filter, CompiledKeyBinding) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
+    auto layer = data.getLayer("admin");
+    ASSERT_TRUE(layer);
+
+    conversion::Error error;
+    std::optional<Filter> filter = conversion::convertJSON<Filter>(
+        R"(["any", ["==", "disputed", "true"], ["!has", "disputed"], ["has", "not-a-key"]])", error);
+    ASSERT_TRUE(bool(filter));
+
+    const auto binding = filter->bind(*layer);
+    ASSERT_TRUE(binding);
+
+    // Looking properties up by key index gives the same results as looking them up by name
+    layer->visitFeatures([&](std::size_t, const GeometryTileFeature& feature) {
+        const expression::EvaluationContext context{0.0f, &feature};
+        EXPECT_EQ((*filter)(context), (*filter)(context, *binding));
+        return true;
+    });
+}
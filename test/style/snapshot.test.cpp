@@ -0,0 +1,165 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/parser.hpp>
+#include <mbgl/style/snapshot.hpp>
+#include <mbgl/style/snapshot_conversion.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+TEST(StyleSnapshot, RoundTrip) {
+    const std::string json = util::read_file("test/fixtures/resources/style_vector.json");
+    const std::string data = snapshot::encode(json);
+    EXPECT_TRUE(snapshot::isSnapshot(data));
+    EXPECT_FALSE(snapshot::isSnapshot(json));
+
+    JSDocument expected;
+    expected.Parse<0>(json.c_str());
+    JSDocument actual;
+    actual.Parse<0>(snapshot::decode(data).c_str());
+    ASSERT_FALSE(actual.HasParseError());
+    EXPECT_TRUE(expected == actual);
+}
+
+TEST(StyleSnapshot, Parse) {
+    const std::string json = util::read_file("test/fixtures/resources/style_vector.json");
+
+    Parser expected;
+    ASSERT_FALSE(expected.parse(json));
+    Parser actual;
+    ASSERT_FALSE(actual.parseSnapshot(snapshot::encode(json)));
+
+    EXPECT_EQ(expected.name, actual.name);
+    EXPECT_EQ(expected.latLng, actual.latLng);
+    EXPECT_EQ(expected.zoom, actual.zoom);
+    EXPECT_EQ(expected.glyphURL, actual.glyphURL);
+    EXPECT_EQ(expected.fontStacks(), actual.fontStacks());
+
+    ASSERT_EQ(expected.sources.size(), actual.sources.size());
+    for (std::size_t i = 0; i < expected.sources.size(); ++i) {
+        EXPECT_EQ(expected.sources[i]->getID(), actual.sources[i]->getID());
+        EXPECT_EQ(expected.sources[i]->getType(), actual.sources[i]->getType());
+    }
+
+    ASSERT_EQ(expected.layers.size(), actual.layers.size());
+    for (std::size_t i = 0; i < expected.layers.size(); ++i) {
+        EXPECT_EQ(expected.layers[i]->getID(), actual.layers[i]->getID());
+        EXPECT_TRUE(expected.layers[i]->serialize() == actual.layers[i]->serialize());
+    }
+}
+
+TEST(StyleSnapshot, SharedValues) {
+    const std::string filter = R"(["match", ["get", "class"], ["motorway", "trunk", "primary"], true, false])";
+    const std::string one = snapshot::encode(R"({"layers": [{"id": "a", "filter": )" + filter + "}]}");
+    const std::string two = snapshot::encode(R"({"layers": [{"id": "a", "filter": )" + filter + R"(},
+                                                            {"id": "b", "filter": )" + filter + "}]}");
+
+    // The second layer only adds its ID, an object and a reference
+    EXPECT_LT(two.size() - one.size(), 40u);
+}
+
+TEST(StyleSnapshot, SharedConversions) {
+    const std::string filter = R"(["match", ["get", "class"], ["motorway", "trunk"], true, false])";
+    const std::string color = R"(["interpolate", ["linear"], ["zoom"], 5, "red", 10, "blue"])";
+    const auto layer = [&](const std::string& id) {
+        return R"({"id": ")" + id + R"(", "type": "fill", "source": "vector", "source-layer": "roads", "filter": )" +
+               filter + R"(, "paint": {"fill-color": )" + color + "}}";
+    };
+    const std::string json = R"({"version": 8, "sources": {"vector": {"type": "vector", "tiles": ["a/{z}/{x}/{y}"]}},
+                                 "layers": [)" +
+                             layer("a") + ", " + layer("b") + "]}";
+
+    const auto expressions = [](const Parser& parser, std::size_t i) {
+        const auto& fill = static_cast<const FillLayer&>(*parser.layers.at(i));
+        return std::make_pair(fill.getFilter().expression->get(),
+                              &fill.getFillColor().asExpression().getExpression());
+    };
+
+    // The values shared by the layers of a snapshot are converted once
+    Parser actual;
+    ASSERT_FALSE(actual.parseSnapshot(snapshot::encode(json)));
+    ASSERT_EQ(2u, actual.layers.size());
+    EXPECT_EQ(expressions(actual, 0), expressions(actual, 1));
+
+    Parser expected;
+    ASSERT_FALSE(expected.parse(json));
+    EXPECT_NE(expressions(expected, 0).first, expressions(expected, 1).first);
+    for (std::size_t i = 0; i < expected.layers.size(); ++i) {
+        EXPECT_TRUE(expected.layers[i]->serialize() == actual.layers[i]->serialize());
+    }
+}
+
+TEST(StyleSnapshot, Invalid) {
+    EXPECT_THROW(snapshot::encode("{"), std::runtime_error);
+    EXPECT_THROW(snapshot::encode("[]"), std::runtime_error);
+
+    const std::string data = snapshot::encode(R"({"version": 8, "sources": {}, "layers": []})");
+    for (std::size_t size : {std::size_t(6), std::size_t(16), data.size() - 1}) {
+        EXPECT_TRUE(Parser().parseSnapshot(data.substr(0, size)));
+    }
+
+    std::string otherVersion = data;
+    otherVersion[7] = '9';
+    EXPECT_TRUE(Parser().parseSnapshot(otherVersion));
+    EXPECT_THROW(snapshot::decode(otherVersion), std::runtime_error);
+
+    // Only JSON is accepted where styles come from URLs
+    EXPECT_FALSE(Parser().parseSnapshot(data));
+    EXPECT_TRUE(Parser().parse(data));
+}
+
+TEST(StyleSnapshot, Depth) {
+    const auto nested = [](std::size_t depth) {
+        return R"({"metadata": )" + std::string(depth, '[') + std::string(depth, ']') + "}";
+    };
+    EXPECT_FALSE(Parser().parseSnapshot(snapshot::encode(nested(100))));
+
+    const std::string deep = snapshot::encode(nested(200));
+    EXPECT_TRUE(Parser().parseSnapshot(deep));
+    EXPECT_THROW(snapshot::decode(deep), std::runtime_error);
+}
+
+TEST(StyleSnapshot, Expansion) {
+    // Arrays each holding the previous one twice: 64 of them are a few hundred bytes, but expand to 2^64
+    // values. Written by hand, as encoding the JSON they stand for isn't possible.
+    std::string data = "MLNSTY01";
+    const auto append = [&](const uint32_t value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    append(0x01020304);
+    append(0); // The offset of the root, written last
+
+    std::size_t previous = data.size();
+    data.push_back(static_cast<char>(snapshot::Tag::Null));
+    for (int i = 0; i < 64; ++i) {
+        const std::size_t position = data.size();
+        data.push_back(static_cast<char>(snapshot::Tag::Array));
+        append(2);
+        append(static_cast<uint32_t>(position - previous));
+        append(static_cast<uint32_t>(position - previous));
+        previous = position;
+    }
+
+    const std::size_t name = data.size();
+    data.push_back(static_cast<char>(snapshot::Tag::String));
+    append(8);
+    data.append("metadata");
+    const std::size_t root = data.size();
+    data.push_back(static_cast<char>(snapshot::Tag::Object));
+    append(1);
+    append(static_cast<uint32_t>(root - name));
+    append(static_cast<uint32_t>(root - previous));
+    const auto rootOffset = static_cast<uint32_t>(root);
+    std::memcpy(data.data() + 12, &rootOffset, sizeof(rootOffset));
+
+    ASSERT_LT(data.size(), 1024u);
+    EXPECT_TRUE(Parser().parseSnapshot(data));
+    EXPECT_THROW(snapshot::decode(data), std::runtime_error);
+}
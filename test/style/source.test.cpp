@@ -77,7 +77,10 @@ public:
                 imageManager,
                 glyphManager,
                 0,
-                threadPool};
+                threadPool,
+                nullptr,
+                nullptr,
+                nullptr};
     };
 
     SourceTest()
@@ -1007,6 +1010,78 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
 
+TEST(Source, GeoJSONSourceUpdateByFeatureID) {
+    SourceTest test;
+    auto point = [](FeatureIdentifier id, double lng, double lat) {
+        GeoJSONFeature feature{mapbox::geometry::point<double>(lng, lat)};
+        feature.id = std::move(id);
+        return feature;
+    };
+
+    // Features are only kept by sources that opt in
+    GeoJSONSource defaultSource("default");
+    defaultSource.setGeoJSON(GeoJSON{GeoJSONData::Features{point(uint64_t(1), 0, 0)}});
+    EXPECT_FALSE(defaultSource.impl().getGeoJSON());
+    EXPECT_THROW(defaultSource.updateGeoJSON({}), std::runtime_error);
+
+    auto options = makeMutable<GeoJSONOptions>();
+    options->updatable = true;
+    GeoJSONSource source("source", std::move(options));
+
+    // Without IDs, features can't be matched
+    source.setGeoJSON(GeoJSON{GeoJSONFeature{mapbox::geometry::point<double>(0, 0)}});
+    EXPECT_THROW(source.updateGeoJSON({}), std::runtime_error);
+
+    source.setGeoJSON(GeoJSON{GeoJSONData::Features{
+        point(uint64_t(1), -90, 45), point(uint64_t(2), 90, 45), point(std::string("three"), 90, -45)}});
+    const auto initial = source.impl().getData().lock();
+    ASSERT_TRUE(initial);
+
+    GeoJSONSourceDiff diff;
+    diff.remove = {uint64_t(2)};
+    diff.add = {point(std::string("three"), 100, -45), point(uint64_t(4), -90, -45)};
+    source.updateGeoJSON(diff);
+
+    // Replaced features keep their position, new ones are appended
+    ASSERT_TRUE(source.impl().getGeoJSON());
+    const auto& features = source.impl().getGeoJSON()->get<GeoJSONData::Features>();
+    ASSERT_EQ(3u, features.size());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(1)), features[0].id);
+    EXPECT_EQ(FeatureIdentifier(std::string("three")), features[1].id);
+    EXPECT_EQ(mapbox::geometry::point<double>(100, -45), features[1].geometry.get<mapbox::geometry::point<double>>());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(4)), features[2].id);
+
+    // The removed feature, both versions of the replaced one and the new one
+    const auto* regions = source.impl().getChangedRegions(*initial);
+    ASSERT_TRUE(regions);
+    ASSERT_EQ(4u, regions->size());
+    EXPECT_DOUBLE_EQ(0.75, (*regions)[0].min.x);
+    EXPECT_GT(0.5, (*regions)[0].max.y);
+    EXPECT_DOUBLE_EQ(0.75, (*regions)[1].min.x);
+    EXPECT_LT(0.5, (*regions)[1].min.y);
+    EXPECT_DOUBLE_EQ(100.0 / 360.0 + 0.5, (*regions)[2].min.x);
+    EXPECT_DOUBLE_EQ(0.25, (*regions)[3].min.x);
+    EXPECT_LT(0.5, (*regions)[3].min.y);
+
+    // Changes accumulate across updates until the data is replaced
+    const auto intermediate = source.impl().getData().lock();
+    diff = {};
+    diff.remove = {uint64_t(1)};
+    source.updateGeoJSON(diff);
+    ASSERT_TRUE(source.impl().getChangedRegions(*intermediate));
+    EXPECT_EQ(1u, source.impl().getChangedRegions(*intermediate)->size());
+    ASSERT_TRUE(source.impl().getChangedRegions(*initial));
+    EXPECT_EQ(5u, source.impl().getChangedRegions(*initial)->size());
+
+    // Added features need an ID too
+    diff = {};
+    diff.add = {GeoJSONFeature{mapbox::geometry::point<double>(0, 0)}};
+    EXPECT_THROW(source.updateGeoJSON(diff), std::runtime_error);
+
+    source.setGeoJSON(GeoJSON{GeoJSONData::Features{}});
+    EXPECT_FALSE(source.impl().getChangedRegions(*initial));
+}
+
 TEST(Source, SetMaxParentOverscaleFactor) {
     SourceTest test;
     test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(8.0));
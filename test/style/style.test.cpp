@@ -165,3 +165,81 @@ TEST(Style, AddRemoveRemoveImage) {
     EXPECT_FALSE(!!style.getImage("two"));
     EXPECT_FALSE(!!style.getImage("four"));
 }
+
+namespace {
+
+std::string diffStyle(const std::string& lineColor, const std::string& roadsTiles, const std::string& extraLayer) {
+    return R"({"version": 8, "sources": {)"
+           R"("streets": {"type": "vector", "tiles": ["http://example.com/streets/{z}-{x}-{y}.pbf"]},)"
+           R"("roads": {"type": "vector", "tiles": [")" +
+           roadsTiles +
+           R"("]}}, "layers": [)"
+           R"({"id": "street", "type": "line", "source": "streets", "source-layer": "street",)"
+           R"("paint": {"line-color": ")" +
+           lineColor +
+           R"("}},)"
+           R"({"id": "road", "type": "line", "source": "roads", "source-layer": "road"})" +
+           extraLayer + "]}";
+}
+
+} // namespace
+
+TEST(Style, LoadDiff) {
+    util::RunLoop loop;
+    auto fileSource = std::make_shared<StubFileSource>();
+    Style::Impl style{fileSource, 1.0, {Scheduler::GetBackground(), {}}};
+
+    const std::string roads = "http://example.com/roads/{z}-{x}-{y}.pbf";
+    const std::string water = R"(, {"id": "water", "type": "fill", "source": "streets", "source-layer": "water"})";
+    style.loadJSON(diffStyle("#ff0000", roads, water));
+    const Source* streets = style.getSource("streets");
+    const Layer* street = style.getLayer("street");
+    const Layer* road = style.getLayer("road");
+    ASSERT_NE(nullptr, style.getLayer("water"));
+
+    // A paint change keeps the layers and the sources
+    style.loadJSON(diffStyle("#0000ff", roads, water), Style::LoadMode::Diff);
+    EXPECT_EQ(streets, style.getSource("streets"));
+    EXPECT_EQ(street, style.getLayer("street"));
+    EXPECT_EQ(road, style.getLayer("road"));
+    EXPECT_EQ(Color::blue(), static_cast<const LineLayer*>(street)->getLineColor().asConstant());
+    EXPECT_TRUE(style.isLoaded());
+
+    // A layer of another type is replaced, and a removed one is dropped
+    const Source* roadsSource = style.getSource("roads");
+    const std::string waterLine = R"(, {"id": "water", "type": "line", "source": "streets", "source-layer": "water"})";
+    style.loadJSON(diffStyle("#0000ff", roads, waterLine), Style::LoadMode::Diff);
+    ASSERT_NE(nullptr, style.getLayer("water"));
+    EXPECT_EQ("line", std::string(style.getLayer("water")->getTypeInfo()->type));
+    EXPECT_EQ(roadsSource, style.getSource("roads"));
+
+    style.loadJSON(diffStyle("#0000ff", roads, ""), Style::LoadMode::Diff);
+    EXPECT_EQ(nullptr, style.getLayer("water"));
+    EXPECT_EQ(2u, style.getLayers().size());
+
+    // Only the source with a new definition is replaced
+    const std::string roadsV2 = "http://example.com/roads/v2/{z}-{x}-{y}.pbf";
+    style.loadJSON(diffStyle("#0000ff", roadsV2, ""), Style::LoadMode::Diff);
+    EXPECT_EQ(streets, style.getSource("streets"));
+    const auto* roadsV2Source = static_cast<const VectorSource*>(style.getSource("roads"));
+    EXPECT_EQ(roadsV2, roadsV2Source->getURLOrTileset().get<Tileset>().tiles.at(0));
+    EXPECT_EQ(road, style.getLayer("road"));
+    EXPECT_EQ(2u, style.getSourceImpls()->size());
+}
+
+TEST(Style, LoadDiffChangedSource) {
+    util::RunLoop loop;
+    auto fileSource = std::make_shared<StubFileSource>();
+    Style style{fileSource, 1.0, {Scheduler::GetBackground(), {}}};
+    const Style& constStyle = style;
+
+    const std::string json = diffStyle("#ff0000", "http://example.com/roads/{z}-{x}-{y}.pbf", "");
+    style.loadJSON(json);
+    const Source* streets = constStyle.getSource("streets");
+
+    // Changes made through the API aren't in the style JSON, so the source is loaded again
+    style.getSource("roads")->setVolatile(true);
+    style.loadJSON(json, Style::LoadMode::Diff);
+    EXPECT_EQ(streets, constStyle.getSource("streets"));
+    EXPECT_FALSE(constStyle.getSource("roads")->isVolatile());
+}
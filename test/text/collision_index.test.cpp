@@ -0,0 +1,204 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/anchor.hpp>
+#include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/text/collision_index.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/mat4.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+const UnwrappedTileID tileID{4, 8, 8};
+const float fontSize = 24.0f;
+
+// A label of 120px along a horizontal line in the upper left quarter of the tile
+struct LineLabel {
+    LineLabel()
+        : anchor(2048.0f, 1024.0f, 0.0f, 0u),
+          line({{0, 1024}, {4096, 1024}}),
+          feature(line,
+                  anchor,
+                  shaping(),
+                  util::EXTENT / util::tileSize_D,
+                  0.0f,
+                  style::SymbolPlacementType::Line,
+                  RefIndexedSubfeature(0, layerName, layerName, 0),
+                  1.0f,
+                  0.0f),
+          symbol(anchor.point,
+                 0,
+                 fontSize,
+                 fontSize,
+                 {{0.0f, 0.0f}},
+                 WritingModeType::Horizontal,
+                 line,
+                 SymbolLayout::calculateTileDistances(line, anchor)) {
+        symbol.glyphOffsets = {-55.0f, -33.0f, -11.0f, 11.0f, 33.0f, 55.0f};
+    }
+
+    static Shaping shaping() {
+        Shaping result(0.0f, 0.0f, WritingModeType::Horizontal);
+        result.top = -12.0f;
+        result.bottom = 12.0f;
+        result.left = -60.0f;
+        result.right = 60.0f;
+        return result;
+    }
+
+    const std::string layerName = "labels";
+    Anchor anchor;
+    GeometryCoordinates line;
+    CollisionFeature feature;
+    PlacedSymbol symbol;
+};
+
+TransformState makeState(const LatLng& center, double pitch = 0.0) {
+    TransformState state;
+    state.setSize({512, 512});
+    state.setLatLngZoom(center, tileID.canonical.z);
+    state.setPitch(pitch);
+    return state;
+}
+
+mat4 tileMatrix(const TransformState& state) {
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+    mat4 matrix;
+    state.matrixFor(matrix, tileID);
+    matrix::multiply(matrix, projMatrix, matrix);
+    return matrix;
+}
+
+struct Placed {
+    std::pair<bool, bool> result;
+    std::vector<ProjectedCollisionBox> circles;
+};
+
+// Places the label with placeFeature(), as a placement without reusable projections does
+Placed placeFresh(CollisionIndex& index, const LineLabel& label, const TransformState& state) {
+    const mat4 posMatrix = tileMatrix(state);
+    const float pixelsToTileUnits = util::EXTENT / util::tileSize_D;
+    const mat4 labelPlaneMatrix = getLabelPlaneMatrix(posMatrix, false, false, state, pixelsToTileUnits);
+    Placed placed;
+    placed.result = index.placeFeature(label.feature,
+                                       {0.0f, 0.0f},
+                                       posMatrix,
+                                       labelPlaneMatrix,
+                                       1.0f / pixelsToTileUnits,
+                                       label.symbol,
+                                       1.0f,
+                                       fontSize,
+                                       false,
+                                       false,
+                                       false,
+                                       std::nullopt,
+                                       std::nullopt,
+                                       placed.circles);
+    return placed;
+}
+
+CollisionIndex::ProjectedLineFeature project(const CollisionIndex& index,
+                                             const LineLabel& label,
+                                             const TransformState& state) {
+    const mat4 posMatrix = tileMatrix(state);
+    const float pixelsToTileUnits = util::EXTENT / util::tileSize_D;
+    const mat4 labelPlaneMatrix = getLabelPlaneMatrix(posMatrix, false, false, state, pixelsToTileUnits);
+    return index.projectLineFeature(
+        label.feature, posMatrix, labelPlaneMatrix, 1.0f / pixelsToTileUnits, label.symbol, 1.0f, fontSize, false);
+}
+
+Placed placeProjected(CollisionIndex& index, const CollisionIndex::ProjectedLineFeature& projected) {
+    Placed placed;
+    placed.result = index.placeProjectedLineFeature(
+        projected, false, false, std::nullopt, std::nullopt, placed.circles);
+    return placed;
+}
+
+void expectSamePlacement(const Placed& expected, const Placed& actual) {
+    EXPECT_EQ(expected.result, actual.result);
+    ASSERT_EQ(expected.circles.size(), actual.circles.size());
+    for (std::size_t i = 0; i < expected.circles.size(); ++i) {
+        ASSERT_EQ(expected.circles[i].isCircle(), actual.circles[i].isCircle()) << "circle " << i;
+        if (expected.circles[i].isCircle()) {
+            const auto& a = expected.circles[i].circle();
+            const auto& b = actual.circles[i].circle();
+            EXPECT_NEAR(a.center.x, b.center.x, 1e-3) << "circle " << i;
+            EXPECT_NEAR(a.center.y, b.center.y, 1e-3) << "circle " << i;
+            EXPECT_NEAR(a.radius, b.radius, 1e-3) << "circle " << i;
+        }
+    }
+}
+
+} // namespace
+
+TEST(CollisionIndex, ViewportShift) {
+    const auto state = makeState({0.0, 0.0});
+    const auto panned = makeState({0.5, -0.5});
+    const auto pitched = makeState({0.0, 0.0}, 0.5);
+
+    const auto none = CollisionIndex::viewportShift(tileMatrix(state), tileMatrix(state), state.getSize());
+    ASSERT_TRUE(none);
+    EXPECT_EQ(Point<float>(0.0f, 0.0f), *none);
+
+    const auto shift = CollisionIndex::viewportShift(tileMatrix(state), tileMatrix(panned), state.getSize());
+    ASSERT_TRUE(shift);
+    vec4 before = {{2048, 1024, 0, 1}};
+    vec4 after = before;
+    matrix::transformMat4(before, before, tileMatrix(state));
+    matrix::transformMat4(after, after, tileMatrix(panned));
+    EXPECT_NEAR((after[0] / after[3] - before[0] / before[3]) / 2 * 512, shift->x, 1e-3);
+    EXPECT_NEAR(-(after[1] / after[3] - before[1] / before[3]) / 2 * 512, shift->y, 1e-3);
+
+    // Perspective over the tile plane moves points by different amounts
+    EXPECT_FALSE(CollisionIndex::viewportShift(
+        tileMatrix(pitched), tileMatrix(makeState({0.5, -0.5}, 0.5)), pitched.getSize()));
+}
+
+TEST(CollisionIndex, ProjectedLineFeatureSameCamera) {
+    const LineLabel label;
+    const auto state = makeState({0.0, 0.0});
+
+    CollisionIndex fresh(state, MapMode::Continuous);
+    const auto expected = placeFresh(fresh, label, state);
+    ASSERT_TRUE(expected.result.first);
+
+    // Reused unchanged by the next placement, the projection places exactly like placeFeature()
+    const auto shift = CollisionIndex::viewportShift(tileMatrix(state), tileMatrix(state), state.getSize());
+    ASSERT_TRUE(shift);
+    CollisionIndex reused(state, MapMode::Continuous);
+    expectSamePlacement(expected, placeProjected(reused, project(reused, label, state).translated(*shift)));
+}
+
+TEST(CollisionIndex, ProjectedLineFeaturePan) {
+    const LineLabel label;
+    const auto state = makeState({0.0, 0.0});
+    const auto panned = makeState({0.5, -0.5});
+
+    CollisionIndex fresh(panned, MapMode::Continuous);
+    const auto expected = placeFresh(fresh, label, panned);
+    ASSERT_TRUE(expected.result.first);
+
+    // Projected for the previous view and translated by the pan, as a placement reusing them does
+    const auto shift = CollisionIndex::viewportShift(tileMatrix(state), tileMatrix(panned), state.getSize());
+    ASSERT_TRUE(shift);
+    ASSERT_NE(Point<float>(0.0f, 0.0f), *shift);
+    const CollisionIndex previous(state, MapMode::Continuous);
+    CollisionIndex reused(panned, MapMode::Continuous);
+    expectSamePlacement(expected, placeProjected(reused, project(previous, label, state).translated(*shift)));
+
+    // A label colliding with the first one is rejected either way
+    fresh.insertFeature(label.feature, expected.circles, false, 1, 0);
+    reused.insertFeature(label.feature, expected.circles, false, 1, 0);
+    const auto secondFresh = placeFresh(fresh, label, panned);
+    const auto secondReused = placeProjected(reused, project(previous, label, state).translated(*shift));
+    EXPECT_FALSE(secondFresh.result.first);
+    EXPECT_EQ(secondFresh.result, secondReused.result);
+}
@@ -0,0 +1,176 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// The cache is shared by the whole process, each test starts with it empty and leaves it as it found it
+class ShapingCacheTest : public ::testing::Test {
+protected:
+    ShapingCacheTest() {
+        cache.setMaxEntries(ShapingCache::defaultMaxEntries);
+        cache.clear();
+        metrics.width = 18;
+        metrics.height = 18;
+        metrics.advance = 21;
+    }
+
+    ~ShapingCacheTest() override {
+        cache.setMaxEntries(ShapingCache::defaultMaxEntries);
+        cache.clear();
+    }
+
+    Shaping shape(const TaggedString& string, const GlyphPositions& glyphPositions, const GlyphMap& glyphMap = {}) {
+        return cache.getShaping(string,
+                                10 * util::ONE_EM, // maxWidth
+                                util::ONE_EM,      // lineHeight
+                                style::SymbolAnchorType::Center,
+                                style::TextJustifyType::Center,
+                                0,              // spacing
+                                {{0.0f, 0.0f}}, // translate
+                                WritingModeType::Horizontal,
+                                bidi,
+                                glyphMap,
+                                glyphPositions,
+                                {},
+                                16.0f,
+                                16.0f,
+                                /*allowVerticalPlacement*/ false);
+    }
+
+    GlyphPositions positionsAt(uint16_t x, GlyphMetrics glyphMetrics) {
+        GlyphPosition position{{x, 0, 18, 18}, glyphMetrics};
+        return {{FontStackHasher()(fontStack), {{u'a', position}, {u'b', position}}}};
+    }
+
+    // The glyphs of the tile, where those not in `loaded` failed to load
+    GlyphMap glyphsOf(const std::u16string& loaded) { return glyphsOf(loaded, metrics); }
+
+    GlyphMap glyphsOf(const std::u16string& loaded, const GlyphMetrics& glyphMetrics) {
+        Glyphs glyphs;
+        for (const char16_t id : {u'a', u'b'}) {
+            glyphs[id] = std::nullopt;
+        }
+        for (const char16_t id : loaded) {
+            Glyph glyph;
+            glyph.id = id;
+            glyph.metrics = glyphMetrics;
+            glyphs[id] = Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph)));
+        }
+        return {{FontStackHasher()(fontStack), std::move(glyphs)}};
+    }
+
+    ShapingCache& cache = ShapingCache::getInstance();
+    BiDi bidi;
+    const FontStack fontStack{"font-stack"};
+    GlyphMetrics metrics;
+};
+
+} // namespace
+
+TEST_F(ShapingCacheTest, ReusesShapingWithTileGlyphPositions) {
+    const TaggedString string(u"ab ba", {1.0, fontStack});
+
+    const Shaping first = shape(string, positionsAt(0, metrics));
+    ASSERT_EQ(1u, first.positionedLines.size());
+    ASSERT_EQ(4u, first.positionedLines[0].positionedGlyphs.size());
+
+    // The same text in another tile has its glyphs elsewhere in the atlas
+    const Shaping second = shape(string, positionsAt(32, metrics));
+    ASSERT_EQ(4u, second.positionedLines[0].positionedGlyphs.size());
+    for (std::size_t i = 0; i < 4; ++i) {
+        const auto& a = first.positionedLines[0].positionedGlyphs[i];
+        const auto& b = second.positionedLines[0].positionedGlyphs[i];
+        EXPECT_EQ(a.glyph, b.glyph);
+        EXPECT_EQ(a.x, b.x);
+        EXPECT_EQ(0, a.rect.x);
+        EXPECT_EQ(32, b.rect.x);
+    }
+    EXPECT_EQ(first.left, second.left);
+    EXPECT_EQ(first.right, second.right);
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.entries);
+}
+
+TEST_F(ShapingCacheTest, DifferentMetrics) {
+    const TaggedString string(u"ab", {1.0, fontStack});
+
+    const Shaping first = shape(string, positionsAt(0, metrics));
+
+    // Same font stack, but different glyphs, as with another glyph URL
+    GlyphMetrics wide = metrics;
+    wide.advance = 30;
+    const Shaping second = shape(string, positionsAt(0, wide));
+    EXPECT_LT(second.left, first.left);
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+}
+
+TEST_F(ShapingCacheTest, SameFontStackDifferentGlyphs) {
+    const TaggedString string(u"ab", {1.0, fontStack});
+
+    // Two styles with the same font stack names, whose glyphs come from different glyph URLs
+    GlyphMetrics narrow = metrics;
+    narrow.advance = 12;
+    const Shaping first = shape(string, positionsAt(0, metrics), glyphsOf(u"ab"));
+    const Shaping second = shape(string, positionsAt(0, narrow), glyphsOf(u"ab", narrow));
+    EXPECT_GT(second.left, first.left);
+    ASSERT_EQ(1u, second.positionedLines.size());
+    const auto& glyphs = second.positionedLines[0].positionedGlyphs;
+    ASSERT_EQ(2u, glyphs.size());
+    EXPECT_EQ(12.0f, glyphs[1].x - glyphs[0].x);
+
+    EXPECT_EQ(0u, cache.getStats().hits);
+
+    // Tiles of either style are given the shaping with their own glyphs
+    EXPECT_EQ(second.left, shape(string, positionsAt(32, narrow), glyphsOf(u"ab", narrow)).left);
+    EXPECT_EQ(1u, cache.getStats().hits);
+    EXPECT_EQ(first.left, shape(string, positionsAt(32, metrics), glyphsOf(u"ab")).left);
+    EXPECT_EQ(second.left, shape(string, positionsAt(0, narrow), glyphsOf(u"ab", narrow)).left);
+}
+
+TEST_F(ShapingCacheTest, MissingGlyphs) {
+    const TaggedString string(u"ab", {1.0, fontStack});
+
+    // A tile where the glyph of "b" didn't load, so it's left out of the shaping and the atlas
+    GlyphPosition position{{0, 0, 18, 18}, metrics};
+    const GlyphPositions partial{{FontStackHasher()(fontStack), {{u'a', position}}}};
+    const Shaping first = shape(string, partial, glyphsOf(u"a"));
+    ASSERT_EQ(1u, first.positionedLines.size());
+    EXPECT_EQ(1u, first.positionedLines[0].positionedGlyphs.size());
+
+    // A tile with every glyph isn't given the shaping without "b"
+    const Shaping second = shape(string, positionsAt(0, metrics), glyphsOf(u"ab"));
+    ASSERT_EQ(1u, second.positionedLines.size());
+    EXPECT_EQ(2u, second.positionedLines[0].positionedGlyphs.size());
+
+    // Nor is a tile where the glyph of "b" is missing given the shaping with it
+    const Shaping third = shape(string, partial, glyphsOf(u"a"));
+    EXPECT_EQ(1u, third.positionedLines[0].positionedGlyphs.size());
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+}
+
+TEST_F(ShapingCacheTest, Disabled) {
+    const TaggedString string(u"ab", {1.0, fontStack});
+
+    cache.setMaxEntries(0);
+    shape(string, positionsAt(0, metrics));
+    shape(string, positionsAt(0, metrics));
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(0u, stats.entries);
+}
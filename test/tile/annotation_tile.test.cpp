@@ -0,0 +1,164 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/fake_file_source.hpp>
+#include <mbgl/test/stub_tile_observer.hpp>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <set>
+
+using namespace mbgl;
+
+class AnnotationTileTest {
+public:
+    util::SimpleIdentity uniqueID;
+    std::shared_ptr<FileSource> fileSource = std::make_shared<FakeFileSource>();
+    TransformState transformState;
+    util::RunLoop loop;
+    AnnotationManager annotationManager{style};
+    std::shared_ptr<ImageManager> imageManager = std::make_shared<ImageManager>();
+    std::shared_ptr<GlyphManager> glyphManager = std::make_shared<GlyphManager>();
+    TileParameters tileParameters;
+    style::Style style;
+    StubTileObserver observer;
+
+    AnnotationTileTest()
+        : tileParameters{1.0,
+                         MapDebugOptions(),
+                         transformState,
+                         fileSource,
+                         MapMode::Continuous,
+                         annotationManager.makeWeakPtr(),
+                         imageManager,
+                         glyphManager,
+                         0,
+                         {Scheduler::GetBackground(), uniqueID},
+                         nullptr,
+                         nullptr,
+                         nullptr},
+          style{fileSource, 1, tileParameters.threadPool} {}
+
+    // A tile parsing its annotations without any style layers, which is enough for its data to be queried
+    std::unique_ptr<AnnotationTile> makeTile(uint8_t z, uint32_t x, uint32_t y) {
+        auto tile = std::make_unique<AnnotationTile>(OverscaledTileID(z, x, y), tileParameters, &observer);
+        tile->setLayers({});
+        // The tile is given its data when created, and is complete once a worker has parsed it
+        EXPECT_FALSE(tile->isComplete());
+        return tile;
+    }
+
+    void load(const std::vector<AnnotationTile*>& tiles) {
+        while (std::any_of(tiles.begin(), tiles.end(), [](const auto* tile) { return !tile->isComplete(); })) {
+            loop.runOnce();
+        }
+    }
+
+    // Updates the tiles, and returns the ones that were given new data to parse. Giving a tile data marks it
+    // as pending right away, so those are the tiles that aren't complete afterwards.
+    std::set<const Tile*> update(const std::vector<AnnotationTile*>& tiles) {
+        EXPECT_TRUE(std::all_of(tiles.begin(), tiles.end(), [](const auto* tile) { return tile->isComplete(); }));
+        annotationManager.updateData();
+        std::set<const Tile*> refreshed;
+        for (const auto* tile : tiles) {
+            if (!tile->isComplete()) {
+                refreshed.insert(tile);
+            }
+        }
+        load(tiles);
+        return refreshed;
+    }
+};
+
+namespace {
+
+// The number of features of the shape annotation in the data of the tile
+std::size_t featureCount(AnnotationTile& tile, AnnotationID id) {
+    std::vector<Feature> features;
+    const std::vector<std::string> sourceLayers{AnnotationManager::ShapeLayerID + util::toString(id)};
+    tile.querySourceFeatures(features, {sourceLayers});
+    return features.size();
+}
+
+} // namespace
+
+// At z4, the tiles of row 7 span the latitudes 0 to 21.94 and those of row 6 the latitudes 21.94 to 40.98. Each
+// tile is 22.5 degrees wide, and the buffer of the shapes adds 0.7 degrees to each side.
+
+TEST(AnnotationTile, RefreshesOverlappingTiles) {
+    AnnotationTileTest test;
+
+    const auto other = test.annotationManager.addAnnotation(LineAnnotation{LineString<double>{{95, 10}, {105, 10}}});
+
+    auto center = test.makeTile(4, 8, 7);
+    auto east = test.makeTile(4, 9, 7);
+    auto north = test.makeTile(4, 8, 6);
+    auto distant = test.makeTile(4, 12, 7);
+    const std::vector<AnnotationTile*> tiles{center.get(), east.get(), north.get(), distant.get()};
+    test.load(tiles);
+    // The data of tiles without style layers can be queried
+    ASSERT_EQ(1u, featureCount(*distant, other));
+    ASSERT_EQ(0u, featureCount(*center, other));
+
+    // The shape ends within the buffer of the tile to the east, which shows it too
+    const auto id = test.annotationManager.addAnnotation(LineAnnotation{LineString<double>{{1, 10}, {22, 10}}});
+    EXPECT_EQ((std::set<const Tile*>{center.get(), east.get()}), test.update(tiles));
+    EXPECT_EQ(1u, featureCount(*center, id));
+    EXPECT_EQ(1u, featureCount(*east, id));
+    EXPECT_EQ(0u, featureCount(*north, id));
+
+    // Both the tiles the shape left and the one it moved to are refreshed
+    test.annotationManager.updateAnnotation(id, LineAnnotation{LineString<double>{{1, 30}, {10, 30}}});
+    EXPECT_EQ((std::set<const Tile*>{center.get(), east.get(), north.get()}), test.update(tiles));
+    EXPECT_EQ(0u, featureCount(*center, id));
+    EXPECT_EQ(0u, featureCount(*east, id));
+    EXPECT_EQ(1u, featureCount(*north, id));
+
+    test.annotationManager.removeAnnotation(id);
+    EXPECT_EQ((std::set<const Tile*>{north.get()}), test.update(tiles));
+    EXPECT_EQ(0u, featureCount(*north, id));
+
+    // The tile away from the changes was never given new data, and kept its own
+    EXPECT_EQ(1u, featureCount(*distant, other));
+    EXPECT_EQ(0u, featureCount(*distant, id));
+}
+
+TEST(AnnotationTile, RefreshesWorldCopies) {
+    AnnotationTileTest test;
+
+    auto west = test.makeTile(4, 0, 7);
+    auto east = test.makeTile(4, 15, 7);
+    auto center = test.makeTile(4, 8, 7);
+    const std::vector<AnnotationTile*> tiles{west.get(), east.get(), center.get()};
+    test.load(tiles);
+
+    // The part of the shape beyond the antimeridian is shown in the first tile of the row
+    const auto crossing = test.annotationManager.addAnnotation(
+        LineAnnotation{LineString<double>{{170, 10}, {190, 10}}});
+    EXPECT_EQ((std::set<const Tile*>{west.get(), east.get()}), test.update(tiles));
+    EXPECT_EQ(1u, featureCount(*west, crossing));
+    EXPECT_EQ(1u, featureCount(*east, crossing));
+    EXPECT_EQ(0u, featureCount(*center, crossing));
+
+    // The shape starts within the buffer of the last tile of the row, across the antimeridian
+    const auto wrapped = test.annotationManager.addAnnotation(
+        LineAnnotation{LineString<double>{{-179.6, 5}, {-170, 5}}});
+    EXPECT_EQ((std::set<const Tile*>{west.get(), east.get()}), test.update(tiles));
+    EXPECT_EQ(1u, featureCount(*west, wrapped));
+    EXPECT_EQ(1u, featureCount(*east, wrapped));
+
+    test.annotationManager.removeAnnotation(crossing);
+    EXPECT_EQ((std::set<const Tile*>{west.get(), east.get()}), test.update(tiles));
+    EXPECT_EQ(0u, featureCount(*west, crossing));
+    EXPECT_EQ(0u, featureCount(*east, crossing));
+    EXPECT_EQ(1u, featureCount(*east, wrapped));
+}
@@ -43,7 +43,10 @@ public:
                          imageManager,
                          glyphManager,
                          0,
-                         {Scheduler::GetBackground(), uniqueID}},
+                         {Scheduler::GetBackground(), uniqueID},
+                         nullptr,
+                         nullptr,
+                         nullptr},
           style{fileSource, 1, tileParameters.threadPool} {}
 };
 
@@ -142,3 +145,36 @@ TEST(GeoJSONTile, Issue9927) {
     ASSERT_TRUE(tile.isRenderable());
     ASSERT_TRUE(tile.layerPropertiesUpdated(layerProperties));
 }
+
+TEST(GeoJSONTile, RetainData) {
+    GeoJSONTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(0, 0)});
+    auto data = std::make_shared<FakeGeoJSONData>(features);
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, data);
+
+    Immutable<LayerProperties> layerProperties = makeMutable<CircleLayerProperties>(
+        staticImmutableCast<CircleLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+    tile.setLayers(layers);
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // Data with the same features in this tile doesn't trigger a reload
+    tile.retainData(std::make_shared<FakeGeoJSONData>(features));
+    EXPECT_TRUE(tile.isComplete());
+    EXPECT_TRUE(tile.isRenderable());
+
+    // A pending load still completes after the data is switched
+    tile.updateData(data, true);
+    tile.retainData(std::make_shared<FakeGeoJSONData>(features));
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+    EXPECT_TRUE(tile.layerPropertiesUpdated(layerProperties));
+}
@@ -0,0 +1,175 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/layout_cache.hpp>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/test/vector_tile_test.hpp>
+#include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+LayoutCache::Key makeKey(const OverscaledTileID& id, const LayoutCache::Layers& layers) {
+    return {"source", id, MapMode::Continuous, 1.0f, false, LayoutCache::hashLayers(layers)};
+}
+
+LayoutCache::Entry makeEntry(const LayoutCache::Layers& layers, std::shared_ptr<const std::string> data) {
+    return {layers,
+            std::move(data),
+            {},
+            std::make_shared<GeometryTile::LayoutResult>(
+                mbgl::unordered_map<std::string, LayerRenderData>{}, nullptr, std::nullopt, ImageAtlas{}),
+            std::make_shared<TileAtlasTextures>()};
+}
+
+} // namespace
+
+TEST(LayoutCache, TakeMatchingEntry) {
+    VectorTileTest test;
+    LayoutCache cache(test.threadPool, 1000);
+
+    LineLayer layer("line", "source");
+    const LayoutCache::Layers layers{layer.baseImpl};
+    const auto data = std::make_shared<const std::string>(100, 'a');
+    const OverscaledTileID id(0, 0, 0);
+
+    EXPECT_FALSE(cache.take(makeKey(id, layers), layers, *data, {}));
+    cache.add(makeKey(id, layers), makeEntry(layers, data));
+    EXPECT_EQ(1u, cache.getStats().entries);
+    EXPECT_EQ(100u, cache.getStats().bytes);
+
+    // Equal data found through another string is a hit, and the entry is handed over
+    const auto entry = cache.take(makeKey(id, layers), layers, std::string(100, 'a'), {});
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(data, entry->data);
+    EXPECT_FALSE(cache.take(makeKey(id, layers), layers, *data, {}));
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(0u, stats.entries);
+    EXPECT_EQ(0u, stats.bytes);
+}
+
+TEST(LayoutCache, RejectsChangedInputs) {
+    VectorTileTest test;
+    LayoutCache cache(test.threadPool, 1000);
+
+    LineLayer layer("line", "source");
+    const LayoutCache::Layers layers{layer.baseImpl};
+    const auto data = std::make_shared<const std::string>(100, 'a');
+    const OverscaledTileID id(0, 0, 0);
+
+    // Other tile
+    cache.add(makeKey(id, layers), makeEntry(layers, data));
+    EXPECT_FALSE(cache.take(makeKey(OverscaledTileID(1, 0, 0), layers), layers, *data, {}));
+    EXPECT_EQ(1u, cache.getStats().entries);
+
+    // Changed data or images drop the entry
+    EXPECT_FALSE(cache.take(makeKey(id, layers), layers, std::string(100, 'b'), {}));
+    EXPECT_EQ(0u, cache.getStats().entries);
+    cache.add(makeKey(id, layers), makeEntry(layers, data));
+    EXPECT_FALSE(cache.take(makeKey(id, layers), layers, *data, {"image"}));
+    EXPECT_EQ(0u, cache.getStats().entries);
+
+    // A changed layer has a new implementation
+    cache.add(makeKey(id, layers), makeEntry(layers, data));
+    layer.setLineWidth(2.0f);
+    const LayoutCache::Layers changed{layer.baseImpl};
+    EXPECT_FALSE(cache.take(makeKey(id, changed), changed, *data, {}));
+
+    cache.remove("source");
+    EXPECT_EQ(0u, cache.getStats().entries);
+    EXPECT_EQ(0u, cache.getStats().hits);
+}
+
+TEST(LayoutCache, EvictsLeastRecent) {
+    VectorTileTest test;
+    LayoutCache cache(test.threadPool, 250);
+
+    LineLayer layer("line", "source");
+    const LayoutCache::Layers layers{layer.baseImpl};
+    const auto data = std::make_shared<const std::string>(100, 'a');
+
+    for (uint32_t x = 0; x < 3; ++x) {
+        cache.add(makeKey(OverscaledTileID(2, x, 0), layers), makeEntry(layers, data));
+    }
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(2u, stats.entries);
+    EXPECT_EQ(200u, stats.bytes);
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_FALSE(cache.take(makeKey(OverscaledTileID(2, 0, 0), layers), layers, *data, {}));
+    EXPECT_TRUE(cache.take(makeKey(OverscaledTileID(2, 2, 0), layers), layers, *data, {}));
+
+    // Entries larger than the whole budget are not kept
+    cache.add(makeKey(OverscaledTileID(2, 3, 0), layers),
+              makeEntry(layers, std::make_shared<const std::string>(300, 'a')));
+    EXPECT_EQ(1u, cache.getStats().entries);
+
+    cache.setMaxSize(0);
+    stats = cache.getStats();
+    EXPECT_EQ(0u, stats.entries);
+    EXPECT_EQ(0u, stats.bytes);
+}
+
+TEST(LayoutCache, ReusesVectorTileLayout) {
+    VectorTileTest test;
+    const auto cache = std::make_shared<LayoutCache>(test.threadPool, 64 * 1024 * 1024);
+    const TileParameters parameters{test.tileParameters.pixelRatio,
+                                    test.tileParameters.debugOptions,
+                                    test.tileParameters.transformState,
+                                    test.tileParameters.fileSource,
+                                    test.tileParameters.mode,
+                                    test.tileParameters.annotationManager,
+                                    test.tileParameters.imageManager,
+                                    test.tileParameters.glyphManager,
+                                    test.tileParameters.prefetchZoomDelta,
+                                    test.tileParameters.threadPool,
+                                    cache,
+                                    nullptr,
+                                    nullptr};
+
+    LineLayer layer("admin", "source");
+    layer.setSourceLayer("admin");
+    const std::vector<Immutable<LayerProperties>> layers{
+        makeMutable<LineLayerProperties>(staticImmutableCast<LineLayer::Impl>(layer.baseImpl))};
+    const auto data = std::make_shared<const std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt"));
+
+    auto load = [&] {
+        auto tile = std::make_unique<VectorTile>(OverscaledTileID(0, 0, 0), "source", parameters, test.tileset);
+        tile->setLayers(layers);
+        tile->setData(data);
+        while (!tile->isComplete()) {
+            test.loop.runOnce();
+        }
+        return tile;
+    };
+
+    auto tile = load();
+    ASSERT_TRUE(tile->isRenderable());
+    const auto featureIndex = tile->getFeatureIndex();
+    ASSERT_TRUE(featureIndex);
+    EXPECT_EQ(1u, cache->getStats().misses);
+
+    tile.reset();
+    EXPECT_EQ(1u, cache->getStats().entries);
+    EXPECT_LT(data->size(), cache->getStats().bytes);
+
+    // The second tile completes with the same layout, without a parse
+    tile = load();
+    EXPECT_TRUE(tile->isRenderable());
+    EXPECT_TRUE(tile->layerPropertiesUpdated(layers.front()));
+    EXPECT_EQ(featureIndex, tile->getFeatureIndex());
+    EXPECT_EQ(1u, cache->getStats().hits);
+    EXPECT_EQ(0u, cache->getStats().entries);
+}
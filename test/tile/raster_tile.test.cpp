@@ -37,7 +37,10 @@ public:
                          imageManager,
                          glyphManager,
                          0,
-                         {Scheduler::GetBackground(), uniqueID}},
+                         {Scheduler::GetBackground(), uniqueID},
+                         nullptr,
+                         nullptr,
+                         nullptr},
           style{fileSource, 1, tileParameters.threadPool} {}
 };
 
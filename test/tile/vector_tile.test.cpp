@@ -84,3 +84,40 @@ TEST(VectorTileData, ParseResults) {
 
     ASSERT_EQ(feature->getValue("invalid"), std::nullopt);
 }
+
+TEST(VectorTileData, VisitFeatures) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
+
+    for (const auto& name : data.layerNames()) {
+        std::unique_ptr<GeometryTileLayer> layer = data.getLayer(name);
+        ASSERT_TRUE(layer);
+
+        // The reused feature view decodes the same features as the owning feature objects
+        std::size_t visited = 0;
+        layer->visitFeatures([&](std::size_t i, const GeometryTileFeature& feature) {
+            EXPECT_EQ(visited++, i);
+            const std::unique_ptr<GeometryTileFeature> expected = layer->getFeature(i);
+            EXPECT_EQ(expected->getType(), feature.getType());
+            EXPECT_EQ(expected->getID(), feature.getID());
+            EXPECT_EQ(expected->getProperties(), feature.getProperties());
+            EXPECT_EQ(expected->getGeometries(), feature.getGeometries());
+            for (const auto& property : expected->getProperties()) {
+                EXPECT_EQ(expected->getValue(property.first), feature.getValue(property.first));
+            }
+            EXPECT_EQ(std::nullopt, feature.getValue("invalid"));
+            return true;
+        });
+        EXPECT_EQ(layer->featureCount(), visited);
+    }
+
+    // Returning false stops the iteration
+    std::size_t visited = 0;
+    data.getLayer("admin")->visitFeatures([&](std::size_t, const GeometryTileFeature&) { return ++visited < 10; });
+    EXPECT_EQ(10u, visited);
+
+    auto admin = data.getLayer("admin");
+    const auto& table = static_cast<const VectorTileLayer&>(*admin).getTable();
+    ASSERT_TRUE(table.keyIndex("disputed"));
+    EXPECT_EQ("disputed", table.getKey(*table.keyIndex("disputed")));
+    EXPECT_FALSE(table.keyIndex("invalid"));
+}
@@ -2,6 +2,8 @@
 
 #include <mbgl/test/util.hpp>
 
+#include <functional>
+
 using namespace mbgl;
 
 TEST(GridIndex, IndexesFeatures) {
@@ -55,3 +57,44 @@ TEST(GridIndex, IndexesFeaturesOverflow) {
     grid.insert(0, {{4500, 4500}, {4900, 4900}});
     EXPECT_EQ(grid.query({{4000, 4000}, {5000, 5000}}), (std::vector<int16_t>{0}));
 }
+
+TEST(GridIndex, ManyElementsPerCell) {
+    GridIndex<int16_t> grid(100, 100, 50);
+    std::vector<int16_t> expected;
+    for (int16_t i = 0; i < 20; ++i) {
+        grid.insert(int16_t(i), {{float(i), float(i)}, {float(i) + 60, float(i) + 1}});
+        expected.push_back(i);
+    }
+
+    // Insertion order holds across cells and across elements spanning several cells
+    EXPECT_EQ(grid.query({{0, 0}, {99, 99}}), expected);
+    EXPECT_EQ(grid.query({{70, 0}, {75, 30}}), (std::vector<int16_t>{10, 11, 12, 13, 14, 15, 16, 17, 18, 19}));
+    EXPECT_EQ(grid.query({{0, 18.5f}, {100, 18.5f}}), (std::vector<int16_t>{18}));
+}
+
+TEST(GridIndex, HitTestPredicate) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(1, {{10, 10}, {20, 20}});
+    grid.insert(2, {{50, 50}, 10});
+
+    const std::optional<std::function<bool(const int16_t&)>> odd{[](const int16_t& i) { return i % 2 == 1; }};
+    EXPECT_TRUE(grid.hitTest({{15, 15}, {16, 16}}, odd));
+    EXPECT_FALSE(grid.hitTest({{50, 50}, 1}, odd));
+    EXPECT_TRUE(grid.hitTest({{50, 50}, 1}));
+    EXPECT_TRUE(grid.hitTest({{50, 50}, 1}, std::optional<std::function<bool(const int16_t&)>>{}));
+}
+
+TEST(GridIndex, Clear) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(0, {{4, 10}, {6, 30}});
+    grid.insert(1, {{50, 50}, 10});
+    ASSERT_FALSE(grid.empty());
+
+    grid.clear();
+    EXPECT_TRUE(grid.empty());
+    EXPECT_EQ(grid.query({{-1000, -1000}, {1000, 1000}}), (std::vector<int16_t>{}));
+    EXPECT_FALSE(grid.hitTest({{5, 20}, {5, 20}}));
+
+    grid.insert(2, {{4, 10}, {6, 30}});
+    EXPECT_EQ(grid.query({{0, 0}, {10, 40}}), (std::vector<int16_t>{2}));
+}
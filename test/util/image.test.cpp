@@ -163,3 +163,45 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(0u, rgba.size.width);
     EXPECT_EQ(0u, rgba.size.height);
 }
+
+TEST(Image, PremultiplyAllValues) {
+    // Every color and alpha combination, plus a few pixels that don't fill a whole vector
+    constexpr uint32_t count = 256 * 256 + 3;
+    UnassociatedImage rgba({count, 1});
+    for (uint32_t i = 0; i < count; i++) {
+        rgba.data[i * 4 + 0] = static_cast<uint8_t>(i);
+        rgba.data[i * 4 + 1] = static_cast<uint8_t>(255 - i);
+        rgba.data[i * 4 + 2] = static_cast<uint8_t>(i / 2);
+        rgba.data[i * 4 + 3] = static_cast<uint8_t>(i / 256);
+    }
+    const UnassociatedImage original = rgba.clone();
+
+    const PremultipliedImage image = util::premultiply(std::move(rgba));
+    for (size_t i = 0; i < image.bytes(); i++) {
+        const uint8_t alpha = original.data[i | 3];
+        const uint8_t expected = i % 4 == 3 ? alpha : static_cast<uint8_t>((original.data[i] * alpha + 127) / 255);
+        ASSERT_EQ(expected, image.data[i]) << "at byte " << i;
+    }
+}
+
+TEST(Image, UnpremultiplyAllValues) {
+    constexpr uint32_t count = 256 * 256 + 3;
+    PremultipliedImage premultiplied({count, 1});
+    for (uint32_t i = 0; i < count; i++) {
+        premultiplied.data[i * 4 + 0] = static_cast<uint8_t>(i);
+        premultiplied.data[i * 4 + 1] = static_cast<uint8_t>(255 - i);
+        premultiplied.data[i * 4 + 2] = static_cast<uint8_t>(i / 2);
+        premultiplied.data[i * 4 + 3] = static_cast<uint8_t>(i / 256);
+    }
+    const PremultipliedImage original = premultiplied.clone();
+
+    // Colors brighter than alpha aren't valid, but must still convert the same way on every platform
+    const UnassociatedImage image = util::unpremultiply(std::move(premultiplied));
+    for (size_t i = 0; i < image.bytes(); i++) {
+        const uint8_t alpha = original.data[i | 3];
+        const uint8_t expected = i % 4 == 3 || alpha == 0
+                                     ? original.data[i]
+                                     : static_cast<uint8_t>((255 * original.data[i] + (alpha / 2)) / alpha);
+        ASSERT_EQ(expected, image.data[i]) << "at byte " << i;
+    }
+}
@@ -0,0 +1,216 @@
+#include <mbgl/util/thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr SchedulingMode modes[] = {SchedulingMode::SharedQueue, SchedulingMode::WorkStealing};
+
+} // namespace
+
+TEST(ThreadPool, RunsAllTasks) {
+    for (const auto mode : modes) {
+        ParallelScheduler scheduler(3, mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag;
+
+        std::atomic<int> count{0};
+        for (int i = 0; i < 10000; ++i) {
+            base.schedule(tag, [&] { count++; });
+        }
+        base.waitForEmpty(tag);
+
+        EXPECT_EQ(10000, count);
+    }
+}
+
+TEST(ThreadPool, NestedTasks) {
+    for (const auto mode : modes) {
+        ParallelScheduler scheduler(3, mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag;
+
+        // Tasks scheduled from within the pool are counted against their tag too
+        std::atomic<int> count{0};
+        for (int i = 0; i < 100; ++i) {
+            base.schedule(tag, [&] {
+                for (int j = 0; j < 100; ++j) {
+                    base.schedule(tag, [&] { count++; });
+                }
+            });
+        }
+        base.waitForEmpty(tag);
+
+        EXPECT_EQ(10000, count);
+    }
+}
+
+TEST(ThreadPool, WaitForTag) {
+    for (const auto mode : modes) {
+        ParallelScheduler scheduler(3, mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag1, tag2;
+
+        std::atomic<bool> release{false};
+        std::atomic<int> count1{0};
+        base.schedule(tag2, [&] {
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+        for (int i = 0; i < 100; ++i) {
+            base.schedule(tag1, [&] { count1++; });
+        }
+
+        // A blocked task with another tag doesn't hold up waiting on the first
+        base.waitForEmpty(tag1);
+        EXPECT_EQ(100, count1);
+
+        release = true;
+        base.waitForEmpty(tag2);
+    }
+}
+
+TEST(ThreadPool, SequencedOrder) {
+    for (const auto mode : modes) {
+        SequencedScheduler scheduler(mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag;
+
+        std::vector<int> order;
+        for (int i = 0; i < 1000; ++i) {
+            base.schedule(tag, [&order, i] { order.push_back(i); });
+        }
+        base.waitForEmpty(tag);
+
+        ASSERT_EQ(1000u, order.size());
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(i, order[i]);
+        }
+    }
+}
+
+TEST(ThreadPool, SequencedOrderNestedTasks) {
+    for (const auto mode : modes) {
+        SequencedScheduler scheduler(mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag;
+
+        // Hold the only worker until the tasks from outside the pool are queued
+        std::atomic<bool> release{false};
+        base.schedule(tag, [&] {
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+
+        // Tasks scheduled from within the pool queue up behind the ones scheduled before them from outside
+        std::vector<std::string> order;
+        for (const std::string name : {"a", "b", "c"}) {
+            base.schedule(tag, [&base, &order, &tag, name] {
+                order.push_back(name);
+                base.schedule(tag, [&order, name] { order.push_back(name + "'"); });
+            });
+        }
+        release = true;
+        base.waitForEmpty(tag);
+
+        const std::vector<std::string> expected = {"a", "b", "c", "a'", "b'", "c'"};
+        EXPECT_EQ(expected, order);
+    }
+}
+
+TEST(ThreadPool, MultipleProducers) {
+    for (const auto mode : modes) {
+        ParallelScheduler scheduler(3, mode);
+        Scheduler& base = scheduler;
+
+        constexpr int producerCount = 4;
+        constexpr int tasksPerProducer = 5000;
+        std::atomic<int> count{0};
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&] {
+                const util::SimpleIdentity tag;
+                for (int i = 0; i < tasksPerProducer; ++i) {
+                    base.schedule(tag, [&] { count++; });
+                }
+                base.waitForEmpty(tag);
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        EXPECT_EQ(producerCount * tasksPerProducer, count);
+    }
+}
+
+TEST(ThreadPool, PriorityLanes) {
+    for (const auto mode : modes) {
+        SequencedScheduler scheduler(mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag;
+
+        // Hold the only worker until everything else is queued
+        std::atomic<bool> release{false};
+        base.schedule(tag, [&] {
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+
+        std::vector<TaskPriority> order;
+        for (const auto priority : {TaskPriority::Low, TaskPriority::Normal, TaskPriority::High}) {
+            for (int i = 0; i < 3; ++i) {
+                base.scheduleWithPriority(tag, priority, [&order, priority] { order.push_back(priority); });
+            }
+        }
+        release = true;
+        base.waitForEmpty(tag);
+
+        const std::vector<TaskPriority> expected = {TaskPriority::High,
+                                                    TaskPriority::High,
+                                                    TaskPriority::High,
+                                                    TaskPriority::Normal,
+                                                    TaskPriority::Normal,
+                                                    TaskPriority::Normal,
+                                                    TaskPriority::Low,
+                                                    TaskPriority::Low,
+                                                    TaskPriority::Low};
+        EXPECT_EQ(expected, order);
+    }
+}
+
+TEST(ThreadPool, LowPriorityNotStarved) {
+    for (const auto mode : modes) {
+        SequencedScheduler scheduler(mode);
+        Scheduler& base = scheduler;
+        const util::SimpleIdentity tag;
+
+        // Sustained load: a high priority task that keeps scheduling another one until the low priority one ran
+        constexpr int maxHighTasks = 10000;
+        std::atomic<bool> lowRan{false};
+        std::atomic<int> highCount{0};
+        std::function<void()> high = [&] {
+            if (!lowRan && ++highCount < maxHighTasks) {
+                base.scheduleWithPriority(tag, TaskPriority::High, [&] { high(); });
+            }
+        };
+        base.scheduleWithPriority(tag, TaskPriority::High, [&] { high(); });
+        base.scheduleWithPriority(tag, TaskPriority::Low, [&] { lowRan = true; });
+        base.waitForEmpty(tag);
+
+        EXPECT_TRUE(lowRan);
+        EXPECT_LT(highCount, 100);
+    }
+}